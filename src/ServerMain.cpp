@@ -6,12 +6,15 @@
 #include <CompilationInfo.h>
 #include <engine/Server.h>
 #include <global/Constants.h>
+#include <util/File.h>
 #include <util/ProgramOptionsHelpers.h>
 #include <util/ReadableNumberFact.h>
 
 #include <boost/program_options.hpp>
 #include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -28,6 +31,50 @@ namespace po = boost::program_options;
 #define EMPH_ON "\033[1m"
 #define EMPH_OFF "\033[22m"
 
+// Configure the disk that STXXL uses for the external sorting of large inputs
+// of Sort and ORDER BY (see `ExternalSort.h`) if one of the `directory` and
+// the `diskSizeGb` is specified: write a .stxxl config file to the `directory`
+// (by default the directory of the index) and inform STXXL about its location.
+// Otherwise, or if the environment variable STXXLCFG is already set, or if the
+// file can't be written (e.g. because the directory is read-only), STXXL uses
+// its default configuration.
+void writeStxxlConfigFile(const string& indexBasename,
+                          const std::optional<string>& directory,
+                          std::optional<size_t> diskSizeGb) {
+  if (!directory.has_value() && !diskSizeGb.has_value()) {
+    return;
+  }
+  if (const char* configFileName = std::getenv("STXXLCFG")) {
+    LOG(INFO) << "Using the STXXL configuration from " << configFileName
+              << std::endl;
+    return;
+  }
+  string basename = indexBasename;
+  if (directory.has_value()) {
+    basename = (std::filesystem::path{directory.value()} /
+                std::filesystem::path{indexBasename}.filename())
+                   .string();
+  }
+  string stxxlConfigFileName = basename + ".server.stxxl";
+  try {
+    auto configFile = ad_utility::makeOfstream(stxxlConfigFileName);
+    configFile << "disk=" << basename << ".server.stxxl-disk,"
+               << (diskSizeGb.has_value() ? diskSizeGb.value() * 1000
+                                          : STXXL_DISK_SIZE_SERVER)
+               << ",syscall\n";
+    configFile.close();
+    if (!configFile) {
+      throw std::runtime_error("Writing the file failed");
+    }
+  } catch (const std::exception& e) {
+    LOG(WARN) << "Could not write the STXXL configuration file "
+              << stxxlConfigFileName << " (" << e.what()
+              << "), STXXL uses its default configuration" << std::endl;
+    return;
+  }
+  setenv("STXXLCFG", stxxlConfigFileName.c_str(), true);
+}
+
 // Main function.
 int main(int argc, char** argv) {
   setlocale(LC_CTYPE, "");
@@ -49,6 +96,12 @@ int main(int argc, char** argv) {
   bool noPatterns;
   bool noPatternTrick;
   bool onlyPsoAndPosPermutations;
+  bool memoryMapPermutations;
+  std::vector<std::string> memoryResidentPermutations;
+  bool useHugePages;
+  bool lockPermutationsInMemory;
+  std::optional<NonNegative> stxxlDiskSizeGb;
+  std::optional<std::string> stxxlDirectory;
 
   NonNegative memoryMaxSizeGb;
 
@@ -106,6 +159,37 @@ int main(int argc, char** argv) {
       po::bool_switch(&onlyPsoAndPosPermutations),
       "Only load the PSO and POS permutations. This disables queries with "
       "predicate variables.");
+  add("memory-map-permutations", po::bool_switch(&memoryMapPermutations),
+      "Map the files of the permutations into memory instead of reading the "
+      "blocks via explicit file reads. This avoids one copy per block and "
+      "leaves the caching of the blocks to the page cache of the operating "
+      "system.");
+  add("memory-resident-permutations",
+      po::value<std::vector<std::string>>(&memoryResidentPermutations)
+          ->multitoken(),
+      "Completely load the files of the given permutations (e.g. `PSO POS`) "
+      "into memory when the index is loaded. Scans of these permutations then "
+      "never have to access the disk.");
+  add("huge-pages", po::bool_switch(&useHugePages),
+      "Back the memory of the permutations given via "
+      "--memory-resident-permutations by transparent huge pages.");
+  add("mlock-permutations", po::bool_switch(&lockPermutationsInMemory),
+      "Lock the memory of the permutations given via "
+      "--memory-resident-permutations (via `mlock`), s.t. it is never swapped "
+      "out. This requires the capability CAP_IPC_LOCK or a sufficient limit "
+      "for locked memory (see `ulimit -l`), otherwise only a warning is "
+      "logged.");
+  add("stxxl-disk-size-gb", po::value(&stxxlDiskSizeGb),
+      "The size of the file `<index-basename>.server.stxxl-disk` that is used "
+      "for sorting the inputs of Sort and ORDER BY operations that are too "
+      "large to be sorted in RAM (see the runtime parameter "
+      "`sort-in-memory-max-size-mb`). The default is 10 GB if --stxxl-dir is "
+      "specified. If neither option is specified, or if the environment "
+      "variable STXXLCFG is set, STXXL uses its default configuration.");
+  add("stxxl-dir", po::value(&stxxlDirectory),
+      "The (writable) directory for the STXXL configuration file and the file "
+      "`<index-basename>.server.stxxl-disk` (see --stxxl-disk-size-gb). The "
+      "default is the directory of the index.");
   po::variables_map optionsMap;
 
   try {
@@ -126,9 +210,16 @@ int main(int argc, char** argv) {
             << qlever::version::GitShortHash() << EMPH_OFF << std::endl;
 
   try {
+    writeStxxlConfigFile(indexBasename, stxxlDirectory, stxxlDiskSizeGb);
     Server server(port, static_cast<int>(numSimultaneousQueries),
                   memoryMaxSizeGb, std::move(accessToken), !noPatternTrick);
-    server.run(indexBasename, text, !noPatterns, !onlyPsoAndPosPermutations);
+    std::vector<Permutation::Enum> residentPermutations;
+    for (const auto& name : memoryResidentPermutations) {
+      residentPermutations.push_back(Permutation::fromString(name));
+    }
+    server.run(indexBasename, text, !noPatterns, !onlyPsoAndPosPermutations,
+               memoryMapPermutations, std::move(residentPermutations),
+               useHugePages, lockPermutationsInMemory);
   } catch (const std::exception& e) {
     // This code should never be reached as all exceptions should be handled
     // within server.run()
@@ -109,28 +109,72 @@ ResultTable Bind::computeResult() {
   size_t outwidth = getResultWidth();
 
   CALL_FIXED_SIZE((std::array{inwidth, outwidth}), &Bind::computeExpressionBind,
-                  this, &idTable, &localVocab, *subRes,
-                  _bind._expression.getPimpl());
+                  this, &idTable, &localVocab, subRes->idTable(),
+                  subRes->localVocab(), _bind._expression.getPimpl());
 
   LOG(DEBUG) << "BIND result computation done." << endl;
   return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
 }
 
+// _____________________________________________________________________________
+bool Bind::supportsLazyEvaluation() const {
+  return _subtree->getRootOperation()->supportsLazyEvaluation();
+}
+
+// _____________________________________________________________________________
+LazyResultTable Bind::computeResultLazily() {
+  LazyResultTable subRes = _subtree->getLazyResult();
+  auto localVocab = std::make_shared<LocalVocab>();
+  return {computeBindForBlocks(std::move(subRes), localVocab), resultSortedOn(),
+          localVocab};
+}
+
+// _____________________________________________________________________________
+LazyResultTable::Blocks Bind::computeBindForBlocks(
+    LazyResultTable input, std::shared_ptr<LocalVocab> outputLocalVocab) {
+  size_t inWidth = _subtree->getResultWidth();
+  size_t outWidth = getResultWidth();
+  IdTable idTable{getExecutionContext()->getAllocator()};
+  IdTable remappedBlock{getExecutionContext()->getAllocator()};
+  for (const IdTable& block : input.blocks_) {
+    // The local vocab of the input might still grow while we are consuming
+    // its blocks, so we cannot simply copy it once (as it is done in
+    // `computeResult`). Instead, the words of the input block are transferred
+    // to our own local vocab, s.t. all IDs of the result refer to the same
+    // vocabulary. This requires a copy of the block, but only if the input
+    // actually uses its local vocab.
+    const IdTable* inputBlock = &block;
+    if (!input.localVocab_->empty()) {
+      remappedBlock = block.clone();
+      LazyResultTable::remapLocalVocabIndices(
+          remappedBlock, *input.localVocab_, *outputLocalVocab);
+      inputBlock = &remappedBlock;
+    }
+    idTable.clear();
+    idTable.setNumColumns(outWidth);
+    CALL_FIXED_SIZE((std::array{inWidth, outWidth}),
+                    &Bind::computeExpressionBind, this, &idTable,
+                    outputLocalVocab.get(), *inputBlock, *outputLocalVocab,
+                    _bind._expression.getPimpl());
+    checkTimeout();
+    co_yield idTable;
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t IN_WIDTH, size_t OUT_WIDTH>
 void Bind::computeExpressionBind(
     IdTable* outputIdTable, LocalVocab* outputLocalVocab,
-    const ResultTable& inputResultTable,
+    const IdTable& inputTable, const LocalVocab& inputLocalVocab,
     sparqlExpression::SparqlExpression* expression) const {
   sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
-      inputResultTable.idTable(), getExecutionContext()->getAllocator(),
-      inputResultTable.localVocab());
+      *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+      getExecutionContext()->getAllocator(), inputLocalVocab);
 
   sparqlExpression::ExpressionResult expressionResult =
       expression->evaluate(&evaluationContext);
 
-  const auto input = inputResultTable.idTable().asStaticView<IN_WIDTH>();
+  const auto input = inputTable.asStaticView<IN_WIDTH>();
   auto output = std::move(*outputIdTable).toStatic<OUT_WIDTH>();
 
   // first initialize the first columns (they remain identical)
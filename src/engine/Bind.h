@@ -48,11 +48,27 @@ class Bind : public Operation {
  private:
   ResultTable computeResult() override;
 
-  // Implementation for the binding of arbitrary expressions.
+ public:
+  // A BIND can be evaluated block by block, so it can be computed lazily
+  // whenever its input can be computed lazily.
+  bool supportsLazyEvaluation() const override;
+
+ private:
+  LazyResultTable computeResultLazily() override;
+
+  // Compute the BIND for each of the blocks of the `input` and yield the
+  // resulting blocks. All the `LocalVocabIndex` IDs of the yielded blocks refer
+  // to the `outputLocalVocab`.
+  LazyResultTable::Blocks computeBindForBlocks(
+      LazyResultTable input, std::shared_ptr<LocalVocab> outputLocalVocab);
+
+  // Implementation for the binding of arbitrary expressions. The `inputTable`
+  // uses the `inputLocalVocab`, new words are added to the `outputLocalVocab`.
+  // The two local vocabs may be the same object.
   template <size_t IN_WIDTH, size_t OUT_WIDTH>
   void computeExpressionBind(
       IdTable* outputIdTable, LocalVocab* outputLocalVocab,
-      const ResultTable& inputResultTable,
+      const IdTable& inputTable, const LocalVocab& inputLocalVocab,
       sparqlExpression::SparqlExpression* expression) const;
 
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap() const override;
@@ -118,7 +118,7 @@ ResultTable CountAvailablePredicates::computeResult() {
 
   RuntimeInformation& runtimeInfo = getRuntimeInfo();
 
-  const std::vector<PatternID>& hasPattern =
+  std::span<const PatternID> hasPattern =
       _executionContext->getIndex().getHasPattern();
   const CompactVectorOfStrings<Id>& hasPredicate =
       _executionContext->getIndex().getHasPredicate();
@@ -145,7 +145,7 @@ ResultTable CountAvailablePredicates::computeResult() {
 }
 
 void CountAvailablePredicates::computePatternTrickAllEntities(
-    IdTable* dynResult, const vector<PatternID>& hasPattern,
+    IdTable* dynResult, std::span<const PatternID> hasPattern,
     const CompactVectorOfStrings<Id>& hasPredicate,
     const CompactVectorOfStrings<Id>& patterns) {
   IdTableStatic<2> result = std::move(*dynResult).toStatic<2>();
@@ -207,7 +207,7 @@ class MergeableHashMap : public ad_utility::HashMap<T, size_t> {
 template <size_t WIDTH>
 void CountAvailablePredicates::computePatternTrick(
     const IdTable& dynInput, IdTable* dynResult,
-    const vector<PatternID>& hasPattern,
+    std::span<const PatternID> hasPattern,
     const CompactVectorOfStrings<Id>& hasPredicate,
     const CompactVectorOfStrings<Id>& patterns, const size_t subjectColumn,
     RuntimeInformation* runtimeInfo) {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -102,13 +103,13 @@ class CountAvailablePredicates : public Operation {
   template <size_t I>
   static void computePatternTrick(
       const IdTable& input, IdTable* result,
-      const vector<PatternID>& hasPattern,
+      std::span<const PatternID> hasPattern,
       const CompactVectorOfStrings<Id>& hasPredicate,
       const CompactVectorOfStrings<Id>& patterns, size_t subjectColumn,
       RuntimeInformation* runtimeInfo);
 
   static void computePatternTrickAllEntities(
-      IdTable* result, const vector<PatternID>& hasPattern,
+      IdTable* result, std::span<const PatternID> hasPattern,
       const CompactVectorOfStrings<Id>& hasPredicate,
       const CompactVectorOfStrings<Id>& patterns);
 
@@ -52,3 +52,45 @@ ResultTable Distinct::computeResult() {
   LOG(DEBUG) << "Distinct result computation done." << endl;
   return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
+
+// _____________________________________________________________________________
+LazyResultTable Distinct::computeResultLazily() {
+  LazyResultTable subRes = _subtree->getLazyResult();
+  auto localVocab = subRes.localVocab_;
+  return {distinctBlocks(std::move(subRes)), resultSortedOn(),
+          std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+LazyResultTable::Blocks Distinct::distinctBlocks(LazyResultTable input) {
+  IdTable idTable{getExecutionContext()->getAllocator()};
+  // The values of the `_keepIndices` of the last row that was yielded.
+  std::optional<std::vector<Id>> lastRow;
+  auto isEqualToLastRow = [this, &lastRow](const auto& row) {
+    return lastRow.has_value() &&
+           std::ranges::equal(_keepIndices, lastRow.value(),
+                              std::ranges::equal_to{},
+                              [&row](ColumnIndex col) { return row[col]; });
+  };
+  for (const IdTable& block : input.blocks_) {
+    idTable.clear();
+    idTable.setNumColumns(block.numColumns());
+    CALL_FIXED_SIZE(block.numColumns(), &Engine::distinct, block, _keepIndices,
+                    &idTable);
+    // Within a block, all duplicates have been removed. Only the first row
+    // might still be a duplicate of the last row of the previous block.
+    if (!idTable.empty() && isEqualToLastRow(idTable[0])) {
+      idTable.erase(idTable.begin());
+    }
+    checkTimeout();
+    if (idTable.empty()) {
+      continue;
+    }
+    const auto& last = idTable[idTable.size() - 1];
+    lastRow.emplace();
+    for (ColumnIndex col : _keepIndices) {
+      lastRow->push_back(last[col]);
+    }
+    co_yield idTable;
+  }
+}
@@ -65,5 +65,19 @@ class Distinct : public Operation {
  private:
   virtual ResultTable computeResult() override;
 
+ public:
+  // The input of a DISTINCT is sorted, so duplicates can only occur in
+  // consecutive rows, also across block boundaries. It can thus be computed
+  // lazily whenever its input can be computed lazily.
+  bool supportsLazyEvaluation() const override {
+    return _subtree->getRootOperation()->supportsLazyEvaluation();
+  }
+
+ private:
+  LazyResultTable computeResultLazily() override;
+
+  // Yield the distinct rows of the blocks of the `input`.
+  LazyResultTable::Blocks distinctBlocks(LazyResultTable input);
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 };
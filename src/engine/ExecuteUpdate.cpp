@@ -0,0 +1,255 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/ExecuteUpdate.h"
+
+#include <variant>
+
+#include "engine/QueryPlanner.h"
+#include "global/Constants.h"
+#include "index/IndexImpl.h"
+#include "util/Conversions.h"
+#include "util/HashMap.h"
+#include "util/OverloadCallOperator.h"
+
+namespace {
+using IdTriple = std::array<Id, 3>;
+
+// An element of a triple template after resolving the constants, either a
+// fixed ID or the column of a variable in the result of the WHERE clause.
+using IdOrColumn = std::variant<Id, ColumnIndex>;
+using ResolvedTemplate = std::array<IdOrColumn, 3>;
+
+// Resolve the constants and variables of the `templates`. For inserted
+// triples (`isInsert == true`), IRIs and literals that are not contained in
+// the index are added to its update vocabulary. Templates that can never be
+// instantiated are dropped: those with a variable that is not bound by the
+// WHERE clause, and deleted triples with a word that is unknown to the index.
+std::vector<ResolvedTemplate> resolveTemplates(
+    const std::vector<ParsedUpdate::Triple>& templates,
+    const VariableToColumnMap& variableColumns, IndexImpl& index,
+    bool isInsert) {
+  auto isBound = [&variableColumns](const TripleComponent& tc) {
+    return !tc.isVariable() || variableColumns.contains(tc.getVariable());
+  };
+  auto resolve = [&](const TripleComponent& tc) -> std::optional<IdOrColumn> {
+    if (tc.isVariable()) {
+      return variableColumns.at(tc.getVariable()).columnIndex_;
+    }
+    if (!isInsert) {
+      return index.getId(tc);
+    }
+    if (tc.isString()) {
+      return index.getOrAddIdForUpdate(tc.getString());
+    }
+    if (tc.isLiteral()) {
+      return index.getOrAddIdForUpdate(tc.getLiteral().rawContent());
+    }
+    return tc.toValueIdIfNotString();
+  };
+  std::vector<ResolvedTemplate> result;
+  for (const auto& triple : templates) {
+    // Check the variables first, so that no words are added for templates
+    // that are dropped anyway.
+    if (!std::ranges::all_of(triple, isBound)) {
+      continue;
+    }
+    ResolvedTemplate resolved;
+    bool isValid = true;
+    for (size_t i = 0; i < 3 && isValid; ++i) {
+      auto element = resolve(triple[i]);
+      isValid = element.has_value();
+      if (isValid) {
+        resolved[i] = element.value();
+      }
+    }
+    if (isValid) {
+      result.push_back(resolved);
+    }
+  }
+  return result;
+}
+
+// Instantiate the resolved `templates` with each row of the `whereResult`, or
+// once if there is no WHERE clause. Rows in which a variable of a template is
+// unbound are skipped for that template. Words from the local vocabulary of
+// the `whereResult` are translated to the IDs of the index, see
+// `resolveTemplates` for the semantics of `isInsert`.
+std::vector<IdTriple> instantiateTemplates(
+    const std::vector<ResolvedTemplate>& templates,
+    const ResultTable* whereResult, IndexImpl& index, bool isInsert) {
+  std::vector<IdTriple> triples;
+  if (whereResult == nullptr) {
+    for (const auto& resolved : templates) {
+      IdTriple& triple = triples.emplace_back();
+      for (size_t i = 0; i < 3; ++i) {
+        triple[i] = std::get<Id>(resolved[i]);
+      }
+    }
+    return triples;
+  }
+  auto toIndexId = [&](Id id) -> std::optional<Id> {
+    if (id.isUndefined()) {
+      return std::nullopt;
+    }
+    if (id.getDatatype() != Datatype::LocalVocabIndex) {
+      return id;
+    }
+    const auto& word =
+        whereResult->localVocab().getWord(id.getLocalVocabIndex());
+    return isInsert ? index.getOrAddIdForUpdate(word) : index.getIdOfWord(word);
+  };
+  const IdTable& idTable = whereResult->idTable();
+  for (size_t row = 0; row < idTable.size(); ++row) {
+    for (const auto& resolved : templates) {
+      IdTriple triple;
+      bool isValid = true;
+      for (size_t i = 0; i < 3 && isValid; ++i) {
+        auto id = std::visit(
+            ad_utility::OverloadCallOperator{
+                [](Id fixedId) -> std::optional<Id> { return fixedId; },
+                [&](ColumnIndex column) {
+                  return toIndexId(idTable(row, column));
+                }},
+            resolved[i]);
+        isValid = id.has_value();
+        if (isValid) {
+          triple[i] = id.value();
+        }
+      }
+      if (isValid) {
+        triples.push_back(triple);
+      }
+    }
+  }
+  return triples;
+}
+
+// Return true iff a triple with the `object` remains in the `index` after the
+// `sortedDeletedTriples` were deleted, not counting the triples for the
+// `LANG()` filters (see `getLanguageTagTriples` below). If the OPS permutation
+// is not loaded, this can't be determined and true is returned.
+bool hasRemainingTriplesWithObject(
+    Id object, const std::vector<IdTriple>& sortedDeletedTriples,
+    const IndexImpl& index) {
+  if (!index.hasAllPermutations()) {
+    return true;
+  }
+  IdTable predicatesAndSubjects = index.OPS().scan(object, std::nullopt);
+  for (size_t row = 0; row < predicatesAndSubjects.size(); ++row) {
+    Id predicate = predicatesAndSubjects(row, 0);
+    Id subject = predicatesAndSubjects(row, 1);
+    if (std::ranges::binary_search(sortedDeletedTriples,
+                                   IdTriple{subject, predicate, object})) {
+      continue;
+    }
+    // The language-tagged predicates like `@en@<p>` are the only words that
+    // start with `@`.
+    if (predicate.getDatatype() == Datatype::VocabIndex &&
+        index.idToOptionalString(predicate.getVocabIndex())
+            .value_or("")
+            .starts_with('@')) {
+      continue;
+    }
+    return true;
+  }
+  return false;
+}
+
+// For each of the `triples` that has a literal with a language tag as its
+// object, the index build adds the triples `<s> @lang@<p> <o>` and `<o>
+// ql:langtag <@lang>` (see `getIdMapLambdas`), on which the `LANG()` filters
+// are evaluated (see `ParsedQuery::GraphPattern::addLanguageFilter`). Return
+// these triples for the given `triples`, see `resolveTemplates` for the
+// semantics of `isInsert`. The `ql:langtag` triple is shared by all the triples
+// with the same object, so for deleted triples it is only returned if no other
+// triple with this object remains.
+std::vector<IdTriple> getLanguageTagTriples(
+    const std::vector<IdTriple>& triples, IndexImpl& index, bool isInsert) {
+  auto getId = [&index, isInsert](const std::string& word) {
+    return isInsert ? std::optional{index.getOrAddIdForUpdate(word)}
+                    : index.getIdOfWord(word);
+  };
+  auto getWord = [&index](Id id) -> std::optional<std::string> {
+    if (id.getDatatype() != Datatype::VocabIndex) {
+      return std::nullopt;
+    }
+    return index.idToOptionalString(id.getVocabIndex());
+  };
+  std::vector<IdTriple> result;
+  // The objects with a language tag and the IDs of their `<@lang>` entities.
+  ad_utility::HashMap<Id, Id> languageTagOfObject;
+  for (const auto& [subject, predicate, object] : triples) {
+    auto objectWord = getWord(object);
+    if (!objectWord.has_value() || !Index::Vocab::isLiteral(*objectWord)) {
+      continue;
+    }
+    auto languageTag = Index::Vocab::getLanguage(*objectWord);
+    auto predicateWord = getWord(predicate);
+    if (languageTag.empty() || !predicateWord.has_value()) {
+      continue;
+    }
+    if (auto taggedPredicate =
+            getId(ad_utility::convertToLanguageTaggedPredicate(*predicateWord,
+                                                               languageTag))) {
+      result.push_back({subject, taggedPredicate.value(), object});
+    }
+    if (auto languageTagEntity =
+            getId(ad_utility::convertLangtagToEntityUri(languageTag))) {
+      languageTagOfObject.emplace(object, languageTagEntity.value());
+    }
+  }
+  auto languagePredicate = getId(LANGUAGE_PREDICATE);
+  if (languageTagOfObject.empty() || !languagePredicate.has_value()) {
+    return result;
+  }
+  std::vector<IdTriple> sortedTriples;
+  if (!isInsert) {
+    sortedTriples = triples;
+    std::ranges::sort(sortedTriples);
+  }
+  for (const auto& [object, languageTagEntity] : languageTagOfObject) {
+    if (isInsert ||
+        !hasRemainingTriplesWithObject(object, sortedTriples, index)) {
+      result.push_back({object, languagePredicate.value(), languageTagEntity});
+    }
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ExecuteUpdate::Statistics ExecuteUpdate::execute(
+    Index& index, const ParsedUpdate& update, QueryExecutionContext& qec,
+    ad_utility::SharedConcurrentTimeoutTimer timer) {
+  AD_CONTRACT_CHECK(&qec.getIndex() == &index);
+  IndexImpl& impl = index.getImpl();
+  std::shared_ptr<const ResultTable> whereResult;
+  VariableToColumnMap variableColumns;
+  if (update.whereClause_.has_value()) {
+    ParsedQuery whereClause = update.whereClause_.value();
+    QueryPlanner queryPlanner{&qec};
+    QueryExecutionTree qet = queryPlanner.createExecutionTree(whereClause);
+    qet.recursivelySetTimeoutTimer(std::move(timer));
+    whereResult = qet.getResult();
+    variableColumns = qet.getVariableColumns();
+  }
+  auto computeTriples = [&](const std::vector<ParsedUpdate::Triple>& templates,
+                            bool isInsert) {
+    return instantiateTemplates(
+        resolveTemplates(templates, variableColumns, impl, isInsert),
+        whereResult.get(), impl, isInsert);
+  };
+  auto toDelete = computeTriples(update.toDelete_, false);
+  auto toInsert = computeTriples(update.toInsert_, true);
+  Statistics statistics{toDelete.size(), toInsert.size()};
+  // The additional triples for the `LANG()` filters are not counted.
+  std::ranges::copy(getLanguageTagTriples(toDelete, impl, false),
+                    std::back_inserter(toDelete));
+  std::ranges::copy(getLanguageTagTriples(toInsert, impl, true),
+                    std::back_inserter(toInsert));
+  if (!toDelete.empty() || !toInsert.empty()) {
+    index.deleteAndInsertTriples(toDelete, toInsert);
+  }
+  return statistics;
+}
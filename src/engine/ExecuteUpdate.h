@@ -0,0 +1,38 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include "engine/QueryExecutionContext.h"
+#include "index/Index.h"
+#include "parser/ParsedUpdate.h"
+#include "util/Timer.h"
+
+// Execute the operations of a SPARQL 1.1 Update request (see
+// `SparqlParser::parseUpdate`) by computing the triples that have to be
+// deleted and inserted and passing them on to the delta triples of the index
+// as a single operation (see `IndexImpl::deleteAndInsertTriples`).
+class ExecuteUpdate {
+ public:
+  // The number of triples that were passed on to the index. This includes
+  // deleted triples that were not contained in the index and inserted triples
+  // that already were, but not the additional triples for the `LANG()` filters
+  // that are deleted and inserted together with triples that have a literal
+  // with a language tag as their object.
+  struct Statistics {
+    size_t numDeleted_ = 0;
+    size_t numInserted_ = 0;
+  };
+
+  // Execute the `update` on the `index`. The WHERE clause (if any) is
+  // evaluated using the `qec`, which must refer to the same `index`. As
+  // required by the standard, the triples to delete and to insert are both
+  // computed from the same result of the WHERE clause, and the deletions are
+  // applied before the insertions.
+  //
+  // NOTE: Concurrent updates have to be serialized by the caller, who is also
+  // responsible for clearing the query result cache after each update.
+  static Statistics execute(Index& index, const ParsedUpdate& update,
+                            QueryExecutionContext& qec,
+                            ad_utility::SharedConcurrentTimeoutTimer timer);
+};
@@ -7,6 +7,7 @@
 #include <ranges>
 
 #include "parser/RdfEscaping.h"
+#include "util/HashMap.h"
 #include "util/http/MediaTypes.h"
 
 // __________________________________________________________________________
@@ -19,6 +20,140 @@ auto getRowIndices(const LimitOffsetClause& limitOffset,
   return std::views::iota(limitOffset.actualOffset(idTable.size()),
                           limitOffset.upperBound(idTable.size()));
 }
+
+// Adjust the `limitOffset` after the rows of a block of `blockSize` rows have
+// been exported (see `getRowIndices`), s.t. it can be applied to the next block
+// of a lazily computed result. Return false iff no more rows have to be
+// exported.
+bool updateLimitOffsetForNextBlock(LimitOffsetClause& limitOffset,
+                                  size_t blockSize) {
+  size_t numExportedRows = limitOffset.actualSize(blockSize);
+  limitOffset._offset -= limitOffset.actualOffset(blockSize);
+  if (!limitOffset._limit.has_value()) {
+    return true;
+  }
+  limitOffset._limit.value() -= numExportedRows;
+  return limitOffset._limit.value() > 0;
+}
+
+// The rows of a result are exported in batches of (at most) this many rows. The
+// words of the `VocabIndex` IDs of each batch are looked up together, see
+// `VocabWordsOfBatch` below.
+constexpr size_t NUM_ROWS_PER_EXPORT_BATCH = 50'000;
+
+using RowIndices = std::ranges::iota_view<size_t, size_t>;
+
+// Split the `rowIndices` (see `getRowIndices`) into consecutive batches of at
+// most `NUM_ROWS_PER_EXPORT_BATCH` rows.
+std::vector<RowIndices> getRowIndexBatches(RowIndices rowIndices) {
+  std::vector<RowIndices> batches;
+  if (rowIndices.empty()) {
+    return batches;
+  }
+  const size_t end = rowIndices.back() + 1;
+  for (size_t begin = rowIndices.front(); begin < end;
+       begin += NUM_ROWS_PER_EXPORT_BATCH) {
+    batches.emplace_back(begin,
+                         std::min(begin + NUM_ROWS_PER_EXPORT_BATCH, end));
+  }
+  return batches;
+}
+
+// Convert a `word` from the vocabulary or from a `LocalVocab`. The template
+// parameters and the return value have the same meaning as for
+// `ExportQueryExecutionTrees::idToStringAndType`.
+template <bool removeQuotesAndAngleBrackets, bool onlyReturnLiterals,
+          typename EscapeFunction>
+std::optional<std::pair<std::string, const char*>> wordToStringAndType(
+    std::string word, EscapeFunction&& escapeFunction) {
+  if constexpr (onlyReturnLiterals) {
+    if (!word.starts_with('"')) {
+      return std::nullopt;
+    }
+  }
+  if constexpr (removeQuotesAndAngleBrackets) {
+    word = RdfEscaping::normalizedContentFromLiteralOrIri(std::move(word));
+  }
+  return std::pair{escapeFunction(std::move(word)), nullptr};
+}
+
+// The words of the `VocabIndex` IDs in the given `columns` and `rows` of an
+// `IdTable`. They are looked up in a single batch in the order of their IDs
+// (see `Index::idsToOptionalStrings`). For the part of the vocabulary that is
+// stored on disk, this turns many random reads into an (almost) sequential
+// sweep over the file.
+class VocabWordsOfBatch {
+ private:
+  // The sorted and unique indices and their words.
+  std::vector<VocabIndex> indices_;
+  std::vector<std::optional<std::string>> words_;
+
+ public:
+  VocabWordsOfBatch(const Index& index, const IdTable& idTable,
+                    RowIndices rows,
+                    const QueryExecutionTree::ColumnIndicesAndTypes& columns) {
+    for (const auto& column : columns) {
+      if (!column.has_value()) {
+        continue;
+      }
+      auto ids = idTable.getColumn(column->_columnIndex);
+      for (size_t row : rows) {
+        if (ids[row].getDatatype() == Datatype::VocabIndex) {
+          indices_.push_back(ids[row].getVocabIndex());
+        }
+      }
+    }
+    std::ranges::sort(indices_);
+    auto [uniqueEnd, end] = std::ranges::unique(indices_);
+    indices_.erase(uniqueEnd, end);
+    words_ = index.idsToOptionalStrings(indices_);
+  }
+
+  // Same as `ExportQueryExecutionTrees::idToStringAndType`, but the word of a
+  // `VocabIndex` ID is taken from this batch, which must contain it.
+  template <bool removeQuotesAndAngleBrackets = false,
+            bool onlyReturnLiterals = false,
+            typename EscapeFunction = std::identity>
+  std::optional<std::pair<std::string, const char*>> idToStringAndType(
+      const Index& index, Id id, const LocalVocab& localVocab,
+      EscapeFunction&& escapeFunction = EscapeFunction{}) const {
+    if (id.getDatatype() != Datatype::VocabIndex) {
+      return ExportQueryExecutionTrees::idToStringAndType<
+          removeQuotesAndAngleBrackets, onlyReturnLiterals>(
+          index, id, localVocab, AD_FWD(escapeFunction));
+    }
+    auto it = std::ranges::lower_bound(indices_, id.getVocabIndex());
+    AD_CORRECTNESS_CHECK(it != indices_.end() && *it == id.getVocabIndex());
+    const auto& word = words_.at(it - indices_.begin());
+    AD_CONTRACT_CHECK(word.has_value());
+    return wordToStringAndType<removeQuotesAndAngleBrackets,
+                               onlyReturnLiterals>(word.value(),
+                                                   AD_FWD(escapeFunction));
+  }
+};
+
+// Return the `value` as a JSON string (with quotes and escaped special
+// characters). Invalid UTF-8 is replaced instead of throwing, because the JSON
+// results are streamed and an exception would leave a truncated response.
+std::string toJsonString(std::string_view value) {
+  return nlohmann::json(value).dump(-1, ' ', false,
+                                    nlohmann::json::error_handler_t::replace);
+}
+
+// Return a single binding in the SPARQL JSON format with the given `value` and
+// `type`. If the `extraKey` is not empty, a member with this key (e.g.
+// "xml:lang" or "datatype") and the `extraValue` is added.
+std::string sparqlJsonBinding(std::string_view value, std::string_view type,
+                              std::string_view extraKey = "",
+                              std::string_view extraValue = "") {
+  std::string result = absl::StrCat("{\"value\":", toJsonString(value),
+                                    ",\"type\":\"", type, "\"");
+  if (!extraKey.empty()) {
+    absl::StrAppend(&result, ",\"", extraKey, "\":", toJsonString(extraValue));
+  }
+  result.push_back('}');
+  return result;
+}
 }  // namespace
 
 // _____________________________________________________________________________
@@ -79,56 +214,63 @@ ExportQueryExecutionTrees::constructQueryResultToTurtle(
 }
 
 // _____________________________________________________________________________
-nlohmann::json
+cppcoro::generator<std::string>
 ExportQueryExecutionTrees::constructQueryResultBindingsToQLeverJSON(
     const QueryExecutionTree& qet,
     const ad_utility::sparql_types::Triples& constructTriples,
-    const LimitOffsetClause& limitAndOffset,
-    std::shared_ptr<const ResultTable> res) {
+    LimitOffsetClause limitAndOffset, std::shared_ptr<const ResultTable> res) {
   auto generator = constructQueryResultToTriples(
       qet, constructTriples, limitAndOffset, std::move(res));
-  std::vector<std::array<std::string, 3>> jsonArray;
-  for (auto& triple : generator) {
-    jsonArray.push_back({std::move(triple._subject),
-                         std::move(triple._predicate),
-                         std::move(triple._object)});
+  for (const auto& triple : generator) {
+    co_yield absl::StrCat("[", toJsonString(triple._subject), ",",
+                          toJsonString(triple._predicate), ",",
+                          toJsonString(triple._object), "]");
   }
-  return jsonArray;
 }
 
 // __________________________________________________________________________________________________________
-nlohmann::json ExportQueryExecutionTrees::idTableToQLeverJSONArray(
-    const QueryExecutionTree& qet, const LimitOffsetClause& limitAndOffset,
-    const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+cppcoro::generator<std::string>
+ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
+    const QueryExecutionTree& qet, LimitOffsetClause limitAndOffset,
+    QueryExecutionTree::ColumnIndicesAndTypes columns,
     std::shared_ptr<const ResultTable> resultTable) {
   AD_CORRECTNESS_CHECK(resultTable != nullptr);
   const IdTable& data = resultTable->idTable();
-  nlohmann::json json = nlohmann::json::array();
-
-  for (size_t rowIndex : getRowIndices(limitAndOffset, data)) {
-    json.emplace_back();
-    auto& row = json.back();
-    for (const auto& opt : columns) {
-      if (!opt) {
-        row.emplace_back(nullptr);
-        continue;
-      }
-      const auto& currentId = data(rowIndex, opt->_columnIndex);
-      const auto& optionalStringAndXsdType = idToStringAndType(
-          qet.getQec()->getIndex(), currentId, resultTable->localVocab());
-      if (!optionalStringAndXsdType.has_value()) {
-        row.emplace_back(nullptr);
-        continue;
-      }
-      const auto& [stringValue, xsdType] = optionalStringAndXsdType.value();
-      if (xsdType) {
-        row.emplace_back('"' + stringValue + "\"^^<" + xsdType + '>');
-      } else {
-        row.emplace_back(stringValue);
+  const Index& index = qet.getQec()->getIndex();
+
+  for (RowIndices batch :
+       getRowIndexBatches(getRowIndices(limitAndOffset, data))) {
+    VocabWordsOfBatch vocabWords{index, data, batch, columns};
+    for (size_t rowIndex : batch) {
+      std::string row = "[";
+      for (size_t i = 0; i < columns.size(); ++i) {
+        if (i > 0) {
+          row.push_back(',');
+        }
+        const auto& opt = columns[i];
+        if (!opt) {
+          row.append("null");
+          continue;
+        }
+        const auto& currentId = data(rowIndex, opt->_columnIndex);
+        const auto& optionalStringAndXsdType = vocabWords.idToStringAndType(
+            index, currentId, resultTable->localVocab());
+        if (!optionalStringAndXsdType.has_value()) {
+          row.append("null");
+          continue;
+        }
+        const auto& [stringValue, xsdType] = optionalStringAndXsdType.value();
+        if (xsdType) {
+          row.append(toJsonString(
+              absl::StrCat("\"", stringValue, "\"^^<", xsdType, ">")));
+        } else {
+          row.append(toJsonString(stringValue));
+        }
       }
+      row.push_back(']');
+      co_yield row;
     }
   }
-  return json;
 }
 
 // ___________________________________________________________________________
@@ -193,29 +335,14 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
       std::optional<string> entity =
           index.idToOptionalString(id.getVocabIndex());
       AD_CONTRACT_CHECK(entity.has_value());
-      if constexpr (onlyReturnLiterals) {
-        if (!entity.value().starts_with('"')) {
-          return std::nullopt;
-        }
-      }
-      if constexpr (removeQuotesAndAngleBrackets) {
-        entity = RdfEscaping::normalizedContentFromLiteralOrIri(
-            std::move(entity.value()));
-      }
-      return std::pair{escapeFunction(std::move(entity.value())), nullptr};
-    }
-    case LocalVocabIndex: {
-      std::string word = localVocab.getWord(id.getLocalVocabIndex());
-      if constexpr (onlyReturnLiterals) {
-        if (!word.starts_with('"')) {
-          return std::nullopt;
-        }
-      }
-      if constexpr (removeQuotesAndAngleBrackets) {
-        word = RdfEscaping::normalizedContentFromLiteralOrIri(std::move(word));
-      }
-      return std::pair{escapeFunction(std::move(word)), nullptr};
+      return wordToStringAndType<removeQuotesAndAngleBrackets,
+                                 onlyReturnLiterals>(
+          std::move(entity.value()), AD_FWD(escapeFunction));
     }
+    case LocalVocabIndex:
+      return wordToStringAndType<removeQuotesAndAngleBrackets,
+                                 onlyReturnLiterals>(
+          localVocab.getWord(id.getLocalVocabIndex()), AD_FWD(escapeFunction));
     case TextRecordIndex:
       return std::pair{
           escapeFunction(index.getTextExcerpt(id.getTextRecordIndex())),
@@ -245,13 +372,12 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
                                              std::identity&& escapeFunction);
 
 // _____________________________________________________________________________
-nlohmann::json ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
+ad_utility::streams::stream_generator
+ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
     const QueryExecutionTree& qet,
     const parsedQuery::SelectClause& selectClause,
-    const LimitOffsetClause& limitAndOffset,
+    LimitOffsetClause limitAndOffset,
     shared_ptr<const ResultTable> resultTable) {
-  using nlohmann::json;
-
   AD_CORRECTNESS_CHECK(resultTable != nullptr);
   LOG(DEBUG) << "Finished computing the query result in the ID space. "
                 "Resolving strings in result...\n";
@@ -265,7 +391,6 @@ nlohmann::json ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
 
   const IdTable& idTable = resultTable->idTable();
 
-  json result;
   std::vector<std::string> selectedVars =
       selectClause.getSelectedVariablesAsStrings();
   // Strip the leading '?' from the variables, it is not part of the SPARQL JSON
@@ -275,94 +400,101 @@ nlohmann::json ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
       var = var.substr(1);
     }
   }
-  result["head"]["vars"] = selectedVars;
-
-  json bindings = json::array();
+  co_yield "{\"head\":{\"vars\":";
+  co_yield nlohmann::json(selectedVars).dump();
+  co_yield "},\"results\":{\"bindings\":[";
 
   // TODO<joka921> add a warning to the result (Also for other formats).
   if (columns.empty()) {
     LOG(WARN) << "Exporting a SPARQL query where none of the selected "
                  "variables is bound in the query"
               << std::endl;
-    result["results"]["bindings"] = json::array();
-    return result;
+    co_yield "]}}";
+    co_return;
   }
 
   // Take a string from the vocabulary, deduce the type and
   // return a json dict that describes the binding
-  auto stringToBinding = [](std::string_view entitystr) -> nlohmann::json {
-    nlohmann::ordered_json b;
+  auto stringToBinding = [](std::string_view entitystr) -> std::string {
     // The string is an IRI or literal.
     if (entitystr.starts_with('<')) {
-      // Strip the <> surrounding the iri.
-      b["value"] = entitystr.substr(1, entitystr.size() - 2);
-      // Even if they are technically IRIs, the format needs the type to be
-      // "uri".
-      b["type"] = "uri";
+      // Strip the <> surrounding the iri. Even if they are technically IRIs,
+      // the format needs the type to be "uri".
+      return sparqlJsonBinding(entitystr.substr(1, entitystr.size() - 2),
+                               "uri");
     } else if (entitystr.starts_with("_:")) {
-      b["value"] = entitystr.substr(2);
-      b["type"] = "bnode";
-    } else {
-      size_t quote_pos = entitystr.rfind('"');
-      if (quote_pos == std::string::npos) {
-        // TEXT entries are currently not surrounded by quotes
-        b["value"] = entitystr;
-        b["type"] = "literal";
-      } else {
-        b["value"] = entitystr.substr(1, quote_pos - 1);
-        b["type"] = "literal";
-        // Look for a language tag or type.
-        if (quote_pos < entitystr.size() - 1 &&
-            entitystr[quote_pos + 1] == '@') {
-          b["xml:lang"] = entitystr.substr(quote_pos + 2);
-        } else if (quote_pos < entitystr.size() - 2 &&
-                   entitystr[quote_pos + 1] == '^') {
-          AD_CONTRACT_CHECK(entitystr[quote_pos + 2] == '^');
-          std::string_view datatype{entitystr};
-          // remove the < angledBrackets> around the datatype IRI
-          AD_CONTRACT_CHECK(datatype.size() >= quote_pos + 5);
-          datatype.remove_prefix(quote_pos + 4);
-          datatype.remove_suffix(1);
-          b["datatype"] = datatype;
-          ;
-        }
-      }
+      return sparqlJsonBinding(entitystr.substr(2), "bnode");
+    }
+    size_t quote_pos = entitystr.rfind('"');
+    if (quote_pos == std::string::npos) {
+      // TEXT entries are currently not surrounded by quotes
+      return sparqlJsonBinding(entitystr, "literal");
     }
-    return b;
+    auto value = entitystr.substr(1, quote_pos - 1);
+    // Look for a language tag or type.
+    if (quote_pos < entitystr.size() - 1 && entitystr[quote_pos + 1] == '@') {
+      return sparqlJsonBinding(value, "literal", "xml:lang",
+                               entitystr.substr(quote_pos + 2));
+    } else if (quote_pos < entitystr.size() - 2 &&
+               entitystr[quote_pos + 1] == '^') {
+      AD_CONTRACT_CHECK(entitystr[quote_pos + 2] == '^');
+      std::string_view datatype{entitystr};
+      // remove the < angledBrackets> around the datatype IRI
+      AD_CONTRACT_CHECK(datatype.size() >= quote_pos + 5);
+      datatype.remove_prefix(quote_pos + 4);
+      datatype.remove_suffix(1);
+      return sparqlJsonBinding(value, "literal", "datatype", datatype);
+    }
+    return sparqlJsonBinding(value, "literal");
   };
 
-  for (size_t rowIndex : getRowIndices(limitAndOffset, idTable)) {
-    // TODO: ordered_json` entries are ordered alphabetically, but insertion
-    // order would be preferable.
-    nlohmann::ordered_json binding;
-    for (const auto& column : columns) {
-      const auto& currentId = idTable(rowIndex, column->_columnIndex);
-      const auto& optionalValue = idToStringAndType(
-          qet.getQec()->getIndex(), currentId, resultTable->localVocab());
-      if (!optionalValue.has_value()) {
-        continue;
-      }
-      const auto& [stringValue, xsdType] = optionalValue.value();
-      nlohmann::ordered_json b;
-      if (!xsdType) {
-        // No xsdType, this means that `stringValue` is a plain string literal
-        // or entity.
-        b = stringToBinding(stringValue);
-      } else {
-        b["value"] = stringValue;
-        b["type"] = "literal";
-        b["datatype"] = xsdType;
+  // The names of the variables as JSON keys, they are the same for each row.
+  std::vector<std::string> variableKeys;
+  for (const auto& column : columns) {
+    variableKeys.push_back(absl::StrCat(toJsonString(column->_variable), ":"));
+  }
+
+  const Index& index = qet.getQec()->getIndex();
+  bool isFirstRow = true;
+  for (RowIndices batch :
+       getRowIndexBatches(getRowIndices(limitAndOffset, idTable))) {
+    VocabWordsOfBatch vocabWords{index, idTable, batch, columns};
+    for (size_t rowIndex : batch) {
+      std::string binding = isFirstRow ? "\n{" : ",\n{";
+      isFirstRow = false;
+      bool isFirstColumn = true;
+      for (size_t i = 0; i < columns.size(); ++i) {
+        const auto& currentId = idTable(rowIndex, columns[i]->_columnIndex);
+        const auto& optionalValue = vocabWords.idToStringAndType(
+            index, currentId, resultTable->localVocab());
+        if (!optionalValue.has_value()) {
+          continue;
+        }
+        if (!isFirstColumn) {
+          binding.push_back(',');
+        }
+        isFirstColumn = false;
+        binding.append(variableKeys[i]);
+        const auto& [stringValue, xsdType] = optionalValue.value();
+        if (!xsdType) {
+          // No xsdType, this means that `stringValue` is a plain string literal
+          // or entity.
+          binding.append(stringToBinding(stringValue));
+        } else {
+          binding.append(
+              sparqlJsonBinding(stringValue, "literal", "datatype", xsdType));
+        }
       }
-      binding[column->_variable] = std::move(b);
+      binding.push_back('}');
+      co_yield binding;
     }
-    bindings.emplace_back(std::move(binding));
   }
-  result["results"]["bindings"] = std::move(bindings);
-  return result;
+  co_yield "\n]}}";
 }
 
 // _____________________________________________________________________________
-nlohmann::json ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
+cppcoro::generator<std::string>
+ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
     const QueryExecutionTree& qet,
     const parsedQuery::SelectClause& selectClause,
     const LimitOffsetClause& limitAndOffset,
@@ -378,8 +510,9 @@ nlohmann::json ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
   // can be changed.
   AD_CORRECTNESS_CHECK(!selectedColumnIndices.empty());
 
-  return ExportQueryExecutionTrees::idTableToQLeverJSONArray(
-      qet, limitAndOffset, selectedColumnIndices, std::move(resultTable));
+  return ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
+      qet, limitAndOffset, std::move(selectedColumnIndices),
+      std::move(resultTable));
 }
 
 using parsedQuery::SelectClause;
@@ -394,12 +527,6 @@ ExportQueryExecutionTrees::selectQueryResultToCsvTsvOrBinary(
   static_assert(format == MediaType::octetStream || format == MediaType::csv ||
                 format == MediaType::tsv);
 
-  // This call triggers the possibly expensive computation of the query result
-  // unless the result is already cached.
-  shared_ptr<const ResultTable> resultTable = qet.getResult();
-  resultTable->logResultSize();
-  LOG(DEBUG) << "Converting result IDs to their corresponding strings ..."
-             << std::endl;
   auto selectedColumnIndices =
       qet.selectedVariablesToColumnIndices(selectClause, true);
   // This case should only fail if we have no variables selected at all.
@@ -408,53 +535,259 @@ ExportQueryExecutionTrees::selectQueryResultToCsvTsvOrBinary(
   // appear in the query body?
   AD_CONTRACT_CHECK(!selectedColumnIndices.empty());
 
-  const auto& idTable = resultTable->idTable();
-  // special case : binary export of IdTable
-  if constexpr (format == MediaType::octetStream) {
-    for (size_t i : getRowIndices(limitAndOffset, idTable)) {
-      for (const auto& columnIndex : selectedColumnIndices) {
-        if (columnIndex.has_value()) {
-          co_yield std::string_view{reinterpret_cast<const char*>(&idTable(
-                                        i, columnIndex.value()._columnIndex)),
-                                    sizeof(Id)};
+  static constexpr char separator = format == MediaType::tsv ? '\t' : ',';
+  // Print the header line before computing the result. The binary format has
+  // no header.
+  if constexpr (format != MediaType::octetStream) {
+    auto variables = selectClause.getSelectedVariablesAsStrings();
+
+    // In the CSV format, the variables don't include the question mark.
+    if (format == MediaType::csv) {
+      std::ranges::for_each(variables,
+                            [](std::string& var) { var = var.substr(1); });
+    }
+    co_yield absl::StrJoin(variables, std::string_view{&separator, 1});
+    co_yield '\n';
+  }
+
+  // This call triggers the possibly expensive computation of the query result
+  // unless the result is already cached. If the query execution tree supports
+  // lazy evaluation, the result is computed block by block while it is
+  // exported, so the complete result is never materialized.
+  LazyResultTable result = qet.getLazyResult();
+  const LocalVocab& localVocab = *result.localVocab_;
+  LOG(DEBUG) << "Converting result IDs to their corresponding strings ..."
+             << std::endl;
+
+  constexpr auto& escapeFunction = format == MediaType::tsv
+                                       ? RdfEscaping::escapeForTsv
+                                       : RdfEscaping::escapeForCsv;
+  size_t numRowsTotal = 0;
+  size_t numColumns = 0;
+  for (const IdTable& idTable : result.blocks_) {
+    numRowsTotal += idTable.numRows();
+    numColumns = idTable.numColumns();
+    if constexpr (format == MediaType::octetStream) {
+      // special case : binary export of IdTable
+      for (size_t i : getRowIndices(limitAndOffset, idTable)) {
+        for (const auto& columnIndex : selectedColumnIndices) {
+          if (columnIndex.has_value()) {
+            co_yield std::string_view{
+                reinterpret_cast<const char*>(
+                    &idTable(i, columnIndex.value()._columnIndex)),
+                sizeof(Id)};
+          }
+        }
+      }
+    } else {
+      const Index& index = qet.getQec()->getIndex();
+      for (RowIndices batch :
+           getRowIndexBatches(getRowIndices(limitAndOffset, idTable))) {
+        VocabWordsOfBatch vocabWords{index, idTable, batch,
+                                     selectedColumnIndices};
+        for (size_t i : batch) {
+          for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+            if (selectedColumnIndices[j].has_value()) {
+              const auto& val = selectedColumnIndices[j].value();
+              Id id = idTable(i, val._columnIndex);
+              auto optionalStringAndType =
+                  vocabWords.idToStringAndType<format == MediaType::csv>(
+                      index, id, localVocab, escapeFunction);
+              if (optionalStringAndType.has_value()) [[likely]] {
+                co_yield optionalStringAndType.value().first;
+              }
+            }
+            co_yield j + 1 < selectedColumnIndices.size() ? separator : '\n';
+          }
         }
       }
     }
-    co_return;
+    if (!updateLimitOffsetForNextBlock(limitAndOffset, idTable.numRows())) {
+      break;
+    }
   }
+  LOG(INFO) << "Result has size " << numRowsTotal << " x " << numColumns
+            << std::endl;
+  LOG(DEBUG) << "Done creating readable result.\n";
+}
 
-  static constexpr char separator = format == MediaType::tsv ? '\t' : ',';
-  // Print header line
-  auto variables = selectClause.getSelectedVariablesAsStrings();
+namespace {
+// The types of the columns in the `qleverColumnar` format (see
+// `ExportQueryExecutionTrees::selectQueryResultToColumnar`).
+enum class ColumnarType : uint8_t { Int = 0, Double = 1, Bool = 2, String = 3 };
+
+// Append the bytes of the trivially copyable `value` to the `target`.
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+void appendBytes(std::string& target, const T& value) {
+  target.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
 
-  // In the CSV format, the variables don't include the question mark.
-  if (format == MediaType::csv) {
-    std::ranges::for_each(variables,
-                          [](std::string& var) { var = var.substr(1); });
+// Append zero bytes to the `target` until its size is a multiple of 8.
+void appendPadding(std::string& target) {
+  target.append((8 - target.size() % 8) % 8, '\0');
+}
+
+// Return a bitmap of `(n + 7) / 8` bytes, padded to a multiple of 8, where bit
+// `i % 8` of byte `i / 8` is set iff `predicate(ids[i])` is true.
+std::string makeBitmap(std::span<const Id> ids, const auto& predicate) {
+  std::string bitmap((ids.size() + 7) / 8, '\0');
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (predicate(ids[i])) {
+      bitmap[i / 8] |= static_cast<char>(1 << (i % 8));
+    }
   }
-  co_yield absl::StrJoin(variables, std::string_view{&separator, 1});
-  co_yield '\n';
+  appendPadding(bitmap);
+  return bitmap;
+}
 
-  constexpr auto& escapeFunction = format == MediaType::tsv
-                                       ? RdfEscaping::escapeForTsv
-                                       : RdfEscaping::escapeForCsv;
-  for (size_t i : getRowIndices(limitAndOffset, idTable)) {
-    for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
-      if (selectedColumnIndices[j].has_value()) {
-        const auto& val = selectedColumnIndices[j].value();
-        Id id = idTable(i, val._columnIndex);
+// Return the type of a column in the `qleverColumnar` format with the `ids`.
+ColumnarType getColumnarType(std::span<const Id> ids) {
+  std::optional<Datatype> commonDatatype;
+  for (Id id : ids) {
+    if (id.isUndefined()) {
+      continue;
+    }
+    if (!commonDatatype.has_value()) {
+      commonDatatype = id.getDatatype();
+    } else if (commonDatatype.value() != id.getDatatype()) {
+      return ColumnarType::String;
+    }
+  }
+  switch (commonDatatype.value_or(Datatype::Undefined)) {
+    case Datatype::Int:
+      return ColumnarType::Int;
+    case Datatype::Double:
+      return ColumnarType::Double;
+    case Datatype::Bool:
+      return ColumnarType::Bool;
+    default:
+      return ColumnarType::String;
+  }
+}
+
+// Return a single column of a batch in the `qleverColumnar` format for the
+// `ids` of the column. The `idToString` function is called once for each
+// distinct ID in a column of type string. The size of the result is a multiple
+// of 8, and so is the offset of each of its buffers.
+std::string columnToColumnar(std::span<const Id> ids, const auto& idToString) {
+  std::string result;
+  const ColumnarType type = getColumnarType(ids);
+  appendBytes(result, type);
+  appendPadding(result);
+  result.append(makeBitmap(ids, [](Id id) { return !id.isUndefined(); }));
+
+  switch (type) {
+    case ColumnarType::Int:
+      for (Id id : ids) {
+        appendBytes(result, id.isUndefined() ? int64_t{0} : id.getInt());
+      }
+      return result;
+    case ColumnarType::Double:
+      for (Id id : ids) {
+        appendBytes(result, id.isUndefined() ? 0.0 : id.getDouble());
+      }
+      return result;
+    case ColumnarType::Bool:
+      result.append(makeBitmap(
+          ids, [](Id id) { return !id.isUndefined() && id.getBool(); }));
+      return result;
+    case ColumnarType::String:
+      break;
+  }
+
+  // Dictionary-encode the strings. Equal IDs always have the same string, so
+  // each distinct ID is converted only once.
+  ad_utility::HashMap<Id, uint32_t> dictionaryIndices;
+  std::vector<uint64_t> offsets{0};
+  std::string words;
+  std::vector<uint32_t> indices;
+  indices.reserve(ids.size());
+  for (Id id : ids) {
+    if (id.isUndefined()) {
+      indices.push_back(0);
+      continue;
+    }
+    auto [it, isNew] = dictionaryIndices.try_emplace(
+        id, static_cast<uint32_t>(offsets.size() - 1));
+    if (isNew) {
+      words.append(idToString(id));
+      offsets.push_back(words.size());
+    }
+    indices.push_back(it->second);
+  }
+  appendBytes(result, static_cast<uint32_t>(offsets.size() - 1));
+  appendPadding(result);
+  for (uint64_t offset : offsets) {
+    appendBytes(result, offset);
+  }
+  result.append(words);
+  appendPadding(result);
+  for (uint32_t index : indices) {
+    appendBytes(result, index);
+  }
+  appendPadding(result);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ad_utility::streams::stream_generator
+ExportQueryExecutionTrees::selectQueryResultToColumnar(
+    const QueryExecutionTree& qet,
+    const parsedQuery::SelectClause& selectClause,
+    LimitOffsetClause limitAndOffset) {
+  auto selectedColumnIndices =
+      qet.selectedVariablesToColumnIndices(selectClause, true);
+  AD_CONTRACT_CHECK(!selectedColumnIndices.empty());
+
+  // The header is written before computing the result.
+  std::string header = "QLVRCOL1";
+  auto variables = selectClause.getSelectedVariablesAsStrings();
+  appendBytes(header, static_cast<uint64_t>(variables.size()));
+  for (const auto& variable : variables) {
+    appendBytes(header, static_cast<uint64_t>(variable.size()));
+    header.append(variable);
+    appendPadding(header);
+  }
+  co_yield header;
+
+  LazyResultTable result = qet.getLazyResult();
+  const LocalVocab& localVocab = *result.localVocab_;
+  const Index& index = qet.getQec()->getIndex();
+  std::vector<Id> ids;
+  for (const IdTable& idTable : result.blocks_) {
+    for (RowIndices batch :
+         getRowIndexBatches(getRowIndices(limitAndOffset, idTable))) {
+      VocabWordsOfBatch vocabWords{index, idTable, batch,
+                                   selectedColumnIndices};
+      auto idToString = [&](Id id) {
         auto optionalStringAndType =
-            idToStringAndType<format == MediaType::csv>(
-                qet.getQec()->getIndex(), id, resultTable->localVocab(),
-                escapeFunction);
-        if (optionalStringAndType.has_value()) [[likely]] {
-          co_yield optionalStringAndType.value().first;
+            vocabWords.idToStringAndType(index, id, localVocab);
+        return optionalStringAndType.has_value()
+                   ? std::move(optionalStringAndType.value().first)
+                   : std::string{};
+      };
+      std::string numRows;
+      appendBytes(numRows, static_cast<uint64_t>(batch.size()));
+      co_yield numRows;
+      for (const auto& columnIndex : selectedColumnIndices) {
+        ids.assign(batch.size(), Id::makeUndefined());
+        if (columnIndex.has_value()) {
+          auto column = idTable.getColumn(columnIndex.value()._columnIndex);
+          std::ranges::copy(column.subspan(batch.front(), batch.size()),
+                            ids.begin());
         }
+        co_yield columnToColumnar(ids, idToString);
       }
-      co_yield j + 1 < selectedColumnIndices.size() ? separator : '\n';
+    }
+    if (!updateLimitOffsetForNextBlock(limitAndOffset, idTable.numRows())) {
+      break;
     }
   }
-  LOG(DEBUG) << "Done creating readable result.\n";
+  std::string endOfResult;
+  appendBytes(endOfResult, uint64_t{0});
+  co_yield endOfResult;
 }
 
 // _____________________________________________________________________________
@@ -490,15 +823,17 @@ ExportQueryExecutionTrees::constructQueryResultToTsvOrCsv(
 }
 
 // _____________________________________________________________________________
-nlohmann::json ExportQueryExecutionTrees::computeQueryResultAsQLeverJSON(
+ad_utility::streams::stream_generator
+ExportQueryExecutionTrees::computeQueryResultAsQLeverJSON(
     const ParsedQuery& query, const QueryExecutionTree& qet,
-    ad_utility::Timer& requestTimer, uint64_t maxSend) {
-  shared_ptr<const ResultTable> resultTable = qet.getResult();
-  resultTable->logResultSize();
-  auto timeResultComputation = requestTimer.value();
-
+    ad_utility::Timer& requestTimer, uint64_t maxSend,
+    std::shared_ptr<const ResultTable> resultTable,
+    ad_utility::Timer::Duration timeResultComputation) {
   size_t resultSize = resultTable->size();
 
+  // The members before the result rows are small, so they are serialized via
+  // `nlohmann::json`. The result rows and the members after them are written
+  // directly.
   nlohmann::json j;
 
   j["query"] = query._originalString;
@@ -520,26 +855,38 @@ nlohmann::json ExportQueryExecutionTrees::computeQueryResultAsQLeverJSON(
   j["runtimeInformation"]["query_execution_tree"] =
       nlohmann::ordered_json(runtimeInformation);
 
-  {
-    auto limitAndOffset = query._limitOffset;
-    limitAndOffset._limit = std::min(limitAndOffset.limitOrDefault(), maxSend);
-    j["res"] =
-        query.hasSelectClause()
-            ? ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
-                  qet, query.selectClause(), limitAndOffset,
-                  std::move(resultTable))
-            : ExportQueryExecutionTrees::
-                  constructQueryResultBindingsToQLeverJSON(
-                      qet, query.constructClause().triples_, limitAndOffset,
-                      std::move(resultTable));
-  }
-  j["resultsize"] = query.hasSelectClause() ? resultSize : j["res"].size();
-  j["time"]["total"] = std::to_string(requestTimer.msecs()) + "ms";
-  j["time"]["computeResult"] =
-      std::to_string(ad_utility::Timer::toMilliseconds(timeResultComputation)) +
-      "ms";
-
-  return j;
+  std::string head =
+      j.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+  // Remove the closing brace, the object is continued below.
+  head.pop_back();
+  co_yield head;
+  co_yield ",\"res\":[";
+
+  auto limitAndOffset = query._limitOffset;
+  limitAndOffset._limit = std::min(limitAndOffset.limitOrDefault(), maxSend);
+  auto rows =
+      query.hasSelectClause()
+          ? ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
+                qet, query.selectClause(), limitAndOffset,
+                std::move(resultTable))
+          : ExportQueryExecutionTrees::constructQueryResultBindingsToQLeverJSON(
+                qet, query.constructClause().triples_, limitAndOffset,
+                std::move(resultTable));
+  size_t numRows = 0;
+  for (const std::string& row : rows) {
+    if (numRows > 0) {
+      co_yield ',';
+    }
+    co_yield '\n';
+    co_yield row;
+    ++numRows;
+  }
+  co_yield "\n],\"resultsize\":";
+  co_yield std::to_string(query.hasSelectClause() ? resultSize : numRows);
+  co_yield absl::StrCat(
+      ",\"time\":{\"total\":\"", requestTimer.msecs(), "ms\",",
+      "\"computeResult\":\"",
+      ad_utility::Timer::toMilliseconds(timeResultComputation), "ms\"}}");
 }
 
 // _____________________________________________________________________________
@@ -563,6 +910,12 @@ ExportQueryExecutionTrees::computeResultAsStream(
     return compute.template operator()<MediaType::tsv>();
   } else if (mediaType == ad_utility::MediaType::octetStream) {
     return compute.template operator()<MediaType::octetStream>();
+  } else if (mediaType == ad_utility::MediaType::qleverColumnar) {
+    if (!parsedQuery.hasSelectClause()) {
+      AD_THROW("The columnar export is only supported for SELECT queries");
+    }
+    return selectQueryResultToColumnar(qet, parsedQuery.selectClause(),
+                                       parsedQuery._limitOffset);
   } else if (mediaType == ad_utility::MediaType::turtle) {
     return computeConstructQueryResultAsTurtle(parsedQuery, qet);
   }
@@ -583,36 +936,28 @@ ExportQueryExecutionTrees::computeConstructQueryResultAsTurtle(
       qet.getResult());
 }
 // _____________________________________________________________________________
-nlohmann::json ExportQueryExecutionTrees::computeSelectQueryResultAsSparqlJSON(
-    const ParsedQuery& query, const QueryExecutionTree& qet,
-    [[maybe_unused]] ad_utility::Timer& requestTimer, uint64_t maxSend) {
-  if (!query.hasSelectClause()) {
+ad_utility::streams::stream_generator
+ExportQueryExecutionTrees::computeResultAsJSONStream(
+    const ParsedQuery& parsedQuery, const QueryExecutionTree& qet,
+    ad_utility::Timer& requestTimer, uint64_t maxSend,
+    ad_utility::MediaType mediaType) {
+  AD_CONTRACT_CHECK(mediaType == MediaType::qleverJson ||
+                    mediaType == MediaType::sparqlJson);
+  if (mediaType == MediaType::sparqlJson && !parsedQuery.hasSelectClause()) {
     AD_THROW(
         "SPARQL-compliant JSON format is only supported for SELECT queries");
   }
+  // Compute the result before the first byte is sent, so that errors during
+  // the computation (e.g. timeouts) are reported as a proper error response.
   shared_ptr<const ResultTable> resultTable = qet.getResult();
   resultTable->logResultSize();
-  nlohmann::json j;
-  auto limitAndOffset = query._limitOffset;
-  limitAndOffset._limit = std::min(limitAndOffset.limitOrDefault(), maxSend);
-  j = ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
-      qet, query.selectClause(), limitAndOffset, std::move(resultTable));
-  return j;
-}
-
-// _____________________________________________________________________________
-nlohmann::json ExportQueryExecutionTrees::computeResultAsJSON(
-    const ParsedQuery& parsedQuery, const QueryExecutionTree& qet,
-    ad_utility::Timer& requestTimer, uint64_t maxSend,
-    ad_utility::MediaType mediaType) {
-  switch (mediaType) {
-    case ad_utility::MediaType::qleverJson:
-      return computeQueryResultAsQLeverJSON(parsedQuery, qet, requestTimer,
-                                            maxSend);
-    case ad_utility::MediaType::sparqlJson:
-      return computeSelectQueryResultAsSparqlJSON(parsedQuery, qet,
-                                                  requestTimer, maxSend);
-    default:
-      AD_FAIL();
+  if (mediaType == MediaType::qleverJson) {
+    return computeQueryResultAsQLeverJSON(parsedQuery, qet, requestTimer,
+                                          maxSend, std::move(resultTable),
+                                          requestTimer.value());
   }
+  auto limitAndOffset = parsedQuery._limitOffset;
+  limitAndOffset._limit = std::min(limitAndOffset.limitOrDefault(), maxSend);
+  return selectQueryResultToSparqlJSON(qet, parsedQuery.selectClause(),
+                                       limitAndOffset, std::move(resultTable));
 }
@@ -14,13 +14,11 @@
 // This class contains all the functionality to convert a query that has already
 // been parsed (by the SPARQL parser) and planned (by the query planner) into
 // a serialized result. In particular, it creates TSV, CSV, Turtle, JSON (SPARQL
-// conforming and QLever's flavor) and binary results).
-// This class has only two static public functions, one for the JSON
-// output format (which returns a `nlohmann::json` object) and one for the other
-// result formats (tsv, csv, turtle, binary) which returns a
-// `streamable_generator`.
-// TODO<joka921> Also implement a streaming JSON serializer to reduce the RAM
-// consumption of large JSON exports and to make this interface even simpler.
+// conforming and QLever's flavor), binary, and columnar binary results (see
+// `selectQueryResultToColumnar` for the latter).
+// All result formats are produced by a `stream_generator`, so that large
+// results are serialized chunk by chunk while they are sent, and are never
+// completely materialized as a string or a `nlohmann::json` object.
 class ExportQueryExecutionTrees {
  public:
   using MediaType = ad_utility::MediaType;
@@ -30,11 +28,12 @@ class ExportQueryExecutionTrees {
   // created by the `QueryPlanner`. The result is converted into a sequence of
   // bytes that represents the result of the computed query in the format
   // specified by the `mediaType`. Supported formats for this function are CSV,
-  // TSV, Turtle, Binary. Note that the Binary format can only be used with
-  // SELECT queries and the Turtle format can only be used with CONSTRUCT
-  // queries. Invalid `mediaType`s and invalid combinations of `mediaType` and
-  // the query type will throw. The result is returned as a `stream_generator`
-  // that lazily computes the serialized result in large chunks of bytes.
+  // TSV, Turtle, Binary, and QLever's columnar format. Note that the Binary and
+  // the columnar format can only be used with SELECT queries and the Turtle
+  // format can only be used with CONSTRUCT queries. Invalid `mediaType`s and
+  // invalid combinations of `mediaType` and the query type will throw. The
+  // result is returned as a `stream_generator` that lazily computes the
+  // serialized result in large chunks of bytes.
   static ad_utility::streams::stream_generator computeResultAsStream(
       const ParsedQuery& parsedQuery, const QueryExecutionTree& qet,
       MediaType mediaType);
@@ -45,17 +44,16 @@ class ExportQueryExecutionTrees {
   // specified by the `mediaType`. Supported formats for this function are
   // `SparqlJSON` and `QLeverJSON`. Note that the SparqlJSON format can only be
   // used with SELECT queries. Invalid `mediaType`s and invalid combinations of
-  // `mediaType` and the query type will throw. The result is returned as a
-  // single JSON object that is fully materialized before the function returns.
-  // The `requestTimer` is used to report timing statistics on the query. It
-  // must have already run during the query planning to produce the expected
-  // results. If `maxSend` is smaller than the size of the query result, then
-  // only the first `maxSend` rows are// returned.
-  static nlohmann::json computeResultAsJSON(const ParsedQuery& parsedQuery,
-                                            const QueryExecutionTree& qet,
-                                            ad_utility::Timer& requestTimer,
-                                            uint64_t maxSend,
-                                            MediaType mediaType);
+  // `mediaType` and the query type will throw. The query result is computed
+  // before this function returns, but its rows are only converted to JSON
+  // while the returned `stream_generator` is consumed. The `requestTimer` is
+  // used to report timing statistics on the query. It must have already run
+  // during the query planning to produce the expected results. If `maxSend` is
+  // smaller than the size of the query result, then only the first `maxSend`
+  // rows are returned.
+  static ad_utility::streams::stream_generator computeResultAsJSONStream(
+      const ParsedQuery& parsedQuery, const QueryExecutionTree& qet,
+      ad_utility::Timer& requestTimer, uint64_t maxSend, MediaType mediaType);
 
   // Convert the `id` to a human-readable string. The `index` is used to resolve
   // `Id`s with datatype `VocabIndex` or `TextRecordIndex`. The `localVocab` is
@@ -95,14 +93,14 @@ class ExportQueryExecutionTrees {
   // up their interfaces (are all these functions needed, or can some of them
   // be merged).
 
-  // Similar to `queryToJSON`, but always returns the `QLeverJSON` format.
-  static nlohmann::json computeQueryResultAsQLeverJSON(
-      const ParsedQuery& query, const QueryExecutionTree& qet,
-      ad_utility::Timer& requestTimer, uint64_t maxSend);
-  // Similar to `queryToJSON`, but always returns the `SparqlJSON` format.
-  static nlohmann::json computeSelectQueryResultAsSparqlJSON(
+  // Similar to `computeResultAsJSONStream`, but always returns the
+  // `QLeverJSON` format for the already computed `resultTable`. The
+  // `timeResultComputation` is reported in the result.
+  static ad_utility::streams::stream_generator computeQueryResultAsQLeverJSON(
       const ParsedQuery& query, const QueryExecutionTree& qet,
-      ad_utility::Timer& requestTimer, uint64_t maxSend);
+      ad_utility::Timer& requestTimer, uint64_t maxSend,
+      std::shared_ptr<const ResultTable> resultTable,
+      ad_utility::Timer::Duration timeResultComputation);
 
   // ___________________________________________________________________________
   static ad_utility::streams::stream_generator
@@ -110,15 +108,15 @@ class ExportQueryExecutionTrees {
                                       const QueryExecutionTree& qet);
 
   // ___________________________________________________________________________
-  static nlohmann::json selectQueryResultBindingsToQLeverJSON(
+  static cppcoro::generator<std::string> selectQueryResultBindingsToQLeverJSON(
       const QueryExecutionTree& qet,
       const parsedQuery::SelectClause& selectClause,
       const LimitOffsetClause& limitAndOffset,
       shared_ptr<const ResultTable> resultTable);
 
   /**
-   * @brief Convert an `IdTable` (typically from a query result) to a JSON array
-   *   In the `QLeverJSON` format. This function is called by
+   * @brief Convert an `IdTable` (typically from a query result) to the rows of
+   *   a JSON array in the `QLeverJSON` format. This function is called by
    *  `computeQueryResultAsQLeverJSON` to obtain the "actual" query results
    * (without the meta data)
    * @param qet The `QueryExecutionTree` of the query.
@@ -127,21 +125,21 @@ class ExportQueryExecutionTrees {
    * <from>
    * @param columns each pair of <columnInIdTable, correspondingType> tells
    * us which columns are to be serialized in which order
-   * @param resultTable The query result in the ID space. If it is `nullptr`,
-   *        then the query result will be obtained via `qet->getResult()`.
-   * @return a 2D-Json array corresponding to the IdTable given the arguments
+   * @param resultTable The query result in the ID space.
+   * @return the rows of the IdTable given the arguments, each row serialized
+   * as a JSON array
    */
-  static nlohmann::json idTableToQLeverJSONArray(
-      const QueryExecutionTree& qet, const LimitOffsetClause& limitAndOffset,
-      const QueryExecutionTree::ColumnIndicesAndTypes& columns,
-      std::shared_ptr<const ResultTable> resultTable = nullptr);
+  static cppcoro::generator<std::string> idTableToQLeverJSONBindings(
+      const QueryExecutionTree& qet, LimitOffsetClause limitAndOffset,
+      QueryExecutionTree::ColumnIndicesAndTypes columns,
+      std::shared_ptr<const ResultTable> resultTable);
 
   // ___________________________________________________________________________
-  static nlohmann::json constructQueryResultBindingsToQLeverJSON(
+  static cppcoro::generator<std::string>
+  constructQueryResultBindingsToQLeverJSON(
       const QueryExecutionTree& qet,
       const ad_utility::sparql_types::Triples& constructTriples,
-      const LimitOffsetClause& limitAndOffset,
-      std::shared_ptr<const ResultTable> res);
+      LimitOffsetClause limitAndOffset, std::shared_ptr<const ResultTable> res);
 
   // Generate an RDF graph for a CONSTRUCT query.
   static cppcoro::generator<QueryExecutionTree::StringTriple>
@@ -158,10 +156,10 @@ class ExportQueryExecutionTrees {
       std::shared_ptr<const ResultTable> resultTable);
 
   // ___________________________________________________________________________
-  static nlohmann::json selectQueryResultToSparqlJSON(
+  static ad_utility::streams::stream_generator selectQueryResultToSparqlJSON(
       const QueryExecutionTree& qet,
       const parsedQuery::SelectClause& selectClause,
-      const LimitOffsetClause& limitAndOffset,
+      LimitOffsetClause limitAndOffset,
       shared_ptr<const ResultTable> resultTable);
 
   // ___________________________________________________________________________
@@ -172,6 +170,45 @@ class ExportQueryExecutionTrees {
       LimitOffsetClause limitAndOffset,
       std::shared_ptr<const ResultTable> resultTable);
 
+  // Export the result of a SELECT query in the columnar binary format
+  // `MediaType::qleverColumnar`. Unlike the Binary format, which consists of
+  // the raw IDs, the values are decoded, so clients don't need the vocabulary,
+  // and unlike TSV, numbers are stored natively and strings are not escaped.
+  // All numbers are in the native (little-endian) byte order. Each of the
+  // fields below that is marked with (*) is followed by zero bytes up to the
+  // next multiple of 8, so every field starts at an offset (from the beginning
+  // of the result) that is a multiple of 8. A client that reads the result
+  // into an 8-byte aligned buffer can thus use the values, bitmaps, offsets,
+  // and indices in place, e.g. as the buffers of Apache Arrow arrays.
+  //
+  // The header consists of the 8 bytes "QLVRCOL1", the number of columns
+  // (uint64), and for each column the length (uint64) and the bytes (*) of
+  // the name of its variable.
+  //
+  // Then the rows follow in batches of at most `NUM_ROWS_PER_EXPORT_BATCH`
+  // rows. Each batch starts with its number of rows `n` (uint64), followed by
+  // each of its columns:
+  //   - The type of the column (uint8) (*): 0 = int64, 1 = double, 2 = bool,
+  //     3 = string. A column has one of the first three types iff all its bound
+  //     values in the batch have this type.
+  //   - The validity bitmap with (n + 7) / 8 bytes (*). Bit i % 8 of byte i / 8
+  //     is set iff the i-th row is bound.
+  //   - For int64 and double: n values with 8 bytes each.
+  //   - For bool: a bitmap of the values (*), like the validity bitmap.
+  //   - For string: The size `d` of the dictionary of the batch (uint32) (*),
+  //     d + 1 offsets (uint64) into the following concatenated words of the
+  //     dictionary, these words (*), and n indices (uint32) (*) into the
+  //     dictionary. The words have the same content as in the TSV format, but
+  //     without escaping (e.g. `<http://example.org>` or `"text"@en`).
+  //   The values (and indices) of unbound rows are zero.
+  //
+  // The end of the result is marked by a batch with zero rows (that has no
+  // columns).
+  static ad_utility::streams::stream_generator selectQueryResultToColumnar(
+      const QueryExecutionTree& qet,
+      const parsedQuery::SelectClause& selectClause,
+      LimitOffsetClause limitAndOffset);
+
   // _____________________________________________________________________________
   template <MediaType format>
   static ad_utility::streams::stream_generator
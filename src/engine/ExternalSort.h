@@ -0,0 +1,135 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "engine/QueryExecutionTree.h"
+#include "engine/ResultTable.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Constants.h"
+#include "global/Id.h"
+#include "util/BackgroundStxxlSorter.h"
+
+// Helpers for the `Sort` and `OrderBy` operations to sort inputs that are too
+// large to be sorted in RAM. The rows are sorted in runs that are written to
+// disk by STXXL (see `BackgroundStxxlSorter.h`, which is also used for the
+// index building), and the sorted runs are then merged lazily while the result
+// is being consumed. The external sort is used both for lazy results and for
+// results that are materialized (e.g. as the input of a `Join`). In the latter
+// case only the final sorted result is held in RAM, but not the input and the
+// intermediate data of the sort.
+namespace externalSort {
+
+// The number of rows of the blocks of the sorted result.
+constexpr inline size_t DEFAULT_BLOCK_SIZE = 100'000;
+
+// A row of an `IdTable` with a fixed number of columns, as it is stored in a
+// `stxxl::sorter`. The `stxxl::sorter` requires values that are strictly
+// smaller and larger than all the actual values. The rows are compared by
+// arbitrary comparators, so these sentinels are represented by the `kind_`.
+template <size_t NumColumns>
+struct Row {
+  enum struct Kind : uint8_t { Min, Regular, Max };
+  std::array<Id, NumColumns> ids_{};
+  Kind kind_ = Kind::Regular;
+};
+
+// Wrap the `rowComparator`, which compares two `std::array<Id, NumColumns>`,
+// s.t. it can be used as the comparator of a `stxxl::sorter` of
+// `Row<NumColumns>`s.
+template <size_t NumColumns, typename RowComparator>
+struct Comparator {
+  using R = Row<NumColumns>;
+  RowComparator rowComparator_;
+
+  bool operator()(const R& a, const R& b) const {
+    if (a.kind_ != b.kind_) {
+      return a.kind_ < b.kind_;
+    }
+    return a.kind_ == R::Kind::Regular && rowComparator_(a.ids_, b.ids_);
+  }
+
+  // Value that is strictly smaller than any input element.
+  R min_value() const { return {{}, R::Kind::Min}; }
+
+  // Value that is strictly larger than any input element.
+  R max_value() const { return {{}, R::Kind::Max}; }
+};
+
+// Return true iff the result of the `subtree` should be sorted externally
+// because its estimated size exceeds the runtime parameter
+// `sort-in-memory-max-size-mb`. Only results with a number of columns for
+// which there is a static `IdTable` can be sorted externally.
+inline bool shouldSortExternally(QueryExecutionTree& subtree) {
+  size_t numColumns = subtree.getResultWidth();
+  if (numColumns == 0 ||
+      numColumns > DEFAULT_MAX_NUM_COLUMNS_STATIC_ID_TABLE) {
+    return false;
+  }
+  size_t maxSizeInBytes =
+      RuntimeParameters().get<"sort-in-memory-max-size-mb">() * 1'000'000;
+  return subtree.getSizeEstimate() * numColumns * sizeof(Id) > maxSizeInBytes;
+}
+
+// Sort all the rows of the `blocks`, which must have `NumColumns` columns,
+// according to the `rowComparator`, which compares two
+// `std::array<Id, NumColumns>`. The sorted rows are yielded in blocks with at
+// most `blockSize` rows. STXXL uses about three times the value of the runtime
+// parameter `sort-external-memory-mb` of RAM. The `checkTimeout` function is
+// called regularly.
+template <size_t NumColumns, typename RowComparator, typename CheckTimeout>
+cppcoro::generator<const IdTable&> sortBlocks(
+    LazyResultTable::Blocks blocks, RowComparator rowComparator,
+    ad_utility::AllocatorWithLimit<Id> allocator, CheckTimeout checkTimeout,
+    size_t blockSize = DEFAULT_BLOCK_SIZE) {
+  static_assert(NumColumns > 0);
+  using R = Row<NumColumns>;
+  ad_utility::BackgroundStxxlSorter<R, Comparator<NumColumns, RowComparator>>
+      sorter{RuntimeParameters().get<"sort-external-memory-mb">() * 1'000'000,
+             {std::move(rowComparator)}};
+  for (const IdTable& block : blocks) {
+    checkTimeout();
+    const auto view = block.asStaticView<NumColumns>();
+    for (size_t i = 0; i < view.numRows(); ++i) {
+      R row;
+      for (size_t j = 0; j < NumColumns; ++j) {
+        row.ids_[j] = view(i, j);
+      }
+      sorter.push(row);
+    }
+  }
+
+  IdTable result{NumColumns, std::move(allocator)};
+  result.reserve(blockSize);
+  for (const R& row : sorter.sortedView()) {
+    result.push_back(row.ids_);
+    if (result.size() == blockSize) {
+      checkTimeout();
+      co_yield result;
+      result.clear();
+    }
+  }
+  if (!result.empty()) {
+    co_yield result;
+  }
+}
+
+// Consume the `lazyResult` of an external sort with `numColumns` columns and
+// return it as a single materialized `ResultTable`.
+inline ResultTable materialize(
+    LazyResultTable lazyResult, size_t numColumns,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  IdTable idTable = std::move(lazyResult).materialize(allocator);
+  // An empty result has no blocks from which the number of columns is known.
+  if (idTable.empty()) {
+    idTable.setNumColumns(numColumns);
+  }
+  // The local vocab is only complete after all blocks have been consumed.
+  return {std::move(idTable), std::move(lazyResult.sortedBy_),
+          lazyResult.localVocab_->clone()};
+}
+
+}  // namespace externalSort
@@ -11,6 +11,7 @@
 #include <sstream>
 
 #include "engine/CallFixedSize.h"
+#include "engine/IndexScan.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
@@ -46,6 +47,14 @@ string Filter::getDescriptor() const {
 
 // _____________________________________________________________________________
 ResultTable Filter::computeResult() {
+  if (auto prefilteredScan = getPrefilteredIndexScan()) {
+    IdTable idTable{getResultWidth(), getExecutionContext()->getAllocator()};
+    auto blocks = filterBlocks(std::move(prefilteredScan.value()));
+    for (const IdTable& block : blocks) {
+      idTable.insertAtEnd(block.begin(), block.end());
+    }
+    return {std::move(idTable), resultSortedOn(), LocalVocab{}};
+  }
   LOG(DEBUG) << "Getting sub-result for Filter result computation..." << endl;
   shared_ptr<const ResultTable> subRes = _subtree->getResult();
   LOG(DEBUG) << "Filter result computation..." << endl;
@@ -54,29 +63,102 @@ ResultTable Filter::computeResult() {
   idTable.setNumColumns(subRes->idTable().numColumns());
 
   size_t width = idTable.numColumns();
-  CALL_FIXED_SIZE(width, &Filter::computeFilterImpl, this, &idTable, *subRes);
+  CALL_FIXED_SIZE(width, &Filter::computeFilterImpl, this, &idTable,
+                  subRes->idTable(), subRes->localVocab(), subRes->sortedBy());
   LOG(DEBUG) << "Filter result computation done." << endl;
 
   return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
 
+// _____________________________________________________________________________
+LazyResultTable Filter::computeResultLazily() {
+  if (auto prefilteredScan = getPrefilteredIndexScan()) {
+    return {filterBlocks(std::move(prefilteredScan.value())), resultSortedOn(),
+            std::make_shared<const LocalVocab>()};
+  }
+  LazyResultTable subRes = _subtree->getLazyResult();
+  // The FILTER doesn't add any words to the local vocabulary, so we can share
+  // it with the input.
+  auto localVocab = subRes.localVocab_;
+  return {filterBlocks(std::move(subRes)), resultSortedOn(),
+          std::move(localVocab)};
+}
+
+namespace {
+// Yield the blocks of the lazy scan `generator` that was created for the `scan`
+// and set the runtime information of the `scan` once all the blocks have been
+// consumed.
+LazyResultTable::Blocks yieldPrefilteredBlocks(
+    Permutation::IdTableGenerator generator, IndexScan& scan) {
+  for (IdTable& block : generator) {
+    co_yield block;
+  }
+  const auto& details = generator.details();
+  scan.updateRuntimeInformationWhenOptimizedOut(
+      RuntimeInformation::Status::lazilyMaterialized);
+  auto& runtimeInfo = scan.getRuntimeInfo();
+  runtimeInfo.numRows_ = details.numElementsRead_;
+  runtimeInfo.totalTime_ = static_cast<double>(details.blockingTimeMs_);
+  runtimeInfo.addDetail("num-blocks-read", details.numBlocksRead_);
+  runtimeInfo.addDetail("num-blocks-all", details.numBlocksAll_);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<LazyResultTable> Filter::getPrefilteredIndexScan() {
+  if (_subtree->getType() != QueryExecutionTree::SCAN) {
+    return std::nullopt;
+  }
+  auto rangeFilter = _expression.getRangeFilterExpression();
+  if (!rangeFilter.has_value()) {
+    return std::nullopt;
+  }
+  auto& scan = dynamic_cast<IndexScan&>(*_subtree->getRootOperation());
+  auto generator = scan.lazyScanWithFilter(
+      rangeFilter->variable_, rangeFilter->comparison_, rangeFilter->value_);
+  // If the complete result of the scan is already cached, we use it instead.
+  // The second argument means "only read the result from the cache".
+  if (!generator.has_value() || scan.getResult(false, true) != nullptr) {
+    return std::nullopt;
+  }
+  return LazyResultTable{
+      yieldPrefilteredBlocks(std::move(generator.value()), scan),
+      scan.resultSortedOn(), std::make_shared<const LocalVocab>()};
+}
+
+// _____________________________________________________________________________
+LazyResultTable::Blocks Filter::filterBlocks(LazyResultTable input) {
+  IdTable idTable{getExecutionContext()->getAllocator()};
+  for (const IdTable& block : input.blocks_) {
+    idTable.clear();
+    idTable.setNumColumns(block.numColumns());
+    CALL_FIXED_SIZE(block.numColumns(), &Filter::computeFilterImpl, this,
+                    &idTable, block, *input.localVocab_, input.sortedBy_);
+    checkTimeout();
+    if (!idTable.empty()) {
+      co_yield idTable;
+    }
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t WIDTH>
 void Filter::computeFilterImpl(IdTable* outputIdTable,
-                               const ResultTable& inputResultTable) {
+                               const IdTable& inputTable,
+                               const LocalVocab& localVocab,
+                               const std::vector<ColumnIndex>& sortedBy) {
   sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
-      inputResultTable.idTable(), getExecutionContext()->getAllocator(),
-      inputResultTable.localVocab());
+      *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+      getExecutionContext()->getAllocator(), localVocab);
 
   // TODO<joka921> This should be a mandatory argument to the EvaluationContext
   // constructor.
-  evaluationContext._columnsByWhichResultIsSorted = inputResultTable.sortedBy();
+  evaluationContext._columnsByWhichResultIsSorted = sortedBy;
 
   sparqlExpression::ExpressionResult expressionResult =
       _expression.getPimpl()->evaluate(&evaluationContext);
 
-  const auto input = inputResultTable.idTable().asStaticView<WIDTH>();
+  const auto input = inputTable.asStaticView<WIDTH>();
   auto output = std::move(*outputIdTable).toStatic<WIDTH>();
 
   auto visitor =
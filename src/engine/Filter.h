@@ -62,7 +62,32 @@ class Filter : public Operation {
 
   ResultTable computeResult() override;
 
+ public:
+  // A FILTER can be evaluated block by block, so it can be computed lazily
+  // whenever its input can be computed lazily.
+  bool supportsLazyEvaluation() const override {
+    return _subtree->getRootOperation()->supportsLazyEvaluation();
+  }
+
+ private:
+  LazyResultTable computeResultLazily() override;
+
+  // If the `_subtree` is an `IndexScan` the result of which is not contained in
+  // the cache, and the `_expression` compares the variable of the last column
+  // of this scan with a constant (see
+  // `SparqlExpressionPimpl::getRangeFilterExpression`), return the lazy result
+  // of the scan without the blocks that cannot contain any matching rows
+  // according to their zone maps. Else return `std::nullopt`.
+  std::optional<LazyResultTable> getPrefilteredIndexScan();
+
+  // Apply the filter to each of the blocks of the `input` and yield the
+  // (nonempty) filtered blocks.
+  LazyResultTable::Blocks filterBlocks(LazyResultTable input);
+
+  // Apply the filter to the `input` which uses the `localVocab` and is sorted
+  // by the `sortedBy` columns. Write the matching rows to the `outputIdTable`.
   template <size_t WIDTH>
-  void computeFilterImpl(IdTable* outputIdTable,
-                         const ResultTable& inputResultTable);
+  void computeFilterImpl(IdTable* outputIdTable, const IdTable& input,
+                         const LocalVocab& localVocab,
+                         const std::vector<ColumnIndex>& sortedBy);
 };
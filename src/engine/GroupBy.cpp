@@ -6,26 +6,33 @@
 
 #include "engine/GroupBy.h"
 
+#include <future>
+
 #include "absl/strings/str_join.h"
 #include "engine/CallFixedSize.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/Sort.h"
 #include "engine/Values.h"
+#include "engine/sparqlExpressions/AggregateExpression.h"
+#include "engine/sparqlExpressions/SampleExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "parser/Alias.h"
 #include "util/Conversions.h"
 #include "util/HashSet.h"
+#include "util/ThreadBudget.h"
 
 // _______________________________________________________________________________________________
 GroupBy::GroupBy(QueryExecutionContext* qec, vector<Variable> groupByVariables,
                  std::vector<Alias> aliases,
-                 std::shared_ptr<QueryExecutionTree> subtree)
+                 std::shared_ptr<QueryExecutionTree> subtree,
+                 Algorithm algorithm)
     : Operation{qec},
       _groupByVariables{std::move(groupByVariables)},
-      _aliases{std::move(aliases)} {
+      _aliases{std::move(aliases)},
+      _algorithm{algorithm} {
   // Sort the groupByVariables to ensure that the cache key is order
   // invariant.
   // Note: It is tempting to do the same also for the aliases, but that would
@@ -33,6 +40,12 @@ GroupBy::GroupBy(QueryExecutionContext* qec, vector<Variable> groupByVariables,
   // alias.
   std::ranges::sort(_groupByVariables, std::less<>{}, &Variable::name);
 
+  if (_algorithm == Algorithm::HashBased) {
+    AD_CONTRACT_CHECK(
+        supportsHashBasedAlgorithm(_groupByVariables, _aliases, *subtree));
+    _subtree = std::move(subtree);
+    return;
+  }
   auto sortColumns = computeSortColumns(subtree.get());
   _subtree =
       QueryExecutionTree::createSortedTree(std::move(subtree), sortColumns);
@@ -60,7 +73,7 @@ string GroupBy::asStringImpl(size_t indent) const {
   for (size_t i = 0; i < indent; ++i) {
     os << " ";
   }
-  os << "GROUP_BY ";
+  os << (_algorithm == Algorithm::HashBased ? "HASH_GROUP_BY " : "GROUP_BY ");
   for (const auto& var : _groupByVariables) {
     os << varMap.at(var).columnIndex_ << ", ";
   }
@@ -75,7 +88,8 @@ string GroupBy::asStringImpl(size_t indent) const {
 
 string GroupBy::getDescriptor() const {
   // TODO<C++23>:: Use std::views::join_with.
-  return "GroupBy on " +
+  return (_algorithm == Algorithm::HashBased ? "Hash-based GroupBy on "
+                                              : "GroupBy on ") +
          absl::StrJoin(_groupByVariables, " ", &Variable::AbslFormatter);
 }
 
@@ -169,7 +183,19 @@ size_t GroupBy::getCostEstimate() {
   // TODO: add the cost of the actual group by operation to the cost.
   // Currently group by is only added to the optimizer as a terminal operation
   // and its cost should not affect the optimizers results.
-  return _subtree->getCostEstimate();
+  if (_algorithm == Algorithm::SortBased) {
+    return _subtree->getCostEstimate();
+  }
+  // The hash-based GROUP BY doesn't sort its input, but it has to look up each
+  // row of the input in a hash map and sort the groups at the end. This is
+  // cheaper than the `Sort` of the sort-based GROUP BY if there are few groups,
+  // but more expensive if the input is already sorted.
+  size_t numGroups = getSizeEstimateBeforeLimit();
+  size_t logNumGroups =
+      numGroups < 4 ? 2
+                    : static_cast<size_t>(logb(static_cast<double>(numGroups)));
+  return _subtree->getCostEstimate() + _subtree->getSizeEstimate() +
+         numGroups * logNumGroups;
 }
 
 template <size_t OUT_WIDTH>
@@ -316,16 +342,6 @@ ResultTable GroupBy::computeResult() {
   std::shared_ptr<const ResultTable> subresult = _subtree->getResult();
   LOG(DEBUG) << "GroupBy subresult computation done" << std::endl;
 
-  // Make a deep copy of the local vocab from `subresult` and then add to it (in
-  // case GROUP_CONCAT adds a new word or words).
-  //
-  // TODO: In most GROUP BY operations, nothing is added to the local
-  // vocabulary, so it would be more efficient to first share the pointer here
-  // (like with `shareLocalVocabFrom`) and only copy it when a new word is about
-  // to be added. Same for BIND.
-
-  auto localVocab = subresult->getCopyOfLocalVocab();
-
   std::vector<size_t> groupByColumns;
 
   idTable.setNumColumns(getResultWidth());
@@ -357,6 +373,24 @@ ResultTable GroupBy::computeResult() {
     groupByCols.push_back(subtreeVarCols.at(var).columnIndex_);
   }
 
+  if (_algorithm == Algorithm::HashBased) {
+    doHashBasedGroupBy(subresult->idTable(), groupByCols, &idTable);
+    LOG(DEBUG) << "GroupBy result computation done." << std::endl;
+    // The hash-based GROUP BY never adds words to the local vocab.
+    return {std::move(idTable), resultSortedOn(),
+            subresult->getSharedLocalVocab()};
+  }
+
+  // Make a deep copy of the local vocab from `subresult` and then add to it (in
+  // case GROUP_CONCAT adds a new word or words).
+  //
+  // TODO: In most GROUP BY operations, nothing is added to the local
+  // vocabulary, so it would be more efficient to first share the pointer here
+  // (like with `shareLocalVocabFrom`) and only copy it when a new word is about
+  // to be added. Same for BIND.
+
+  auto localVocab = subresult->getCopyOfLocalVocab();
+
   size_t inWidth = subresult->idTable().numColumns();
   size_t outWidth = idTable.numColumns();
 
@@ -368,6 +402,289 @@ ResultTable GroupBy::computeResult() {
   return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
 }
 
+namespace {
+using sparqlExpression::detail::NumericValue;
+
+// The aggregates that are supported by the hash-based GROUP BY.
+enum struct HashAggregateType { Count, Sum, Avg, Min, Max, Sample };
+
+// If the `expression` is a non-distinct aggregate of type `AggregateT` of a
+// single variable, return that variable, else return `std::nullopt`.
+template <typename AggregateT>
+std::optional<Variable> getVariableOfNonDistinctAggregate(
+    const sparqlExpression::SparqlExpression& expression) {
+  const auto* aggregate = dynamic_cast<const AggregateT*>(&expression);
+  if (aggregate == nullptr) {
+    return std::nullopt;
+  }
+  // `SAMPLE(DISTINCT ?x)` is the same as `SAMPLE(?x)`.
+  if constexpr (requires { aggregate->isDistinct(); }) {
+    if (aggregate->isDistinct()) {
+      return std::nullopt;
+    }
+  }
+  return aggregate->getAggregatedVariable();
+}
+
+// If the `expression` can be computed by the hash-based GROUP BY, return the
+// type of the aggregate and the aggregated variable, else `std::nullopt`.
+std::optional<std::pair<HashAggregateType, Variable>> getHashAggregate(
+    const sparqlExpression::SparqlExpression& expression) {
+  using namespace sparqlExpression;
+  using enum HashAggregateType;
+  std::optional<std::pair<HashAggregateType, Variable>> result;
+  auto check = [&]<typename AggregateT>(HashAggregateType type) {
+    if (result.has_value()) {
+      return;
+    }
+    auto variable = getVariableOfNonDistinctAggregate<AggregateT>(expression);
+    if (variable.has_value()) {
+      result = std::pair{type, std::move(variable.value())};
+    }
+  };
+  check.operator()<CountExpression>(Count);
+  check.operator()<SumExpression>(Sum);
+  check.operator()<AvgExpression>(Avg);
+  check.operator()<MinExpression>(Min);
+  check.operator()<MaxExpression>(Max);
+  check.operator()<SampleExpression>(Sample);
+  return result;
+}
+
+// The intermediate state of a single aggregate for a single group during the
+// hash-based GROUP BY. The semantics of the aggregates are exactly the same as
+// those of the corresponding `AggregateExpression`s, which are used by the
+// sort-based GROUP BY.
+struct HashAggregateState {
+  // The number of valid values for COUNT, the number of values for AVG, and
+  // whether a value has been seen for SAMPLE.
+  int64_t count_ = 0;
+  // The sum for SUM and AVG.
+  NumericValue sum_ = int64_t{0};
+  // The current result for MIN, MAX and SAMPLE.
+  Id id_ = Id::makeUndefined();
+
+  // Add the value `id` of the aggregated variable to the state.
+  void add(HashAggregateType type, Id id) {
+    using namespace sparqlExpression::detail;
+    using enum HashAggregateType;
+    switch (type) {
+      case Count:
+        count_ += IsValidValueGetter{}(id, nullptr);
+        return;
+      case Avg:
+        ++count_;
+        [[fallthrough]];
+      case Sum:
+        sum_ = addForSum(sum_, NumericValueGetter{}(id, nullptr));
+        return;
+      case Min:
+        id_ = minLambdaForAllTypes(id_, id);
+        return;
+      case Max:
+        id_ = maxLambdaForAllTypes(id_, id);
+        return;
+      case Sample:
+        if (count_ == 0) {
+          id_ = id;
+          count_ = 1;
+        }
+        return;
+    }
+    AD_FAIL();
+  }
+
+  // Merge the state of the same group from a different part of the input.
+  void merge(HashAggregateType type, const HashAggregateState& other) {
+    using namespace sparqlExpression::detail;
+    using enum HashAggregateType;
+    switch (type) {
+      case Count:
+        count_ += other.count_;
+        return;
+      case Avg:
+        count_ += other.count_;
+        [[fallthrough]];
+      case Sum:
+        sum_ = addForSum(sum_, other.sum_);
+        return;
+      case Min:
+        id_ = minLambdaForAllTypes(id_, other.id_);
+        return;
+      case Max:
+        id_ = maxLambdaForAllTypes(id_, other.id_);
+        return;
+      case Sample:
+        if (count_ == 0) {
+          *this = other;
+        }
+        return;
+    }
+    AD_FAIL();
+  }
+
+  // Return the final result of the aggregate.
+  Id finish(HashAggregateType type) const {
+    using namespace sparqlExpression::detail;
+    using enum HashAggregateType;
+    switch (type) {
+      case Count:
+        return Id::makeFromInt(count_);
+      case Sum:
+        return makeNumericId(sum_);
+      case Avg:
+        return makeNumericId(averageFinalOp(sum_, count_));
+      case Min:
+      case Max:
+      case Sample:
+        return id_;
+    }
+    AD_FAIL();
+  }
+};
+
+// The result of the hash-based GROUP BY for a part of the input. For each
+// group, the values of the grouped columns are mapped to the offset of the
+// group's states in `states_`, where the states of all the aggregates of a
+// group are stored contiguously.
+struct HashAggregationResult {
+  ad_utility::HashMap<std::vector<Id>, size_t> groups_;
+  std::vector<HashAggregateState> states_;
+};
+}  // namespace
+
+// _____________________________________________________________________________
+bool GroupBy::supportsHashBasedAlgorithm(
+    const vector<Variable>& groupByVariables,
+    const std::vector<Alias>& aliases, const QueryExecutionTree& subtree) {
+  const auto& variableColumns = subtree.getVariableColumns();
+  auto isBound = [&variableColumns](const Variable& variable) {
+    return variableColumns.contains(variable);
+  };
+  return !groupByVariables.empty() &&
+         std::ranges::all_of(groupByVariables, isBound) &&
+         std::ranges::all_of(aliases, [&isBound](const Alias& alias) {
+           auto aggregate = getHashAggregate(*alias._expression.getPimpl());
+           return aggregate.has_value() && isBound(aggregate->second);
+         });
+}
+
+// _____________________________________________________________________________
+void GroupBy::doHashBasedGroupBy(const IdTable& input,
+                                 const vector<size_t>& groupByCols,
+                                 IdTable* result) const {
+  LOG(DEBUG) << "Hash-based group by input size " << input.size() << std::endl;
+  // For each alias, the type of the aggregate, the input column, and the
+  // output column.
+  struct HashAggregate {
+    HashAggregateType type_;
+    ColumnIndex inputColumn_;
+    ColumnIndex outputColumn_;
+  };
+  std::vector<HashAggregate> aggregates;
+  const auto& outputColumns = getInternallyVisibleVariableColumns();
+  for (const Alias& alias : _aliases) {
+    auto [type, variable] =
+        getHashAggregate(*alias._expression.getPimpl()).value();
+    aggregates.push_back(HashAggregate{
+        type, _subtree->getVariableColumn(variable),
+        outputColumns.at(alias._target).columnIndex_});
+  }
+  const size_t numAggregates = aggregates.size();
+
+  // Aggregate the rows `[begin, end)` of the input.
+  auto aggregateRows = [&](size_t begin, size_t end) {
+    HashAggregationResult partialResult;
+    auto checkTimeoutAfterNCalls = checkTimeoutAfterNCallsFactory(32000);
+    std::vector<Id> groupKey(groupByCols.size());
+    for (size_t row = begin; row < end; ++row) {
+      checkTimeoutAfterNCalls();
+      for (size_t i = 0; i < groupByCols.size(); ++i) {
+        groupKey[i] = input(row, groupByCols[i]);
+      }
+      auto it = partialResult.groups_.find(groupKey);
+      if (it == partialResult.groups_.end()) {
+        it = partialResult.groups_
+                 .emplace(groupKey, partialResult.states_.size())
+                 .first;
+        partialResult.states_.resize(partialResult.states_.size() +
+                                     numAggregates);
+      }
+      auto* states = partialResult.states_.data() + it->second;
+      for (size_t i = 0; i < numAggregates; ++i) {
+        states[i].add(aggregates[i].type_,
+                      input(row, aggregates[i].inputColumn_));
+      }
+    }
+    return partialResult;
+  };
+
+  // Aggregate parts of the input in parallel and merge the results. The
+  // results are merged in the order of the parts, s.t. a SAMPLE is the same
+  // as for a sequential computation.
+  const size_t maxNumThreads =
+      std::max(RuntimeParameters().get<"group-by-max-num-threads">(), 1UL);
+  const size_t minNumRowsPerThread = std::max(
+      RuntimeParameters().get<"group-by-min-num-rows-per-thread">(), 1UL);
+  const size_t numWantedThreads =
+      std::clamp(input.size() / minNumRowsPerThread, 1UL, maxNumThreads);
+  // The first part is aggregated by this thread, the other parts by threads
+  // from the budget that is shared with the concurrent queries.
+  ad_utility::ReservedThreads reservedThreads{numWantedThreads - 1};
+  const size_t numThreads = 1 + reservedThreads.numThreads();
+  std::vector<std::future<HashAggregationResult>> partialResults;
+  for (size_t i = 1; i < numThreads; ++i) {
+    partialResults.push_back(std::async(std::launch::async, aggregateRows,
+                                        i * input.size() / numThreads,
+                                        (i + 1) * input.size() / numThreads));
+  }
+  HashAggregationResult aggregationResult =
+      aggregateRows(0, input.size() / numThreads);
+  for (auto& future : partialResults) {
+    HashAggregationResult partialResult = future.get();
+    checkTimeout();
+    for (auto& [groupKey, offset] : partialResult.groups_) {
+      auto [it, isNew] = aggregationResult.groups_.try_emplace(
+          groupKey, aggregationResult.states_.size());
+      const auto* states = partialResult.states_.data() + offset;
+      if (isNew) {
+        aggregationResult.states_.insert(aggregationResult.states_.end(),
+                                         states, states + numAggregates);
+      } else {
+        for (size_t j = 0; j < numAggregates; ++j) {
+          aggregationResult.states_.at(it->second + j)
+              .merge(aggregates[j].type_, states[j]);
+        }
+      }
+    }
+  }
+
+  // Sort the groups by the grouped columns and write the result.
+  using Group = std::pair<const std::vector<Id>, size_t>;
+  std::vector<const Group*> groups;
+  groups.reserve(aggregationResult.groups_.size());
+  for (const auto& group : aggregationResult.groups_) {
+    groups.push_back(&group);
+  }
+  std::ranges::sort(groups, std::less<>{},
+                    [](const Group* group) -> const std::vector<Id>& {
+                      return group->first;
+                    });
+  checkTimeout();
+  result->resize(groups.size());
+  for (size_t row = 0; row < groups.size(); ++row) {
+    const auto& [groupKey, offset] = *groups[row];
+    for (size_t i = 0; i < groupKey.size(); ++i) {
+      (*result)(row, i) = groupKey[i];
+    }
+    const auto* states = aggregationResult.states_.data() + offset;
+    for (size_t i = 0; i < numAggregates; ++i) {
+      (*result)(row, aggregates[i].outputColumn_) =
+          states[i].finish(aggregates[i].type_);
+    }
+  }
+}
+
 // _____________________________________________________________________________
 bool GroupBy::computeGroupByForSingleIndexScan(IdTable* result) {
   // The child must be an `IndexScan` for this optimization.
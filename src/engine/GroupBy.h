@@ -27,10 +27,23 @@ class IndexScan;
 class Join;
 
 class GroupBy : public Operation {
+ public:
+  // The algorithm that is used to compute the GROUP BY.
+  enum struct Algorithm {
+    // Process the groups one after the other. This requires the input to be
+    // sorted by the grouped variables, so a `Sort` is added if necessary.
+    SortBased,
+    // Aggregate the (possibly unsorted) input using hash maps that are built in
+    // parallel and then merged. This is only possible if
+    // `supportsHashBasedAlgorithm` returns true.
+    HashBased
+  };
+
  private:
   std::shared_ptr<QueryExecutionTree> _subtree;
   vector<Variable> _groupByVariables;
   std::vector<Alias> _aliases;
+  Algorithm _algorithm;
 
  public:
   /**
@@ -43,7 +56,18 @@ class GroupBy : public Operation {
 
   GroupBy(QueryExecutionContext* qec, vector<Variable> groupByVariables,
           std::vector<Alias> aliases,
-          std::shared_ptr<QueryExecutionTree> subtree);
+          std::shared_ptr<QueryExecutionTree> subtree,
+          Algorithm algorithm = Algorithm::SortBased);
+
+  // Return true iff a GROUP BY with the given variables and aliases of the
+  // `subtree` can be computed using the `HashBased` algorithm. This is the case
+  // if at least one variable is grouped, all grouped variables are bound by the
+  // `subtree`, and each of the aliases is a non-distinct `COUNT`, `SUM`, `AVG`,
+  // `MIN`, `MAX`, or `SAMPLE` of a single variable that is bound by the
+  // `subtree`.
+  static bool supportsHashBasedAlgorithm(
+      const vector<Variable>& groupByVariables,
+      const std::vector<Alias>& aliases, const QueryExecutionTree& subtree);
 
  protected:
   virtual string asStringImpl(size_t indent = 0) const override;
@@ -101,6 +125,12 @@ class GroupBy : public Operation {
                  IdTable* dynResult, const IdTable* inTable,
                  LocalVocab* outLocalVocab) const;
 
+  // Compute the GROUP BY using the `HashBased` algorithm. The `input` does not
+  // have to be sorted, the `result` will be sorted by the `groupByCols`.
+  void doHashBasedGroupBy(const IdTable& input,
+                          const vector<size_t>& groupByCols,
+                          IdTable* result) const;
+
   FRIEND_TEST(GroupByTest, doGroupBy);
 
  public:
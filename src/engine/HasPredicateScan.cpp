@@ -216,7 +216,7 @@ ResultTable HasPredicateScan::computeResult() {
   IdTable idTable{getExecutionContext()->getAllocator()};
   idTable.setNumColumns(getResultWidth());
 
-  const std::vector<PatternID>& hasPattern = getIndex().getHasPattern();
+  std::span<const PatternID> hasPattern = getIndex().getHasPattern();
   const CompactVectorOfStrings<Id>& hasPredicate = getIndex().getHasPredicate();
   const CompactVectorOfStrings<Id>& patterns = getIndex().getPatterns();
 
@@ -260,7 +260,7 @@ ResultTable HasPredicateScan::computeResult() {
 }
 
 void HasPredicateScan::computeFreeS(
-    IdTable* resultTable, Id objectId, const std::vector<PatternID>& hasPattern,
+    IdTable* resultTable, Id objectId, std::span<const PatternID> hasPattern,
     const CompactVectorOfStrings<Id>& hasPredicate,
     const CompactVectorOfStrings<Id>& patterns) {
   IdTableStatic<1> result = std::move(*resultTable).toStatic<1>();
@@ -292,7 +292,7 @@ void HasPredicateScan::computeFreeS(
 
 void HasPredicateScan::computeFreeO(
     IdTable* resultTable, Id subjectAsId,
-    const std::vector<PatternID>& hasPattern,
+    std::span<const PatternID> hasPattern,
     const CompactVectorOfStrings<Id>& hasPredicate,
     const CompactVectorOfStrings<Id>& patterns) {
   // Subjects always have to be from the vocabulary
@@ -319,7 +319,7 @@ void HasPredicateScan::computeFreeO(
 }
 
 void HasPredicateScan::computeFullScan(
-    IdTable* resultTable, const std::vector<PatternID>& hasPattern,
+    IdTable* resultTable, std::span<const PatternID> hasPattern,
     const CompactVectorOfStrings<Id>& hasPredicate,
     const CompactVectorOfStrings<Id>& patterns, size_t resultSize) {
   IdTableStatic<2> result = std::move(*resultTable).toStatic<2>();
@@ -352,7 +352,7 @@ void HasPredicateScan::computeFullScan(
 template <int IN_WIDTH, int OUT_WIDTH>
 void HasPredicateScan::computeSubqueryS(
     IdTable* dynResult, const IdTable& dynInput, const size_t subtreeColIndex,
-    const std::vector<PatternID>& hasPattern,
+    std::span<const PatternID> hasPattern,
     const CompactVectorOfStrings<Id>& hasPredicate,
     const CompactVectorOfStrings<Id>& patterns) {
   IdTableStatic<OUT_WIDTH> result = std::move(*dynResult).toStatic<OUT_WIDTH>();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -85,17 +86,17 @@ class HasPredicateScan : public Operation {
 
   // These are made static and public mainly for easier testing
   static void computeFreeS(IdTable* resultTable, Id objectId,
-                           const std::vector<PatternID>& hasPattern,
+                           std::span<const PatternID> hasPattern,
                            const CompactVectorOfStrings<Id>& hasPredicate,
                            const CompactVectorOfStrings<Id>& patterns);
 
   static void computeFreeO(IdTable* resultTable, Id subjectAsId,
-                           const std::vector<PatternID>& hasPattern,
+                           std::span<const PatternID> hasPattern,
                            const CompactVectorOfStrings<Id>& hasPredicate,
                            const CompactVectorOfStrings<Id>& patterns);
 
   static void computeFullScan(IdTable* resultTable,
-                              const std::vector<PatternID>& hasPattern,
+                              std::span<const PatternID> hasPattern,
                               const CompactVectorOfStrings<Id>& hasPredicate,
                               const CompactVectorOfStrings<Id>& patterns,
                               size_t resultSize);
@@ -103,7 +104,7 @@ class HasPredicateScan : public Operation {
   template <int IN_WIDTH, int OUT_WIDTH>
   static void computeSubqueryS(IdTable* result, const IdTable& _subtree,
                                size_t subtreeColIndex,
-                               const std::vector<PatternID>& hasPattern,
+                               std::span<const PatternID> hasPattern,
                                const CompactVectorOfStrings<Id>& hasPredicate,
                                const CompactVectorOfStrings<Id>& patterns);
 
@@ -135,6 +135,41 @@ ResultTable IndexScan::computeResult() {
   return {std::move(idTable), resultSortedOn(), LocalVocab{}};
 }
 
+// _____________________________________________________________________________
+namespace {
+// Yield the blocks of a lazy index scan and add the statistics of the scan to
+// the `runtimeInfo` once all the blocks have been consumed.
+LazyResultTable::Blocks yieldScannedBlocks(
+    Permutation::IdTableGenerator generator, RuntimeInformation& runtimeInfo) {
+  for (IdTable& block : generator) {
+    co_yield block;
+  }
+  const auto& details = generator.details();
+  runtimeInfo.addDetail("num-blocks-read", details.numBlocksRead_);
+  runtimeInfo.addDetail("num-elements-read", details.numElementsRead_);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+LazyResultTable IndexScan::computeResultLazily() {
+  AD_CORRECTNESS_CHECK(numVariables_ == 1 || numVariables_ == 2);
+  const IndexImpl& index = getIndex().getImpl();
+  const auto permutedTriple = getPermutedTriple();
+  std::optional<Id> col0Id = index.getId(*permutedTriple[0]);
+  std::optional<Id> col1Id =
+      numVariables_ == 2 ? std::nullopt : index.getId(*permutedTriple[1]);
+  // If one of the fixed entries is not contained in the vocabulary, the result
+  // is empty.
+  Permutation::IdTableGenerator generator;
+  if (col0Id.has_value() && (numVariables_ == 2 || col1Id.has_value())) {
+    generator = index.getPermutation(permutation_)
+                    .lazyScan(col0Id.value(), col1Id, std::nullopt,
+                              _timeoutTimer);
+  }
+  return {yieldScannedBlocks(std::move(generator), getRuntimeInfo()),
+          resultSortedOn(), std::make_shared<const LocalVocab>()};
+}
+
 // _____________________________________________________________________________
 size_t IndexScan::computeSizeEstimate() {
   if (_executionContext) {
@@ -284,10 +319,10 @@ std::array<const TripleComponent* const, 3> IndexScan::getPermutedTriple()
 Permutation::IdTableGenerator IndexScan::getLazyScan(
     const IndexScan& s, std::vector<CompressedBlockMetadata> blocks) {
   const IndexImpl& index = s.getIndex().getImpl();
-  Id col0Id = s.getPermutedTriple()[0]->toValueId(index.getVocab()).value();
+  Id col0Id = index.getId(*s.getPermutedTriple()[0]).value();
   std::optional<Id> col1Id;
   if (s.numVariables_ == 1) {
-    col1Id = s.getPermutedTriple()[1]->toValueId(index.getVocab()).value();
+    col1Id = index.getId(*s.getPermutedTriple()[1]).value();
   }
   return index.getPermutation(s.permutation())
       .lazyScan(col0Id, col1Id, std::move(blocks), s._timeoutTimer);
@@ -298,10 +333,10 @@ std::optional<Permutation::MetadataAndBlocks> IndexScan::getMetadataForScan(
     const IndexScan& s) {
   auto permutedTriple = s.getPermutedTriple();
   const IndexImpl& index = s.getIndex().getImpl();
-  std::optional<Id> col0Id = permutedTriple[0]->toValueId(index.getVocab());
+  std::optional<Id> col0Id = index.getId(*permutedTriple[0]);
   std::optional<Id> col1Id =
       s.numVariables_ == 2 ? std::nullopt
-                           : permutedTriple[1]->toValueId(index.getVocab());
+                           : index.getId(*permutedTriple[1]);
   if (!col0Id.has_value() || (!col1Id.has_value() && s.numVariables_ == 1)) {
     return std::nullopt;
   }
@@ -337,6 +372,26 @@ IndexScan::lazyScanForJoinOfTwoScans(const IndexScan& s1, const IndexScan& s2) {
   auto [blocks1, blocks2] = CompressedRelationReader::getBlocksForJoin(
       metaBlocks1.value(), metaBlocks2.value());
 
+  // Triples that were inserted after the index was built are not part of the
+  // block metadata, so they must not be used to prefilter the blocks of the
+  // other scan.
+  auto hasInsertedTriples = [](const IndexScan& scan,
+                               const Permutation::MetadataAndBlocks& meta) {
+    return scan.getIndex()
+        .getImpl()
+        .getPermutation(scan.permutation())
+        .hasInsertedTriples(meta.relationMetadata_.col0Id_, meta.col1Id_);
+  };
+  auto allBlocks = [](const Permutation::MetadataAndBlocks& meta) {
+    return std::vector(meta.blockMetadata_.begin(), meta.blockMetadata_.end());
+  };
+  if (hasInsertedTriples(s2, metaBlocks2.value())) {
+    blocks1 = allBlocks(metaBlocks1.value());
+  }
+  if (hasInsertedTriples(s1, metaBlocks1.value())) {
+    blocks2 = allBlocks(metaBlocks2.value());
+  }
+
   std::array result{getLazyScan(s1, blocks1), getLazyScan(s2, blocks2)};
   result[0].details().numBlocksAll_ = metaBlocks1.value().blockMetadata_.size();
   result[1].details().numBlocksAll_ = metaBlocks2.value().blockMetadata_.size();
@@ -361,3 +416,26 @@ Permutation::IdTableGenerator IndexScan::lazyScanForJoinOfColumnWithScan(
   result.details().numBlocksAll_ = metaBlocks1.value().blockMetadata_.size();
   return result;
 }
+
+// ________________________________________________________________
+std::optional<Permutation::IdTableGenerator> IndexScan::lazyScanWithFilter(
+    const Variable& variable, valueIdComparators::Comparison comparison,
+    Id value) const {
+  if (numVariables_ != 1 && numVariables_ != 2) {
+    return std::nullopt;
+  }
+  const TripleComponent& lastComponent = *getPermutedTriple()[2];
+  if (!lastComponent.isVariable() || lastComponent.getVariable() != variable) {
+    return std::nullopt;
+  }
+  auto metadataAndBlocks = getMetadataForScan(*this);
+  if (!metadataAndBlocks.has_value()) {
+    return Permutation::IdTableGenerator{};
+  }
+  auto blocks = CompressedRelationReader::getBlocksForFilter(
+      metadataAndBlocks.value(), comparison, value);
+  auto result = getLazyScan(*this, std::move(blocks));
+  result.details().numBlocksAll_ =
+      metadataAndBlocks.value().blockMetadata_.size();
+  return result;
+}
@@ -59,6 +59,16 @@ class IndexScan : public Operation {
   static Permutation::IdTableGenerator lazyScanForJoinOfColumnWithScan(
       std::span<const Id> joinColumn, const IndexScan& s);
 
+  // Return a generator that lazily yields the result of this scan in blocks,
+  // but only the blocks that can theoretically contain rows for which the
+  // condition `variable comparison value` holds (according to the zone maps of
+  // the blocks, see `CompressedBlockMetadata::ZoneMap`). Return `std::nullopt`
+  // if the `variable` is not the variable of the last column of this scan, or
+  // if this scan has three variables.
+  std::optional<Permutation::IdTableGenerator> lazyScanWithFilter(
+      const Variable& variable, valueIdComparators::Comparison comparison,
+      Id value) const;
+
  private:
   // TODO<joka921> Make the `getSizeEstimateBeforeLimit()` function `const` for
   // ALL the `Operations`.
@@ -89,6 +99,15 @@ class IndexScan : public Operation {
  private:
   ResultTable computeResult() override;
 
+ public:
+  // Scans with one or two variables read the blocks of a single relation,
+  // which can be directly yielded one by one. The full index scan is
+  // currently always materialized.
+  bool supportsLazyEvaluation() const override { return numVariables_ < 3; }
+
+ private:
+  LazyResultTable computeResultLazily() override;
+
   vector<QueryExecutionTree*> getChildren() override { return {}; }
 
   void computeFullScan(IdTable* result, Permutation::Enum permutation) const;
@@ -12,8 +12,11 @@
 #include <global/Id.h>
 #include <util/Exception.h>
 #include <util/HashMap.h>
+#include <util/ThreadBudget.h>
 
 #include <functional>
+#include <future>
+#include <ranges>
 #include <sstream>
 #include <type_traits>
 #include <vector>
@@ -147,10 +150,9 @@ ResultTable Join::computeResult() {
 
     } else if (!leftResIfCached) {
       idTable = computeResultForTwoIndexScans();
-      // TODO<joka921, hannahbast, SPARQL update> When we add triples to the
-      // index, the vocabularies of index scans will not necessarily be empty
-      // and we need a mechanism to still retrieve them when using the lazy
-      // scan.
+      // The results of index scans never have a local vocab, the words that
+      // were added by updates have regular vocabulary IDs (see
+      // `IndexImpl::getOrAddIdForUpdate`).
       return {std::move(idTable), resultSortedOn(), LocalVocab{}};
     }
   }
@@ -461,12 +463,13 @@ void Join::join(const IdTable& a, ColumnIndex jc1, const IdTable& b,
   auto aPermuted = a.asColumnSubsetView(joinColumnData.permutationLeft());
   auto bPermuted = b.asColumnSubsetView(joinColumnData.permutationRight());
 
-  auto rowAdder = ad_utility::AddCombinedRowToIdTable(1, aPermuted, bPermuted,
-                                                      std::move(*result));
-  auto addRow = [beginLeft = joinColumnL.begin(),
-                 beginRight = joinColumnR.begin(),
-                 &rowAdder](const auto& itLeft, const auto& itRight) {
-    rowAdder.addRow(itLeft - beginLeft, itRight - beginRight);
+  // Return a function that adds the rows to which the iterators `itLeft` and
+  // `itRight` into `joinColumnL` and `joinColumnR` point to the `rowAdder`.
+  auto makeAddRow = [&joinColumnL, &joinColumnR](auto& rowAdder) {
+    return [beginLeft = joinColumnL.begin(), beginRight = joinColumnR.begin(),
+            &rowAdder](const auto& itLeft, const auto& itRight) {
+      rowAdder.addRow(itLeft - beginLeft, itRight - beginRight);
+    };
   };
 
   // The UNDEF values are right at the start, so this calculation works.
@@ -479,21 +482,76 @@ void Join::join(const IdTable& a, ColumnIndex jc1, const IdTable& b,
   std::pair undefRangeA{joinColumnL.begin(), joinColumnL.begin() + numUndefA};
   std::pair undefRangeB{joinColumnR.begin(), joinColumnR.begin() + numUndefB};
 
-  // Determine whether we should use the galloping join optimization.
-  if (a.size() / b.size() > GALLOP_THRESHOLD && numUndefA == 0 &&
-      numUndefB == 0) {
-    // The first argument to the galloping join will always be the smaller
-    // input, so we need to switch the rows when adding them.
-    auto inverseAddRow = [&addRow](const auto& rowA, const auto& rowB) {
-      addRow(rowB, rowA);
+  if (numUndefA == 0 && numUndefB == 0) {
+    // Join the subranges of the join columns that are specified by the
+    // `partition` and return the result, which is appended to the `output`.
+    auto joinPartition = [&](const ad_utility::JoinPartition& partition,
+                             IdTable output) -> IdTable {
+      auto rowAdder = ad_utility::AddCombinedRowToIdTable(
+          1, aPermuted, bPermuted, std::move(output));
+      auto addRow = makeAddRow(rowAdder);
+      auto left = joinColumnL.subspan(
+          partition.beginLeft_, partition.endLeft_ - partition.beginLeft_);
+      auto right = joinColumnR.subspan(
+          partition.beginRight_, partition.endRight_ - partition.beginRight_);
+      if (left.empty() || right.empty()) {
+        return std::move(rowAdder).resultTable();
+      }
+      // Determine whether we should use the galloping join optimization.
+      if (left.size() / right.size() > GALLOP_THRESHOLD) {
+        // The first argument to the galloping join will always be the smaller
+        // input, so we need to switch the rows when adding them.
+        auto inverseAddRow = [&addRow](const auto& rowA, const auto& rowB) {
+          addRow(rowB, rowA);
+        };
+        ad_utility::gallopingJoin(right, left, std::ranges::less{},
+                                  inverseAddRow);
+      } else if (right.size() / left.size() > GALLOP_THRESHOLD) {
+        ad_utility::gallopingJoin(left, right, std::ranges::less{}, addRow);
+      } else {
+        // The most common case: A single join column without UNDEF values,
+        // for which we use a specialized zipper join.
+        ad_utility::zipperJoinForSingleColumnWithoutUndef(left, right, addRow);
+      }
+      return std::move(rowAdder).resultTable();
     };
-    ad_utility::gallopingJoin(joinColumnR, joinColumnL, std::ranges::less{},
-                              inverseAddRow);
-  } else if (b.size() / a.size() > GALLOP_THRESHOLD && numUndefA == 0 &&
-             numUndefB == 0) {
-    ad_utility::gallopingJoin(joinColumnL, joinColumnR, std::ranges::less{},
-                              addRow);
+
+    // For large inputs, split the inputs into partitions that can be joined
+    // independently and join them in parallel. The results of the partitions
+    // are concatenated in order, so the result is still sorted by the join
+    // column.
+    const size_t maxNumThreads =
+        RuntimeParameters().get<"join-max-num-threads">();
+    const size_t minNumRowsPerThread =
+        std::max(RuntimeParameters().get<"join-min-num-rows-per-thread">(),
+                 size_t{1});
+    const size_t numWantedPartitions =
+        std::clamp((a.size() + b.size()) / minNumRowsPerThread, size_t{1},
+                   std::max(maxNumThreads, size_t{1}));
+    // The first partition is joined by this thread, the other partitions by
+    // threads from the budget that is shared with the concurrent queries.
+    ad_utility::ReservedThreads reservedThreads{numWantedPartitions - 1};
+    auto partitions = ad_utility::partitionSortedInputsForJoin(
+        joinColumnL, joinColumnR, 1 + reservedThreads.numThreads(),
+        std::ranges::less{});
+    if (partitions.size() <= 1) {
+      *result = joinPartition({0, a.size(), 0, b.size()}, std::move(*result));
+    } else {
+      std::vector<std::future<IdTable>> partialResults;
+      for (const auto& partition : partitions | std::views::drop(1)) {
+        partialResults.push_back(std::async(
+            std::launch::async, joinPartition, partition,
+            IdTable{result->numColumns(), result->getAllocator()}));
+      }
+      *result = joinPartition(partitions.at(0), std::move(*result));
+      for (auto& partialResult : partialResults) {
+        result->insertAtEnd(partialResult.get());
+      }
+    }
   } else {
+    auto rowAdder = ad_utility::AddCombinedRowToIdTable(1, aPermuted, bPermuted,
+                                                        std::move(*result));
+    auto addRow = makeAddRow(rowAdder);
     // TODO<joka921> Reinstate the timeout checks.
     auto findSmallerUndefRangeLeft =
         [undefRangeA](
@@ -510,21 +568,12 @@ void Join::join(const IdTable& a, ColumnIndex jc1, const IdTable& b,
       }
     };
 
-    auto numOutOfOrder = [&]() {
-      if (numUndefB == 0 && numUndefA == 0) {
-        return ad_utility::zipperJoinWithUndef(
-            joinColumnL, joinColumnR, std::ranges::less{}, addRow,
-            ad_utility::noop, ad_utility::noop);
-
-      } else {
-        return ad_utility::zipperJoinWithUndef(
-            joinColumnL, joinColumnR, std::ranges::less{}, addRow,
-            findSmallerUndefRangeLeft, findSmallerUndefRangeRight);
-      }
-    }();
+    auto numOutOfOrder = ad_utility::zipperJoinWithUndef(
+        joinColumnL, joinColumnR, std::ranges::less{}, addRow,
+        findSmallerUndefRangeLeft, findSmallerUndefRangeRight);
     AD_CORRECTNESS_CHECK(numOutOfOrder == 0);
+    *result = std::move(rowAdder).resultTable();
   }
-  *result = std::move(rowAdder).resultTable();
   // The column order in the result is now
   // [joinColumns, non-join-columns-a, non-join-columns-b] (which makes the
   // algorithms above easier), be the order that is expected by the rest of
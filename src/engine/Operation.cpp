@@ -94,6 +94,103 @@ shared_ptr<const ResultTable> Operation::getResult(bool isRoot,
     });
   }
 
+  return computeAndHandleExceptions(
+      timer, [&]() -> shared_ptr<const ResultTable> {
+        auto computeLambda = [this, &timer] {
+          return CacheValue{computeResultAndFinalize(timer), getRuntimeInfo()};
+        };
+
+        const size_t generation = _executionContext->getCacheGeneration();
+        auto result =
+            (pinResult)
+                ? cache.computeOncePinned(cacheKey, computeLambda,
+                                          onlyReadFromCache, generation)
+                : cache.computeOnce(cacheKey, computeLambda, onlyReadFromCache,
+                                    generation);
+
+        if (result._resultPointer == nullptr) {
+          AD_CORRECTNESS_CHECK(onlyReadFromCache);
+          return nullptr;
+        }
+
+        updateRuntimeInformationOnSuccess(result, timer.msecs());
+        auto resultNumRows = result._resultPointer->resultTable()->size();
+        auto resultNumCols = result._resultPointer->resultTable()->width();
+        LOG(DEBUG) << "Computed result of size " << resultNumRows << " x "
+                   << resultNumCols << std::endl;
+        return result._resultPointer->resultTable();
+      });
+}
+
+// ________________________________________________________________________
+ResultTable Operation::getOwnedResult(bool isRoot) {
+  std::shared_ptr<const ResultTable> result = getResult(isRoot);
+  // If the result was neither added to the cache nor passed on to another
+  // thread that waited for it, we are its only owner and can take it. This is
+  // safe despite the `const_cast`, because the `ResultTable` of a `CacheValue`
+  // is not created as a const object.
+  if (result.use_count() == 1) {
+    return std::move(const_cast<ResultTable&>(*result));
+  }
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  IdTable idTable = result->idTable().clone();
+  _runtimeInfo.addDetail("time-cloning", timer.msecs());
+  return {std::move(idTable), result->sortedBy(),
+          result->getSharedLocalVocab()};
+}
+
+// ________________________________________________________________________
+ResultTable Operation::computeResultAndFinalize(
+    const ad_utility::Timer& timer) {
+  if (_timeoutTimer->wlock()->hasTimedOut()) {
+    throw ad_utility::TimeoutException(
+        "Timeout in operation with no or insufficient timeout "
+        "functionality, before " +
+        getDescriptor());
+  }
+  ResultTable result = computeResult();
+
+  // Compute the datatypes that occur in each column of the result.
+  // Also assert, that if a column contains UNDEF values, then the
+  // `mightContainUndef` flag for that columns is set.
+  // TODO<joka921> It is cheaper to move this calculation into the
+  // individual results, but that requires changes in each individual
+  // operation, therefore we currently only perform this expensive
+  // change in the DEBUG builds.
+  AD_EXPENSIVE_CHECK(
+      result.checkDefinedness(getExternallyVisibleVariableColumns()));
+  if (_timeoutTimer->wlock()->hasTimedOut()) {
+    throw ad_utility::TimeoutException(
+        "Timeout in " + getDescriptor() +
+        ". This timeout was not caught inside the actual computation, "
+        "which indicates insufficient timeout functionality.");
+  }
+  // Make sure that the results that are written to the cache have the
+  // correct runtimeInfo. The children of the runtime info are already set
+  // correctly because the result was computed, so we can pass `nullopt` as
+  // the last argument.
+  updateRuntimeInformationOnSuccess(result, ad_utility::CacheStatus::computed,
+                                    timer.msecs(), std::nullopt);
+  // Apply LIMIT and OFFSET, but only if the call to `computeResult` did not
+  // already perform it. An example for an operation that directly computes
+  // the Limit is a full index scan with three variables.
+  if (!supportsLimit()) {
+    ad_utility::timer::Timer limitTimer{ad_utility::timer::Timer::Started};
+    // Note: both of the following calls have no effect and negligible
+    // runtime if neither a LIMIT nor an OFFSET were specified.
+    result.applyLimitOffset(_limit);
+    _runtimeInfo.addLimitOffsetRow(_limit, limitTimer.msecs(), true);
+  } else {
+    AD_CONTRACT_CHECK(result.idTable().numRows() ==
+                      _limit.actualSize(result.idTable().numRows()));
+  }
+  return result;
+}
+
+// ________________________________________________________________________
+template <typename F>
+std::invoke_result_t<F> Operation::computeAndHandleExceptions(
+    const ad_utility::Timer& timer, F computation) {
   try {
     // In case of an exception, create the correct runtime info, no matter which
     // exception handler is called.
@@ -107,69 +204,7 @@ shared_ptr<const ResultTable> Operation::getResult(bool isRoot,
                 updateRuntimeInformationOnFailure(timer.msecs());
               }
             });
-    auto computeLambda = [this, &timer] {
-      if (_timeoutTimer->wlock()->hasTimedOut()) {
-        throw ad_utility::TimeoutException(
-            "Timeout in operation with no or insufficient timeout "
-            "functionality, before " +
-            getDescriptor());
-      }
-      ResultTable result = computeResult();
-
-      // Compute the datatypes that occur in each column of the result.
-      // Also assert, that if a column contains UNDEF values, then the
-      // `mightContainUndef` flag for that columns is set.
-      // TODO<joka921> It is cheaper to move this calculation into the
-      // individual results, but that requires changes in each individual
-      // operation, therefore we currently only perform this expensive
-      // change in the DEBUG builds.
-      AD_EXPENSIVE_CHECK(
-          result.checkDefinedness(getExternallyVisibleVariableColumns()));
-      if (_timeoutTimer->wlock()->hasTimedOut()) {
-        throw ad_utility::TimeoutException(
-            "Timeout in " + getDescriptor() +
-            ". This timeout was not caught inside the actual computation, "
-            "which indicates insufficient timeout functionality.");
-      }
-      // Make sure that the results that are written to the cache have the
-      // correct runtimeInfo. The children of the runtime info are already set
-      // correctly because the result was computed, so we can pass `nullopt` as
-      // the last argument.
-      updateRuntimeInformationOnSuccess(result,
-                                        ad_utility::CacheStatus::computed,
-                                        timer.msecs(), std::nullopt);
-      // Apply LIMIT and OFFSET, but only if the call to `computeResult` did not
-      // already perform it. An example for an operation that directly computes
-      // the Limit is a full index scan with three variables.
-      if (!supportsLimit()) {
-        ad_utility::timer::Timer limitTimer{ad_utility::timer::Timer::Started};
-        // Note: both of the following calls have no effect and negligible
-        // runtime if neither a LIMIT nor an OFFSET were specified.
-        result.applyLimitOffset(_limit);
-        _runtimeInfo.addLimitOffsetRow(_limit, limitTimer.msecs(), true);
-      } else {
-        AD_CONTRACT_CHECK(result.idTable().numRows() ==
-                          _limit.actualSize(result.idTable().numRows()));
-      }
-      return CacheValue{std::move(result), getRuntimeInfo()};
-    };
-
-    auto result = (pinResult) ? cache.computeOncePinned(cacheKey, computeLambda,
-                                                        onlyReadFromCache)
-                              : cache.computeOnce(cacheKey, computeLambda,
-                                                  onlyReadFromCache);
-
-    if (result._resultPointer == nullptr) {
-      AD_CORRECTNESS_CHECK(onlyReadFromCache);
-      return nullptr;
-    }
-
-    updateRuntimeInformationOnSuccess(result, timer.msecs());
-    auto resultNumRows = result._resultPointer->resultTable()->size();
-    auto resultNumCols = result._resultPointer->resultTable()->width();
-    LOG(DEBUG) << "Computed result of size " << resultNumRows << " x "
-               << resultNumCols << std::endl;
-    return result._resultPointer->resultTable();
+    return computation();
   } catch (const ad_utility::AbortException& e) {
     // A child Operation was aborted, do not print the information again.
     _runtimeInfo.status_ = RuntimeInformation::Status::failedBecauseChildFailed;
@@ -201,6 +236,63 @@ shared_ptr<const ResultTable> Operation::getResult(bool isRoot,
   }
 }
 
+// ______________________________________________________________________
+LazyResultTable Operation::getLazyResult(bool isRoot) {
+  auto& cache = _executionContext->getQueryTreeCache();
+  const bool pinResult = _executionContext->_pinSubtrees ||
+                         (_executionContext->_pinResult && isRoot);
+  const bool hasLimitOrOffset =
+      _limit._limit.has_value() || _limit._offset != 0;
+  if (!supportsLazyEvaluation() || pinResult || hasLimitOrOffset ||
+      cache.getIfContained(asString()).has_value()) {
+    return LazyResultTable::fromMaterialized(getResult(isRoot));
+  }
+
+  if (isRoot) {
+    // Start with an estimated runtime info which will be updated as we go.
+    createRuntimeInfoFromEstimates();
+  }
+  checkTimeout();
+  LazyResultTable result = computeResultLazily();
+  result.blocks_ = updateRuntimeInformationWhileConsuming(
+      std::move(result.blocks_));
+  return result;
+}
+
+// ______________________________________________________________________
+LazyResultTable::Blocks Operation::updateRuntimeInformationWhileConsuming(
+    LazyResultTable::Blocks blocks) {
+  // Only measure the time that is spent inside this operation and its
+  // children, but not the time of the consumer between two blocks.
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  _runtimeInfo.status_ = RuntimeInformation::Status::lazilyMaterialized;
+  _runtimeInfo.cacheStatus_ = ad_utility::CacheStatus::computed;
+  _runtimeInfo.numRows_ = 0;
+  size_t numBlocks = 0;
+  try {
+    for (const IdTable& block : blocks) {
+      _runtimeInfo.numRows_ += block.numRows();
+      ++numBlocks;
+      timer.stop();
+      co_yield block;
+      timer.cont();
+    }
+  } catch (...) {
+    updateRuntimeInformationOnFailure(timer.msecs());
+    throw;
+  }
+  _runtimeInfo.totalTime_ = timer.msecs();
+  _runtimeInfo.addDetail("num-blocks", numBlocks);
+  // The children have also been consumed completely, so their runtime
+  // information is now final.
+  _runtimeInfo.children_.clear();
+  for (auto* child : getChildren()) {
+    AD_CONTRACT_CHECK(child);
+    _runtimeInfo.children_.push_back(
+        child->getRootOperation()->getRuntimeInfo());
+  }
+}
+
 // ______________________________________________________________________
 void Operation::checkTimeout() const {
   if (_timeoutTimer->wlock()->hasTimedOut()) {
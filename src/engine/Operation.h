@@ -133,6 +133,27 @@ class Operation {
   shared_ptr<const ResultTable> getResult(bool isRoot = false,
                                           bool onlyReadFromCache = false);
 
+  // Get the result for the subtree rooted at this element as a sequence of
+  // blocks that are computed on demand (see `LazyResultTable`). The result is
+  // only computed lazily if this operation `supportsLazyEvaluation()`, if it is
+  // not already contained in the cache, and if it doesn't have to be pinned or
+  // have a `LIMIT` applied. In all other cases, the result is obtained via
+  // `getResult(isRoot)` and yielded as a single block. Lazily computed results
+  // are never written to the cache. The runtime information of this operation
+  // is only complete after all the blocks have been consumed.
+  LazyResultTable getLazyResult(bool isRoot = false);
+
+  // Get the result for the subtree rooted at this element as a `ResultTable`
+  // that is exclusively owned by the caller, s.t. it can be modified in place
+  // (e.g. sorted). The result is obtained via `getResult(isRoot)`. It is only
+  // copied if it is also owned by someone else, e.g. by the cache or by another
+  // query that waited for the same result.
+  ResultTable getOwnedResult(bool isRoot = false);
+
+  // Return true iff this operation implements `computeResultLazily()` (see
+  // below).
+  [[nodiscard]] virtual bool supportsLazyEvaluation() const { return false; }
+
   // Use the same timeout timer for all children of an operation (= query plan
   // rooted at that operation). As soon as one child times out, the whole
   // operation times out.
@@ -227,6 +248,28 @@ class Operation {
   //! Compute the result of the query-subtree rooted at this element..
   virtual ResultTable computeResult() = 0;
 
+  // Compute the result of the query-subtree rooted at this element as a lazy
+  // sequence of blocks. Only called by `getLazyResult` if
+  // `supportsLazyEvaluation()` returns true, so operations that support lazy
+  // evaluation have to override both functions.
+  virtual LazyResultTable computeResultLazily() { AD_FAIL(); }
+
+  // Call `computeResult()`, check the result, update the runtime information
+  // and apply the LIMIT and OFFSET. The `timer` measures the total time of
+  // this operation.
+  ResultTable computeResultAndFinalize(const ad_utility::Timer& timer);
+
+  // Return `computation()`. If it throws, update the runtime information and
+  // rethrow the exception as an `AbortException`.
+  template <typename F>
+  std::invoke_result_t<F> computeAndHandleExceptions(
+      const ad_utility::Timer& timer, F computation);
+
+  // Wrap the `blocks` of a lazily computed result s.t. the runtime information
+  // of this operation is updated while the blocks are consumed.
+  LazyResultTable::Blocks updateRuntimeInformationWhileConsuming(
+      LazyResultTable::Blocks blocks);
+
   // Create and store the complete runtime information for this operation after
   // it has either been succesfully computed or read from the cache.
   virtual void updateRuntimeInformationOnSuccess(
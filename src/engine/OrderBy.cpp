@@ -9,11 +9,52 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/Comparators.h"
+#include "engine/ExternalSort.h"
 #include "engine/QueryExecutionTree.h"
+#include "index/IndexImpl.h"
 #include "global/ValueIdComparators.h"
 
 using std::string;
 
+namespace {
+// Return true iff `a` comes before `b` in the order of ORDER BY. The IDs of the
+// words that were introduced by updates are not ordered like their words, so
+// if the `orderOfUpdateWords` is not `nullptr`, `VocabIndex` IDs are compared
+// via their positions in the order of all the words.
+bool isLessThan(Id a, Id b, const OrderOfUpdateWords* orderOfUpdateWords) {
+  if (orderOfUpdateWords != nullptr &&
+      a.getDatatype() == Datatype::VocabIndex &&
+      b.getDatatype() == Datatype::VocabIndex) {
+    return orderOfUpdateWords->getPosition(a) <
+           orderOfUpdateWords->getPosition(b);
+  }
+  return toBoolNotUndef(
+      valueIdComparators::compareIds<
+          valueIdComparators::ComparisonForIncompatibleTypes::CompareByType>(
+          a, b, valueIdComparators::Comparison::LT));
+}
+
+// Return a function that returns true iff `rowA` comes before `rowB` in the
+// sort order specified by the `sortIndices` (see `isLessThan` above for the
+// `orderOfUpdateWords`).
+auto makeComparator(
+    OrderBy::SortIndices sortIndices,
+    std::shared_ptr<const OrderOfUpdateWords> orderOfUpdateWords) {
+  return [sortIndices = std::move(sortIndices),
+          order = std::move(orderOfUpdateWords)](const auto& row1,
+                                                 const auto& row2) -> bool {
+    for (auto& [column, isDescending] : sortIndices) {
+      if (row1[column] == row2[column]) {
+        continue;
+      }
+      return isLessThan(row1[column], row2[column], order.get()) !=
+             isDescending;
+    }
+    return false;
+  };
+}
+}  // namespace
+
 // _____________________________________________________________________________
 size_t OrderBy::getResultWidth() const { return subtree_->getResultWidth(); }
 
@@ -67,15 +108,23 @@ string OrderBy::getDescriptor() const {
 
 // _____________________________________________________________________________
 ResultTable OrderBy::computeResult() {
+  // Inputs that are too large to be sorted in RAM are sorted externally also
+  // when the result has to be materialized.
+  if (supportsLazyEvaluation()) {
+    return externalSort::materialize(computeResultLazily(), getResultWidth(),
+                                     getExecutionContext()->getAllocator());
+  }
   LOG(DEBUG) << "Getting sub-result for OrderBy result computation..." << endl;
-  shared_ptr<const ResultTable> subRes = subtree_->getResult();
+  // The result of the subtree is sorted in place, so we need our own copy
+  // (which is only made if the result is shared, e.g. via the cache).
+  ResultTable subRes = subtree_->getOwnedResult();
 
   // TODO<joka921> proper timeout for sorting operations
   auto remainingTime = _timeoutTimer->wlock()->remainingTime();
   auto sortEstimateCancellationFactor =
       RuntimeParameters().get<"sort-estimate-cancellation-factor">();
   if (getExecutionContext()->getSortPerformanceEstimator().estimatedSortTime(
-          subRes->size(), subRes->width()) >
+          subRes.size(), subRes.width()) >
       remainingTime * sortEstimateCancellationFactor) {
     // The estimated time for this sort is much larger than the actually
     // remaining time, cancel this operation
@@ -86,7 +135,8 @@ ResultTable OrderBy::computeResult() {
   }
 
   LOG(DEBUG) << "OrderBy result computation..." << endl;
-  IdTable idTable = subRes->idTable().clone();
+  auto localVocab = subRes.getSharedLocalVocab();
+  IdTable idTable = std::move(subRes).moveIdTable();
 
   size_t width = idTable.numColumns();
 
@@ -110,22 +160,7 @@ ResultTable OrderBy::computeResult() {
   // only contains a single datatype, then we can use more efficient
   // implementations here.
 
-  // Return true iff `rowA` comes before `rowB` in the sort order specified by
-  // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
-    for (auto& [column, isDescending] : sortIndices_) {
-      if (row1[column] == row2[column]) {
-        continue;
-      }
-      bool isLessThan =
-          toBoolNotUndef(valueIdComparators::compareIds<
-                         valueIdComparators::ComparisonForIncompatibleTypes::
-                             CompareByType>(
-              row1[column], row2[column], valueIdComparators::Comparison::LT));
-      return isLessThan != isDescending;
-    }
-    return false;
-  };
+  auto comparison = makeComparator(sortIndices_, getOrderOfUpdateWords());
 
   // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort` function
   // is templated not only on the integer `I` (which the `callFixedSize`
@@ -134,5 +169,39 @@ ResultTable OrderBy::computeResult() {
     Engine::sort<I>(&idTable, comparison);
   });
   LOG(DEBUG) << "OrderBy result computation done." << endl;
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const OrderOfUpdateWords> OrderBy::getOrderOfUpdateWords()
+    const {
+  auto order = getIndex().getImpl().getOrderOfUpdateWords();
+  if (order->numUpdateWords() == 0) {
+    return nullptr;
+  }
+  return order;
+}
+
+// _____________________________________________________________________________
+bool OrderBy::supportsLazyEvaluation() const {
+  return externalSort::shouldSortExternally(*subtree_);
+}
+
+// _____________________________________________________________________________
+LazyResultTable OrderBy::computeResultLazily() {
+  LOG(DEBUG) << "Getting lazy sub-result for external OrderBy..." << endl;
+  LazyResultTable subRes = subtree_->getLazyResult();
+  auto blocks = ad_utility::callFixedSize(
+      getResultWidth(), [&]<size_t I>() -> LazyResultTable::Blocks {
+        if constexpr (I == 0) {
+          AD_FAIL();
+        } else {
+          return externalSort::sortBlocks<I>(
+              std::move(subRes.blocks_),
+              makeComparator(sortIndices_, getOrderOfUpdateWords()),
+              getExecutionContext()->getAllocator(),
+              [this]() { checkTimeout(); });
+        }
+      });
+  return {std::move(blocks), resultSortedOn(), std::move(subRes.localVocab_)};
 }
@@ -9,6 +9,7 @@
 
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
+#include "index/OrderOfUpdateWords.h"
 
 // The implementation of the SPARQL `ORDER BY` operation.
 //
@@ -73,9 +74,19 @@ class OrderBy : public Operation {
     return {subtree_.get()};
   }
 
+  // The result is computed lazily using an external sort if the input is
+  // too large to be sorted in RAM (see `ExternalSort.h`).
+  bool supportsLazyEvaluation() const override;
+
  private:
   ResultTable computeResult() override;
 
+  LazyResultTable computeResultLazily() override;
+
+  // The order of the words that were introduced by updates, or `nullptr` if
+  // there are no such words (see `OrderOfUpdateWords`).
+  std::shared_ptr<const OrderOfUpdateWords> getOrderOfUpdateWords() const;
+
   VariableToColumnMap computeVariableToColumnMap() const override {
     return subtree_->getVariableColumns();
   }
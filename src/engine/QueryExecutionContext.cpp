@@ -0,0 +1,169 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/QueryExecutionContext.h"
+
+#include <filesystem>
+
+#include "engine/LocalVocab.h"
+#include "util/File.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+using ad_utility::serialization::FileReadSerializer;
+using ad_utility::serialization::FileWriteSerializer;
+
+// Write the `result` to the `serializer`: the dimensions and the columns of its
+// `IdTable` (via the bit representation of the IDs), the columns by which it is
+// sorted, and the words of its local vocabulary in the order of their indices.
+void writeResultTable(FileWriteSerializer& serializer,
+                      const ResultTable& result) {
+  const IdTable& idTable = result.idTable();
+  serializer << static_cast<uint64_t>(idTable.numColumns());
+  serializer << static_cast<uint64_t>(idTable.size());
+  for (size_t i = 0; i < idTable.numColumns(); ++i) {
+    auto column = idTable.getColumn(i);
+    serializer.serializeBytes(reinterpret_cast<const char*>(column.data()),
+                              column.size() * sizeof(Id));
+  }
+  std::vector<uint64_t> sortedBy(result.sortedBy().begin(),
+                                 result.sortedBy().end());
+  serializer << sortedBy;
+  const LocalVocab& localVocab = result.localVocab();
+  serializer << static_cast<uint64_t>(localVocab.size());
+  for (size_t i = 0; i < localVocab.size(); ++i) {
+    serializer << localVocab.getWord(LocalVocabIndex::make(i));
+  }
+}
+
+// Read a result that was written by `writeResultTable`.
+ResultTable readResultTable(
+    FileReadSerializer& serializer,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  uint64_t numColumns;
+  uint64_t numRows;
+  serializer >> numColumns;
+  serializer >> numRows;
+  IdTable idTable{numColumns, allocator};
+  idTable.resize(numRows);
+  for (size_t i = 0; i < numColumns; ++i) {
+    auto column = idTable.getColumn(i);
+    serializer.serializeBytes(reinterpret_cast<char*>(column.data()),
+                              column.size() * sizeof(Id));
+  }
+  std::vector<uint64_t> sortedByAsInts;
+  serializer >> sortedByAsInts;
+  std::vector<ColumnIndex> sortedBy(sortedByAsInts.begin(),
+                                    sortedByAsInts.end());
+  uint64_t localVocabSize;
+  serializer >> localVocabSize;
+  LocalVocab localVocab;
+  for (size_t i = 0; i < localVocabSize; ++i) {
+    std::string word;
+    serializer >> word;
+    localVocab.getIndexAndAddIfNotContained(std::move(word));
+  }
+  return {std::move(idTable), std::move(sortedBy), std::move(localVocab)};
+}
+
+// Write and read the parts of the `RuntimeInformation` of a cached result that
+// are reported when the result is later read from the cache. The runtime
+// information of the children is not stored.
+void writeRuntimeInfo(FileWriteSerializer& serializer,
+                      const RuntimeInformation& runtimeInfo) {
+  serializer << runtimeInfo.descriptor_;
+  serializer << runtimeInfo.columnNames_;
+  serializer << runtimeInfo.totalTime_;
+  serializer << static_cast<uint64_t>(runtimeInfo.numRows_);
+  serializer << static_cast<uint64_t>(runtimeInfo.numCols_);
+}
+
+RuntimeInformation readRuntimeInfo(FileReadSerializer& serializer) {
+  RuntimeInformation runtimeInfo;
+  uint64_t numRows;
+  uint64_t numCols;
+  serializer >> runtimeInfo.descriptor_;
+  serializer >> runtimeInfo.columnNames_;
+  serializer >> runtimeInfo.totalTime_;
+  serializer >> numRows;
+  serializer >> numCols;
+  runtimeInfo.numRows_ = numRows;
+  runtimeInfo.numCols_ = numCols;
+  runtimeInfo.status_ = RuntimeInformation::Status::fullyMaterialized;
+  return runtimeInfo;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+size_t QueryResultCache::writePinnedResultsToFile(
+    const std::string& filename, std::string_view indexFingerprint) const {
+  auto entries = getPinnedEntries();
+  std::vector<std::pair<std::string, uint64_t>> pinnedSizes;
+  for (const auto& [key, size] : *_pinnedSizes.rlock()) {
+    pinnedSizes.emplace_back(key, size);
+  }
+  // Write to a temporary file first, so that an interrupted write never
+  // leaves a corrupt file behind.
+  const std::string tmpFilename = filename + ".tmp";
+  {
+    FileWriteSerializer serializer{tmpFilename};
+    serializer << std::string{indexFingerprint};
+    serializer << static_cast<uint64_t>(entries.size());
+    for (const auto& [key, value] : entries) {
+      serializer << key;
+      writeResultTable(serializer, *value->resultTable());
+      writeRuntimeInfo(serializer, value->runtimeInfo());
+    }
+    serializer << static_cast<uint64_t>(pinnedSizes.size());
+    for (const auto& [key, size] : pinnedSizes) {
+      serializer << key;
+      serializer << size;
+    }
+  }
+  std::filesystem::rename(tmpFilename, filename);
+  return entries.size();
+}
+
+// _____________________________________________________________________________
+size_t QueryResultCache::readPinnedResultsFromFile(
+    const std::string& filename, std::string_view indexFingerprint,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  if (!ad_utility::File::exists(filename)) {
+    return 0;
+  }
+  FileReadSerializer serializer{filename};
+  std::string fingerprintInFile;
+  serializer >> fingerprintInFile;
+  if (fingerprintInFile != indexFingerprint) {
+    return 0;
+  }
+  uint64_t numEntries;
+  serializer >> numEntries;
+  size_t numInserted = 0;
+  for (size_t i = 0; i < numEntries; ++i) {
+    std::string key;
+    serializer >> key;
+    auto resultTable = readResultTable(serializer, allocator);
+    auto runtimeInfo = readRuntimeInfo(serializer);
+    auto value = std::make_shared<CacheValue>(std::move(resultTable),
+                                              std::move(runtimeInfo));
+    try {
+      numInserted += insertPinnedIfNotContained(key, std::move(value));
+    } catch (const std::runtime_error&) {
+      // The result is too large for the (possibly reconfigured) cache.
+    }
+  }
+  uint64_t numPinnedSizes;
+  serializer >> numPinnedSizes;
+  auto lock = _pinnedSizes.wlock();
+  for (size_t i = 0; i < numPinnedSizes; ++i) {
+    std::string key;
+    uint64_t size;
+    serializer >> key;
+    serializer >> size;
+    lock->try_emplace(std::move(key), size);
+  }
+  return numInserted;
+}
@@ -33,9 +33,10 @@ class CacheValue {
   RuntimeInformation _runtimeInfo;
 
  public:
+  // The `ResultTable` is deliberately not created as a const object, see
+  // `Operation::getOwnedResult`.
   explicit CacheValue(ResultTable resultTable, RuntimeInformation runtimeInfo)
-      : _resultTable(
-            std::make_shared<const ResultTable>(std::move(resultTable))),
+      : _resultTable(std::make_shared<ResultTable>(std::move(resultTable))),
         _runtimeInfo(std::move(runtimeInfo)) {}
 
   const shared_ptr<const ResultTable>& resultTable() const {
@@ -82,6 +83,22 @@ class QueryResultCache : public ConcurrentLruCache {
       return std::nullopt;
     }
   }
+
+  // Write all pinned results (including their local vocabularies) and the
+  // `pinnedSizes()` to the given file. The `indexFingerprint` has to identify
+  // the state of the index the results were computed on, see
+  // `readPinnedResultsFromFile`. Return the number of written results.
+  size_t writePinnedResultsToFile(const std::string& filename,
+                                  std::string_view indexFingerprint) const;
+
+  // Read the results that were written by `writePinnedResultsToFile` and add
+  // them as pinned results, unless a result for the same key is already
+  // contained in (or currently being computed for) the cache. If the file was
+  // written for a different `indexFingerprint`, nothing is read. Return the
+  // number of results that were added.
+  size_t readPinnedResultsFromFile(
+      const std::string& filename, std::string_view indexFingerprint,
+      const ad_utility::AllocatorWithLimit<Id>& allocator);
 };
 
 // Execution context for queries.
@@ -97,6 +114,7 @@ class QueryExecutionContext {
         _pinResult(pinResult),
         _index(index),
         _subtreeCache(cache),
+        _cacheGeneration(cache->generation()),
         _allocator(std::move(allocator)),
         _costFactors(),
         _sortPerformanceEstimator(sortPerformanceEstimator) {}
@@ -107,6 +125,13 @@ class QueryExecutionContext {
 
   void clearCacheUnpinnedOnly() { getQueryTreeCache().clearUnpinnedOnly(); }
 
+  // The generation of the cache when this context was created (see
+  // `ConcurrentCache::generation`). Results of this context are only added to
+  // the cache if the cache still has this generation, so a query that runs
+  // while the index is updated does not add results to the cache that were
+  // computed (partly) from the state before the update.
+  size_t getCacheGeneration() const { return _cacheGeneration; }
+
   [[nodiscard]] const SortPerformanceEstimator& getSortPerformanceEstimator()
       const {
     return _sortPerformanceEstimator;
@@ -128,6 +153,7 @@ class QueryExecutionContext {
  private:
   const Index& _index;
   QueryResultCache* const _subtreeCache;
+  size_t _cacheGeneration;
   // allocators are copied but hold shared state
   ad_utility::AllocatorWithLimit<Id> _allocator;
   QueryPlanningCostFactors _costFactors;
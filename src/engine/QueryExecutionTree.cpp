@@ -174,6 +174,18 @@ void QueryExecutionTree::readFromCache() {
   }
 }
 
+// _____________________________________________________________________________
+void QueryExecutionTree::resetCachedStateRecursively() {
+  _asString = "";
+  _sizeEstimate = std::numeric_limits<size_t>::max();
+  _cachedResult = nullptr;
+  for (QueryExecutionTree* child : _rootOperation->getChildren()) {
+    if (child) {
+      child->resetCachedStateRecursively();
+    }
+  }
+}
+
 bool QueryExecutionTree::isIndexScan() const { return _type == SCAN; }
 
 template <typename Op>
@@ -102,6 +102,18 @@ class QueryExecutionTree {
     return _rootOperation->getResult(isRoot());
   }
 
+  // Get the result s.t. it can be modified in place. For details see
+  // `Operation::getOwnedResult`.
+  ResultTable getOwnedResult() const {
+    return _rootOperation->getOwnedResult(isRoot());
+  }
+
+  // Get the result as a lazy sequence of blocks. For details see
+  // `Operation::getLazyResult`.
+  LazyResultTable getLazyResult() const {
+    return _rootOperation->getLazyResult(isRoot());
+  }
+
   // A variable, its column index in the Id space result, and the `ResultType`
   // of this column.
   struct VariableAndColumnIndex {
@@ -186,6 +198,13 @@ class QueryExecutionTree {
     }
   }
 
+  // Reset the cached string representation and size estimate, and release
+  // the result that was read from the cache when the tree was created, for
+  // this tree and all its descendants. This is needed when a tree is kept for
+  // later queries, and when its operations are modified after the planning
+  // (see `QueryPlanCache`).
+  void resetCachedStateRecursively();
+
   bool& isRoot() noexcept { return _isRoot; }
   [[nodiscard]] const bool& isRoot() const noexcept { return _isRoot; }
 
@@ -0,0 +1,153 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/QueryPlanCache.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+// Return the position after the end of the literal that starts at
+// `query[start]`, which is a single or a double quote. Literals with three
+// quotes (which may contain line breaks and single quotes) are supported.
+size_t findEndOfLiteral(std::string_view query, size_t start) {
+  const char quote = query[start];
+  const std::string longQuote(3, quote);
+  const bool isLong = query.substr(start, 3) == longQuote;
+  size_t i = start + (isLong ? 3 : 1);
+  while (i < query.size()) {
+    if (query[i] == '\\') {
+      i += 2;
+    } else if (isLong ? query.substr(i, 3) == longQuote : query[i] == quote) {
+      return i + (isLong ? 3 : 1);
+    } else {
+      ++i;
+    }
+  }
+  return query.size();
+}
+
+// Return the position after the end of the IRI that starts at `query[start]`
+// (which is a `<`), or `start + 1` if it is not an IRI but the less-than
+// operator.
+size_t findEndOfIri(std::string_view query, size_t start) {
+  size_t end = query.find_first_of(">< \t\r\n\"{}|^`\\", start + 1);
+  if (end != std::string_view::npos && query[end] == '>') {
+    return end + 1;
+  }
+  return start + 1;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void QueryPlanCache::setMaxNumPlans(size_t maxNumPlans) {
+  maxNumPlans_ = maxNumPlans;
+  auto plans = plans_.wlock();
+  while (plans->size() > maxNumPlans) {
+    plans->pop_back();
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<PlannedQuery> QueryPlanCache::take(const std::string& key) {
+  auto plans = plans_.wlock();
+  while (true) {
+    auto it = std::ranges::find(*plans, key, &Plans::value_type::first);
+    if (it == plans->end()) {
+      return std::nullopt;
+    }
+    PlannedQuery plan = std::move(it->second);
+    plans->erase(it);
+    if (plan.version_ == version_) {
+      return plan;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::put(std::string key, PlannedQuery plan) {
+  if (maxNumPlans_ == 0) {
+    return;
+  }
+  // Don't keep the results that were read from the cache during the planning
+  // alive.
+  plan.tree_.value().resetCachedStateRecursively();
+  auto plans = plans_.wlock();
+  if (plan.version_ != version_) {
+    return;
+  }
+  plans->emplace_front(std::move(key), std::move(plan));
+  if (plans->size() > maxNumPlans_) {
+    plans->pop_back();
+  }
+}
+
+// _____________________________________________________________________________
+std::string QueryPlanCache::normalizeQuery(std::string_view query) {
+  std::string result;
+  result.reserve(query.size());
+  bool hasPendingWhitespace = false;
+  bool lastTokenWasComment = false;
+  size_t i = 0;
+  while (i < query.size()) {
+    const char c = query[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      hasPendingWhitespace = true;
+      ++i;
+      continue;
+    }
+    if (hasPendingWhitespace && !result.empty()) {
+      // A comment ends at the end of the line.
+      result.push_back(lastTokenWasComment ? '\n' : ' ');
+    }
+    hasPendingWhitespace = false;
+    size_t end = i + 1;
+    if (c == '#') {
+      end = std::min(query.find('\n', i), query.size());
+    } else if (c == '<') {
+      end = findEndOfIri(query, i);
+    } else if (c == '"' || c == '\'') {
+      end = findEndOfLiteral(query, i);
+    }
+    lastTokenWasComment = c == '#';
+    result.append(query.substr(i, end - i));
+    i = end;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::addParameters(ParsedQuery& parsedQuery,
+                                   const SparqlValues& parameters) {
+  AD_CONTRACT_CHECK(parameters._values.size() == 1);
+  auto& graphPatterns = parsedQuery._rootGraphPattern._graphPatterns;
+  graphPatterns.insert(graphPatterns.begin(), parsedQuery::Values{parameters});
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<Values> QueryPlanCache::findParameters(
+    const QueryExecutionTree& tree, const SparqlValues& parameters) {
+  std::vector<std::shared_ptr<Values>> candidates;
+  auto addIfCandidate = [&candidates,
+                         &parameters](const QueryExecutionTree* subtree) {
+    auto values =
+        std::dynamic_pointer_cast<Values>(subtree->getRootOperation());
+    if (values && values->getValues()._variables == parameters._variables &&
+        values->getValues()._values == parameters._values) {
+      candidates.push_back(std::move(values));
+    }
+  };
+  addIfCandidate(&tree);
+  tree.forAllDescendants(addIfCandidate);
+  return candidates.size() == 1 ? candidates[0] : nullptr;
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::bindParameters(PlannedQuery& plan,
+                                    SparqlValues parameters) {
+  AD_CONTRACT_CHECK(plan.parameters_ != nullptr);
+  plan.parameters_->replaceValues(std::move(parameters));
+  // The string representations are the keys of the query result cache, so
+  // they have to be computed again for the new values.
+  plan.tree_.value().resetCachedStateRecursively();
+}
@@ -0,0 +1,111 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/Values.h"
+#include "parser/ParsedQuery.h"
+#include "util/Synchronized.h"
+
+// A query that has been parsed and planned, and that can be executed
+// repeatedly, but only by one query at a time. The operations of the `tree_`
+// refer to the `qec_`, which is therefore owned by the plan.
+struct PlannedQuery {
+  std::unique_ptr<QueryExecutionContext> qec_;
+  ParsedQuery parsedQuery_;
+  std::optional<QueryExecutionTree> tree_;
+  // The operation that binds the parameters of a prepared query (see
+  // `QueryPlanCache::addParameters`), nullptr if the query has no parameters.
+  std::shared_ptr<Values> parameters_;
+  // The `QueryPlanCache::version()` at the time the query was planned.
+  uint64_t version_ = 0;
+};
+
+// A cache for the plans of queries that are sent repeatedly, so that they are
+// parsed and planned only once. The key is the normalized query text (see
+// `normalizeQuery`) together with everything else that affects the plan.
+//
+// A prepared query is a query with parameters: variables that are bound to a
+// single value each when the query is processed. The parameters are added to
+// the query as a `VALUES` clause, so all queries with the same text and the
+// same parameter variables share their plan. When a plan is reused, only the
+// values of this clause are replaced.
+//
+// A plan is taken out of the cache while it is executed and then put back, so
+// several concurrent executions of the same query each get their own plan.
+// The plans refer to the index, so the cache has to be cleared after updates.
+// Each call to `clear` increments the `version()` of the cache, and plans that
+// were created for an older version (e.g. a plan that was executed while the
+// cache was cleared) are never put back or taken out again.
+class QueryPlanCache {
+ public:
+  using SparqlValues = parsedQuery::SparqlValues;
+
+ private:
+  // The plans that are currently not executed, the most recently used first.
+  // There can be several plans for the same key.
+  using Plans = std::list<std::pair<std::string, PlannedQuery>>;
+  ad_utility::Synchronized<Plans> plans_;
+  std::atomic<size_t> maxNumPlans_;
+  // Only changed while `plans_` is locked.
+  std::atomic<uint64_t> version_ = 0;
+
+ public:
+  explicit QueryPlanCache(size_t maxNumPlans = 100)
+      : maxNumPlans_{maxNumPlans} {}
+
+  // Set the maximal number of plans. Zero disables the cache.
+  void setMaxNumPlans(size_t maxNumPlans);
+
+  // The version of the cache, new plans have to be tagged with it (see
+  // `PlannedQuery::version_`).
+  uint64_t version() const { return version_; }
+
+  // Take a plan for the `key` out of the cache, or return `std::nullopt` if
+  // there is none. Plans for older versions are dropped.
+  std::optional<PlannedQuery> take(const std::string& key);
+
+  // Add the `plan` for the `key` (e.g. after it has been executed). If the
+  // cache is full, the least recently used plan is dropped. A plan for an
+  // older version is not added.
+  void put(std::string key, PlannedQuery plan);
+
+  size_t numPlans() const { return plans_.rlock()->size(); }
+
+  // Remove all plans and increment the `version()`.
+  void clear() {
+    auto plans = plans_.wlock();
+    plans->clear();
+    ++version_;
+  }
+
+  // Collapse each sequence of whitespace outside of IRIs, literals, and
+  // comments into a single space (or a newline after a comment), and remove
+  // leading and trailing whitespace.
+  static std::string normalizeQuery(std::string_view query);
+
+  // Add the `parameters` (with a single row) as a `VALUES` clause at the
+  // beginning of the root graph pattern of the `parsedQuery`, so that the
+  // parameter variables behave as if they were replaced by their values.
+  static void addParameters(ParsedQuery& parsedQuery,
+                            const SparqlValues& parameters);
+
+  // Return the operation in the planned `tree` that was created for the
+  // `parameters` by `addParameters`. Return nullptr if there is not exactly
+  // one such operation, then the plan cannot be reused for other values.
+  static std::shared_ptr<Values> findParameters(
+      const QueryExecutionTree& tree, const SparqlValues& parameters);
+
+  // Replace the values of the parameters of the cached `plan`.
+  static void bindParameters(PlannedQuery& plan, SparqlValues parameters);
+};
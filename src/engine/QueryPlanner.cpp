@@ -26,6 +26,7 @@
 #include <engine/TransitivePath.h>
 #include <engine/Union.h>
 #include <engine/Values.h>
+#include <index/IndexImpl.h>
 #include <parser/Alias.h>
 #include <parser/SparqlParserHelpers.h>
 
@@ -76,8 +77,9 @@ std::vector<QueryPlanner::SubtreePlan> QueryPlanner::createExecutionTrees(
   // triple will be handled using a `HasPredicateScan`.
   using checkUsePatternTrick::PatternTrickTuple;
   const auto patternTrickTuple =
-      _enablePatternTrick ? checkUsePatternTrick::checkUsePatternTrick(&pq)
-                          : std::nullopt;
+      _enablePatternTrick && !hasOutdatedPatterns()
+          ? checkUsePatternTrick::checkUsePatternTrick(&pq)
+          : std::nullopt;
 
   // Do GROUP BY if one of the following applies:
   // 1. There is an explicit group by
@@ -412,7 +414,7 @@ std::vector<QueryPlanner::SubtreePlan> QueryPlanner::optimize(
             leftVar = false;
             leftColName = generateUniqueVarName();
             leftCol = sub._qet->getVariableColumn(arg._innerLeft.getVariable());
-            if (auto opt = arg._left.toValueId(_qec->getIndex().getVocab());
+            if (auto opt = _qec->getIndex().getImpl().getId(arg._left);
                 opt.has_value()) {
               leftValue = opt.value();
             } else {
@@ -430,7 +432,7 @@ std::vector<QueryPlanner::SubtreePlan> QueryPlanner::optimize(
             rightCol =
                 sub._qet->getVariableColumn(arg._innerRight.getVariable());
             rightColName = generateUniqueVarName();
-            if (auto opt = arg._right.toValueId(_qec->getIndex().getVocab());
+            if (auto opt = _qec->getIndex().getImpl().getId(arg._right);
                 opt.has_value()) {
               rightValue = opt.value();
             } else {
@@ -615,6 +617,17 @@ vector<QueryPlanner::SubtreePlan> QueryPlanner::getGroupByRow(
       aliases = pq.selectClause().getAliases();
     }
 
+    // If possible, also add a hash-based GROUP BY, which doesn't need a sorted
+    // input. The cheaper of the two plans is chosen later.
+    if (GroupBy::supportsHashBasedAlgorithm(pq._groupByVariables, aliases,
+                                            *parent._qet)) {
+      SubtreePlan hashGroupByPlan = groupByPlan;
+      hashGroupByPlan._qet = makeExecutionTree<GroupBy>(
+          _qec, pq._groupByVariables, aliases, parent._qet,
+          GroupBy::Algorithm::HashBased);
+      added.push_back(std::move(hashGroupByPlan));
+    }
+
     // The GroupBy constructor automatically takes care of sorting the input if
     // necessary.
     groupByPlan._qet = makeExecutionTree<GroupBy>(
@@ -751,7 +764,9 @@ vector<QueryPlanner::SubtreePlan> QueryPlanner::seedWithScansAndText(
     }
 
     if (node._triple._p._iri == HAS_PREDICATE_PREDICATE) {
-      pushPlan(makeSubtreePlan<HasPredicateScan>(_qec, node._triple));
+      pushPlan(hasOutdatedPatterns()
+                   ? getHasPredicatePlanWithoutPatterns(node._triple)
+                   : makeSubtreePlan<HasPredicateScan>(_qec, node._triple));
       continue;
     }
 
@@ -822,6 +837,64 @@ vector<QueryPlanner::SubtreePlan> QueryPlanner::seedWithScansAndText(
   return seeds;
 }
 
+// _____________________________________________________________________________
+bool QueryPlanner::hasOutdatedPatterns() const {
+  return _qec && _qec->getIndex().getImpl().hasOutdatedPatterns();
+}
+
+// _____________________________________________________________________________
+QueryPlanner::SubtreePlan QueryPlanner::getHasPredicatePlanWithoutPatterns(
+    const SparqlTriple& triple) {
+  // `?s ql:has-predicate ?p` is evaluated as `SELECT DISTINCT ?s ?p { ?s ?p
+  // ?o }`, and analogously if the subject or the predicate is fixed.
+  const bool subjectIsVariable = triple._s.isVariable();
+  const bool predicateIsVariable = triple._o.isVariable();
+  if (subjectIsVariable && predicateIsVariable && _qec &&
+      !_qec->getIndex().hasAllPermutations()) {
+    AD_THROW(
+        "After updates, `ql:has-predicate` with two variables requires all "
+        "permutations. Rerun the server without the option "
+        "--only-pso-and-pos-permutations.");
+  }
+  SparqlTriple scanTriple{
+      triple._s,
+      predicateIsVariable ? PropertyPath::fromVariable(triple._o.getVariable())
+                          : PropertyPath::fromIri(triple._o.toString()),
+      generateUniqueVarName()};
+  auto scan = makeExecutionTree<IndexScan>(
+      _qec, predicateIsVariable ? Permutation::SPO : Permutation::PSO,
+      scanTriple);
+  std::vector<Variable> variables;
+  std::vector<ColumnIndex> keepIndices;
+  for (const auto& component : {triple._s, triple._o}) {
+    if (component.isVariable()) {
+      variables.push_back(component.getVariable());
+      keepIndices.push_back(scan->getVariableColumn(variables.back()));
+    }
+  }
+  // The scan is sorted by the `keepIndices`, so `Distinct` can be applied
+  // directly.
+  auto tree = makeExecutionTree<Distinct>(_qec, std::move(scan), keepIndices);
+  // Like the patterns, ignore the triples with internal predicates (the
+  // language-tagged predicates `@lang@<p>` and `ql:langtag`, see
+  // `IndexImpl::createFromFiles`).
+  if (predicateIsVariable) {
+    std::string filterString = absl::StrCat(
+        "FILTER (!REGEX(", triple._o.getVariable().name(), ", \"^(@|<?",
+        std::string_view{INTERNAL_ENTITIES_URI_PREFIX}.substr(1), ")\"))");
+    auto filter = sparqlParserHelpers::ParserAndVisitor{filterString}
+                      .parseTypesafe(&SparqlAutomaticParser::filterR)
+                      .resultOfParse_;
+    tree = makeExecutionTree<Filter>(_qec, std::move(tree),
+                                     std::move(filter.expression_));
+  }
+  // The column of the object of the scan is not visible.
+  tree->getRootOperation()->setSelectedVariablesForSubquery(variables);
+  SubtreePlan plan{_qec};
+  plan._qet = std::move(tree);
+  return plan;
+}
+
 // _____________________________________________________________________________
 vector<QueryPlanner::SubtreePlan> QueryPlanner::seedFromPropertyPathTriple(
     const SparqlTriple& triple) {
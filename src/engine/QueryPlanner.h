@@ -252,6 +252,19 @@ class QueryPlanner {
                                           const vector<SubtreePlan>& b,
                                           const TripleGraph& tg) const;
 
+
+  // Return true iff triples were inserted into or deleted from the index after
+  // it was built. The patterns that are used for `ql:has-predicate` (by the
+  // `HasPredicateScan` and the pattern trick) are computed during the index
+  // build and don't reflect these changes (see
+  // `IndexImpl::hasOutdatedPatterns`).
+  [[nodiscard]] bool hasOutdatedPatterns() const;
+
+  // Return a plan for a triple with the predicate `ql:has-predicate` that
+  // doesn't use the patterns, but a scan of the permutations (see above).
+  [[nodiscard]] SubtreePlan getHasPredicatePlanWithoutPatterns(
+      const SparqlTriple& triple);
+
   [[nodiscard]] std::vector<QueryPlanner::SubtreePlan> createJoinCandidates(
       const SubtreePlan& a, const SubtreePlan& b,
       std::optional<TripleGraph> tg) const;
@@ -120,3 +120,56 @@ bool ResultTable::checkDefinedness(const VariableToColumnMap& varColMap) {
            !hasUndefined;
   });
 }
+
+// _____________________________________________________________________________
+namespace {
+// Yield the `IdTable` of the `result` as a single block. The `result` is passed
+// by `shared_ptr`, so it stays alive as long as the generator.
+LazyResultTable::Blocks yieldAsSingleBlock(
+    std::shared_ptr<const ResultTable> result) {
+  co_yield result->idTable();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+LazyResultTable LazyResultTable::fromMaterialized(
+    std::shared_ptr<const ResultTable> result) {
+  AD_CONTRACT_CHECK(result != nullptr);
+  // Use the aliasing constructor of `shared_ptr`, s.t. the local vocab keeps
+  // the complete `result` alive.
+  std::shared_ptr<const LocalVocab> localVocab{result, &result->localVocab()};
+  auto sortedBy = result->sortedBy();
+  return {yieldAsSingleBlock(std::move(result)), std::move(sortedBy),
+          std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+IdTable LazyResultTable::materialize(
+    const ad_utility::AllocatorWithLimit<Id>& allocator) && {
+  std::optional<IdTable> result;
+  for (const IdTable& block : blocks_) {
+    if (!result.has_value()) {
+      result.emplace(block.numColumns(), allocator);
+    }
+    result->insertAtEnd(block);
+  }
+  return result.has_value() ? std::move(result.value()) : IdTable{allocator};
+}
+
+// _____________________________________________________________________________
+void LazyResultTable::remapLocalVocabIndices(IdTable& block,
+                                             const LocalVocab& sourceVocab,
+                                             LocalVocab& targetVocab) {
+  if (sourceVocab.empty() || &sourceVocab == &targetVocab) {
+    return;
+  }
+  for (auto column : block.getColumns()) {
+    for (Id& id : column) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex) {
+        id = Id::makeFromLocalVocabIndex(
+            targetVocab.getIndexAndAddIfNotContained(
+                sourceVocab.getWord(id.getLocalVocabIndex())));
+      }
+    }
+  }
+}
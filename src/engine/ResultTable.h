@@ -13,6 +13,7 @@
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
 #include "parser/data/LimitOffsetClause.h"
+#include "util/Generator.h"
 #include "util/Log.h"
 
 using std::vector;
@@ -110,6 +111,10 @@ class ResultTable {
   // Const access to the underlying `IdTable`.
   const IdTable& idTable() const { return _idTable; }
 
+  // Move the underlying `IdTable` out of this result. This can be used if the
+  // result is exclusively owned (see `Operation::getOwnedResult`).
+  IdTable moveIdTable() && { return std::move(_idTable); }
+
   // Const access to the columns by which the `idTable()` is sorted.
   const std::vector<ColumnIndex>& sortedBy() const { return _sortedBy; }
 
@@ -176,3 +181,45 @@ class ResultTable {
   // check is succesful.
   bool checkDefinedness(const VariableToColumnMap& varColMap);
 };
+
+// The result of an `Operation` that is computed lazily (see
+// `Operation::getLazyResult`). Instead of a single `IdTable`, the rows of the
+// result are yielded as a sequence of `IdTable` blocks which are only computed
+// when the consumer asks for them. That way, a pipeline of operations that
+// support lazy evaluation (e.g. `Filter` over `IndexScan`) never holds more
+// than a few blocks in memory at the same time.
+struct LazyResultTable {
+  using Blocks = cppcoro::generator<const IdTable&>;
+
+  // The blocks of the result. All blocks have the same number of columns.
+  // A yielded block is only valid until the generator is advanced.
+  Blocks blocks_;
+
+  // The column indices by which the concatenation of all the `blocks_` is
+  // sorted (primary sort key first).
+  std::vector<ColumnIndex> sortedBy_;
+
+  // The local vocabulary of the result. The producer of the `blocks_` might
+  // still add words while it is running, but it is guaranteed that all the
+  // `LocalVocabIndex` IDs of a block are contained in the `localVocab_` as soon
+  // as the block is yielded.
+  std::shared_ptr<const LocalVocab> localVocab_ =
+      std::make_shared<const LocalVocab>();
+
+  // Create a `LazyResultTable` that yields the complete `IdTable` of the
+  // (already materialized) `result` as a single block.
+  static LazyResultTable fromMaterialized(
+      std::shared_ptr<const ResultTable> result);
+
+  // Consume all the `blocks_` and concatenate them to a single `IdTable`.
+  IdTable materialize(const ad_utility::AllocatorWithLimit<Id>& allocator) &&;
+
+  // Rewrite all the `LocalVocabIndex` IDs in the `block`, which refer to the
+  // `sourceVocab`, s.t. they refer to the same words in the `targetVocab`.
+  // Words that are not yet contained in the `targetVocab` are added. This is
+  // used by lazy operations that combine blocks with different (and possibly
+  // still growing) local vocabularies into a single result.
+  static void remapLocalVocabIndices(IdTable& block,
+                                     const LocalVocab& sourceVocab,
+                                     LocalVocab& targetVocab);
+};
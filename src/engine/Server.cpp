@@ -11,8 +11,14 @@
 #include <string>
 #include <vector>
 
+#include "CompilationInfo.h"
+#include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/QueryPlanner.h"
+#include "index/CompressedRelation.h"
+#include "index/IndexImpl.h"
+#include "index/VocabularyCache.h"
+#include "parser/TurtleParser.h"
 #include "util/BoostHelpers/AsyncWaitForFuture.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 
@@ -56,15 +62,33 @@ Server::Server(unsigned short port, int numThreads, size_t maxMemGB,
       [this, toNumIds](size_t newValue) {
         cache_.setMaxSizeSingleEntry(toNumIds(newValue));
       });
+  RuntimeParameters().setOnUpdateAction<"plan-cache-max-num-entries">(
+      [this](size_t newValue) { planCache_.setMaxNumPlans(newValue); });
+  RuntimeParameters().setOnUpdateAction<"block-cache-max-size-mb">(
+      [](size_t newValue) {
+        DecompressedBlockCache::shared().setMaxSizeInBytes(newValue *
+                                                           1'000'000);
+      });
+  RuntimeParameters().setOnUpdateAction<"vocabulary-cache-max-size-mb">(
+      [](size_t newValue) {
+        VocabularyCache::shared().setMaxSizeInBytes(newValue * 1'000'000);
+      });
 }
 
 // __________________________________________________________________________
 void Server::initialize(const string& indexBaseName, bool useText,
-                        bool usePatterns, bool loadAllPermutations) {
+                        bool usePatterns, bool loadAllPermutations,
+                        bool memoryMapPermutations,
+                        std::vector<Permutation::Enum>
+                            memoryResidentPermutations,
+                        bool useHugePages, bool lockPermutationsInMemory) {
   LOG(INFO) << "Initializing server ..." << std::endl;
 
   index_.setUsePatterns(usePatterns);
   index_.setLoadAllPermutations(loadAllPermutations);
+  index_.setMemoryMapPermutations(memoryMapPermutations);
+  index_.setMemoryResidentPermutations(std::move(memoryResidentPermutations),
+                                       useHugePages, lockPermutationsInMemory);
 
   // Init the index.
   index_.createFromOnDiskIndex(indexBaseName);
@@ -72,9 +96,65 @@ void Server::initialize(const string& indexBaseName, bool useText,
     index_.addTextFromOnDiskIndex();
   }
 
-  sortPerformanceEstimator_.computeEstimatesExpensively(
-      allocator_, index_.numTriples().normalAndInternal_() *
-                      PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
+  // Measuring the sort performance is the most expensive part of the startup
+  // that doesn't depend on the size of the index files, so the estimates are
+  // reused from previous starts of a server for the same index (like the
+  // metadata of the blocks of the permutations and the patterns, see
+  // `StartupSnapshot`).
+  const size_t maxNumElementsToSort =
+      index_.numTriples().normalAndInternal_() *
+      PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100;
+  const std::string sortEstimatesFilename =
+      indexBaseName + SORT_ESTIMATES_SUFFIX;
+  // A corrupt file (e.g. because a previous server was killed while writing
+  // it) must not prevent the server from starting, the estimates are then
+  // simply measured and written again.
+  const bool estimatesWereRead = [&]() {
+    try {
+      return sortPerformanceEstimator_.readFromFile(sortEstimatesFilename,
+                                                    maxNumElementsToSort);
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not read the sort estimates from "
+                << sortEstimatesFilename << ", they are measured again: "
+                << e.what() << std::endl;
+      return false;
+    }
+  }();
+  if (estimatesWereRead) {
+    LOG(INFO) << "Read the estimates of the sorting performance from "
+              << sortEstimatesFilename << " (delete this file to measure them "
+              << "again)" << std::endl;
+  } else {
+    sortPerformanceEstimator_.computeEstimatesExpensively(allocator_,
+                                                          maxNumElementsToSort);
+    try {
+      sortPerformanceEstimator_.writeToFile(sortEstimatesFilename,
+                                            maxNumElementsToSort);
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not write the sort estimates to "
+                << sortEstimatesFilename << ": " << e.what() << std::endl;
+    }
+  }
+
+  // Restore the pinned results that were saved for the same state of the
+  // index. Reading large results takes a while, so this happens in the
+  // background. Queries that ask for a result before it is restored simply
+  // compute it again. Updates have to wait, because they clear the cache.
+  pinnedResultsFilename_ = indexBaseName + PINNED_RESULTS_SUFFIX;
+  pinnedResultsLoader_ = ad_utility::JThread{[this] {
+    try {
+      std::lock_guard lock{updateMutex_};
+      size_t numRestored = cache_.readPinnedResultsFromFile(
+          pinnedResultsFilename_, getIndexFingerprint(), allocator_);
+      if (numRestored > 0) {
+        LOG(INFO) << "Restored " << numRestored << " pinned results from "
+                  << pinnedResultsFilename_ << std::endl;
+      }
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not restore the pinned results from "
+                << pinnedResultsFilename_ << ": " << e.what() << std::endl;
+    }
+  }};
 
   LOG(INFO) << "Access token for restricted API calls is \"" << accessToken_
             << "\"" << std::endl;
@@ -84,7 +164,9 @@ void Server::initialize(const string& indexBaseName, bool useText,
 
 // _____________________________________________________________________________
 void Server::run(const string& indexBaseName, bool useText, bool usePatterns,
-                 bool loadAllPermutations) {
+                 bool loadAllPermutations, bool memoryMapPermutations,
+                 std::vector<Permutation::Enum> memoryResidentPermutations,
+                 bool useHugePages, bool lockPermutationsInMemory) {
   using namespace ad_utility::httpUtils;
 
   // Function that handles a request asynchronously, will be passed as argument
@@ -140,7 +222,9 @@ void Server::run(const string& indexBaseName, bool useText, bool usePatterns,
       HttpServer{port_, "0.0.0.0", numThreads_, std::move(httpSessionHandler)};
 
   // Initialize the index
-  initialize(indexBaseName, useText, usePatterns, loadAllPermutations);
+  initialize(indexBaseName, useText, usePatterns, loadAllPermutations,
+             memoryMapPermutations, std::move(memoryResidentPermutations),
+             useHugePages, lockPermutationsInMemory);
 
   // Start listening for connections on the server.
   httpServer.run();
@@ -157,12 +241,13 @@ ad_utility::UrlParser::UrlPathAndParameters Server::getUrlPathAndParameters(
   }
   if (request.method() == http::verb::post) {
     // For a POST request, the content type *must* be either
-    // "application/x-www-form-urlencoded" or "application/sparql-query". In
-    // the first case, the body of the POST request contains a URL-encoded
-    // query (just like in the part of a GET request after the "?"). In the
-    // second case, the body of the POST request contains *only* the SPARQL
-    // query, but not URL-encoded, and no other URL parameters. See Sections
-    // 2.1.2 and 2.1.3 of the SPARQL 1.1 standard:
+    // "application/x-www-form-urlencoded", "application/sparql-query", or
+    // "application/sparql-update". In the first case, the body of the POST
+    // request contains a URL-encoded query (just like in the part of a GET
+    // request after the "?"). In the other cases, the body of the POST request
+    // contains *only* the SPARQL query or update, but not URL-encoded, and no
+    // other URL parameters. See Sections 2.1.2, 2.1.3, and 2.2.2 of the SPARQL
+    // 1.1 standard:
     // https://www.w3.org/TR/2013/REC-sparql11-protocol-20130321
     std::string_view contentType = request.base()[http::field::content_type];
     LOG(DEBUG) << "Content-type: \"" << contentType << "\"" << std::endl;
@@ -170,6 +255,8 @@ ad_utility::UrlParser::UrlPathAndParameters Server::getUrlPathAndParameters(
         "application/x-www-form-urlencoded";
     static constexpr std::string_view contentTypeSparqlQuery =
         "application/sparql-query";
+    static constexpr std::string_view contentTypeSparqlUpdate =
+        "application/sparql-update";
 
     // In either of the two cases explained above, we convert the data to a
     // format as if it came from a GET request. The second argument to
@@ -189,10 +276,15 @@ ad_utility::UrlParser::UrlPathAndParameters Server::getUrlPathAndParameters(
           absl::StrCat(toStd(request.target()), "?query=", request.body()),
           false);
     }
-    throw std::runtime_error(
-        absl::StrCat("POST request with content type \"", contentType,
-                     "\" not supported (must be \"", contentTypeUrlEncoded,
-                     "\" or \"", contentTypeSparqlQuery, "\")"));
+    if (contentType.starts_with(contentTypeSparqlUpdate)) {
+      return ad_utility::UrlParser::parseGetRequestTarget(
+          absl::StrCat(toStd(request.target()), "?update=", request.body()),
+          false);
+    }
+    throw std::runtime_error(absl::StrCat(
+        "POST request with content type \"", contentType,
+        "\" not supported (must be \"", contentTypeUrlEncoded, "\", \"",
+        contentTypeSparqlQuery, "\", or \"", contentTypeSparqlUpdate, "\")"));
   }
   std::ostringstream requestMethodName;
   requestMethodName << request.method();
@@ -305,12 +397,31 @@ Awaitable<void> Server::process(
   } else if (auto cmd = checkParameter("cmd", "clear-cache")) {
     logCommand(cmd, "clear the cache (unpinned elements only)");
     cache_.clearUnpinnedOnly();
+    planCache_.clear();
+    DecompressedBlockCache::shared().clear();
+    VocabularyCache::shared().clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd =
                  checkParameter("cmd", "clear-cache-complete", accessTokenOk)) {
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache_.clearAll();
+    planCache_.clear();
+    DecompressedBlockCache::shared().clear();
+    VocabularyCache::shared().clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
+  } else if (auto cmd =
+                 checkParameter("cmd", "save-pinned-results", accessTokenOk)) {
+    logCommand(cmd, "save the pinned results to " + pinnedResultsFilename_);
+    // Updates are blocked while saving, so that the fingerprint matches the
+    // saved results.
+    size_t numSaved = co_await computeInNewThread([this] {
+      std::lock_guard lock{updateMutex_};
+      return cache_.writePinnedResultsToFile(pinnedResultsFilename_,
+                                             getIndexFingerprint());
+    });
+    json j = composeCacheStatsJson();
+    j["num-saved-pinned-results"] = numSaved;
+    response = createJsonResponse(j, request);
   } else if (auto cmd = checkParameter("cmd", "get-settings")) {
     logCommand(cmd, "get server settings");
     response = createJsonResponse(RuntimeParameters().toMap(), request);
@@ -366,6 +477,16 @@ Awaitable<void> Server::process(
                                     std::move(request), send);
   }
 
+  // If "update" parameter is given, process the update.
+  if (auto update = checkParameter("update", std::nullopt, accessTokenOk)) {
+    if (update.value().empty()) {
+      throw std::runtime_error(
+          "Parameter \"update\" must not have an empty value");
+    }
+    co_return co_await processUpdate(parameters, requestTimer,
+                                     std::move(request), send);
+  }
+
   // If there was no "query", but any of the URL parameters processed before
   // produced a `response`, send that now. Note that if multiple URL parameters
   // were processed, only the `response` from the last one is sent.
@@ -456,6 +577,11 @@ json Server::composeStatsJson() const {
   result["num-text-records"] = index_.getNofTextRecords();
   result["num-word-occurrences"] = index_.getNofWordPostings();
   result["num-entity-occurrences"] = index_.getNofEntityPostings();
+  const auto& vocabularyCache = VocabularyCache::shared();
+  result["vocabulary-cache-num-entries"] = vocabularyCache.numEntries();
+  result["vocabulary-cache-size-bytes"] = vocabularyCache.sizeInBytes();
+  result["vocabulary-cache-hits"] = vocabularyCache.numHits();
+  result["vocabulary-cache-misses"] = vocabularyCache.numMisses();
   return result;
 }
 
@@ -467,6 +593,12 @@ nlohmann::json Server::composeCacheStatsJson() const {
   result["non-pinned-size"] = cache_.nonPinnedSize();
   result["pinned-size"] = cache_.pinnedSize();
   result["num-pinned-index-scan-sizes"] = cache_.pinnedSizes().rlock()->size();
+  result["num-cached-query-plans"] = planCache_.numPlans();
+  const auto& blockCache = DecompressedBlockCache::shared();
+  result["block-cache-num-entries"] = blockCache.numEntries();
+  result["block-cache-size-bytes"] = blockCache.sizeInBytes();
+  result["block-cache-hits"] = blockCache.numHits();
+  result["block-cache-misses"] = blockCache.numMisses();
   return result;
 }
 
@@ -493,9 +625,9 @@ boost::asio::awaitable<void> Server::processQuery(
   // block, hence the workaround with the optional `exceptionErrorMsg`.
   std::optional<std::string> exceptionErrorMsg;
   std::optional<ExceptionMetadata> metadata;
-  // Also store the QueryExecutionTree outside the try-catch block to gain
-  // access to the runtimeInformation in the case of an error.
-  std::optional<QueryExecutionTree> queryExecutionTree;
+  // Also store the plan (with the `QueryExecutionTree`) outside the try-catch
+  // block to gain access to the runtimeInformation in the case of an error.
+  std::optional<PlannedQuery> plan;
   try {
     ad_utility::SharedConcurrentTimeoutTimer timeoutTimer = [&]() {
       auto t = ad_utility::TimeoutTimer::unlimited();
@@ -518,7 +650,42 @@ boost::asio::awaitable<void> Server::processQuery(
               << (pinResult ? " [pin result]" : "")
               << (pinSubtrees ? " [pin subresults]" : "") << "\n"
               << query << std::endl;
-    ParsedQuery pq = SparqlParser::parseQuery(query);
+
+    // The parameters of a prepared query, see `QueryPlanCache`. They are
+    // sorted by their names, so that they are part of the key of the plan.
+    QueryPlanCache::SparqlValues parameters;
+    std::vector<std::pair<std::string, std::string>> bindParams;
+    for (const auto& [key, value] : params) {
+      if (key.starts_with("bind-")) {
+        bindParams.emplace_back(key.substr(5), value);
+      }
+    }
+    std::ranges::sort(bindParams);
+    if (!bindParams.empty()) {
+      parameters._values.emplace_back();
+      for (const auto& [name, value] : bindParams) {
+        parameters._variables.emplace_back(absl::StrCat("?", name));
+        parameters._values.back().push_back(
+            TurtleStringParser<TokenizerCtre>::parseTripleObject(value));
+      }
+    }
+
+    // Repeated queries reuse the parsed query and the query plan.
+    const std::string planCacheKey = absl::StrCat(
+        pinSubtrees, pinResult, parameters.variablesToString(), "\n",
+        QueryPlanCache::normalizeQuery(query));
+    plan = planCache_.take(planCacheKey);
+    const bool planIsCached = plan.has_value();
+    if (planIsCached) {
+      plan->parsedQuery_._originalString = query;
+    } else {
+      plan.emplace();
+      plan->parsedQuery_ = SparqlParser::parseQuery(query);
+      if (!bindParams.empty()) {
+        QueryPlanCache::addParameters(plan->parsedQuery_, parameters);
+      }
+    }
+    const ParsedQuery& pq = plan->parsedQuery_;
 
     // The following code block determines the media type to be used for the
     // result. The media type is either determined by the "Accept:" header of
@@ -536,7 +703,8 @@ boost::asio::awaitable<void> Server::processQuery(
           ad_utility::MediaType::tsv,
           ad_utility::MediaType::csv,
           ad_utility::MediaType::turtle,
-          ad_utility::MediaType::octetStream};
+          ad_utility::MediaType::octetStream,
+          ad_utility::MediaType::qleverColumnar};
       return mediaTypes;
     };
 
@@ -556,6 +724,8 @@ boost::asio::awaitable<void> Server::processQuery(
       mediaType = ad_utility::MediaType::turtle;
     } else if (containsParam("action", "binary_export")) {
       mediaType = ad_utility::MediaType::octetStream;
+    } else if (containsParam("action", "columnar_export")) {
+      mediaType = ad_utility::MediaType::qleverColumnar;
     }
 
     std::string_view acceptHeader = request.base()[http::field::accept];
@@ -566,6 +736,10 @@ boost::asio::awaitable<void> Server::processQuery(
     }
 
     if (!mediaType.has_value()) {
+      // The plan can still be used by the next query.
+      if (planIsCached) {
+        planCache_.put(planCacheKey, std::move(plan.value()));
+      }
       co_return co_await send(createBadRequestResponse(
           "Did not find any supported media type "
           "in this \'Accept:\' header field: \"" +
@@ -586,13 +760,25 @@ boost::asio::awaitable<void> Server::processQuery(
     // might happen that the query planner runs for a while (recall that it many
     // do index scans) and then we get an error message afterwards that a
     // certain media type is not supported.
-    QueryExecutionContext qec(index_, &cache_, allocator_,
-                              sortPerformanceEstimator_, pinSubtrees,
-                              pinResult);
-    QueryPlanner qp(&qec);
-    qp.setEnablePatternTrick(enablePatternTrick_);
-    queryExecutionTree = qp.createExecutionTree(pq);
-    auto& qet = queryExecutionTree.value();
+    if (planIsCached) {
+      if (plan->parameters_) {
+        QueryPlanCache::bindParameters(plan.value(), std::move(parameters));
+      }
+      LOG(INFO) << "Reusing the query plan of a previous query" << std::endl;
+    } else {
+      plan->version_ = planCache_.version();
+      plan->qec_ = std::make_unique<QueryExecutionContext>(
+          index_, &cache_, allocator_, sortPerformanceEstimator_, pinSubtrees,
+          pinResult);
+      QueryPlanner qp(plan->qec_.get());
+      qp.setEnablePatternTrick(enablePatternTrick_);
+      plan->tree_ = qp.createExecutionTree(plan->parsedQuery_);
+      if (!bindParams.empty()) {
+        plan->parameters_ =
+            QueryPlanCache::findParameters(plan->tree_.value(), parameters);
+      }
+    }
+    auto& qet = plan->tree_.value();
     qet.isRoot() = true;  // allow pinning of the final result
     qet.recursivelySetTimeoutTimer(timeoutTimer);
     qet.getRootOperation()->createRuntimeInfoFromEstimates();
@@ -604,13 +790,18 @@ boost::asio::awaitable<void> Server::processQuery(
               << std::endl;
     LOG(TRACE) << qet.asString() << std::endl;
 
-    // Common code for sending responses for the streamable media types
-    // (tsv, csv, octet-stream, turtle).
+    // Common code for sending responses for all the media types. The JSON
+    // results are sent as "application/json" (like all other JSON responses
+    // of the server).
     auto sendStreamableResponse =
         [&](ad_utility::MediaType mediaType) -> Awaitable<void> {
-      auto responseGenerator = co_await computeInNewThread([&] {
-        return ExportQueryExecutionTrees::computeResultAsStream(pq, qet,
-                                                                mediaType);
+      const bool isJson = mediaType == ad_utility::MediaType::qleverJson ||
+                          mediaType == ad_utility::MediaType::sparqlJson;
+      auto responseGenerator = co_await computeInNewThread([&, maxSend] {
+        return isJson ? ExportQueryExecutionTrees::computeResultAsJSONStream(
+                            pq, qet, requestTimer, maxSend, mediaType)
+                      : ExportQueryExecutionTrees::computeResultAsStream(
+                            pq, qet, mediaType);
       });
 
       // The `streamable_body` that is used internally turns all exceptions that
@@ -622,8 +813,9 @@ boost::asio::awaitable<void> Server::processQuery(
       std::exception_ptr exceptionPtr;
       responseGenerator.assignExceptionToThisPointer(&exceptionPtr);
       try {
-        auto response =
-            createOkResponse(std::move(responseGenerator), request, mediaType);
+        auto response = createOkResponse(
+            std::move(responseGenerator), request,
+            isJson ? ad_utility::MediaType::json : mediaType);
         co_await send(std::move(response));
       } catch (...) {
         if (exceptionPtr) {
@@ -639,17 +831,11 @@ boost::asio::awaitable<void> Server::processQuery(
       case ad_utility::MediaType::csv:
       case ad_utility::MediaType::tsv:
       case ad_utility::MediaType::octetStream:
-      case ad_utility::MediaType::turtle: {
-        co_await sendStreamableResponse(mediaType.value());
-      } break;
+      case ad_utility::MediaType::qleverColumnar:
+      case ad_utility::MediaType::turtle:
       case ad_utility::MediaType::qleverJson:
       case ad_utility::MediaType::sparqlJson: {
-        // Normal case: JSON response
-        auto responseString = co_await computeInNewThread([&, maxSend] {
-          return ExportQueryExecutionTrees::computeResultAsJSON(
-              pq, qet, requestTimer, maxSend, mediaType.value());
-        });
-        co_await sendJson(std::move(responseString));
+        co_await sendStreamableResponse(mediaType.value());
       } break;
       default:
         // This should never happen, because we have carefully restricted the
@@ -673,6 +859,13 @@ boost::asio::awaitable<void> Server::processQuery(
     LOG(DEBUG) << "Runtime Info:\n"
                << qet.getRootOperation()->getRuntimeInfo().toString()
                << std::endl;
+
+    // Keep the plan for the next query with the same text and the same
+    // parameter variables. A plan with parameters can only be reused if the
+    // operation for the parameters was found.
+    if (bindParams.empty() || plan->parameters_ != nullptr) {
+      planCache_.put(planCacheKey, std::move(plan.value()));
+    }
   } catch (const ParseException& e) {
     exceptionErrorMsg = e.errorMessageWithoutPositionalInfo();
     metadata = e.metadata();
@@ -700,14 +893,124 @@ boost::asio::awaitable<void> Server::processQuery(
     }
     auto errorResponseJson = composeErrorResponseJson(
         query, exceptionErrorMsg.value(), requestTimer, metadata);
-    if (queryExecutionTree) {
+    if (plan.has_value() && plan->tree_.has_value()) {
       errorResponseJson["runtimeInformation"] = nlohmann::ordered_json(
-          queryExecutionTree->getRootOperation()->getRuntimeInfo());
+          plan->tree_->getRootOperation()->getRuntimeInfo());
     }
     co_return co_await sendJson(errorResponseJson, http::status::bad_request);
   }
 }
 
+// ____________________________________________________________________________
+boost::asio::awaitable<void> Server::processUpdate(
+    const ParamValueMap& params, ad_utility::Timer& requestTimer,
+    const ad_utility::httpUtils::HttpRequest auto& request, auto&& send) {
+  using namespace ad_utility::httpUtils;
+  AD_CONTRACT_CHECK(params.contains("update"));
+  const auto& update = params.at("update");
+  AD_CONTRACT_CHECK(!update.empty());
+
+  // As in `processQuery`, the C++ standard forbids co_await in the catch
+  // block, hence the `exceptionErrorMsg`.
+  std::optional<std::string> exceptionErrorMsg;
+  std::optional<ExceptionMetadata> metadata;
+  // The operations are applied one after the other, because each of them has
+  // to see the changes of the previous ones. If an operation fails, the
+  // previous ones remain applied (and persisted), which is reported to the
+  // client.
+  size_t numOperations = 0;
+  size_t numAppliedOperations = 0;
+  ExecuteUpdate::Statistics statistics;
+  try {
+    // The same timeout as for queries (see `processQuery`). It also limits the
+    // time that the update waits for other updates to complete.
+    auto timer = std::make_shared<ad_utility::ConcurrentTimeoutTimer>(
+        ad_utility::TimeoutTimer::unlimited());
+    if (params.contains("timeout")) {
+      ad_utility::Timer::Seconds timeout{std::stof(params.at("timeout"))};
+      timer = std::make_shared<ad_utility::ConcurrentTimeoutTimer>(
+          ad_utility::TimeoutTimer{timeout, ad_utility::Timer::Started});
+    }
+    LOG(INFO) << "Processing the following SPARQL update:\n"
+              << update << std::endl;
+    std::vector<ParsedUpdate> operations = SparqlParser::parseUpdate(update);
+    numOperations = operations.size();
+    co_await computeInNewThread([&] {
+      std::lock_guard lock{updateMutex_};
+      QueryExecutionContext qec(index_, &cache_, allocator_,
+                                sortPerformanceEstimator_);
+      for (const auto& operation : operations) {
+        timer->wlock()->checkTimeoutAndThrow(absl::StrCat(
+            "Update operation ", numAppliedOperations + 1, " of ",
+            numOperations, " was not started. "));
+        auto [numDeleted, numInserted] =
+            ExecuteUpdate::execute(index_, operation, qec, timer);
+        statistics.numDeleted_ += numDeleted;
+        statistics.numInserted_ += numInserted;
+        ++numAppliedOperations;
+        // The following operations and all following queries must not see
+        // results or query plans that were computed before this operation.
+        // The results of queries that were started before are not added to
+        // the cache (see `QueryExecutionContext::getCacheGeneration`). The
+        // decompressed blocks are not affected by updates. The saved pinned
+        // results are outdated as well.
+        cache_.clearAllAndStartNewGeneration();
+        planCache_.clear();
+        ad_utility::deleteFile(pinnedResultsFilename_, false);
+      }
+      // `computeInNewThread` doesn't support functions without a result.
+      return numAppliedOperations;
+    });
+    json j;
+    j["update"] = update;
+    j["status"] = "OK";
+    j["num-operations"] = numOperations;
+    j["num-deleted-triples"] = statistics.numDeleted_;
+    j["num-inserted-triples"] = statistics.numInserted_;
+    j["time"]["total"] =
+        ad_utility::Timer::toMilliseconds(requestTimer.value());
+    LOG(INFO) << "Done processing update (" << statistics.numDeleted_
+              << " triples deleted, " << statistics.numInserted_
+              << " triples inserted), total time was " << requestTimer.msecs()
+              << " ms" << std::endl;
+    co_return co_await send(createJsonResponse(j, request));
+  } catch (const ParseException& e) {
+    exceptionErrorMsg = e.errorMessageWithoutPositionalInfo();
+    metadata = e.metadata();
+  } catch (const std::exception& e) {
+    exceptionErrorMsg = e.what();
+  }
+  if (numAppliedOperations > 0) {
+    exceptionErrorMsg = absl::StrCat(
+        "The first ", numAppliedOperations, " of the ", numOperations,
+        " operations of the update were applied and are not reverted, the "
+        "following operation failed: ",
+        exceptionErrorMsg.value());
+  }
+  LOG(ERROR) << exceptionErrorMsg.value() << std::endl;
+  auto errorResponseJson = composeErrorResponseJson(
+      update, exceptionErrorMsg.value(), requestTimer, metadata);
+  errorResponseJson["num-operations"] = numOperations;
+  errorResponseJson["num-applied-operations"] = numAppliedOperations;
+  errorResponseJson["num-deleted-triples"] = statistics.numDeleted_;
+  errorResponseJson["num-inserted-triples"] = statistics.numInserted_;
+  co_return co_await send(createJsonResponse(
+      errorResponseJson, request, http::status::bad_request));
+}
+
+// _____________________________________________________________________________
+std::string Server::getIndexFingerprint() const {
+  const auto& impl = index_.getImpl();
+  // The serialization of the results might change between different versions
+  // of QLever, so the version is also part of the fingerprint.
+  return absl::StrCat(qlever::version::GitHash, " ",
+                      impl.getFingerprintOfFiles(), " ",
+                      impl.getFingerprintOfUpdateFiles(), " ",
+                      impl.deltaTriples().numInserted(), " ",
+                      impl.deltaTriples().numDeleted(), " ",
+                      impl.getNumUpdateWords());
+}
+
 // _____________________________________________________________________________
 template <typename Function, typename T>
 Awaitable<T> Server::computeInNewThread(Function function) const {
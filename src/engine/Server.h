@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <semaphore>
 #include <string>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "engine/Engine.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanCache.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "index/Index.h"
 #include "parser/SparqlParser.h"
@@ -20,6 +22,7 @@
 #include "util/Timer.h"
 #include "util/http/HttpServer.h"
 #include "util/http/streamable_body.h"
+#include "util/jthread.h"
 #include "util/json.h"
 
 using nlohmann::json;
@@ -38,14 +41,19 @@ class Server {
 
  private:
   //! Initialize the server.
-  void initialize(const string& indexBaseName, bool useText,
-                  bool usePatterns = true, bool loadAllPermutations = true);
+  void initialize(
+      const string& indexBaseName, bool useText, bool usePatterns = true,
+      bool loadAllPermutations = true, bool memoryMapPermutations = false,
+      std::vector<Permutation::Enum> memoryResidentPermutations = {},
+      bool useHugePages = false, bool lockPermutationsInMemory = false);
 
  public:
   //! First initialize the server. Then loop, wait for requests and trigger
   //! processing. This method never returns except when throwing an exception.
   void run(const string& indexBaseName, bool useText, bool usePatterns = true,
-           bool loadAllPermutations = true);
+           bool loadAllPermutations = true, bool memoryMapPermutations = false,
+           std::vector<Permutation::Enum> memoryResidentPermutations = {},
+           bool useHugePages = false, bool lockPermutationsInMemory = false);
 
   Index& index() { return index_; }
   const Index& index() const { return index_; }
@@ -58,6 +66,9 @@ class Server {
   ad_utility::AllocatorWithLimit<Id> allocator_;
   SortPerformanceEstimator sortPerformanceEstimator_;
   Index index_;
+  // The plans refer to the `cache_` and the `index_`, so this member has to
+  // come after them.
+  QueryPlanCache planCache_;
 
   bool enablePatternTrick_;
 
@@ -65,6 +76,14 @@ class Server {
   mutable std::counting_semaphore<std::numeric_limits<int>::max()>
       queryProcessingSemaphore_;
 
+  // Updates are processed one at a time.
+  std::mutex updateMutex_;
+
+  // The file to which the pinned results are saved via
+  // `cmd=save-pinned-results` (see `QueryResultCache`), and from which they
+  // are restored at startup.
+  std::string pinnedResultsFilename_;
+
   template <typename T>
   using Awaitable = boost::asio::awaitable<T>;
 
@@ -85,7 +104,8 @@ class Server {
   /// Handle a http request that asks for the processing of a query.
   /// \param params The key-value-pairs  sent in the HTTP GET request. When this
   /// function is called, we already know that a parameter "query" is contained
-  /// in `params`.
+  /// in `params`. Each parameter "bind-<name>" binds the variable "?<name>" of
+  /// the query to an IRI or literal (see `QueryPlanCache`).
   /// \param requestTimer Timer that measure the total processing
   ///                     time of this request.
   /// \param request The HTTP request.
@@ -95,6 +115,14 @@ class Server {
       const ParamValueMap& params, ad_utility::Timer& requestTimer,
       const ad_utility::httpUtils::HttpRequest auto& request, auto&& send);
 
+  /// Handle a http request that asks for the processing of a SPARQL 1.1
+  /// Update (parameter "update", which requires a valid access token). After
+  /// each operation of the update, the query result cache is cleared.
+  /// The parameters are the same as for `processQuery`.
+  Awaitable<void> processUpdate(
+      const ParamValueMap& params, ad_utility::Timer& requestTimer,
+      const ad_utility::httpUtils::HttpRequest auto& request, auto&& send);
+
   static json composeErrorResponseJson(
       const string& query, const std::string& errorMsg,
       ad_utility::Timer& requestTimer,
@@ -110,4 +138,14 @@ class Server {
   // Returns an awaitable of the return value of `function`
   template <typename Function, typename T = std::invoke_result_t<Function>>
   Awaitable<T> computeInNewThread(Function function) const;
+
+  // Identify the state of the index (including the triples and words that
+  // were added by updates, and the files in which they are stored) that the
+  // saved pinned results are valid for.
+  std::string getIndexFingerprint() const;
+
+  // Restores the saved pinned results in the background after startup. This
+  // is the last member, so that it is joined before the `cache_` and the
+  // `index_` are destroyed.
+  ad_utility::JThread pinnedResultsLoader_;
 };
@@ -9,6 +9,7 @@
 #include "engine/CallFixedSize.h"
 #include "engine/Values.h"
 #include "engine/VariableToColumnMap.h"
+#include "index/IndexImpl.h"
 #include "parser/TokenizerCtre.h"
 #include "parser/TurtleParser.h"
 #include "util/Exception.h"
@@ -175,7 +176,10 @@ void Service::writeTsvResult(std::istringstream tsvResult, IdTable* idTablePtr,
     for (size_t colIdx = 0; colIdx < valueStrings.size(); colIdx++) {
       TripleComponent tc = TurtleStringParser<TokenizerCtre>::parseTripleObject(
           valueStrings[colIdx]);
-      Id id = std::move(tc).toValueId(getIndex().getVocab(), *localVocab);
+      std::optional<Id> optionalId = getIndex().getImpl().getId(tc);
+      Id id = optionalId.has_value()
+                  ? optionalId.value()
+                  : std::move(tc).toValueId(getIndex().getVocab(), *localVocab);
       idTable(rowIdx, colIdx) = id;
       if (id.getDatatype() == Datatype::LocalVocabIndex) {
         ++numLocalVocabPerColumn[colIdx];
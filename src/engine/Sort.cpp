@@ -9,6 +9,7 @@
 
 #include "CallFixedSize.h"
 #include "QueryExecutionTree.h"
+#include "engine/ExternalSort.h"
 
 using std::string;
 
@@ -56,15 +57,23 @@ string Sort::getDescriptor() const {
 
 // _____________________________________________________________________________
 ResultTable Sort::computeResult() {
+  // Inputs that are too large to be sorted in RAM are sorted externally also
+  // when the result has to be materialized.
+  if (supportsLazyEvaluation()) {
+    return externalSort::materialize(computeResultLazily(), getResultWidth(),
+                                     getExecutionContext()->getAllocator());
+  }
   LOG(DEBUG) << "Getting sub-result for Sort result computation..." << endl;
-  shared_ptr<const ResultTable> subRes = subtree_->getResult();
+  // The result of the subtree is sorted in place, so we need our own copy
+  // (which is only made if the result is shared, e.g. via the cache).
+  ResultTable subRes = subtree_->getOwnedResult();
 
   // TODO<joka921> proper timeout for sorting operations
   auto remainingTime = _timeoutTimer->wlock()->remainingTime();
   auto sortEstimateCancellationFactor =
       RuntimeParameters().get<"sort-estimate-cancellation-factor">();
   if (getExecutionContext()->getSortPerformanceEstimator().estimatedSortTime(
-          subRes->size(), subRes->width()) >
+          subRes.size(), subRes.width()) >
       remainingTime * sortEstimateCancellationFactor) {
     // The estimated time for this sort is much larger than the actually
     // remaining time, cancel this operation
@@ -75,11 +84,43 @@ ResultTable Sort::computeResult() {
   }
 
   LOG(DEBUG) << "Sort result computation..." << endl;
-  ad_utility::Timer t{ad_utility::timer::Timer::InitialStatus::Started};
-  IdTable idTable = subRes->idTable().clone();
-  getRuntimeInfo().addDetail("time-cloning", t.msecs());
+  auto localVocab = subRes.getSharedLocalVocab();
+  IdTable idTable = std::move(subRes).moveIdTable();
   Engine::sort(idTable, sortColumnIndices_);
 
   LOG(DEBUG) << "Sort result computation done." << endl;
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+bool Sort::supportsLazyEvaluation() const {
+  return externalSort::shouldSortExternally(*subtree_);
+}
+
+// _____________________________________________________________________________
+LazyResultTable Sort::computeResultLazily() {
+  LOG(DEBUG) << "Getting lazy sub-result for external Sort..." << endl;
+  LazyResultTable subRes = subtree_->getLazyResult();
+  auto blocks = ad_utility::callFixedSize(
+      getResultWidth(), [&]<size_t I>() -> LazyResultTable::Blocks {
+        if constexpr (I == 0) {
+          AD_FAIL();
+        } else {
+          auto comparator = [sortColumns = sortColumnIndices_](
+                                const std::array<Id, I>& a,
+                                const std::array<Id, I>& b) {
+            for (ColumnIndex col : sortColumns) {
+              if (a[col] != b[col]) {
+                return a[col] < b[col];
+              }
+            }
+            return false;
+          };
+          return externalSort::sortBlocks<I>(
+              std::move(subRes.blocks_), std::move(comparator),
+              getExecutionContext()->getAllocator(),
+              [this]() { checkTimeout(); });
+        }
+      });
+  return {std::move(blocks), resultSortedOn(), std::move(subRes.localVocab_)};
 }
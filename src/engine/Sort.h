@@ -67,9 +67,15 @@ class Sort : public Operation {
     return {subtree_.get()};
   }
 
+  // The result is computed lazily using an external sort if the input is
+  // too large to be sorted in RAM (see `ExternalSort.h`).
+  bool supportsLazyEvaluation() const override;
+
  private:
   virtual ResultTable computeResult() override;
 
+  LazyResultTable computeResultLazily() override;
+
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap()
       const override {
     return subtree_->getVariableColumns();
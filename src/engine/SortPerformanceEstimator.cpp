@@ -10,7 +10,10 @@
 #include "engine/Engine.h"
 #include "engine/idTable/IdTable.h"
 #include "util/Log.h"
+#include "util/File.h"
 #include "util/Random.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeVector.h"
 #include "util/Timer.h"
 
 // ___________________________________________________________________
@@ -187,3 +190,43 @@ void SortPerformanceEstimator::computeEstimatesExpensively(
   LOG(DEBUG) << "Done computing sort estimates" << std::endl;
   _estimatesWereCalculated = true;
 }
+
+// ____________________________________________________________________________
+void SortPerformanceEstimator::writeToFile(
+    const std::string& filename, size_t maxNumberOfElementsToSort) const {
+  AD_CONTRACT_CHECK(_estimatesWereCalculated);
+  std::vector<int64_t> microseconds;
+  for (const auto& row : _samples) {
+    for (const auto& sample : row) {
+      microseconds.push_back(sample.count());
+    }
+  }
+  ad_utility::serialization::FileWriteSerializer serializer{filename};
+  serializer << static_cast<uint64_t>(maxNumberOfElementsToSort);
+  serializer << microseconds;
+}
+
+// ____________________________________________________________________________
+bool SortPerformanceEstimator::readFromFile(const std::string& filename,
+                                            size_t maxNumberOfElementsToSort) {
+  if (!ad_utility::File::exists(filename)) {
+    return false;
+  }
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  uint64_t maxNumberOfElementsInFile;
+  std::vector<int64_t> microseconds;
+  serializer >> maxNumberOfElementsInFile;
+  serializer >> microseconds;
+  if (maxNumberOfElementsInFile != maxNumberOfElementsToSort ||
+      microseconds.size() != NUM_SAMPLES_ROWS * NUM_SAMPLES_COLS) {
+    return false;
+  }
+  for (size_t i = 0; i < NUM_SAMPLES_ROWS; ++i) {
+    for (size_t j = 0; j < NUM_SAMPLES_COLS; ++j) {
+      _samples[i][j] =
+          Timer::Duration{microseconds[i * NUM_SAMPLES_COLS + j]};
+    }
+  }
+  _estimatesWereCalculated = true;
+  return true;
+}
@@ -6,6 +6,7 @@
 #define QLEVER_SORTPERFORMANCEESTIMATOR_H
 
 #include <array>
+#include <string>
 
 #include "global/Id.h"
 #include "util/AllocatorWithLimit.h"
@@ -49,6 +50,22 @@ class SortPerformanceEstimator {
       const ad_utility::AllocatorWithLimit<Id>& allocator,
       size_t maxNumberOfElementsToSort);
 
+  // Write the estimates, which must have been computed before, to the given
+  // file. They were computed with the given `maxNumberOfElementsToSort`.
+  void writeToFile(const std::string& filename,
+                   size_t maxNumberOfElementsToSort) const;
+
+  // Read estimates that were written by `writeToFile` for the same
+  // `maxNumberOfElementsToSort`, which is much cheaper than computing them.
+  // Return false and leave the estimates unchanged if the file does not exist
+  // or was written for a different `maxNumberOfElementsToSort`. Throw (and
+  // also leave the estimates unchanged) if the file is truncated or corrupt.
+  //
+  // NOTE: The estimates depend on the machine, so the file should not be
+  // copied to machines with different hardware.
+  bool readFromFile(const std::string& filename,
+                    size_t maxNumberOfElementsToSort);
+
  private:
   // The number of columns for which we will sample the sorting time as a base
   // for the estimates. It is crucial that we have values for 5 and 6, because
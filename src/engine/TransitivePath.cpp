@@ -4,12 +4,18 @@
 
 #include "TransitivePath.h"
 
+#include <atomic>
+#include <future>
 #include <limits>
+#include <numeric>
+#include <span>
 
 #include "engine/CallFixedSize.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/IndexScan.h"
+#include "index/IndexImpl.h"
 #include "util/Exception.h"
+#include "util/ThreadBudget.h"
 
 // _____________________________________________________________________________
 TransitivePath::TransitivePath(
@@ -252,6 +258,206 @@ template void TransitivePath::computeTransitivePath<2>(
     size_t leftSubCol, size_t rightSubCol, Id leftValue, Id rightValue,
     size_t minDist, size_t maxDist);
 
+namespace {
+// A directed graph in the compressed sparse row (CSR) format. The nodes are the
+// distinct `Id`s that occur in the edges. They are identified by their dense
+// index in the sorted sequence of these `Id`s, s.t. the successors of a node
+// are a contiguous range of `targets_` and sets of nodes can be represented as
+// bitmaps.
+class CsrGraph {
+ private:
+  // The `Id` of each node, sorted.
+  std::vector<Id> ids_;
+  // The successors of node `i` are `targets_[offsets_[i], offsets_[i + 1])`.
+  std::vector<size_t> offsets_;
+  std::vector<size_t> targets_;
+
+ public:
+  // Build the graph from the `edges`, which are pairs of (source, target).
+  // Duplicate edges are removed.
+  explicit CsrGraph(std::vector<std::pair<Id, Id>> edges) {
+    std::ranges::sort(edges);
+    auto duplicates = std::ranges::unique(edges);
+    edges.erase(duplicates.begin(), duplicates.end());
+
+    ids_.reserve(2 * edges.size());
+    for (const auto& [source, target] : edges) {
+      ids_.push_back(source);
+      ids_.push_back(target);
+    }
+    std::ranges::sort(ids_);
+    auto duplicateIds = std::ranges::unique(ids_);
+    ids_.erase(duplicateIds.begin(), duplicateIds.end());
+    ids_.shrink_to_fit();
+
+    // The edges are sorted by their source, so the offsets can be computed
+    // by counting.
+    offsets_.resize(ids_.size() + 1, 0);
+    targets_.reserve(edges.size());
+    for (const auto& [source, target] : edges) {
+      ++offsets_[getIndex(source).value() + 1];
+      targets_.push_back(getIndex(target).value());
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+  }
+
+  size_t numNodes() const { return ids_.size(); }
+
+  Id getId(size_t node) const { return ids_[node]; }
+
+  // Return the index of the node with the given `id`, or `std::nullopt` if the
+  // `id` doesn't occur in the graph.
+  std::optional<size_t> getIndex(Id id) const {
+    auto it = std::ranges::lower_bound(ids_, id);
+    if (it == ids_.end() || *it != id) {
+      return std::nullopt;
+    }
+    return it - ids_.begin();
+  }
+
+  std::span<const size_t> successors(size_t node) const {
+    return {targets_.data() + offsets_[node],
+            targets_.data() + offsets_[node + 1]};
+  }
+};
+
+// Append all the nodes of the `graph` that can be reached from the `start` node
+// via a path with at least `minDist` and at most `maxDist` edges to `reached`
+// in the order of a breadth-first search. Each reached node is only added
+// once. `visited` is a bitmap with one entry per node, which has to be all
+// `false` and is reset to all `false` before returning.
+void appendReachableNodes(const CsrGraph& graph, size_t start, size_t minDist,
+                          size_t maxDist, std::vector<bool>& visited,
+                          std::vector<size_t>& reached, auto& checkTimeout) {
+  size_t reachedBegin = reached.size();
+  std::vector<size_t> frontier{start};
+  std::vector<size_t> nextFrontier;
+  for (size_t depth = 1; depth <= maxDist && !frontier.empty(); ++depth) {
+    nextFrontier.clear();
+    for (size_t node : frontier) {
+      auto successors = graph.successors(node);
+      checkTimeout(successors.size());
+      for (size_t successor : successors) {
+        if (depth < minDist) {
+          // The paths to the nodes of the next frontier are too short, so the
+          // nodes may not be marked yet, as they might be reached again via a
+          // longer path.
+          nextFrontier.push_back(successor);
+        } else if (!visited[successor]) {
+          visited[successor] = true;
+          reached.push_back(successor);
+          nextFrontier.push_back(successor);
+        }
+      }
+    }
+    if (depth < minDist) {
+      std::ranges::sort(nextFrontier);
+      auto duplicates = std::ranges::unique(nextFrontier);
+      nextFrontier.erase(duplicates.begin(), duplicates.end());
+    }
+    std::swap(frontier, nextFrontier);
+  }
+  for (size_t i = reachedBegin; i < reached.size(); ++i) {
+    visited[reached[i]] = false;
+  }
+}
+
+// Return true iff the `target` can be reached from the `source` via a path with
+// at least `minDist` and at most `maxDist` edges. `successors(id)` and
+// `predecessors(id)` return the direct successors and predecessors of a node
+// as a `std::vector<Id>`. The nodes at distance `minDist - 1` from the
+// `source` are found by a one-sided search. From there on, the search is
+// bidirectional: it alternately expands the smaller one of the frontiers of a
+// forward search and a backward search from the `target`, and it stops as soon
+// as the two searches meet.
+bool isReachable(Id source, Id target, size_t minDist, size_t maxDist,
+                 const auto& successors, const auto& predecessors,
+                 auto& checkTimeout) {
+  if (minDist == 0) {
+    AD_THROW(
+        "The TransitivePath operation does not support a minimum "
+        "distance of 0 (use at least one instead).");
+  }
+  if (maxDist < minDist) {
+    return false;
+  }
+  using Set = ad_utility::HashSet<Id>;
+  // Replace the `frontier` by the `neighbors` of its nodes that have not been
+  // `visited` yet, and mark them as `visited`. Return true iff one of these
+  // nodes has already been visited by the search from the other side.
+  auto expand = [&checkTimeout](std::vector<Id>& frontier, Set& visited,
+                                const Set& visitedByOtherSide,
+                                const auto& neighbors) {
+    std::vector<Id> nextFrontier;
+    for (Id node : frontier) {
+      std::vector<Id> ids = neighbors(node);
+      checkTimeout(ids.size());
+      for (Id id : ids) {
+        if (visited.insert(id).second) {
+          if (visitedByOtherSide.contains(id)) {
+            return true;
+          }
+          nextFrontier.push_back(id);
+        }
+      }
+    }
+    frontier = std::move(nextFrontier);
+    return false;
+  };
+
+  std::vector<Id> forward{source};
+  for (size_t depth = 1; depth < minDist && !forward.empty(); ++depth) {
+    // The paths to these nodes are too short, so the nodes are only
+    // deduplicated per level, as they might be reached again via a longer path.
+    Set level;
+    expand(forward, level, Set{}, successors);
+  }
+
+  // The remaining paths from the `forward` frontier to the `target` must have
+  // at least one and at most `maxLength` edges.
+  const size_t maxLength = maxDist - minDist + 1;
+  Set forwardVisited;
+  Set backwardVisited{target};
+  std::vector<Id> backward{target};
+  if (expand(forward, forwardVisited, backwardVisited, successors)) {
+    return true;
+  }
+  // All paths with at most `forwardDepth + backwardDepth` edges have been
+  // found at this point.
+  size_t forwardDepth = 1;
+  size_t backwardDepth = 0;
+  while (forwardDepth + backwardDepth < maxLength && !forward.empty() &&
+         !backward.empty()) {
+    if (forward.size() <= backward.size()) {
+      if (expand(forward, forwardVisited, backwardVisited, successors)) {
+        return true;
+      }
+      ++forwardDepth;
+    } else {
+      if (expand(backward, backwardVisited, forwardVisited, predecessors)) {
+        return true;
+      }
+      ++backwardDepth;
+    }
+  }
+  return false;
+}
+
+// Return a function that returns the `Id`s of the successors of the node with
+// the given `Id` in the `graph`.
+auto makeSuccessorFunction(const CsrGraph& graph) {
+  return [&graph](Id id) {
+    std::vector<Id> result;
+    if (auto node = graph.getIndex(id); node.has_value()) {
+      for (size_t successor : graph.successors(node.value())) {
+        result.push_back(graph.getId(successor));
+      }
+    }
+    return result;
+  };
+}
+}  // namespace
+
 // _____________________________________________________________________________
 template <size_t SUB_WIDTH, bool leftIsVar, bool rightIsVar>
 void TransitivePath::computeTransitivePath(IdTable* dynRes,
@@ -260,140 +466,134 @@ void TransitivePath::computeTransitivePath(IdTable* dynRes,
                                            size_t rightSubCol, Id leftValue,
                                            Id rightValue, size_t minDist,
                                            size_t maxDist) {
-  using Map = ad_utility::HashMap<Id, std::shared_ptr<ad_utility::HashSet<Id>>>;
-  using MapIt = Map::iterator;
+  const IdTableView<SUB_WIDTH> sub = dynSub.asStaticView<SUB_WIDTH>();
 
+  // If both sides are fixed, only check whether the right value is reachable
+  // from the left value, using a bidirectional search.
   if constexpr (!leftIsVar && !rightIsVar) {
+    std::vector<std::pair<Id, Id>> edges;
+    std::vector<std::pair<Id, Id>> reverseEdges;
+    edges.reserve(sub.size());
+    reverseEdges.reserve(sub.size());
+    for (size_t i = 0; i < sub.size(); i++) {
+      edges.emplace_back(sub(i, leftSubCol), sub(i, rightSubCol));
+      reverseEdges.emplace_back(sub(i, rightSubCol), sub(i, leftSubCol));
+    }
+    checkTimeout();
+    const CsrGraph graph{std::move(edges)};
+    const CsrGraph reverseGraph{std::move(reverseEdges)};
+    checkTimeout();
+    auto checkTimeoutAfterNCalls = checkTimeoutAfterNCallsFactory();
+    if (isReachable(leftValue, rightValue, minDist, maxDist,
+                    makeSuccessorFunction(graph),
+                    makeSuccessorFunction(reverseGraph),
+                    checkTimeoutAfterNCalls)) {
+      dynRes->push_back({leftValue, rightValue});
+    }
     return;
   }
 
-  const IdTableView<SUB_WIDTH> sub = dynSub.asStaticView<SUB_WIDTH>();
-  IdTableStatic<2> res = std::move(*dynRes).toStatic<2>();
-
-  // Used to map entries in the left column to entries they have connection with
-  Map edges;
-  // All nodes on the graph from which an edge leads to another node
-  std::vector<Id> nodes;
-
-  auto checkTimeoutAfterNCalls = checkTimeoutAfterNCallsFactory();
-  auto checkTimeoutHashSet = [&checkTimeoutAfterNCalls]() {
-    checkTimeoutAfterNCalls(NUM_OPERATIONS_HASHSET_LOOKUP);
-  };
-
-  // initialize the map from the subresult
-  if constexpr (rightIsVar) {
-    (void)rightValue;
-    if (!leftIsVar) {
-      nodes.push_back(leftValue);
+  // Build the graph from the subresult. If the right side is fixed, the search
+  // starts from the right, so the edges are inverted.
+  std::vector<std::pair<Id, Id>> edges;
+  edges.reserve(sub.size());
+  for (size_t i = 0; i < sub.size(); i++) {
+    Id l = sub(i, leftSubCol);
+    Id r = sub(i, rightSubCol);
+    if constexpr (rightIsVar) {
+      edges.emplace_back(l, r);
+    } else {
+      edges.emplace_back(r, l);
     }
+  }
+  checkTimeout();
+  const CsrGraph graph{std::move(edges)};
+  checkTimeout();
+
+  // The nodes from which the search starts. If both sides are variables, these
+  // are all the nodes with an outgoing edge in the order in which they first
+  // appear in the subresult, s.t. the sorting of the left column is preserved.
+  std::vector<size_t> startNodes;
+  if constexpr (leftIsVar && rightIsVar) {
+    std::vector<bool> isStartNode(graph.numNodes(), false);
     for (size_t i = 0; i < sub.size(); i++) {
-      checkTimeoutHashSet();
-      Id l = sub(i, leftSubCol);
-      Id r = sub(i, rightSubCol);
-      MapIt it = edges.find(l);
-      if (it == edges.end()) {
-        if constexpr (leftIsVar) {
-          nodes.push_back(l);
-        }
-        std::shared_ptr<ad_utility::HashSet<Id>> s =
-            std::make_shared<ad_utility::HashSet<Id>>();
-        s->insert(r);
-        edges[l] = s;
-      } else {
-        // If r is not in the vector insert it
-        it->second->insert(r);
+      size_t node = graph.getIndex(sub(i, leftSubCol)).value();
+      if (!isStartNode[node]) {
+        isStartNode[node] = true;
+        startNodes.push_back(node);
       }
     }
   } else {
-    (void)leftValue;
-    nodes.push_back(rightValue);
-    for (size_t i = 0; i < sub.size(); i++) {
-      checkTimeoutHashSet();
-      // Use the inverted edges
-      Id l = sub(i, leftSubCol);
-      Id r = sub(i, rightSubCol);
-      MapIt it = edges.find(r);
-      if (it == edges.end()) {
-        std::shared_ptr<ad_utility::HashSet<Id>> s =
-            std::make_shared<ad_utility::HashSet<Id>>();
-        s->insert(l);
-        edges[r] = s;
-      } else {
-        // If r is not in the vector insert it
-        it->second->insert(l);
-      }
+    std::optional<size_t> node =
+        graph.getIndex(rightIsVar ? leftValue : rightValue);
+    if (node.has_value()) {
+      startNodes.push_back(node.value());
     }
   }
+  if (!startNodes.empty() && minDist == 0) {
+    AD_THROW(
+        "The TransitivePath operation does not support a minimum "
+        "distance of 0 (use at least one instead).");
+  }
 
-  // For every node do a dfs on the graph
-
-  // Stores nodes we already have a path to. This avoids cycles.
-  ad_utility::HashSet<Id> marks;
-
-  // The stack used to store the dfs' progress
-  std::vector<ad_utility::HashSet<Id>::const_iterator> positions;
-
-  // Used to store all edges leading away from a node for every level.
-  // Reduces access to the hashmap, and is safe as the map will not
-  // be modified after this point.
-  std::vector<std::shared_ptr<const ad_utility::HashSet<Id>>> edgeCache;
-
-  for (size_t i = 0; i < nodes.size(); i++) {
-    MapIt rootEdges = edges.find(nodes[i]);
-    if (rootEdges != edges.end()) {
-      positions.push_back(rootEdges->second->begin());
-      edgeCache.push_back(rootEdges->second);
-    }
-    if (minDist == 0) {
-      AD_THROW(
-          "The TransitivePath operation does not support a minimum "
-          "distance of 0 (use at least one instead).");
-    }
-
-    // While we have not found the entire transitive hull and have not reached
-    // the max step limit
-    while (!positions.empty()) {
-      size_t stackIndex = positions.size() - 1;
-      // Process the next child of the node at the top of the stack
-      ad_utility::HashSet<Id>::const_iterator& pos = positions[stackIndex];
-      const ad_utility::HashSet<Id>* nodeEdges = edgeCache.back().get();
-
-      if (pos == nodeEdges->end()) {
-        // We finished processing this node
-        positions.pop_back();
-        edgeCache.pop_back();
-        continue;
-      }
-
-      Id child = *pos;
-      ++pos;
-      size_t childDepth = positions.size();
-      if (childDepth <= maxDist && marks.count(child) == 0) {
-        // process the child
-        if (childDepth >= minDist) {
-          marks.insert(child);
+  // Search from all the start nodes. The start nodes are divided into chunks
+  // that are distributed dynamically over the threads. The results of the
+  // chunks are then concatenated in the order of the start nodes.
+  const size_t chunkSize =
+      std::max(RuntimeParameters().get<"transitive-path-chunk-size">(), 1UL);
+  const size_t numChunks = (startNodes.size() + chunkSize - 1) / chunkSize;
+  std::vector<IdTable> chunkResults;
+  chunkResults.reserve(numChunks);
+  for (size_t i = 0; i < numChunks; ++i) {
+    chunkResults.emplace_back(2, dynRes->getAllocator());
+  }
+  std::atomic<size_t> nextChunk = 0;
+  auto searchFromStartNodes = [&]() {
+    std::vector<bool> visited(graph.numNodes(), false);
+    std::vector<size_t> reached;
+    auto checkTimeoutAfterNCalls = checkTimeoutAfterNCallsFactory();
+    for (size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+      IdTable& chunkResult = chunkResults[chunk];
+      size_t end = std::min((chunk + 1) * chunkSize, startNodes.size());
+      for (size_t i = chunk * chunkSize; i < end; ++i) {
+        reached.clear();
+        appendReachableNodes(graph, startNodes[i], minDist, maxDist, visited,
+                             reached, checkTimeoutAfterNCalls);
+        Id startId = graph.getId(startNodes[i]);
+        for (size_t node : reached) {
           if constexpr (rightIsVar) {
-            res.push_back({nodes[i], child});
+            chunkResult.push_back({startId, graph.getId(node)});
           } else {
-            res.push_back({child, nodes[i]});
+            chunkResult.push_back({graph.getId(node), startId});
           }
         }
-        // Add the child to the stack
-        MapIt it = edges.find(child);
-        if (it != edges.end()) {
-          positions.push_back(it->second->begin());
-          edgeCache.push_back(it->second);
-        }
       }
     }
-
-    if (i + 1 < nodes.size()) {
-      // reset everything for the next iteration
-      marks.clear();
-    }
+  };
+  const size_t numThreads = std::clamp(
+      numChunks, 1UL,
+      std::max(RuntimeParameters().get<"transitive-path-max-num-threads">(),
+               1UL));
+  // This thread also searches, the other threads are taken from the budget
+  // that is shared with the concurrent queries.
+  ad_utility::ReservedThreads reservedThreads{numThreads - 1};
+  std::vector<std::future<void>> threads;
+  for (size_t i = 0; i < reservedThreads.numThreads(); ++i) {
+    threads.push_back(std::async(std::launch::async, searchFromStartNodes));
+  }
+  searchFromStartNodes();
+  for (auto& thread : threads) {
+    thread.get();
   }
 
-  *dynRes = std::move(res).toDynamic();
+  size_t resultSize = 0;
+  for (const IdTable& chunkResult : chunkResults) {
+    resultSize += chunkResult.size();
+  }
+  dynRes->reserve(dynRes->size() + resultSize);
+  for (const IdTable& chunkResult : chunkResults) {
+    dynRes->insertAtEnd(chunkResult);
+  }
 }
 
 template <size_t SUB_WIDTH, size_t LEFT_WIDTH, size_t RES_WIDTH>
@@ -669,9 +869,63 @@ void TransitivePath::computeTransitivePathRightBound(
   *dynRes = std::move(res).toDynamic();
 }
 
+// _____________________________________________________________________________
+std::optional<IdTable> TransitivePath::computeReachabilityWithIndexScans() {
+  if (_leftIsVar || _rightIsVar || _leftSideTree != nullptr ||
+      _rightSideTree != nullptr) {
+    return std::nullopt;
+  }
+  auto scan =
+      std::dynamic_pointer_cast<IndexScan>(_subtree->getRootOperation());
+  if (scan == nullptr) {
+    return std::nullopt;
+  }
+  const TripleComponent& subject = scan->getSubject();
+  const TripleComponent& predicate = scan->getPredicate();
+  const TripleComponent& object = scan->getObject();
+  if (predicate.isVariable() || !subject.isVariable() ||
+      !object.isVariable() || subject.getVariable() == object.getVariable()) {
+    return std::nullopt;
+  }
+
+  IdTable result{2, getExecutionContext()->getAllocator()};
+  std::optional<Id> predicateId = getIndex().getImpl().getId(predicate);
+  if (!predicateId.has_value()) {
+    return result;
+  }
+  // The edges of the paths go from the subject to the object, unless the
+  // subject of the scan is bound to the right side of the paths.
+  bool leftIsSubject =
+      _subtree->getVariableColumn(subject.getVariable()) == _leftSubCol;
+  using enum Permutation::Enum;
+  auto makeScanFunction = [this, &predicateId](Permutation::Enum permutation) {
+    return [this, &predicateId, permutation](Id id) {
+      IdTable neighbors = getIndex().scan(predicateId.value(), id, permutation,
+                                          _timeoutTimer);
+      auto column = neighbors.getColumn(0);
+      return std::vector<Id>(column.begin(), column.end());
+    };
+  };
+  auto checkTimeoutAfterNCalls = checkTimeoutAfterNCallsFactory();
+  if (isReachable(_leftValue, _rightValue, _minDist, _maxDist,
+                  makeScanFunction(leftIsSubject ? PSO : POS),
+                  makeScanFunction(leftIsSubject ? POS : PSO),
+                  checkTimeoutAfterNCalls)) {
+    result.push_back({_leftValue, _rightValue});
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 ResultTable TransitivePath::computeResult() {
   LOG(DEBUG) << "TransitivePath result computation..." << std::endl;
+  if (auto result = computeReachabilityWithIndexScans(); result.has_value()) {
+    // The `_subtree` was not evaluated, its triples were read by index scans
+    // that are part of this operation.
+    _subtree->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    LOG(DEBUG) << "TransitivePath result computation done." << std::endl;
+    return {std::move(result.value()), resultSortedOn(), LocalVocab{}};
+  }
   shared_ptr<const ResultTable> subRes = _subtree->getResult();
   LOG(DEBUG) << "TransitivePath subresult computation done." << std::endl;
 
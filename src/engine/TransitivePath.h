@@ -142,6 +142,14 @@ class TransitivePath : public Operation {
 
   VariableToColumnMap computeVariableToColumnMap() const override;
 
+  // If both sides are fixed and the subtree is a scan of a single fixed
+  // predicate, check whether the right value is reachable from the left value
+  // by a bidirectional search that directly scans the successors and
+  // predecessors of the visited nodes in the PSO and POS permutations. This
+  // avoids the computation of the complete result of the subtree. Otherwise,
+  // return `std::nullopt`.
+  std::optional<IdTable> computeReachabilityWithIndexScans();
+
   // The internal implementation of `bindLeftSide` and `bindRightSide` which
   // share a lot of code.
   std::shared_ptr<TransitivePath> bindLeftOrRightSide(
@@ -186,6 +186,36 @@ ResultTable Union::computeResult() {
       ResultTable::getSharedLocalVocabFromNonEmptyOf(*subRes1, *subRes2)};
 }
 
+// _____________________________________________________________________________
+LazyResultTable Union::computeResultLazily() {
+  auto localVocab = std::make_shared<LocalVocab>();
+  return {unionBlocks(localVocab), resultSortedOn(), localVocab};
+}
+
+// _____________________________________________________________________________
+LazyResultTable::Blocks Union::unionBlocks(
+    std::shared_ptr<LocalVocab> localVocab) {
+  IdTable idTable{getExecutionContext()->getAllocator()};
+  for (size_t i = 0; i < _subtrees.size(); ++i) {
+    // The subtrees are only evaluated when their blocks are actually needed.
+    LazyResultTable subRes = _subtrees[i]->getLazyResult();
+    IdTable emptyInput{_subtrees[i]->getResultWidth(),
+                       getExecutionContext()->getAllocator()};
+    for (const IdTable& block : subRes.blocks_) {
+      idTable.clear();
+      idTable.setNumColumns(getResultWidth());
+      const IdTable& left = i == 0 ? block : emptyInput;
+      const IdTable& right = i == 0 ? emptyInput : block;
+      computeUnion(&idTable, left, right, _columnOrigins);
+      // The two subtrees have different local vocabularies, so we have to
+      // transfer the words to the common local vocab of the result.
+      LazyResultTable::remapLocalVocabIndices(idTable, *subRes.localVocab_,
+                                              *localVocab);
+      co_yield idTable;
+    }
+  }
+}
+
 void Union::computeUnion(
     IdTable* resPtr, const IdTable& left, const IdTable& right,
     const std::vector<std::array<size_t, 2>>& columnOrigins) {
@@ -65,5 +65,23 @@ class Union : public Operation {
  private:
   virtual ResultTable computeResult() override;
 
+ public:
+  // A UNION can be computed lazily by first yielding the blocks of the left
+  // and then the blocks of the right subtree. This only pays off if at least
+  // one of the subtrees can be computed lazily.
+  bool supportsLazyEvaluation() const override {
+    return std::ranges::any_of(_subtrees, [](const auto& subtree) {
+      return subtree->getRootOperation()->supportsLazyEvaluation();
+    });
+  }
+
+ private:
+  LazyResultTable computeResultLazily() override;
+
+  // Yield the blocks of both subtrees, with the columns rearranged according
+  // to the `_columnOrigins`. All the `LocalVocabIndex` IDs of the yielded
+  // blocks refer to the `localVocab`.
+  LazyResultTable::Blocks unionBlocks(std::shared_ptr<LocalVocab> localVocab);
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 };
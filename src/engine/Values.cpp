@@ -11,6 +11,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "engine/CallFixedSize.h"
+#include "index/IndexImpl.h"
 #include "util/Exception.h"
 #include "util/HashSet.h"
 
@@ -86,6 +87,21 @@ uint64_t Values::getSizeEstimateBeforeLimit() {
 // ____________________________________________________________________________
 size_t Values::getCostEstimate() { return parsedValues_._values.size(); }
 
+// ____________________________________________________________________________
+void Values::replaceValues(SparqlValues parsedValues) {
+  AD_CONTRACT_CHECK(parsedValues._variables == parsedValues_._variables);
+  AD_CONTRACT_CHECK(parsedValues._values.size() ==
+                    parsedValues_._values.size());
+  // The undefined values are part of the `VariableToColumnMap`, which is
+  // computed only once.
+  AD_CONTRACT_CHECK(std::ranges::none_of(
+      parsedValues._values, [](const std::vector<TripleComponent>& row) {
+        return std::ranges::any_of(row, &TripleComponent::isUndef);
+      }));
+  parsedValues_ = std::move(parsedValues);
+  multiplicities_.clear();
+}
+
 // ____________________________________________________________________________
 void Values::computeMultiplicities() {
   if (parsedValues_._variables.empty()) {
@@ -131,8 +147,14 @@ void Values::writeValues(IdTable* idTablePtr, LocalVocab* localVocab) {
   std::vector<size_t> numLocalVocabPerColumn(idTable.numColumns());
   for (auto& row : parsedValues_._values) {
     for (size_t colIdx = 0; colIdx < idTable.numColumns(); colIdx++) {
-      TripleComponent& tc = row[colIdx];
-      Id id = std::move(tc).toValueId(getIndex().getVocab(), *localVocab);
+      // The `parsedValues_` are left intact, so that a cached query plan can
+      // be executed again (see `QueryPlanCache`). Only the words that end up
+      // in the local vocabulary are copied.
+      const TripleComponent& tc = row[colIdx];
+      std::optional<Id> optionalId = getIndex().getImpl().getId(tc);
+      Id id = optionalId.has_value() ? optionalId.value()
+                                     : TripleComponent{tc}.toValueId(
+                                           getIndex().getVocab(), *localVocab);
       idTable(rowIdx, colIdx) = id;
       if (id.getDatatype() == Datatype::LocalVocabIndex) {
         ++numLocalVocabPerColumn[colIdx];
@@ -48,6 +48,15 @@ class Values : public Operation {
 
   vector<QueryExecutionTree*> getChildren() override { return {}; }
 
+  const SparqlValues& getValues() const { return parsedValues_; }
+
+  // Replace the values by `parsedValues`, which must have the same variables
+  // and the same number of rows, and must not contain `UNDEF`. This is used
+  // for the parameters of a cached query plan (see `QueryPlanCache`). The
+  // string representations of the trees that contain this operation have to
+  // be reset by the caller.
+  void replaceValues(SparqlValues parsedValues);
+
  public:
   // These two are also used by class `Service`, hence public.
   virtual ResultTable computeResult() override;
@@ -59,9 +68,6 @@ class Values : public Operation {
   void computeMultiplicities();
 
   // Write `parsedValues_` to the given result object.
-  //
-  // NOTE: this moves the values out of `parsedValues_` (to save a string copy
-  // for those values that end up in the local vocabulary).
   template <size_t I>
   void writeValues(IdTable* idTablePtr, LocalVocab* localVocab);
 };
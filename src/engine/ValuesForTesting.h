@@ -17,17 +17,24 @@ class ValuesForTesting : public Operation {
  private:
   IdTable table_;
   std::vector<Variable> variables_;
+  // If set, the result can also be computed lazily, and is then yielded in
+  // blocks of (at most) this many rows.
+  std::optional<size_t> lazyBlockSize_;
 
  public:
   // Create an operation that has as its result the given `table` and the given
   // `variables`. The number of variables must be equal to the number
-  // of columns in the table.
+  // of columns in the table. If `lazyBlockSize` is specified, then the
+  // operation supports lazy evaluation (see `Operation::getLazyResult`).
   ValuesForTesting(QueryExecutionContext* ctx, IdTable table,
-                   std::vector<Variable> variables)
+                   std::vector<Variable> variables,
+                   std::optional<size_t> lazyBlockSize = std::nullopt)
       : Operation{ctx},
         table_{std::move(table)},
-        variables_{std::move(variables)} {
+        variables_{std::move(variables)},
+        lazyBlockSize_{lazyBlockSize} {
     AD_CONTRACT_CHECK(variables_.size() == table_.numColumns());
+    AD_CONTRACT_CHECK(lazyBlockSize_.value_or(1) > 0);
   }
 
   // ___________________________________________________________________________
@@ -35,7 +42,29 @@ class ValuesForTesting : public Operation {
     return {table_.clone(), resultSortedOn(), LocalVocab{}};
   }
 
+  // ___________________________________________________________________________
+  bool supportsLazyEvaluation() const override {
+    return lazyBlockSize_.has_value();
+  }
+
+  // ___________________________________________________________________________
+  LazyResultTable computeResultLazily() override {
+    return {yieldBlocks(), resultSortedOn(),
+            std::make_shared<const LocalVocab>()};
+  }
+
  private:
+  // Yield the `table_` in blocks of `lazyBlockSize_` rows.
+  LazyResultTable::Blocks yieldBlocks() const {
+    IdTable block{table_.numColumns(), table_.getAllocator()};
+    for (size_t i = 0; i < table_.numRows(); i += lazyBlockSize_.value()) {
+      block.clear();
+      size_t end = std::min(i + lazyBlockSize_.value(), table_.numRows());
+      block.insertAtEnd(table_.begin() + i, table_.begin() + end);
+      co_yield block;
+    }
+  }
+
   // ___________________________________________________________________________
   string asStringImpl([[maybe_unused]] size_t indent) const override {
     std::stringstream str;
@@ -48,6 +48,15 @@ class AggregateExpression : public SparqlExpression {
   [[nodiscard]] std::optional<SparqlExpressionPimpl::VariableAndDistinctness>
   getVariableForCount() const override;
 
+  // Return true iff this is a `DISTINCT` aggregate, e.g. `SUM(DISTINCT ?x)`.
+  bool isDistinct() const { return _distinct; }
+
+  // If the argument of this aggregate is a single variable (as in `SUM(?x)`),
+  // return that variable, else return `std::nullopt`.
+  std::optional<::Variable> getAggregatedVariable() const {
+    return _child->getVariableOrNullopt();
+  }
+
   // This is the visitor for the `evaluateAggregateExpression` function below.
   // It works on a `SingleExpressionResult` rather than on the
   // `ExpressionResult` variant.
@@ -7,6 +7,8 @@
 #include "engine/sparqlExpressions/LangExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "index/IndexImpl.h"
+#include "index/OrderOfUpdateWords.h"
 #include "util/LambdaHelpers.h"
 #include "util/TypeTraits.h"
 
@@ -129,9 +131,96 @@ std::pair<ValueId, ValueId> getRangeFromVocab(
       context->_qec.getIndex().getVocab().lower_bound(s, level));
   const ValueId upper = Id::makeFromVocabIndex(
       context->_qec.getIndex().getVocab().upper_bound(s, level));
+  // The words that were introduced by updates are not part of the vocabulary
+  // and have IDs that are larger than all of its IDs.
+  if (lower == upper) {
+    if (auto id = context->_qec.getIndex().getImpl().getIdOfWord(s)) {
+      return {id.value(), Id::makeFromVocabIndex(
+                              id.value().getVocabIndex().incremented())};
+    }
+  }
   return {lower, upper};
 }
 
+// The IDs of the words that were introduced by updates are larger than all the
+// IDs of the vocabulary, so they are not ordered like their words (see
+// `OrderOfUpdateWords`). If `a` or `b` is the ID of such a word, return the
+// result of `a Comp b` according to the order of the words. Otherwise (or if
+// the `order` is `nullptr`) return `std::nullopt`, then the IDs can be compared
+// directly.
+template <Comparison Comp>
+std::optional<Id> compareWordsOfUpdates(const OrderOfUpdateWords* order, Id a,
+                                        Id b) {
+  if (order == nullptr || a.getDatatype() != Datatype::VocabIndex ||
+      b.getDatatype() != Datatype::VocabIndex ||
+      (!order->isWordOfUpdate(a) && !order->isWordOfUpdate(b))) {
+    return std::nullopt;
+  }
+  return Id::makeFromBool(
+      applyComparison<Comp>(order->getPosition(a), order->getPosition(b)));
+}
+
+// Same as above, but for the comparison of `a` with the range `[lower, upper)`
+// of IDs that are equal to a string (see `getRangeFromVocab`).
+template <Comparison Comp>
+std::optional<Id> compareWordsOfUpdates(const OrderOfUpdateWords* order, Id a,
+                                        Id lower, Id upper,
+                                        const EvaluationContext* context) {
+  if (order == nullptr || a.getDatatype() != Datatype::VocabIndex ||
+      lower.getDatatype() != Datatype::VocabIndex) {
+    return std::nullopt;
+  }
+  using Position = OrderOfUpdateWords::Position;
+  if (lower == upper) {
+    // The string is neither contained in the vocabulary nor in the words of
+    // the updates, it would be inserted into the vocabulary before `lower`.
+    if (!order->isWordOfUpdate(a)) {
+      return std::nullopt;
+    }
+    Position positionOfA = order->getPosition(a);
+    if (positionOfA.first == lower.getVocabIndex().get()) {
+      // The word of `a` would be inserted at the same position, so the IDs
+      // don't determine the order of the two words.
+      auto word = context->_qec.getIndex().getImpl().idToOptionalString(
+          a.getVocabIndex());
+      throw std::runtime_error(absl::StrCat(
+          "The word ", word.value_or(""),
+          " was introduced by a SPARQL update and cannot be compared with a "
+          "string that is not contained in the index via <, <=, >, and >= "
+          "until the index is rebuilt"));
+    }
+    return Id::makeFromBool(applyComparison<Comp>(
+        positionOfA, Position{lower.getVocabIndex().get(), 0}));
+  }
+  if (order->isWordOfUpdate(lower)) {
+    // The range consists of the single ID of a word of an update.
+    return compareWordsOfUpdates<Comp>(order, a, lower);
+  }
+  if (order->isWordOfUpdate(a)) {
+    // The range consists of words of the vocabulary, and the word of `a` is
+    // not equal to them.
+    return Id::makeFromBool(
+        applyComparison<Comp>(order->getPosition(a),
+                              Position{lower.getVocabIndex().get(),
+                                       std::numeric_limits<size_t>::max()}));
+  }
+  return std::nullopt;
+}
+
+// Return true iff the column of the `variable`, which must be sorted, contains
+// the ID of a word that was introduced by an update.
+bool containsWordOfUpdate(const Variable& variable,
+                          const OrderOfUpdateWords& order,
+                          const EvaluationContext* context) {
+  auto columnIndex = context->getColumnIndexForVariable(variable);
+  auto column = context->_inputTable.getColumn(columnIndex)
+                    .subspan(context->_beginIndex, context->size());
+  // All the IDs of the words of updates are at the end of the `VocabIndex`
+  // IDs.
+  auto it = std::ranges::lower_bound(column, order.getMinIdOfUpdateWords());
+  return it != column.end() && order.isWordOfUpdate(*it);
+}
+
 // Convert an int, double, or string value into a `ValueId`. For int and double
 // this is a single `ValueId`, for strings it is a `pair<ValueId, ValueId>` that
 // denotes a range (see `getRangeFromVocab` above).
@@ -266,12 +355,40 @@ requires AreComparable<S1, S2> ExpressionResult evaluateRelationalExpression(
   VectorWithMemoryLimit<Id> result{context->_allocator};
   result.reserve(resultSize);
 
+  // Equality of IDs is also equality of the words of updates, so their order
+  // is only needed for the other comparisons.
+  std::shared_ptr<const OrderOfUpdateWords> orderOfUpdateWords;
+  if constexpr (Comp != Comparison::EQ && Comp != Comparison::NE) {
+    orderOfUpdateWords =
+        context->_qec.getIndex().getImpl().getOrderOfUpdateWords();
+    if (orderOfUpdateWords->numUpdateWords() == 0) {
+      orderOfUpdateWords.reset();
+    }
+  }
+  const OrderOfUpdateWords* order = orderOfUpdateWords.get();
+
   constexpr static bool value2IsString = ad_utility::isSimilar<S2, std::string>;
   if constexpr (ad_utility::isSimilar<S1, Variable> && isConstantResult<S2>) {
     auto columnIndex = context->getColumnIndexForVariable(value1);
     auto valueId = makeValueId(value2, context);
+    // The binary search relies on the order of the IDs, so it can't be used
+    // with the words of updates.
+    auto involvesWordsOfUpdates = [&]() {
+      if (order == nullptr) {
+        return false;
+      }
+      Id id = [&valueId]() {
+        if constexpr (value2IsString) {
+          return valueId.first;
+        } else {
+          return valueId;
+        }
+      }();
+      return order->isWordOfUpdate(id) ||
+             containsWordOfUpdate(value1, *order, context);
+    };
     const auto& cols = context->_columnsByWhichResultIsSorted;
-    if (!cols.empty() && cols[0] == columnIndex) {
+    if (!cols.empty() && cols[0] == columnIndex && !involvesWordsOfUpdates()) {
       if constexpr (value2IsString) {
         return evaluateWithBinarySearch<Comp>(value1, valueId.first,
                                               valueId.second, context);
@@ -286,26 +403,34 @@ requires AreComparable<S1, S2> ExpressionResult evaluateRelationalExpression(
       getGenerators(std::move(value1), std::move(value2), resultSize, context);
   auto itA = generatorA.begin();
   auto itB = generatorB.begin();
+  constexpr auto AlwaysUndef =
+      valueIdComparators::ComparisonForIncompatibleTypes::AlwaysUndef;
 
   for (size_t i = 0; i < resultSize; ++i) {
     if constexpr (requires {
                     valueIdComparators::compareIds(*itA, *itB, Comp);
                   }) {
       // Compare two `ValueId`s
-      result.push_back(toValueId(
-          valueIdComparators::compareIds<
-              valueIdComparators::ComparisonForIncompatibleTypes::AlwaysUndef>(
-              *itA, *itB, Comp)));
+      if (auto id = compareWordsOfUpdates<Comp>(order, *itA, *itB)) {
+        result.push_back(id.value());
+      } else {
+        result.push_back(toValueId(
+            valueIdComparators::compareIds<AlwaysUndef>(*itA, *itB, Comp)));
+      }
     } else if constexpr (requires {
                            valueIdComparators::compareWithEqualIds(
                                *itA, itB->first, itB->second, Comp);
                          }) {
       // Compare `ValueId` with range of equal `ValueId`s (used when `value2` is
       // `string` or `vector<string>`.
-      result.push_back(toValueId(
-          valueIdComparators::compareWithEqualIds<
-              valueIdComparators::ComparisonForIncompatibleTypes::AlwaysUndef>(
-              *itA, itB->first, itB->second, Comp)));
+      if (auto id = compareWordsOfUpdates<Comp>(order, *itA, itB->first,
+                                                itB->second, context)) {
+        result.push_back(id.value());
+      } else {
+        result.push_back(
+            toValueId(valueIdComparators::compareWithEqualIds<AlwaysUndef>(
+                *itA, itB->first, itB->second, Comp)));
+      }
     } else {
       // Compare two numeric values, or two string values.
       result.push_back(Id::makeFromBool(applyComparison<Comp>(*itA, *itB)));
@@ -427,6 +552,49 @@ RelationalExpression<Comp>::getLanguageFilterExpression() const {
   }
 }
 
+// _____________________________________________________________________________
+template <Comparison Comp>
+std::optional<SparqlExpression::RangeFilterData>
+RelationalExpression<Comp>::getRangeFilterExpression() const {
+  // We support both directions: ?x < 42 and 42 > ?x. In the second case the
+  // comparison has to be mirrored.
+  auto getRangeFilterData =
+      [](const auto& left, const auto& right,
+         Comparison comparison) -> std::optional<RangeFilterData> {
+    const auto* varPtr = dynamic_cast<const VariableExpression*>(left.get());
+    const auto* idPtr = dynamic_cast<const IdExpression*>(right.get());
+    if (!varPtr || !idPtr) {
+      return std::nullopt;
+    }
+    return RangeFilterData{varPtr->value(), comparison, idPtr->value()};
+  };
+
+  auto mirroredComparison = [] {
+    using enum Comparison;
+    switch (Comp) {
+      case LT:
+        return GT;
+      case LE:
+        return GE;
+      case GT:
+        return LT;
+      case GE:
+        return LE;
+      case EQ:
+      case NE:
+        return Comp;
+    }
+    AD_FAIL();
+  };
+
+  if (auto rangeFilterData =
+          getRangeFilterData(children_[0], children_[1], Comp)) {
+    return rangeFilterData;
+  } else {
+    return getRangeFilterData(children_[1], children_[0], mirroredComparison());
+  }
+}
+
 template <Comparison comp>
 SparqlExpression::Estimates
 RelationalExpression<comp>::getEstimatesForFilterExpression(
@@ -40,6 +40,10 @@ class RelationalExpression : public SparqlExpression {
   // the appropriate data.
   std::optional<LangFilterData> getLanguageFilterExpression() const override;
 
+  // Check if this expression has the form `?var comparison constant` or
+  // `constant comparison ?var` and return the appropriate data.
+  std::optional<RangeFilterData> getRangeFilterExpression() const override;
+
   // These expressions are typically used inside `FILTER` clauses, so we need
   // proper estimates.
   Estimates getEstimatesForFilterExpression(
@@ -37,6 +37,12 @@ class SampleExpression : public SparqlExpression {
   // __________________________________________________________________________
   std::span<Ptr> children() override { return {&_child, 1}; }
 
+  // If the argument of this SAMPLE is a single variable, return that variable,
+  // else return `std::nullopt`.
+  std::optional<::Variable> getAggregatedVariable() const {
+    return _child->getVariableOrNullopt();
+  }
+
  private:
   Ptr _child;
 };
@@ -105,8 +105,9 @@ class SparqlExpression {
     return std::nullopt;
   }
 
-  // For the following three functions (`containsLangExpression`,
-  // `getLanguageFilterExpression`, and `getEstimatesForFilterExpression`, see
+  // For the following four functions (`containsLangExpression`,
+  // `getLanguageFilterExpression`, `getRangeFilterExpression`, and
+  // `getEstimatesForFilterExpression`, see
   // the documentation of the functions of the same names in
   // `SparqlExpressionPimpl.h`. Each of them has a default implementation that
   // is correct for most of the expressions.
@@ -123,6 +124,12 @@ class SparqlExpression {
     return std::nullopt;
   }
 
+  // ___________________________________________________________________________
+  using RangeFilterData = SparqlExpressionPimpl::RangeFilterData;
+  virtual std::optional<RangeFilterData> getRangeFilterExpression() const {
+    return std::nullopt;
+  }
+
   // ___________________________________________________________________________
   using Estimates = SparqlExpressionPimpl::Estimates;
   virtual Estimates getEstimatesForFilterExpression(
@@ -84,6 +84,12 @@ SparqlExpressionPimpl::getLanguageFilterExpression() const {
   return _pimpl->getLanguageFilterExpression();
 }
 
+// _____________________________________________________________________________
+std::optional<SparqlExpressionPimpl::RangeFilterData>
+SparqlExpressionPimpl::getRangeFilterExpression() const {
+  return _pimpl->getRangeFilterExpression();
+}
+
 // _____________________________________________________________________________
 auto SparqlExpressionPimpl::getEstimatesForFilterExpression(
     uint64_t inputSizeEstimate,
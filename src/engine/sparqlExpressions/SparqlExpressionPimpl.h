@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "engine/VariableToColumnMap.h"
+#include "global/ValueIdComparators.h"
 #include "parser/data/Variable.h"
 #include "util/HashMap.h"
 #include "util/HashSet.h"
@@ -95,6 +96,19 @@ class SparqlExpressionPimpl {
   };
   std::optional<LangFilterData> getLanguageFilterExpression() const;
 
+  // If `this` is an expression of the form `?variable comparison constant` or
+  // `constant comparison ?variable`, where the constant is directly stored in
+  // an `Id` (e.g. a numeric literal or a date), return the variable, the
+  // comparison, and the constant. The comparison is normalized s.t. the
+  // variable is its left operand, for example `42 > ?x` becomes `?x < 42`.
+  // Else return `std::nullopt`.
+  struct RangeFilterData {
+    Variable variable_;
+    valueIdComparators::Comparison comparison_;
+    ValueId value_;
+  };
+  std::optional<RangeFilterData> getRangeFilterExpression() const;
+
   // Return true iff the `LANG()` function is used inside this expression.
   bool containsLangExpression() const;
 
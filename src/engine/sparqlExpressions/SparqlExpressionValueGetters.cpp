@@ -53,8 +53,7 @@ auto EffectiveBooleanValueGetter::operator()(
       // TODO<joka921> We could precompute whether the empty literal or empty
       // iri are contained in the KB.
       return context->_qec.getIndex()
-                     .getVocab()
-                     .indexToOptionalString(index)
+                     .idToOptionalString(index)
                      .value_or("")
                      .empty()
                  ? False
@@ -16,6 +16,7 @@
 static const size_t DEFAULT_STXXL_MEMORY_IN_BYTES = 5'000'000'000UL;
 static const size_t STXXL_DISK_SIZE_INDEX_BUILDER = 1000;  // In MB.
 static const size_t STXXL_DISK_SIZE_INDEX_TEST = 10;
+static const size_t STXXL_DISK_SIZE_SERVER = 10'000;  // In MB.
 
 static constexpr size_t DEFAULT_MEM_FOR_QUERIES_IN_GB = 4;
 
@@ -110,6 +111,11 @@ static const int DEFAULT_NOF_DATE_YEAR_DIGITS = 19;
 static const std::string INTERNAL_VOCAB_SUFFIX = ".vocabulary.internal";
 static const std::string EXTERNAL_VOCAB_SUFFIX = ".vocabulary.external";
 static const std::string MMAP_FILE_SUFFIX = ".meta";
+static const std::string DELTA_TRIPLES_SUFFIX = ".delta-triples";
+static const std::string UPDATE_VOCAB_SUFFIX = ".update-vocab";
+static const std::string SORT_ESTIMATES_SUFFIX = ".sort-estimates";
+static const std::string STARTUP_SNAPSHOT_SUFFIX = ".startup-snapshot";
+static const std::string PINNED_RESULTS_SUFFIX = ".pinned-results";
 static const std::string CONFIGURATION_FILE = ".meta-data.json";
 static const std::string PREFIX_FILE = ".prefixes";
 
@@ -188,9 +194,37 @@ inline auto& RuntimeParameters() {
       SizeT<"cache-max-num-entries">{1000},
       SizeT<"cache-max-size-gb">{30},
       SizeT<"cache-max-size-gb-single-entry">{5},
+      // The maximal number of query plans that are kept for queries that are
+      // sent repeatedly (see `QueryPlanCache`), zero disables the plan cache.
+      SizeT<"plan-cache-max-num-entries">{100},
       SizeT<"lazy-index-scan-queue-size">{20},
       SizeT<"lazy-index-scan-num-threads">{10},
-      SizeT<"lazy-index-scan-max-size-materialization">{1'000'000}};
+      SizeT<"lazy-index-scan-max-size-materialization">{1'000'000},
+      // The maximal total size of the decompressed blocks of the permutations
+      // that are cached (see `DecompressedBlockCache`).
+      SizeT<"block-cache-max-size-mb">{1'000},
+      // The maximal total size of the cached words and indices of the
+      // vocabulary (see `VocabularyCache`). Zero disables the cache.
+      SizeT<"vocabulary-cache-max-size-mb">{100},
+      // The maximal number of threads that are used by a single join, and the
+      // minimal number of input rows per thread. The threads are taken from a
+      // budget that is shared by all queries (see `ReservedThreads`).
+      SizeT<"join-max-num-threads">{8},
+      SizeT<"join-min-num-rows-per-thread">{1'000'000},
+      // The same for the hash-based GROUP BY.
+      SizeT<"group-by-max-num-threads">{8},
+      SizeT<"group-by-min-num-rows-per-thread">{1'000'000},
+      // Sort and ORDER BY operations with a larger estimated input are
+      // computed using an external sort (see `ExternalSort.h`) that uses about
+      // three times `sort-external-memory-mb` of RAM and the disk of STXXL
+      // (see the option `--stxxl-disk-size-gb` of `ServerMain`).
+      SizeT<"sort-in-memory-max-size-mb">{10'000},
+      SizeT<"sort-external-memory-mb">{1'000},
+      // The maximal number of threads for the search of a transitive path, and
+      // the number of start nodes that are handed to a thread at once. The
+      // threads are taken from the same budget as for the join.
+      SizeT<"transitive-path-max-num-threads">{8},
+      SizeT<"transitive-path-chunk-size">{64}};
   return params;
 }
 
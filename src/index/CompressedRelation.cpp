@@ -5,6 +5,7 @@
 #include "CompressedRelation.h"
 
 #include "engine/idTable/IdTable.h"
+#include "util/BitPacking.h"
 #include "util/Cache.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/ConcurrentCache.h"
@@ -18,6 +19,20 @@
 
 using namespace std::chrono_literals;
 
+// ____________________________________________________________________________
+DecompressedBlockCache& DecompressedBlockCache::shared() {
+  static DecompressedBlockCache cache{
+      RuntimeParameters().get<"block-cache-max-size-mb">() * 1'000'000};
+  return cache;
+}
+
+// ____________________________________________________________________________
+CompressedRelationReader::CompressedRelationReader(Allocator allocator)
+    : allocator_{std::move(allocator)} {
+  static std::atomic<size_t> nextBlockCacheId = 0;
+  blockCacheId_ = nextBlockCacheId++;
+}
+
 // ____________________________________________________________________________
 IdTable CompressedRelationReader::scan(
     const CompressedRelationMetadata& metadata,
@@ -63,25 +78,56 @@ IdTable CompressedRelationReader::scan(
 
   // Read all the other (complete!) blocks in parallel
   if (beginBlock < endBlock) {
+    auto& blockCache = DecompressedBlockCache::shared();
+    const bool isSmallScan = static_cast<size_t>(endBlock - beginBlock) <=
+                             DecompressedBlockCache::maxNumBlocksOfSmallScan;
 #pragma omp parallel
 #pragma omp single
     {
       for (; beginBlock < endBlock; ++beginBlock) {
         const auto& block = *beginBlock;
-        // Read a block from disk (serially).
-
-        CompressedBlock compressedBuffer =
-            readCompressedBlockFromFile(block, file, std::nullopt);
+        // If the block is not contained in the cache, read it from disk
+        // (serially).
+        auto cacheKey = blockCacheKey(block);
+        auto cachedBlock = blockCache.getIfContained(cacheKey);
+        const bool insertIntoCache =
+            !cachedBlock && blockCache.registerMiss(cacheKey, isSmallScan);
+        // Note: The `CompressedBlock` can't be copied, but OpenMP copies the
+        // lambda into the task below, so the block is shared.
+        std::shared_ptr<const CompressedBlock> compressedBuffer;
+        if (!cachedBlock) {
+          compressedBuffer = std::make_shared<const CompressedBlock>(
+              readCompressedBlockFromFile(block, file, std::nullopt));
+        }
 
-        // This lambda decompresses the block that was just read to the
-        // correct position in the result.
-        auto decompressLambda = [&result, rowIndexOfNextBlock, &block,
-                                 compressedBuffer =
-                                     std::move(compressedBuffer)]() {
+        // This lambda copies the cached block or decompresses the block that
+        // was just read to the correct position in the result. Only a block
+        // that is inserted into the cache is decompressed separately.
+        auto decompressLambda = [this, &result, rowIndexOfNextBlock, &block,
+                                 &blockCache, cacheKey, cachedBlock,
+                                 insertIntoCache, compressedBuffer]() {
           ad_utility::TimeBlockAndLog tbl{"Decompressing a block"};
-
-          decompressBlockToExistingIdTable(compressedBuffer, block.numRows_,
-                                           result, rowIndexOfNextBlock);
+          auto copyToResult = [&result,
+                               rowIndexOfNextBlock](const IdTable& input) {
+            for (size_t i = 0; i < input.numColumns(); ++i) {
+              std::ranges::copy(input.getColumn(i),
+                                result.getColumn(i).begin() +
+                                    rowIndexOfNextBlock);
+            }
+          };
+          if (cachedBlock) {
+            copyToResult(*cachedBlock);
+            return;
+          }
+          if (!insertIntoCache) {
+            decompressBlockToExistingIdTable(*compressedBuffer, block.numRows_,
+                                             result, rowIndexOfNextBlock);
+            return;
+          }
+          auto decompressedBlock =
+              decompressBlock(*compressedBuffer, block.numRows_);
+          copyToResult(decompressedBlock);
+          blockCache.insert(cacheKey, std::move(decompressedBlock));
         };
 
         // The `decompressLambda` can now run in parallel
@@ -115,6 +161,19 @@ CompressedRelationReader::asyncParallelBlockGenerator(
   }
   const size_t queueSize =
       RuntimeParameters().get<"lazy-index-scan-queue-size">();
+  // If the `file` is mapped into memory, advise the operating system to read
+  // ahead the next `queueSize` blocks, s.t. the reading of the blocks doesn't
+  // trigger a synchronous page fault for every page.
+  auto readAhead = [&file](const CompressedBlockMetadata& block) {
+    for (const auto& offset : block.offsetsAndCompressedSize_) {
+      file.adviseWillNeed(offset.compressedSize_, offset.offsetInFile_);
+    }
+  };
+  const auto numReadAheadBlocks = static_cast<ptrdiff_t>(queueSize);
+  for (auto it = beginBlock;
+       it != endBlock && it - beginBlock < numReadAheadBlocks; ++it) {
+    readAhead(*it);
+  }
   auto blockIterator = beginBlock;
   std::mutex blockIteratorMutex;
   auto readAndDecompressBlock =
@@ -133,14 +192,41 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     // so we have to compute it before incrementing the iterator.
     auto myIndex = static_cast<size_t>(blockIterator - beginBlock);
     ++blockIterator;
+    if (endBlock - blockIterator >= numReadAheadBlocks &&
+        numReadAheadBlocks > 0) {
+      readAhead(*(blockIterator + (numReadAheadBlocks - 1)));
+    }
+    // The cached blocks contain all the columns, so we might have to restrict
+    // them to the `columnIndices`.
+    auto restrictToColumnIndices = [&columnIndices](DecompressedBlock& result) {
+      if (columnIndices.has_value()) {
+        result.setColumnSubset(std::vector<ColumnIndex>(
+            columnIndices->begin(), columnIndices->end()));
+      }
+    };
+    auto& blockCache = DecompressedBlockCache::shared();
+    auto cacheKey = blockCacheKey(block);
+    auto cachedBlock = blockCache.getIfContained(cacheKey);
+    if (cachedBlock) {
+      lock.unlock();
+      DecompressedBlock result = cachedBlock->clone();
+      restrictToColumnIndices(result);
+      return std::pair{myIndex, std::move(result)};
+    }
+    const bool insertIntoCache = blockCache.registerMiss(cacheKey, false);
     // Note: the reading of the block could also happen without holding the
     // lock. We still perform it inside the lock to avoid contention of the
     // file. On a fast SSD we could possibly change this, but this has to be
     // investigated.
-    CompressedBlock compressedBlock =
-        readCompressedBlockFromFile(block, file, columnIndices);
+    CompressedBlock compressedBlock = readCompressedBlockFromFile(
+        block, file, insertIntoCache ? std::nullopt : columnIndices);
     lock.unlock();
-    return std::pair{myIndex, decompressBlock(compressedBlock, block.numRows_)};
+    DecompressedBlock result = decompressBlock(compressedBlock, block.numRows_);
+    if (insertIntoCache) {
+      blockCache.insert(cacheKey, result.clone());
+      restrictToColumnIndices(result);
+    }
+    return std::pair{myIndex, std::move(result)};
   };
   const size_t numThreads =
       RuntimeParameters().get<"lazy-index-scan-num-threads">();
@@ -403,6 +489,111 @@ CompressedRelationReader::getBlocksForJoin(
   return result;
 }
 
+// _____________________________________________________________________________
+CompressedBlockMetadata::ZoneMap CompressedBlockMetadata::ZoneMap::fromColumn(
+    std::span<const Id> column) {
+  if (column.empty()) {
+    return {};
+  }
+  auto [min, max] =
+      std::ranges::minmax(column, &valueIdComparators::compareByBits);
+  ZoneMap result{min, max, 0};
+  for (Id id : column) {
+    result.datatypes_ |= uint32_t{1} << static_cast<size_t>(id.getDatatype());
+  }
+  return result;
+}
+
+namespace {
+// If the values of all the `Id`s that lie between `min` and `max` wrt the
+// underlying bits are contained in the closed interval between the values of
+// `min` and `max`, return the bounds of this interval (smaller bound first).
+// This is the case if `min` and `max` have the same datatype and, for `Int`
+// and `Double`, the same sign (see `valueIdComparators::compareByBits` for
+// details). Otherwise, return `std::nullopt`.
+std::optional<std::pair<Id, Id>> getValueInterval(Id min, Id max) {
+  if (min.getDatatype() != max.getDatatype()) {
+    return std::nullopt;
+  }
+  switch (min.getDatatype()) {
+    case Datatype::Undefined:
+      return std::nullopt;
+    case Datatype::Int:
+      if ((min.getInt() < 0) != (max.getInt() < 0)) {
+        return std::nullopt;
+      }
+      return std::pair{min, max};
+    case Datatype::Double: {
+      double minValue = min.getDouble();
+      double maxValue = max.getDouble();
+      if (std::isnan(minValue) || std::isnan(maxValue) ||
+          std::signbit(minValue) != std::signbit(maxValue)) {
+        return std::nullopt;
+      }
+      // The negative doubles are ordered in reverse by their bits.
+      return std::signbit(minValue) ? std::pair{max, min} : std::pair{min, max};
+    }
+    default:
+      return std::pair{min, max};
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool CompressedBlockMetadata::ZoneMap::mayContainMatch(
+    valueIdComparators::Comparison comparison, Id value) const {
+  using namespace valueIdComparators;
+  // Only `Id`s with a datatype that is compatible to the `value` can match.
+  bool hasCompatibleDatatype = false;
+  for (size_t i = 0; i <= static_cast<size_t>(Datatype::MaxValue); ++i) {
+    hasCompatibleDatatype |= ((datatypes_ >> i) & 1) != 0 &&
+                             valueIdComparators::detail::areTypesCompatible(
+                                 static_cast<Datatype>(i), value.getDatatype());
+  }
+  if (!hasCompatibleDatatype) {
+    return false;
+  }
+  auto interval = getValueInterval(min_, max_);
+  if (!interval.has_value()) {
+    return true;
+  }
+  auto [lower, upper] = interval.value();
+  auto holds = [&value](Id id, Comparison comp) {
+    return compareIds(id, value, comp) == ComparisonResult::True;
+  };
+  using enum Comparison;
+  switch (comparison) {
+    case LT:
+      return holds(lower, LT);
+    case LE:
+      return holds(lower, LE);
+    case GT:
+      return holds(upper, GT);
+    case GE:
+      return holds(upper, GE);
+    case EQ:
+      return holds(lower, LE) && holds(upper, GE);
+    case NE:
+      return !(holds(lower, EQ) && holds(upper, EQ));
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+std::vector<CompressedBlockMetadata>
+CompressedRelationReader::getBlocksForFilter(
+    const MetadataAndBlocks& metadataAndBlocks,
+    valueIdComparators::Comparison comparison, Id value) {
+  std::vector<CompressedBlockMetadata> result;
+  std::ranges::copy_if(getBlocksFromMetadata(metadataAndBlocks),
+                       std::back_inserter(result),
+                       [comparison, value](const auto& block) {
+                         return block.col2ZoneMap_.mayContainMatch(comparison,
+                                                                   value);
+                       });
+  return result;
+}
+
 // _____________________________________________________________________________
 IdTable CompressedRelationReader::scan(
     const CompressedRelationMetadata& metadata, Id col1Id,
@@ -470,25 +661,57 @@ IdTable CompressedRelationReader::scan(
 
   // Insert the complete blocks from the middle in parallel
   if (beginBlock < endBlock) {
+    auto& blockCache = DecompressedBlockCache::shared();
+    const bool isSmallScan = static_cast<size_t>(endBlock - beginBlock) <=
+                             DecompressedBlockCache::maxNumBlocksOfSmallScan;
 #pragma omp parallel
 #pragma omp single
     for (; beginBlock < endBlock; ++beginBlock) {
       const auto& block = *beginBlock;
 
-      // Read the block serially, only read the second column.
+      // If the block is not contained in the cache, read it serially. Only
+      // the second column is read, unless the block is inserted into the
+      // cache, which holds complete blocks.
       AD_CORRECTNESS_CHECK(block.offsetsAndCompressedSize_.size() == 2);
-      CompressedBlock compressedBuffer =
-          readCompressedBlockFromFile(block, file, std::vector{1UL});
-
-      // A lambda that owns the compressed block decompresses it to the
-      // correct position in the result. It may safely be run in parallel
-      auto decompressLambda = [rowIndexOfNextBlockStart, &block, &result,
-                               compressedBuffer =
-                                   std::move(compressedBuffer)]() mutable {
-        ad_utility::TimeBlockAndLog tbl{"Decompression a block"};
+      auto cacheKey = blockCacheKey(block);
+      auto cachedBlock = blockCache.getIfContained(cacheKey);
+      const bool insertIntoCache =
+          !cachedBlock && blockCache.registerMiss(cacheKey, isSmallScan);
+      std::shared_ptr<const CompressedBlock> compressedBuffer;
+      if (!cachedBlock) {
+        compressedBuffer = std::make_shared<const CompressedBlock>(
+            readCompressedBlockFromFile(
+                block, file,
+                insertIntoCache ? std::nullopt
+                                : std::optional{std::vector{1UL}}));
+      }
 
-        decompressBlockToExistingIdTable(compressedBuffer, block.numRows_,
-                                         result, rowIndexOfNextBlockStart);
+      // A lambda that shares the cached or compressed block copies or
+      // decompresses the second column of it to the correct position in the
+      // result. It may safely be run in parallel
+      auto decompressLambda = [this, rowIndexOfNextBlockStart, &block, &result,
+                               &blockCache, cacheKey, cachedBlock,
+                               insertIntoCache, compressedBuffer]() {
+        ad_utility::TimeBlockAndLog tbl{"Decompression a block"};
+        auto copyToResult = [&result,
+                             rowIndexOfNextBlockStart](const IdTable& input) {
+          std::ranges::copy(
+              input.getColumn(1),
+              result.getColumn(0).begin() + rowIndexOfNextBlockStart);
+        };
+        if (cachedBlock) {
+          copyToResult(*cachedBlock);
+          return;
+        }
+        if (!insertIntoCache) {
+          decompressBlockToExistingIdTable(*compressedBuffer, block.numRows_,
+                                           result, rowIndexOfNextBlockStart);
+          return;
+        }
+        auto decompressedBlock =
+            decompressBlock(*compressedBuffer, block.numRows_);
+        copyToResult(decompressedBlock);
+        blockCache.insert(cacheKey, std::move(decompressedBlock));
       };
 
       // Register an OpenMP task that performs the decompression of this
@@ -521,16 +744,15 @@ DecompressedBlock CompressedRelationReader::readPossiblyIncompleteBlock(
     const CompressedBlockMetadata& blockMetadata,
     std::optional<std::reference_wrapper<LazyScanMetadata>> scanMetadata)
     const {
-  // A block is uniquely identified by its start position in the file.
-  auto cacheKey = blockMetadata.offsetsAndCompressedSize_.at(0).offsetInFile_;
-  DecompressedBlock block =
-      blockCache_
-          .computeOnce(cacheKey,
-                       [&]() {
-                         return readAndDecompressBlock(blockMetadata, file,
-                                                       std::nullopt);
-                       })
-          ._resultPointer->clone();
+  auto cacheKey = blockCacheKey(blockMetadata);
+  // Lazy scans (which are the ones with `scanMetadata`) are typically large,
+  // so their blocks are not inserted into the cache to keep it scan-resistant.
+  DecompressedBlock block = DecompressedBlockCache::shared().getOrCompute(
+      cacheKey,
+      [&]() {
+        return readAndDecompressBlock(blockMetadata, file, std::nullopt);
+      },
+      !scanMetadata.has_value());
   AD_CORRECTNESS_CHECK(block.numColumns() == 2);
   const auto& col1Column = block.getColumn(0);
   const auto& col2Column = block.getColumn(1);
@@ -699,12 +921,15 @@ void CompressedRelationWriter::writeRelationToExclusiveBlocks(
           {column.begin() + i, column.begin() + i + actualNumRowsPerBlock}));
     }
 
-    blockBuffer_.push_back(
-        CompressedBlockMetadata{std::move(offsets),
-                                actualNumRowsPerBlock,
-                                {col0Id, data[i][0], data[i][1]},
-                                {col0Id, data[i + actualNumRowsPerBlock - 1][0],
-                                 data[i + actualNumRowsPerBlock - 1][1]}});
+    const auto& col2 = data.getColumn(1);
+    blockBuffer_.push_back(CompressedBlockMetadata{
+        std::move(offsets),
+        actualNumRowsPerBlock,
+        {col0Id, data[i][0], data[i][1]},
+        {col0Id, data[i + actualNumRowsPerBlock - 1][0],
+         data[i + actualNumRowsPerBlock - 1][1]},
+        CompressedBlockMetadata::ZoneMap::fromColumn(
+            {col2.begin() + i, col2.begin() + i + actualNumRowsPerBlock})});
   }
 }
 
@@ -728,6 +953,8 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
                         });
 
   currentBlockData_.numRows_ = numRows;
+  currentBlockData_.col2ZoneMap_ =
+      CompressedBlockMetadata::ZoneMap::fromColumn(buffer_.getColumn(1));
   // The `firstId` and `lastId` of `currentBlockData_` were already set
   // correctly by `addRelation()`.
   blockBuffer_.push_back(currentBlockData_);
@@ -736,6 +963,14 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
   buffer_.clear();
 }
 
+// _____________________________________________________________________________
+DecompressedBlockCache::Key CompressedRelationReader::blockCacheKey(
+    const CompressedBlockMetadata& blockMetadata) const {
+  // A block is uniquely identified by its start position in the file.
+  return {blockCacheId_,
+          blockMetadata.offsetsAndCompressedSize_.at(0).offsetInFile_};
+}
+
 // _____________________________________________________________________________
 CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     const CompressedBlockMetadata& blockMetaData, ad_utility::File& file,
@@ -752,14 +987,23 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     }
   }
   CompressedBlock compressedBuffer;
-  compressedBuffer.resize(columnIndices->size());
-  // TODO<C++23> Use `std::views::zip`
-  for (size_t i = 0; i < compressedBuffer.size(); ++i) {
+  compressedBuffer.columns_.reserve(columnIndices->size());
+  for (size_t columnIndex : columnIndices.value()) {
     const auto& offset =
-        blockMetaData.offsetsAndCompressedSize_.at(columnIndices->at(i));
-    auto& currentCol = compressedBuffer[i];
-    currentCol.resize(offset.compressedSize_);
-    file.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+        blockMetaData.offsetsAndCompressedSize_.at(columnIndex);
+    compressedBuffer.encodings_.push_back(offset.encoding_);
+    if (file.isMappedIntoMemory()) {
+      compressedBuffer.columns_.push_back(
+          file.getMappedRange(offset.compressedSize_, offset.offsetInFile_));
+    } else {
+      // Note: The data of the `buffers_` doesn't move when the `buffers_`
+      // grow, so the views in the `columns_` stay valid.
+      auto& currentCol =
+          compressedBuffer.buffers_.emplace_back(offset.compressedSize_);
+      file.read(currentCol.data(), offset.compressedSize_,
+                offset.offsetInFile_);
+      compressedBuffer.columns_.emplace_back(currentCol);
+    }
   }
   return compressedBuffer;
 }
@@ -771,7 +1015,8 @@ DecompressedBlock CompressedRelationReader::decompressBlock(
   decompressedBlock.resize(numRowsToRead);
   for (size_t i = 0; i < compressedBlock.size(); ++i) {
     auto col = decompressedBlock.getColumn(i);
-    decompressColumn(compressedBlock[i], numRowsToRead, col.data());
+    decompressColumn(compressedBlock[i], compressedBlock.encodings_[i],
+                     numRowsToRead, col.data());
   }
   return decompressedBlock;
 }
@@ -785,21 +1030,39 @@ void CompressedRelationReader::decompressBlockToExistingIdTable(
   AD_CORRECTNESS_CHECK(compressedBlock.size() == table.numColumns());
   for (size_t i = 0; i < compressedBlock.size(); ++i) {
     auto col = table.getColumn(i);
-    decompressColumn(compressedBlock[i], numRowsToRead,
-                     col.data() + offsetInTable);
+    decompressColumn(compressedBlock[i], compressedBlock.encodings_[i],
+                     numRowsToRead, col.data() + offsetInTable);
   }
 }
 
 // ____________________________________________________________________________
 template <typename Iterator>
 void CompressedRelationReader::decompressColumn(
-    const std::vector<char>& compressedBlock, size_t numRowsToRead,
+    std::span<const char> compressedBlock,
+    CompressedBlockMetadata::ColumnEncoding encoding, size_t numRowsToRead,
     Iterator iterator) {
-  auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
-      compressedBlock.data(), compressedBlock.size(), iterator,
-      numRowsToRead * sizeof(*iterator));
   static_assert(sizeof(Id) == sizeof(*iterator));
-  AD_CORRECTNESS_CHECK(numRowsToRead * sizeof(Id) == numBytesActuallyRead);
+  static_assert(sizeof(Id) == sizeof(uint64_t));
+  using enum CompressedBlockMetadata::ColumnEncoding;
+  namespace bitPacking = ad_utility::bitPacking;
+  // The bit-packed encodings operate on the bits of the `Id`s.
+  auto* bits = reinterpret_cast<uint64_t*>(&*iterator);
+  switch (encoding) {
+    case Zstd: {
+      auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
+          compressedBlock.data(), compressedBlock.size(), iterator,
+          numRowsToRead * sizeof(*iterator));
+      AD_CORRECTNESS_CHECK(numRowsToRead * sizeof(Id) == numBytesActuallyRead);
+      return;
+    }
+    case FrameOfReference:
+      bitPacking::decodeFrameOfReference(compressedBlock, numRowsToRead, bits);
+      return;
+    case Delta:
+      bitPacking::decodeDelta(compressedBlock, numRowsToRead, bits);
+      return;
+  }
+  AD_FAIL();
 }
 
 // _____________________________________________________________________________
@@ -815,12 +1078,31 @@ DecompressedBlock CompressedRelationReader::readAndDecompressBlock(
 // _____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
 CompressedRelationWriter::compressAndWriteColumn(std::span<const Id> column) {
+  using enum CompressedBlockMetadata::ColumnEncoding;
+  namespace bitPacking = ad_utility::bitPacking;
   std::vector<char> compressedBlock = ZstdWrapper::compress(
       (void*)(column.data()), column.size() * sizeof(column[0]));
+  auto encoding = Zstd;
+  // Use a bit-packed encoding if it is at most as large as the Zstd
+  // compression, as it is much cheaper to decode.
+  auto useIfSmaller = [&](CompressedBlockMetadata::ColumnEncoding candidate,
+                          std::vector<char> encoded) {
+    if (encoded.size() <= compressedBlock.size()) {
+      compressedBlock = std::move(encoded);
+      encoding = candidate;
+    }
+  };
+  std::vector<uint64_t> bits;
+  bits.reserve(column.size());
+  std::ranges::transform(column, std::back_inserter(bits), &Id::getBits);
+  useIfSmaller(FrameOfReference, bitPacking::encodeFrameOfReference(bits));
+  if (std::ranges::is_sorted(bits)) {
+    useIfSmaller(Delta, bitPacking::encodeDelta(bits));
+  }
   auto offsetInFile = outfile_.tell();
   auto compressedSize = compressedBlock.size();
   outfile_.write(compressedBlock.data(), compressedBlock.size());
-  return {offsetInFile, compressedSize};
+  return {offsetInFile, compressedSize, encoding};
 };
 
 // _____________________________________________________________________________
@@ -6,20 +6,25 @@
 #define QLEVER_COMPRESSEDRELATION_H
 
 #include <algorithm>
+#include <atomic>
+#include <span>
 #include <vector>
 
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "global/ValueIdComparators.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "util/BufferedVector.h"
 #include "util/Cache.h"
 #include "util/ConcurrentCache.h"
 #include "util/File.h"
 #include "util/Generator.h"
+#include "util/HashSet.h"
 #include "util/Serializer/ByteBufferSerializer.h"
 #include "util/Serializer/SerializeArray.h"
 #include "util/Serializer/SerializeVector.h"
 #include "util/Serializer/Serializer.h"
+#include "util/Synchronized.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
 
@@ -44,17 +49,28 @@ using SmallRelationsBuffer = columnBasedIdTable::IdTable<Id, NumColumns>;
 // to use a dynamic `IdTable`.
 using DecompressedBlock = IdTable;
 
-// After compression the columns have different sizes, so we cannot use an
-// `IdTable`.
-using CompressedBlock = std::vector<std::vector<char>>;
-
 // The metadata of a compressed block of ID triples in an index permutation.
 struct CompressedBlockMetadata {
+  // The encodings of a column of a block. Each column is stored with the
+  // encoding that yields the smallest size (see
+  // `CompressedRelationWriter::compressAndWriteColumn`).
+  enum struct ColumnEncoding : uint8_t {
+    // The raw `Id`s, compressed by Zstd.
+    Zstd,
+    // The `Id`s relative to their minimum, bit-packed (see `BitPacking.h`).
+    FrameOfReference,
+    // The differences of consecutive `Id`s, bit-packed. Only possible for
+    // sorted columns.
+    Delta
+  };
+  friend std::true_type allowTrivialSerialization(ColumnEncoding, auto);
+
   // Since we have column-based indices, the two columns of each block are
   // stored separately (but adjacently).
   struct OffsetAndCompressedSize {
     off_t offsetInFile_;
     size_t compressedSize_;
+    ColumnEncoding encoding_ = ColumnEncoding::Zstd;
     bool operator==(const OffsetAndCompressedSize&) const = default;
   };
   std::vector<OffsetAndCompressedSize> offsetsAndCompressedSize_;
@@ -85,14 +101,53 @@ struct CompressedBlockMetadata {
   PermutedTriple firstTriple_;
   PermutedTriple lastTriple_;
 
+  // A "zone map" of a column of a block: The smallest and largest `Id` (wrt the
+  // underlying bits) of the column, and the set of `Datatype`s that occur in
+  // the column (as a bitmask). It is used to skip blocks during scans with a
+  // filter on the column (see `CompressedRelationReader::getBlocksForFilter`).
+  // The default-constructed zone map describes a column about which nothing is
+  // known, so blocks with such a zone map are never skipped. Note: The
+  // `datatypes_` are currently only used to skip the blocks that contain no
+  // `Id` that is comparable to the constant of a range comparison. There are
+  // no FILTERs on the datatype alone (e.g. `isNumeric(?x)`) that could use
+  // them directly.
+  struct ZoneMap {
+    Id min_ = Id::min();
+    Id max_ = Id::max();
+    uint32_t datatypes_ = ~uint32_t{0};
+
+    // Compute the zone map of the given `column`.
+    static ZoneMap fromColumn(std::span<const Id> column);
+
+    // Return false if no `Id` of the column can fulfill the condition
+    // `id comparison value` (with the semantics of a SPARQL FILTER, see
+    // `valueIdComparators::compareIds`), and true if such an `Id` might exist.
+    bool mayContainMatch(valueIdComparators::Comparison comparison,
+                         Id value) const;
+
+    bool operator==(const ZoneMap&) const = default;
+  };
+  // The zone map of the last column (col2). The col1 doesn't need a zone map,
+  // as it is sorted within a relation, so its range is already known from the
+  // `firstTriple_` and `lastTriple_`.
+  ZoneMap col2ZoneMap_;
+
   // Two of these are equal if all members are equal.
   bool operator==(const CompressedBlockMetadata&) const = default;
 };
 
+// Serialization of the `ZoneMap` subclass.
+AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::ZoneMap) {
+  serializer | arg.min_;
+  serializer | arg.max_;
+  serializer | arg.datatypes_;
+}
+
 // Serialization of the `OffsetAndcompressedSize` subclass.
 AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::OffsetAndCompressedSize) {
   serializer | arg.offsetInFile_;
   serializer | arg.compressedSize_;
+  serializer | arg.encoding_;
 }
 
 // Serialization of the block metadata.
@@ -101,8 +156,32 @@ AD_SERIALIZE_FUNCTION(CompressedBlockMetadata) {
   serializer | arg.numRows_;
   serializer | arg.firstTriple_;
   serializer | arg.lastTriple_;
+  serializer | arg.col2ZoneMap_;
 }
 
+// After compression the columns have different sizes, so we cannot use an
+// `IdTable`. If the file of the permutation is mapped into memory, the columns
+// are views directly into this mapping. Otherwise, the columns are read into
+// the `buffers_` and the `columns_` are views into these buffers. A copy would
+// still point into the `buffers_` of the original, so this type can only be
+// moved (which keeps the data of the `buffers_` in place).
+struct CompressedBlock {
+  std::vector<std::span<const char>> columns_;
+  std::vector<std::vector<char>> buffers_;
+  // The encoding of each of the `columns_` (see
+  // `CompressedBlockMetadata::ColumnEncoding`).
+  std::vector<CompressedBlockMetadata::ColumnEncoding> encodings_;
+
+  CompressedBlock() = default;
+  CompressedBlock(CompressedBlock&&) noexcept = default;
+  CompressedBlock& operator=(CompressedBlock&&) noexcept = default;
+  CompressedBlock(const CompressedBlock&) = delete;
+  CompressedBlock& operator=(const CompressedBlock&) = delete;
+
+  size_t size() const { return columns_.size(); }
+  std::span<const char> operator[](size_t i) const { return columns_[i]; }
+};
+
 // The metadata of a whole compressed "relation", where relation refers to a
 // maximal sequence of triples with equal first component (e.g., P for the PSO
 // permutation).
@@ -218,6 +297,131 @@ class CompressedRelationWriter {
       std::span<const Id> column);
 };
 
+// A cache for decompressed blocks that is shared by the
+// `CompressedRelationReader`s of all the permutations. The total size of the
+// cached blocks is bounded by the runtime parameter `block-cache-max-size-mb`.
+// The numbers of cache hits and misses are counted for the statistics of the
+// server.
+//
+// A block that is read from disk is only inserted if it is likely to be read
+// again (see `registerMiss`), s.t. a single large scan doesn't evict all the
+// frequently used blocks.
+class DecompressedBlockCache {
+ public:
+  // A block is identified by the ID of the reader it belongs to (see
+  // `CompressedRelationReader::blockCacheId_`) and its offset in the file.
+  using Key = std::pair<size_t, off_t>;
+
+  // The blocks of a scan with at most this many blocks are always inserted.
+  static constexpr size_t maxNumBlocksOfSmallScan = 4;
+  // The maximal number of keys in `recentMisses_`. If it is exceeded, the
+  // set is cleared.
+  static constexpr size_t maxNumRecentMisses = 100'000;
+
+ private:
+  // The size of a block in bytes.
+  struct SizeGetter {
+    size_t operator()(const DecompressedBlock& block) const {
+      return block.numRows() * block.numColumns() * sizeof(Id);
+    }
+  };
+  mutable ad_utility::ConcurrentCache<
+      ad_utility::HeapBasedLRUCache<Key, DecompressedBlock, SizeGetter>>
+      cache_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  // The keys of the blocks that were read from disk once without being
+  // inserted.
+  ad_utility::Synchronized<ad_utility::HashSet<Key>> recentMisses_;
+
+ public:
+  explicit DecompressedBlockCache(size_t maxSizeInBytes)
+      : cache_{ad_utility::size_t_max, maxSizeInBytes, maxSizeInBytes} {}
+
+  // Return (a copy of) the block with the given `key`. If the block is not
+  // contained in the cache, it is computed by calling `computeBlock()`. The
+  // computed block is only inserted into the cache if `admitToCache` is true.
+  // This allows scans that read many blocks once to use the cache without
+  // evicting the frequently used blocks.
+  template <std::invocable ComputeBlock>
+  DecompressedBlock getOrCompute(const Key& key, ComputeBlock computeBlock,
+                                 bool admitToCache) {
+    auto result = cache_.computeOnce(key, computeBlock, !admitToCache);
+    if (result._resultPointer == nullptr) {
+      ++numMisses_;
+      return computeBlock();
+    }
+    if (result._cacheStatus == ad_utility::CacheStatus::computed) {
+      ++numMisses_;
+    } else {
+      ++numHits_;
+    }
+    return result._resultPointer->clone();
+  }
+
+  // Return the block with the given `key` if it is contained in the cache
+  // (which is counted as a hit), and `nullptr` otherwise. In the latter case,
+  // the caller reads the block from disk and has to call `registerMiss`.
+  std::shared_ptr<const DecompressedBlock> getIfContained(const Key& key) {
+    auto result = cache_.getIfContained(key);
+    if (!result.has_value()) {
+      return nullptr;
+    }
+    ++numHits_;
+    return std::move(result.value()._resultPointer);
+  }
+
+  // Count the block with the given `key` as a miss, because it is read from
+  // disk. Return true iff the block should afterwards be inserted (see
+  // `insert`). This is the case if it is read by a scan with at most
+  // `maxNumBlocksOfSmallScan` blocks (`isSmallScan`), or if the same block was
+  // already read from disk before without being inserted.
+  bool registerMiss(const Key& key, bool isSmallScan) {
+    ++numMisses_;
+    if (isSmallScan) {
+      return true;
+    }
+    auto recentMisses = recentMisses_.wlock();
+    if (recentMisses->erase(key) > 0) {
+      return true;
+    }
+    if (recentMisses->size() >= maxNumRecentMisses) {
+      recentMisses->clear();
+    }
+    recentMisses->insert(key);
+    return false;
+  }
+
+  // Insert the `block` with the given `key` into the cache if it is not yet
+  // contained. This is meant to be called after `registerMiss` returned true,
+  // so it is not counted as a miss again.
+  void insert(const Key& key, DecompressedBlock block) {
+    cache_.computeOnce(key, [&block]() { return std::move(block); });
+  }
+
+  // Change the maximal total size of the cached blocks. Blocks are evicted if
+  // necessary.
+  void setMaxSizeInBytes(size_t maxSizeInBytes) {
+    cache_.setMaxSizeSingleEntry(maxSizeInBytes);
+    cache_.setMaxSize(maxSizeInBytes);
+  }
+
+  // Remove all the blocks from the cache.
+  void clear() {
+    cache_.clearAll();
+    recentMisses_.wlock()->clear();
+  }
+
+  // Getters for the statistics.
+  size_t numHits() const { return numHits_; }
+  size_t numMisses() const { return numMisses_; }
+  size_t numEntries() const { return cache_.numNonPinnedEntries(); }
+  size_t sizeInBytes() const { return cache_.nonPinnedSize(); }
+
+  // The cache that is shared by all the `CompressedRelationReader`s.
+  static DecompressedBlockCache& shared();
+};
+
 /// Manage the reading of relations from disk that have been previously written
 /// using the `CompressedRelationWriter`.
 class CompressedRelationReader {
@@ -256,22 +460,15 @@ class CompressedRelationReader {
   using IdTableGenerator = cppcoro::generator<IdTable, LazyScanMetadata>;
 
  private:
-  // This cache stores a small number of decompressed blocks. Its current
-  // purpose is to make the e2e-tests run fast. They contain many SPARQL queries
-  // with ?s ?p ?o triples in the body.
-  // Note: The cache is thread-safe and using it does not change the semantics
-  // of this class, so it is safe to mark it as `mutable` to make the `scan`
-  // functions below `const`.
-  mutable ad_utility::ConcurrentCache<
-      ad_utility::HeapBasedLRUCache<off_t, DecompressedBlock>>
-      blockCache_{20ul};
+  // The blocks of this reader in the shared `DecompressedBlockCache` are
+  // identified by this ID, which is unique for each reader.
+  size_t blockCacheId_;
 
   // The allocator used to allocate intermediate buffers.
   mutable Allocator allocator_;
 
  public:
-  explicit CompressedRelationReader(Allocator allocator)
-      : allocator_{std::move(allocator)} {}
+  explicit CompressedRelationReader(Allocator allocator);
   /**
    * @brief For a permutation XYZ, retrieve all YZ for a given X.
    *
@@ -307,6 +504,15 @@ class CompressedRelationReader {
       std::span<const Id> joinColumn,
       const MetadataAndBlocks& metadataAndBlocks);
 
+  // Get the blocks (an ordered subset of the blocks that are passed in via the
+  // `metadataAndBlocks`) that might contain triples for which the condition
+  // `col2Id comparison value` holds according to the `ZoneMap` of the col2 of
+  // the blocks. All other blocks can be skipped when scanning with a FILTER on
+  // the last column of the scan.
+  static std::vector<CompressedBlockMetadata> getBlocksForFilter(
+      const MetadataAndBlocks& metadataAndBlocks,
+      valueIdComparators::Comparison comparison, Id value);
+
   // For each of `metadataAndBlocks1, metadataAndBlocks2` get the blocks (an
   // ordered subset of the blocks in the `scanMetadata` that might contain
   // matching elements in the following scenario: The result of
@@ -381,9 +587,16 @@ class CompressedRelationReader {
   const Allocator& allocator() const { return allocator_; }
 
  private:
+  // The key of the block that is identified by the `blockMetadata` in the
+  // shared `DecompressedBlockCache`. The cached blocks always contain all the
+  // columns of the block.
+  DecompressedBlockCache::Key blockCacheKey(
+      const CompressedBlockMetadata& blockMetadata) const;
+
   // Read the block that is identified by the `blockMetaData` from the `file`.
   // If `columnIndices` is `nullopt`, then all columns of the block are read,
-  // else only the specified columns are read.
+  // else only the specified columns are read. If the `file` is mapped into
+  // memory, nothing is copied (see `CompressedBlock`).
   static CompressedBlock readCompressedBlockFromFile(
       const CompressedBlockMetadata& blockMetaData, ad_utility::File& file,
       std::optional<std::vector<size_t>> columnIndices);
@@ -404,11 +617,13 @@ class CompressedRelationReader {
       IdTable& table, size_t offsetInTable);
 
   // Helper function used by `decompressBlock` and
-  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn` and
-  // store the result at the `iterator`. For the `numRowsToRead` argument, see
-  // the documentation of `decompressBlock`.
+  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn`,
+  // which has the given `encoding`, and store the result at the `iterator`.
+  // For the `numRowsToRead` argument, see the documentation of
+  // `decompressBlock`.
   template <typename Iterator>
-  static void decompressColumn(const std::vector<char>& compressedColumn,
+  static void decompressColumn(std::span<const char> compressedColumn,
+                               CompressedBlockMetadata::ColumnEncoding encoding,
                                size_t numRowsToRead, Iterator iterator);
 
   // Read the block that is identified by the `blockMetaData` from the `file`,
@@ -436,7 +651,9 @@ class CompressedRelationReader {
   // `columnIndices` are set, that only the specified columns from the blocks
   // are yielded, else the complete blocks are yielded. The blocks are yielded
   // in the correct order, but asynchronously read and decompressed using
-  // multiple worker threads.
+  // multiple worker threads. Blocks that are contained in the
+  // `DecompressedBlockCache` are taken from there, the blocks that are read
+  // are inserted according to `DecompressedBlockCache::registerMiss`.
   IdTableGenerator asyncParallelBlockGenerator(
       auto beginBlock, auto endBlock, ad_utility::File& file,
       std::optional<std::vector<size_t>> columnIndices,
@@ -69,6 +69,10 @@ constexpr size_t NUM_PARALLEL_ITEM_MAPS = 6;
 // parser is used.
 constexpr size_t NUM_PARALLEL_PARSER_THREADS = 5;
 
+// The number of input files that are parsed concurrently (each by its own
+// parser) when the index is built from several input files.
+constexpr size_t NUM_CONCURRENTLY_PARSED_INPUT_FILES = 4;
+
 // Increasing the following two constants increases the RAM usage without much
 // benefit to the performance.
 
@@ -0,0 +1,427 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/DeltaTriples.h"
+
+#include <cmath>
+#include <ranges>
+
+#include "absl/strings/str_cat.h"
+#include "util/AppendOnlyFile.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeArray.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+using Triple = PermutationDeltas::Triple;
+using TripleIterator = std::vector<Triple>::const_iterator;
+
+// Return the range of the `triples` that have the given `col0Id` (and `col1Id`
+// if specified).
+auto getRange(const std::set<Triple>& triples, Id col0Id,
+              std::optional<Id> col1Id) {
+  Triple lower{col0Id, col1Id.value_or(Id::min()), Id::min()};
+  Triple upper{col0Id, col1Id.value_or(Id::max()), Id::max()};
+  return std::ranges::subrange(triples.lower_bound(lower),
+                               triples.upper_bound(upper));
+}
+
+// Merge the `baseTriples` and the `recentTriples` of the two levels of a
+// `PermutationDeltas`. The `baseTriples` that are contained in
+// `recentOppositeTriples` (the deleted triples of the recent level if the
+// inserted triples are merged and vice versa) are overridden and skipped.
+std::vector<Triple> mergeLevels(const auto& baseTriples,
+                                const auto& recentTriples,
+                                const std::set<Triple>& recentOppositeTriples) {
+  std::vector<Triple> result;
+  auto notOverridden = [&recentOppositeTriples](const Triple& triple) {
+    return !recentOppositeTriples.contains(triple);
+  };
+  std::ranges::set_union(baseTriples | std::views::filter(notOverridden),
+                         recentTriples, std::back_inserter(result));
+  return result;
+}
+
+// Merge the rows of the `block`, which contain the last `block.numColumns()`
+// entries of a triple, with the inserted triples from `[insertedIt,
+// insertedEnd)`, and remove the rows that are contained in `[deletedIt,
+// deletedEnd)`. Inserted triples that are larger than the last row of the
+// `block` are only added if `isLastBlock` is true. The iterators are advanced
+// past the triples that have been dealt with.
+IdTable mergeBlock(const IdTable& block, TripleIterator& insertedIt,
+                   TripleIterator insertedEnd, TripleIterator& deletedIt,
+                   TripleIterator deletedEnd, bool isLastBlock,
+                   const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  const size_t numColumns = block.numColumns();
+  const size_t offset = 3 - numColumns;
+  auto compare = [numColumns, offset](const auto& row, const Triple& triple) {
+    for (size_t i = 0; i < numColumns; ++i) {
+      if (row[i] != triple[offset + i]) {
+        return row[i] <=> triple[offset + i];
+      }
+    }
+    return std::strong_ordering::equal;
+  };
+  IdTable result{numColumns, allocator};
+  result.reserve(block.size());
+  auto pushTriple = [&result, numColumns, offset](const Triple& triple) {
+    result.emplace_back();
+    for (size_t i = 0; i < numColumns; ++i) {
+      result(result.size() - 1, i) = triple[offset + i];
+    }
+  };
+  for (const auto& row : block) {
+    while (insertedIt != insertedEnd && compare(row, *insertedIt) > 0) {
+      pushTriple(*insertedIt);
+      ++insertedIt;
+    }
+    // An inserted triple that already exists is only reported once.
+    if (insertedIt != insertedEnd && compare(row, *insertedIt) == 0) {
+      ++insertedIt;
+    }
+    while (deletedIt != deletedEnd && compare(row, *deletedIt) > 0) {
+      ++deletedIt;
+    }
+    if (deletedIt != deletedEnd && compare(row, *deletedIt) == 0) {
+      continue;
+    }
+    result.push_back(row);
+  }
+  if (isLastBlock) {
+    for (; insertedIt != insertedEnd; ++insertedIt) {
+      pushTriple(*insertedIt);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void PermutationDeltas::insert(const Triple& permutedTriple) {
+  Level& recent = mutableRecentLevel();
+  recent.deleted_.erase(permutedTriple);
+  recent.inserted_.insert(permutedTriple);
+  mergeLevelsIfNecessary();
+}
+
+// _____________________________________________________________________________
+void PermutationDeltas::erase(const Triple& permutedTriple) {
+  Level& recent = mutableRecentLevel();
+  recent.inserted_.erase(permutedTriple);
+  recent.deleted_.insert(permutedTriple);
+  mergeLevelsIfNecessary();
+}
+
+// _____________________________________________________________________________
+auto PermutationDeltas::mutableRecentLevel() -> Level& {
+  // Only this object can create new copies of `recent_`, so if it is not
+  // shared now, it can't become shared while it is modified.
+  if (recent_.use_count() > 1) {
+    recent_ = std::make_shared<Level>(*recent_);
+  }
+  return *recent_;
+}
+
+// _____________________________________________________________________________
+void PermutationDeltas::mergeLevelsIfNecessary() {
+  auto maxSizeOfRecentLevel = std::max(
+      minSizeOfRecentLevel_,
+      static_cast<size_t>(std::sqrt(static_cast<double>(base_->size()))));
+  if (recent_->size() <= maxSizeOfRecentLevel) {
+    return;
+  }
+  auto toSet = [](const std::vector<Triple>& triples) {
+    return std::set<Triple>(triples.begin(), triples.end());
+  };
+  Level merged;
+  merged.inserted_ = toSet(
+      mergeLevels(base_->inserted_, recent_->inserted_, recent_->deleted_));
+  merged.deleted_ = toSet(
+      mergeLevels(base_->deleted_, recent_->deleted_, recent_->inserted_));
+  base_ = std::make_shared<const Level>(std::move(merged));
+  recent_ = std::make_shared<Level>();
+}
+
+// _____________________________________________________________________________
+std::set<Triple> PermutationDeltas::inserted() const {
+  auto triples =
+      mergeLevels(base_->inserted_, recent_->inserted_, recent_->deleted_);
+  return {triples.begin(), triples.end()};
+}
+
+// _____________________________________________________________________________
+std::set<Triple> PermutationDeltas::deleted() const {
+  auto triples =
+      mergeLevels(base_->deleted_, recent_->deleted_, recent_->inserted_);
+  return {triples.begin(), triples.end()};
+}
+
+namespace {
+// Return the number of triples of the `base` and the `recent` set of triples
+// of two levels, where the `recent` one takes precedence (see
+// `mergeLevels`).
+size_t getNumTriples(const std::set<Triple>& base,
+                     const std::set<Triple>& recent,
+                     const std::set<Triple>& recentOpposite) {
+  auto numOverridden = [&base](const std::set<Triple>& triples) {
+    return static_cast<size_t>(std::ranges::count_if(
+        triples, [&base](const Triple& t) { return base.contains(t); }));
+  };
+  return base.size() - numOverridden(recent) - numOverridden(recentOpposite) +
+         recent.size();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+size_t PermutationDeltas::numInserted() const {
+  return getNumTriples(base_->inserted_, recent_->inserted_,
+                       recent_->deleted_);
+}
+
+// _____________________________________________________________________________
+size_t PermutationDeltas::numDeleted() const {
+  return getNumTriples(base_->deleted_, recent_->deleted_,
+                       recent_->inserted_);
+}
+
+// _____________________________________________________________________________
+auto PermutationDeltas::getTriples(bool getInserted, Id col0Id,
+                                   std::optional<Id> col1Id) const
+    -> std::vector<Triple> {
+  const auto& base = getInserted ? base_->inserted_ : base_->deleted_;
+  const auto& recent = getInserted ? recent_->inserted_ : recent_->deleted_;
+  const auto& recentOpposite =
+      getInserted ? recent_->deleted_ : recent_->inserted_;
+  return mergeLevels(getRange(base, col0Id, col1Id),
+                     getRange(recent, col0Id, col1Id), recentOpposite);
+}
+
+namespace {
+// Return true iff `getTriples` would return a non-empty result for the same
+// arguments, without materializing the triples.
+bool hasTriples(const std::set<Triple>& base, const std::set<Triple>& recent,
+                const std::set<Triple>& recentOpposite, Id col0Id,
+                std::optional<Id> col1Id) {
+  return !getRange(recent, col0Id, col1Id).empty() ||
+         std::ranges::any_of(getRange(base, col0Id, col1Id),
+                             [&recentOpposite](const Triple& triple) {
+                               return !recentOpposite.contains(triple);
+                             });
+}
+}  // namespace
+
+// _____________________________________________________________________________
+bool PermutationDeltas::hasInsertedTriples(Id col0Id,
+                                           std::optional<Id> col1Id) const {
+  return hasTriples(base_->inserted_, recent_->inserted_, recent_->deleted_,
+                    col0Id, col1Id);
+}
+
+// _____________________________________________________________________________
+bool PermutationDeltas::hasDeletedTriples(Id col0Id,
+                                          std::optional<Id> col1Id) const {
+  return hasTriples(base_->deleted_, recent_->deleted_, recent_->inserted_,
+                    col0Id, col1Id);
+}
+
+// _____________________________________________________________________________
+size_t PermutationDeltas::getNumInsertedTriples(
+    Id col0Id, std::optional<Id> col1Id) const {
+  return getTriples(true, col0Id, col1Id).size();
+}
+
+// _____________________________________________________________________________
+std::vector<Id> PermutationDeltas::getCol0IdsOfInsertedTriples() const {
+  std::vector<Id> result;
+  for (const auto& triple : inserted()) {
+    if (result.empty() || result.back() != triple[0]) {
+      result.push_back(triple[0]);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+IdTable PermutationDeltas::mergeIntoScanResult(IdTable scanResult, Id col0Id,
+                                               std::optional<Id> col1Id) const {
+  AD_CONTRACT_CHECK(scanResult.numColumns() == (col1Id.has_value() ? 1 : 2));
+  auto inserted = getTriples(true, col0Id, col1Id);
+  auto deleted = getTriples(false, col0Id, col1Id);
+  if (inserted.empty() && deleted.empty()) {
+    return scanResult;
+  }
+  auto insertedIt = inserted.cbegin();
+  auto deletedIt = deleted.cbegin();
+  return mergeBlock(scanResult, insertedIt, inserted.cend(), deletedIt,
+                    deleted.cend(), true, scanResult.getAllocator());
+}
+
+// _____________________________________________________________________________
+PermutationDeltas::IdTableGenerator PermutationDeltas::mergeIntoLazyScan(
+    std::shared_ptr<const PermutationDeltas> deltas, IdTableGenerator blocks,
+    Id col0Id, std::optional<Id> col1Id,
+    ad_utility::AllocatorWithLimit<Id> allocator) {
+  AD_CONTRACT_CHECK(deltas != nullptr);
+  const auto inserted = deltas->getTriples(true, col0Id, col1Id);
+  const auto deleted = deltas->getTriples(false, col0Id, col1Id);
+  auto insertedIt = inserted.begin();
+  auto insertedEnd = inserted.end();
+  auto deletedIt = deleted.begin();
+  auto deletedEnd = deleted.end();
+  CompressedRelationReader::LazyScanMetadata& details =
+      co_await cppcoro::getDetails;
+  for (IdTable& block : blocks) {
+    const auto& blockDetails = blocks.details();
+    details.numBlocksRead_ = blockDetails.numBlocksRead_;
+    details.numElementsRead_ = blockDetails.numElementsRead_;
+    details.blockingTimeMs_ = blockDetails.blockingTimeMs_;
+    auto merged = mergeBlock(block, insertedIt, insertedEnd, deletedIt,
+                             deletedEnd, false, allocator);
+    if (!merged.empty()) {
+      co_yield merged;
+    }
+  }
+  if (insertedIt != insertedEnd) {
+    IdTable remainder{col1Id.has_value() ? 1 : 2, allocator};
+    co_yield mergeBlock(remainder, insertedIt, insertedEnd, deletedIt,
+                        deletedEnd, true, allocator);
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::insertTriple(const Triple& spoTriple) {
+  for (size_t i = 0; i < permutationDeltas_.size(); ++i) {
+    auto keyOrder = Permutation::toKeyOrder(static_cast<Permutation::Enum>(i));
+    permutationDeltas_[i].insert({spoTriple[keyOrder[0]],
+                                  spoTriple[keyOrder[1]],
+                                  spoTriple[keyOrder[2]]});
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::deleteTriple(const Triple& spoTriple) {
+  for (size_t i = 0; i < permutationDeltas_.size(); ++i) {
+    auto keyOrder = Permutation::toKeyOrder(static_cast<Permutation::Enum>(i));
+    permutationDeltas_[i].erase({spoTriple[keyOrder[0]],
+                                 spoTriple[keyOrder[1]],
+                                 spoTriple[keyOrder[2]]});
+  }
+}
+
+// _____________________________________________________________________________
+size_t DeltaTriples::numInserted() const {
+  return getPermutationDeltas(Permutation::SPO).numInserted();
+}
+
+// _____________________________________________________________________________
+size_t DeltaTriples::numDeleted() const {
+  return getPermutationDeltas(Permutation::SPO).numDeleted();
+}
+
+namespace {
+namespace appendOnlyFile = ad_utility::appendOnlyFile;
+using ad_utility::serialization::ByteBufferReadSerializer;
+using ad_utility::serialization::ByteBufferWriteSerializer;
+
+// The records of the file with the delta triples (see
+// `DeltaTriples::writeToFile`). The first record contains the build ID of the
+// index, each of the following ones the deleted and then the inserted triples
+// of one operation in SPO order via the bit representation of their IDs.
+appendOnlyFile::Record makeBuildIdRecord(const std::string& indexBuildId) {
+  ByteBufferWriteSerializer serializer;
+  serializer << indexBuildId;
+  return std::move(serializer).data();
+}
+
+std::vector<std::array<uint64_t, 3>> toBits(const auto& spoTriples) {
+  std::vector<std::array<uint64_t, 3>> bits;
+  bits.reserve(std::ranges::size(spoTriples));
+  for (const auto& triple : spoTriples) {
+    bits.push_back(
+        {triple[0].getBits(), triple[1].getBits(), triple[2].getBits()});
+  }
+  return bits;
+}
+
+appendOnlyFile::Record makeTriplesRecord(const auto& deletedSpoTriples,
+                                         const auto& insertedSpoTriples) {
+  ByteBufferWriteSerializer serializer;
+  serializer << toBits(deletedSpoTriples);
+  serializer << toBits(insertedSpoTriples);
+  return std::move(serializer).data();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void DeltaTriples::writeToFile(const std::string& filename,
+                               const std::string& indexBuildId) {
+  const auto& spo = getPermutationDeltas(Permutation::SPO);
+  std::vector<appendOnlyFile::Record> records;
+  records.push_back(makeBuildIdRecord(indexBuildId));
+  records.push_back(makeTriplesRecord(spo.deleted(), spo.inserted()));
+  appendOnlyFile::writeRecords(filename, records);
+  numTriplesInFile_ = numInserted() + numDeleted();
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::appendToFile(const std::string& filename,
+                                const std::string& indexBuildId,
+                                const std::vector<Triple>& deletedSpoTriples,
+                                const std::vector<Triple>& insertedSpoTriples) {
+  // Rewrite the file if the same triples were inserted and deleted so often
+  // that most of it is obsolete.
+  numTriplesInFile_ += deletedSpoTriples.size() + insertedSpoTriples.size();
+  if (!std::filesystem::exists(filename) ||
+      numTriplesInFile_ > 2 * (numInserted() + numDeleted()) +
+                              PermutationDeltas::defaultMinSizeOfRecentLevel) {
+    writeToFile(filename, indexBuildId);
+    return;
+  }
+  appendOnlyFile::appendRecord(
+      filename, makeTriplesRecord(deletedSpoTriples, insertedSpoTriples));
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::readFromFile(const std::string& filename,
+                                const std::string& indexBuildId) {
+  clear();
+  auto records = appendOnlyFile::readRecords(filename);
+  AD_CORRECTNESS_CHECK(!records.empty());
+  std::string buildId;
+  ByteBufferReadSerializer buildIdSerializer{std::move(records.front())};
+  buildIdSerializer >> buildId;
+  checkBuildId(filename, buildId, indexBuildId);
+  numTriplesInFile_ = 0;
+  for (auto& record : records | std::views::drop(1)) {
+    ByteBufferReadSerializer serializer{std::move(record)};
+    std::vector<std::array<uint64_t, 3>> deleted;
+    std::vector<std::array<uint64_t, 3>> inserted;
+    serializer >> deleted;
+    serializer >> inserted;
+    auto toTriple = [](const std::array<uint64_t, 3>& bits) {
+      return Triple{Id::fromBits(bits[0]), Id::fromBits(bits[1]),
+                    Id::fromBits(bits[2])};
+    };
+    for (const auto& bits : deleted) {
+      deleteTriple(toTriple(bits));
+    }
+    for (const auto& bits : inserted) {
+      insertTriple(toTriple(bits));
+    }
+    numTriplesInFile_ += deleted.size() + inserted.size();
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::checkBuildId(const std::string& filename,
+                                const std::string& buildId,
+                                const std::string& indexBuildId) {
+  if (buildId != indexBuildId) {
+    throw std::runtime_error{absl::StrCat(
+        "The file \"", filename,
+        "\" was written for another build of the index (build ID \"", buildId,
+        "\" instead of \"", indexBuildId,
+        "\"), delete it to use the index without the updates from that file")};
+  }
+}
@@ -0,0 +1,178 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "index/CompressedRelation.h"
+#include "index/Permutation.h"
+
+// The triples of a single permutation that were inserted into or deleted from
+// the index after it was built. The triples are stored in the order of the
+// permutation (e.g. as (P, S, O) for the PSO permutation). When a permutation
+// is scanned, they are merged on the fly with the triples from the compressed
+// blocks (see `Permutation::scan` and `Permutation::lazyScan`).
+//
+// The same triple is never contained in both the inserted and the deleted
+// triples. An inserted triple that is also contained in the compressed blocks
+// is only reported once, and deleting a triple that is not contained in the
+// compressed blocks has no effect.
+class PermutationDeltas {
+ public:
+  using Triple = std::array<Id, 3>;
+  using IdTableGenerator = CompressedRelationReader::IdTableGenerator;
+
+  // The minimal size of the `recent_` level before it is merged into the
+  // `base_` level (see below).
+  static constexpr size_t defaultMinSizeOfRecentLevel = 1000;
+
+ private:
+  struct Level {
+    std::set<Triple> inserted_;
+    std::set<Triple> deleted_;
+    size_t size() const { return inserted_.size() + deleted_.size(); }
+  };
+  // The permutations hold immutable copies of their deltas, which are replaced
+  // after each update. To make these copies cheap, the triples are stored in
+  // two levels that are shared between the copies. The large `base_` level is
+  // never modified. Changes are applied to the small `recent_` level, which is
+  // copied first if it is shared, and which takes precedence over the `base_`.
+  // When the `recent_` level becomes larger than the square root of the size
+  // of the `base_` level, both are merged into a new `base_`. This bounds the
+  // amortized cost of a change by O(sqrt(n)) instead of O(n).
+  std::shared_ptr<const Level> base_ = std::make_shared<const Level>();
+  std::shared_ptr<Level> recent_ = std::make_shared<Level>();
+  size_t minSizeOfRecentLevel_ = defaultMinSizeOfRecentLevel;
+
+ public:
+  explicit PermutationDeltas(
+      size_t minSizeOfRecentLevel = defaultMinSizeOfRecentLevel)
+      : minSizeOfRecentLevel_{minSizeOfRecentLevel} {}
+
+  // Insert or delete the `permutedTriple`. The last call for a given triple
+  // wins.
+  void insert(const Triple& permutedTriple);
+  void erase(const Triple& permutedTriple);
+
+  // Return all the inserted (deleted) triples. Note that this creates a copy.
+  std::set<Triple> inserted() const;
+  std::set<Triple> deleted() const;
+  size_t numInserted() const;
+  size_t numDeleted() const;
+  bool empty() const { return numInserted() == 0 && numDeleted() == 0; }
+
+  // Return true iff there are inserted (deleted) triples with the given
+  // `col0Id` (and the given `col1Id` if specified).
+  bool hasInsertedTriples(Id col0Id, std::optional<Id> col1Id) const;
+  bool hasDeletedTriples(Id col0Id, std::optional<Id> col1Id) const;
+
+  // Return the number of inserted triples with the given `col0Id` (and
+  // `col1Id`).
+  size_t getNumInsertedTriples(Id col0Id, std::optional<Id> col1Id) const;
+
+  // Return the sorted and unique `col0Id`s of all inserted triples.
+  std::vector<Id> getCol0IdsOfInsertedTriples() const;
+
+  // Return the number of triples in the `base_` and the `recent_` level (for
+  // testing).
+  std::pair<size_t, size_t> getSizesOfLevels() const {
+    return {base_->size(), recent_->size()};
+  }
+
+  // Merge the deltas into the `scanResult`, which is the result of
+  // `CompressedRelationReader::scan` for the `col0Id` (and the `col1Id` if
+  // specified, then the result has only one column).
+  IdTable mergeIntoScanResult(IdTable scanResult, Id col0Id,
+                              std::optional<Id> col1Id) const;
+
+  // Same as `mergeIntoScanResult`, but for the lazy scan `blocks`. The
+  // `deltas` are kept alive by the returned generator. Inserted triples that
+  // are larger than the last row of a block are yielded together with the next
+  // block, the remaining ones after the last block. The details of the
+  // `blocks` are passed on to the returned generator.
+  static IdTableGenerator mergeIntoLazyScan(
+      std::shared_ptr<const PermutationDeltas> deltas, IdTableGenerator blocks,
+      Id col0Id, std::optional<Id> col1Id,
+      ad_utility::AllocatorWithLimit<Id> allocator);
+
+ private:
+  // Return the inserted (if `getInserted` is true) or the deleted triples with
+  // the given `col0Id` (and `col1Id` if specified) from both levels.
+  std::vector<Triple> getTriples(bool getInserted, Id col0Id,
+                                 std::optional<Id> col1Id) const;
+
+  // Return the `recent_` level for modification (see above).
+  Level& mutableRecentLevel();
+
+  // Merge the `recent_` level into the `base_` if it has become too large.
+  void mergeLevelsIfNecessary();
+};
+
+// The triples that were inserted into or deleted from an index after it was
+// built, for all the six permutations. This allows regular updates of the
+// data without rebuilding the index. The deltas are written to disk next to the
+// index (see `IndexImpl::insertTriples`) and can be folded into the compressed
+// blocks of the permutations via `IndexImpl::compactDeltaTriples`.
+//
+// NOTE: The triples must only consist of IDs that are stable across queries,
+// in particular they must not contain IDs from the `LocalVocab` of a query
+// result (the words that are introduced by updates get stable IDs, see
+// `IndexImpl::getOrAddIdForUpdate`).
+class DeltaTriples {
+ public:
+  using Triple = PermutationDeltas::Triple;
+
+ private:
+  // Indexed by `static_cast<size_t>(Permutation::Enum)`.
+  std::array<PermutationDeltas, 6> permutationDeltas_;
+  // The number of triples in the file that was last read or written.
+  size_t numTriplesInFile_ = 0;
+
+ public:
+  // Insert or delete a triple that is given in SPO order.
+  void insertTriple(const Triple& spoTriple);
+  void deleteTriple(const Triple& spoTriple);
+
+  // The deltas for a single permutation.
+  const PermutationDeltas& getPermutationDeltas(Permutation::Enum p) const {
+    return permutationDeltas_.at(static_cast<size_t>(p));
+  }
+
+  size_t numInserted() const;
+  size_t numDeleted() const;
+  bool empty() const { return numInserted() == 0 && numDeleted() == 0; }
+  void clear() { permutationDeltas_ = {}; }
+
+  // Write the inserted and the deleted triples to the given file, and read
+  // them back. The file also stores the `indexBuildId` (see
+  // `IndexImpl::getBuildId`), `readFromFile` throws if it differs from the one
+  // of the current index. The file is replaced atomically.
+  void writeToFile(const std::string& filename,
+                   const std::string& indexBuildId);
+  void readFromFile(const std::string& filename,
+                    const std::string& indexBuildId);
+
+  // Append the triples that have just been deleted and inserted (in this
+  // order) by a single operation to the file as a single record, s.t. the file
+  // doesn't have to be rewritten for each update and never contains only a
+  // part of the operation. Falls back to `writeToFile` if the file doesn't
+  // exist yet or if most of it has become obsolete.
+  void appendToFile(const std::string& filename,
+                    const std::string& indexBuildId,
+                    const std::vector<Triple>& deletedSpoTriples,
+                    const std::vector<Triple>& insertedSpoTriples);
+
+  // Throw an exception if the `buildId` that was read from the file with the
+  // given `filename` is not the `indexBuildId` of the current index.
+  static void checkBuildId(const std::string& filename,
+                           const std::string& buildId,
+                           const std::string& indexBuildId);
+};
@@ -23,6 +23,11 @@ void Index::createFromFile(const std::string& filename) {
   pimpl_->createFromFile(filename);
 }
 
+// ____________________________________________________________________________
+void Index::createFromFiles(const std::vector<std::string>& filenames) {
+  pimpl_->createFromFiles(filenames);
+}
+
 // ____________________________________________________________________________
 void Index::addPatternsToExistingIndex() {
   pimpl_->addPatternsToExistingIndex();
@@ -33,6 +38,26 @@ void Index::createFromOnDiskIndex(const std::string& onDiskBase) {
   pimpl_->createFromOnDiskIndex(onDiskBase);
 }
 
+// ____________________________________________________________________________
+void Index::insertTriples(const std::vector<std::array<Id, 3>>& triples) {
+  pimpl_->insertTriples(triples);
+}
+
+// ____________________________________________________________________________
+void Index::deleteTriples(const std::vector<std::array<Id, 3>>& triples) {
+  pimpl_->deleteTriples(triples);
+}
+
+// ____________________________________________________________________________
+void Index::deleteAndInsertTriples(
+    const std::vector<std::array<Id, 3>>& toDelete,
+    const std::vector<std::array<Id, 3>>& toInsert) {
+  pimpl_->deleteAndInsertTriples(toDelete, toInsert);
+}
+
+// ____________________________________________________________________________
+void Index::compactDeltaTriples() { pimpl_->compactDeltaTriples(); }
+
 // ____________________________________________________________________________
 void Index::addTextFromContextFile(const std::string& contextFile,
                                    bool addWordsFromLiterals) {
@@ -76,6 +101,12 @@ std::optional<std::string> Index::idToOptionalString(VocabIndex id) const {
   return pimpl_->idToOptionalString(id);
 }
 
+// ____________________________________________________________________________
+std::vector<std::optional<std::string>> Index::idsToOptionalStrings(
+    std::span<const VocabIndex> sortedIds) const {
+  return pimpl_->idsToOptionalStrings(sortedIds);
+}
+
 // ____________________________________________________________________________
 bool Index::getId(const std::string& element, Id* id) const {
   return pimpl_->getId(element, id);
@@ -87,7 +118,7 @@ std::pair<Id, Id> Index::prefix_range(const std::string& prefix) const {
 }
 
 // ____________________________________________________________________________
-const vector<PatternID>& Index::getHasPattern() const {
+std::span<const PatternID> Index::getHasPattern() const {
   return pimpl_->getHasPattern();
 }
 
@@ -237,6 +268,24 @@ void Index::setLoadAllPermutations(bool loadAllPermutations) {
   return pimpl_->setLoadAllPermutations(loadAllPermutations);
 }
 
+// ____________________________________________________________________________
+void Index::setParallelPermutations(bool parallelPermutations) {
+  return pimpl_->setParallelPermutations(parallelPermutations);
+}
+
+// ____________________________________________________________________________
+void Index::setMemoryMapPermutations(bool memoryMapPermutations) {
+  return pimpl_->setMemoryMapPermutations(memoryMapPermutations);
+}
+
+// ____________________________________________________________________________
+void Index::setMemoryResidentPermutations(
+    std::vector<Permutation::Enum> permutations, bool useHugePages,
+    bool lockInMemory) {
+  return pimpl_->setMemoryResidentPermutations(std::move(permutations),
+                                               useHugePages, lockInMemory);
+}
+
 // ____________________________________________________________________________
 void Index::setKeepTempFiles(bool keepTempFiles) {
   return pimpl_->setKeepTempFiles(keepTempFiles);
@@ -270,6 +319,11 @@ void Index::setPrefixCompression(bool compressed) {
   return pimpl_->setPrefixCompression(compressed);
 }
 
+// ____________________________________________________________________________
+void Index::setFrontCodedExternalVocabulary(bool frontCoded) {
+  return pimpl_->setFrontCodedExternalVocabulary(frontCoded);
+}
+
 // ____________________________________________________________________________
 void Index::setNumTriplesPerBatch(uint64_t numTriplesPerBatch) {
   return pimpl_->setNumTriplesPerBatch(numTriplesPerBatch);
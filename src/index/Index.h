@@ -7,6 +7,7 @@
 
 #include <array>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -71,6 +72,10 @@ class Index {
   // setup by `createFromOnDiskIndex` after this call.
   void createFromFile(const std::string& filename);
 
+  // Same as `createFromFile`, but read the triples from several files, which
+  // are parsed concurrently.
+  void createFromFiles(const std::vector<std::string>& filenames);
+
   void addPatternsToExistingIndex();
 
   // Create an index object from an on-disk index that has previously been
@@ -79,6 +84,17 @@ class Index {
   // handles.
   void createFromOnDiskIndex(const std::string& onDiskBase);
 
+  // Insert or delete triples (in SPO order) without rebuilding the index, see
+  // `IndexImpl::insertTriples` for details.
+  void insertTriples(const std::vector<std::array<Id, 3>>& triples);
+  void deleteTriples(const std::vector<std::array<Id, 3>>& triples);
+  void deleteAndInsertTriples(const std::vector<std::array<Id, 3>>& toDelete,
+                              const std::vector<std::array<Id, 3>>& toInsert);
+
+  // Fold the inserted and deleted triples into the permutations. The index has
+  // to be setup by `createFromOnDiskIndex` after this call.
+  void compactDeltaTriples();
+
   // Add a text index to a complete KB index. First read the given context
   // file (if file name not empty), then add words from literals (if true).
   void addTextFromContextFile(const std::string& contextFile,
@@ -123,11 +139,16 @@ class Index {
   [[nodiscard]] std::optional<std::string> idToOptionalString(
       VocabIndex id) const;
 
+  // Same as `idToOptionalString` for each of the `sortedIds`, but faster than
+  // calling it for each ID, see `Vocabulary::indicesToOptionalStrings`.
+  [[nodiscard]] std::vector<std::optional<std::string>> idsToOptionalStrings(
+      std::span<const VocabIndex> sortedIds) const;
+
   bool getId(const std::string& element, Id* id) const;
 
   [[nodiscard]] std::pair<Id, Id> prefix_range(const std::string& prefix) const;
 
-  [[nodiscard]] const vector<PatternID>& getHasPattern() const;
+  [[nodiscard]] std::span<const PatternID> getHasPattern() const;
   [[nodiscard]] const CompactVectorOfStrings<Id>& getHasPredicate() const;
   [[nodiscard]] const CompactVectorOfStrings<Id>& getPatterns() const;
   /**
@@ -220,6 +241,31 @@ class Index {
 
   void setLoadAllPermutations(bool loadAllPermutations);
 
+  // If set to true, the SPO/SOP and OSP/OPS permutations are created in
+  // parallel during the index build. This is faster on machines with many
+  // cores, but requires more memory and temporary disk space.
+  void setParallelPermutations(bool parallelPermutations);
+
+  // If set to true, the files of the permutations are mapped into memory when
+  // the index is loaded. The compressed blocks are then handed to the
+  // decompression directly from the mapping instead of being copied into
+  // buffers, and the caching of the blocks is left to the page cache of the
+  // operating system.
+  void setMemoryMapPermutations(bool memoryMapPermutations);
+
+  // Completely load the given `permutations` into memory when the index is
+  // loaded (see `Permutation::loadIntoMemory`). This gives predictable scan
+  // times for these permutations at the cost of the memory for their files.
+  // Permutations that are not loaded (see `setLoadAllPermutations`) are
+  // skipped. The blocks stay compressed in memory. Decompressed blocks are
+  // additionally kept in the `DecompressedBlockCache` if they are read
+  // repeatedly or by small scans (see `DecompressedBlockCache::registerMiss`).
+  // See `ad_utility::File::loadIntoMemory` for `useHugePages` and
+  // `lockInMemory`.
+  void setMemoryResidentPermutations(
+      std::vector<Permutation::Enum> permutations, bool useHugePages = false,
+      bool lockInMemory = false);
+
   void setKeepTempFiles(bool keepTempFiles);
 
   uint64_t& stxxlMemoryInBytes();
@@ -233,6 +279,10 @@ class Index {
 
   void setPrefixCompression(bool compressed);
 
+  // Store the externalized words front-coded and compressed in blocks (see
+  // `FrontCodedVocabulary`) instead of one by one (default: false).
+  void setFrontCodedExternalVocabulary(bool frontCoded);
+
   void setNumTriplesPerBatch(uint64_t numTriplesPerBatch);
 
   const std::string& getTextName() const;
@@ -9,8 +9,11 @@
 #include <exception>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "CompilationInfo.h"
+#include "absl/strings/str_join.h"
 #include "global/Constants.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/Index.h"
@@ -71,13 +74,16 @@ int main(int argc, char** argv) {
   string kbIndexName;
   string settingsFile;
   string filetype;
-  string inputFile;
+  std::vector<string> inputFiles;
   bool noPrefixCompression = false;
+  bool frontCodedExternalVocabulary = false;
   bool noPatterns = false;
   bool onlyAddTextIndex = false;
   bool keepTemporaryFiles = false;
   bool onlyPsoAndPos = false;
+  bool parallelPermutations = false;
   bool addWordsFromLiterals = false;
+  bool compactDeltaTriples = false;
   std::optional<ad_utility::NonNegative> stxxlMemoryGB;
   optind = 1;
 
@@ -91,13 +97,14 @@ int main(int argc, char** argv) {
   add("help,h", "Produce this help message.");
   add("index-basename,i", po::value(&baseName)->required(),
       "The basename of the output files (required).");
-  add("kg-input-file,f", po::value(&inputFile),
-      "The file with the knowledge graph data to be parsed from. If omitted, "
-      "will read from stdin.");
+  add("kg-input-file,f", po::value(&inputFiles)->multitoken(),
+      "The file(s) with the knowledge graph data to be parsed from. Files "
+      "ending in `.gz` or `.zst` are decompressed on the fly. Several files "
+      "are parsed concurrently. If omitted, will read from stdin.");
   add("file-format,F", po::value(&filetype),
-      "The format of the input file with the knowledge graph data. Must be one "
-      "of [nt|ttl]. If not set, QLever will try to deduce it from the "
-      "filename suffix.");
+      "The format of the input files with the knowledge graph data. Must be "
+      "one of [nt|ttl]. If not set, QLever will try to deduce it from the "
+      "filename suffix of the first input file.");
   add("kg-index-name,K", po::value(&kbIndexName),
       "The name of the knowledge graph index (default: basename of "
       "`kg-input-file`).");
@@ -125,6 +132,11 @@ int main(int argc, char** argv) {
       "Disable the precomputation for `ql:has-predicate`.");
   add("no-compressed-vocabulary,N", po::bool_switch(&noPrefixCompression),
       "Do not apply prefix compression to the vocabulary (default: do apply).");
+  add("front-coded-external-vocabulary",
+      po::bool_switch(&frontCodedExternalVocabulary),
+      "Store the externalized part of the vocabulary front-coded and "
+      "compressed in blocks. This requires much less disk space, but makes "
+      "the access to single externalized words slower (default: false).");
   add("only-pos-and-pso-permutations,o", po::bool_switch(&onlyPsoAndPos),
       "Only build the PSO and POS permutations. This is faster, but then "
       "queries with predicate variables are not supported");
@@ -135,6 +147,14 @@ int main(int argc, char** argv) {
       "Decrease if the index builder runs out of memory.");
   add("keep-temporary-files,k", po::bool_switch(&keepTemporaryFiles),
       "Do not delete temporary files from index creation for debugging.");
+  add("parallel-permutations", po::bool_switch(&parallelPermutations),
+      "Create the SPO/SOP and OSP/OPS permutations in parallel. This is "
+      "faster on machines with many cores, but requires more memory and "
+      "temporary disk space.");
+  add("compact-delta-triples", po::bool_switch(&compactDeltaTriples),
+      "Fold the triples that were inserted into or deleted from the existing "
+      "index with the given `index-basename` into its permutations, and do "
+      "nothing else.");
 
   // Process command line arguments.
   po::variables_map optionsMap;
@@ -164,8 +184,8 @@ int main(int argc, char** argv) {
 
   // If no index name was specified, take the part of the input file name after
   // the last slash.
-  if (kbIndexName.empty() && !inputFile.empty()) {
-    kbIndexName = ad_utility::getLastPartOfString(inputFile, '/');
+  if (kbIndexName.empty() && !inputFiles.empty()) {
+    kbIndexName = ad_utility::getLastPartOfString(inputFiles.front(), '/');
   }
 
   LOG(INFO) << EMPH_ON << "QLever IndexBuilder, compiled on "
@@ -188,13 +208,34 @@ int main(int argc, char** argv) {
     index.setKeepTempFiles(keepTemporaryFiles);
     index.setSettingsFile(settingsFile);
     index.setPrefixCompression(!noPrefixCompression);
+    index.setFrontCodedExternalVocabulary(frontCodedExternalVocabulary);
     index.setLoadAllPermutations(!onlyPsoAndPos);
+    index.setParallelPermutations(parallelPermutations);
+    if (compactDeltaTriples) {
+      index.createFromOnDiskIndex(baseName);
+      index.compactDeltaTriples();
+      ad_utility::deleteFile(stxxlFileName);
+      return 0;
+    }
     // NOTE: If `onlyAddTextIndex` is true, we do not want to construct an
     // index, but we assume that it already exists. In particular, we then need
     // the vocabulary from the KB index for building the text index.
     if (!onlyAddTextIndex) {
-      if (inputFile.empty() || inputFile == "-") {
-        inputFile = "/dev/stdin";
+      if (inputFiles.empty()) {
+        inputFiles.push_back("-");
+      }
+      for (auto& inputFile : inputFiles) {
+        if (inputFile == "-") {
+          inputFile = "/dev/stdin";
+        }
+      }
+      // The format is deduced from the extension before the compression
+      // suffix (e.g. `.ttl` for `data.ttl.gz`).
+      std::string_view inputFile = inputFiles.front();
+      for (std::string_view suffix : {".gz", ".zst"}) {
+        if (inputFile.ends_with(suffix)) {
+          inputFile.remove_suffix(suffix.size());
+        }
       }
 
       if (!filetype.empty()) {
@@ -223,13 +264,14 @@ int main(int argc, char** argv) {
       }
 
       if (filetype == "ttl") {
-        LOG(DEBUG) << "Parsing uncompressed TTL from: " << inputFile
+        LOG(DEBUG) << "Parsing TTL from: " << absl::StrJoin(inputFiles, ", ")
                    << std::endl;
-        index.createFromFile(inputFile);
+        index.createFromFiles(inputFiles);
       } else if (filetype == "nt") {
-        LOG(DEBUG) << "Parsing uncompressed N-Triples from: " << inputFile
+        LOG(DEBUG) << "Parsing N-Triples from: "
+                   << absl::StrJoin(inputFiles, ", ")
                    << " (using the Turtle parser)" << std::endl;
-        index.createFromFile(inputFile);
+        index.createFromFiles(inputFiles);
       } else {
         LOG(ERROR) << "File format must be one of: nt ttl" << std::endl;
         std::cerr << boostOptions << std::endl;
@@ -9,21 +9,30 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <filesystem>
 #include <future>
+#include <numeric>
 #include <optional>
 #include <unordered_map>
 
 #include "CompilationInfo.h"
+#include "absl/cleanup/cleanup.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "index/IndexFormatVersion.h"
 #include "index/PrefixHeuristic.h"
 #include "index/TriplesView.h"
 #include "index/VocabularyGenerator.h"
 #include "parser/ParallelParseBuffer.h"
+#include "util/AppendOnlyFile.h"
 #include "util/BatchedPipeline.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/HashMap.h"
+#include "util/Random.h"
+#include "util/Serializer/ByteBufferSerializer.h"
 #include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/StableHash.h"
 #include "util/TupleHelpers.h"
 
 using std::array;
@@ -45,6 +54,11 @@ IndexBuilderDataAsPsoSorter IndexImpl::createIdTriplesAndVocab(
 
   LOG(INFO) << "Converting external vocabulary to binary format ..."
             << std::endl;
+  configurationJson_["front-coded-external-vocabulary"] =
+      frontCodedExternalVocabulary_;
+  vocab_.setExternalVocabularyType(frontCodedExternalVocabulary_
+                                       ? PolymorphicVocabulary::Type::FrontCoded
+                                       : PolymorphicVocabulary::Type::OnDisk);
   vocab_.externalizeLiteralsFromTextFile(
       onDiskBase_ + EXTERNAL_LITS_TEXT_FILE_NAME,
       onDiskBase_ + EXTERNAL_VOCAB_SUFFIX);
@@ -77,14 +91,31 @@ void createPatternsFromSpoTriplesView(auto&& spoTriplesView,
 
 // _____________________________________________________________________________
 void IndexImpl::createFromFile(const string& filename) {
-  LOG(INFO) << "Processing input triples from " << filename << " ..."
-            << std::endl;
+  createFromFiles({filename});
+}
+
+// _____________________________________________________________________________
+void IndexImpl::createFromFiles(const std::vector<string>& filenames) {
+  AD_CONTRACT_CHECK(!filenames.empty());
+  LOG(INFO) << "Processing input triples from "
+            << absl::StrJoin(filenames, ", ") << " ..." << std::endl;
   string indexFilename = onDiskBase_ + ".index";
 
   readIndexBuilderSettingsFromFile();
 
-  auto setTokenizer = [this,
-                       &filename]<template <typename> typename ParserTemplate>()
+  // Files that were written next to an earlier index with the same basename
+  // refer to the IDs of that index and must not be used with the new one.
+  for (const auto& suffix :
+       {DELTA_TRIPLES_SUFFIX, UPDATE_VOCAB_SUFFIX, PINNED_RESULTS_SUFFIX}) {
+    ad_utility::deleteFile(onDiskBase_ + suffix, false);
+  }
+  // Additionally, these files store the random ID of the build they belong to
+  // (see `getBuildId`), which is checked when they are read.
+  configurationJson_["build-id"] = absl::StrCat(absl::Hex(
+      FastRandomIntGenerator<uint64_t>{}(), absl::kZeroPad16));
+
+  auto setTokenizer = [this]<template <typename> typename ParserTemplate>(
+                          const string& filename)
       -> std::unique_ptr<TurtleParserBase> {
     if (onlyAsciiTurtlePrefixes_) {
       return std::make_unique<ParserTemplate<TokenizerCtre>>(filename);
@@ -93,13 +124,20 @@ void IndexImpl::createFromFile(const string& filename) {
     }
   };
 
-  std::unique_ptr<TurtleParserBase> parser = [&setTokenizer, this]() {
+  auto makeParser = [&setTokenizer, this](const string& filename) {
     if (useParallelParser_) {
-      return setTokenizer.template operator()<TurtleParallelParser>();
+      return setTokenizer.template operator()<TurtleParallelParser>(filename);
     } else {
-      return setTokenizer.template operator()<TurtleStreamParser>();
+      return setTokenizer.template operator()<TurtleStreamParser>(filename);
     }
-  }();
+  };
+
+  // Each of several input files gets its own parser, and these parsers run
+  // concurrently.
+  std::unique_ptr<TurtleParserBase> parser =
+      filenames.size() == 1
+          ? makeParser(filenames.front())
+          : std::make_unique<TurtleMultiFileParser>(filenames, makeParser);
 
   IndexBuilderDataAsPsoSorter indexBuilderData =
       createIdTriplesAndVocab(std::move(parser));
@@ -168,50 +206,97 @@ void IndexImpl::createFromFile(const string& filename) {
     numTriplesNormal += !std::ranges::any_of(triple, isInternalId);
   };
 
+  // In the default mode, the three pairs of permutations are created one after
+  // the other, and each pass feeds the sorter for the next pass. If
+  // `parallelPermutations_` is set, the PSO pass feeds both the SPO and the OSP
+  // sorter, and the SPO and OSP passes then run concurrently. Each of the
+  // sorters gets a fifth of the STXXL memory, so in the parallel mode three
+  // fifths are used by the sorters during the PSO pass (instead of two fifths)
+  // and the rest remains for the buffers of the concurrent passes.
+  const bool createPermutationsInParallel =
+      parallelPermutations_ && loadAllPermutations_;
+  using OspSorter = StxxlSorter<SortByOSP>;
+  auto makeOspSorter = [this]() {
+    return std::make_unique<OspSorter>(stxxlMemoryInBytes() / 5);
+  };
   StxxlSorter<SortBySPO> spoSorter{stxxlMemoryInBytes() / 5};
+  std::unique_ptr<OspSorter> ospSorter;
   auto& psoSorter = *indexBuilderData.psoSorter;
   // For the first permutation, perform a unique.
   auto uniqueSorter = ad_utility::uniqueView(psoSorter.sortedView());
 
   size_t numPredicatesNormal = 0;
-  createPermutationPair(
-      std::move(uniqueSorter), pso_, pos_, spoSorter.makePushCallback(),
-      makeNumEntitiesCounter(numPredicatesNormal, 1), countActualTriples);
+  auto numPredicatesCounter = makeNumEntitiesCounter(numPredicatesNormal, 1);
+  if (createPermutationsInParallel) {
+    LOG(INFO) << "Creating the remaining permutations in parallel" << std::endl;
+    ospSorter = makeOspSorter();
+    createPermutationPair(std::move(uniqueSorter), pso_, pos_,
+                          spoSorter.makePushCallback(),
+                          ospSorter->makePushCallback(), numPredicatesCounter,
+                          countActualTriples);
+  } else {
+    createPermutationPair(std::move(uniqueSorter), pso_, pos_,
+                          spoSorter.makePushCallback(), numPredicatesCounter,
+                          countActualTriples);
+  }
   configurationJson_["num-predicates-normal"] = numPredicatesNormal;
   configurationJson_["num-triples-normal"] = numTriplesNormal;
   writeConfiguration();
   psoSorter.clear();
 
   if (loadAllPermutations_) {
-    // After the SPO permutation, create patterns if so desired.
-    StxxlSorter<SortByOSP> ospSorter{stxxlMemoryInBytes() / 5};
+    // Create the SPO and SOP permutations (and the patterns if so desired). The
+    // `perTripleCallbacks` are additionally called for each SPO triple. Return
+    // the number of normal subjects.
+    auto createSpoAndSop = [&](auto&&... perTripleCallbacks) {
+      size_t numSubjectsNormal = 0;
+      auto numSubjectCounter = makeNumEntitiesCounter(numSubjectsNormal, 0);
+      if (usePatterns_) {
+        PatternCreator patternCreator{onDiskBase_ + ".index.patterns"};
+        auto pushTripleToPatterns = [&patternCreator,
+                                     &isInternalId](const auto& triple) {
+          if (!std::ranges::any_of(triple, isInternalId)) {
+            patternCreator.processTriple(triple);
+          }
+        };
+        createPermutationPair(spoSorter.sortedView(), spo_, sop_,
+                              AD_FWD(perTripleCallbacks)...,
+                              pushTripleToPatterns, numSubjectCounter);
+        patternCreator.finish();
+      } else {
+        createPermutationPair(spoSorter.sortedView(), spo_, sop_,
+                              AD_FWD(perTripleCallbacks)...,
+                              numSubjectCounter);
+      }
+      spoSorter.clear();
+      return numSubjectsNormal;
+    };
+
+    // Create the OSP and OPS permutations, for which we don't need a next
+    // sorter. Return the number of normal objects.
+    auto createOspAndOps = [&]() {
+      size_t numObjectsNormal = 0;
+      createPermutationPair(ospSorter->sortedView(), osp_, ops_,
+                            makeNumEntitiesCounter(numObjectsNormal, 2));
+      return numObjectsNormal;
+    };
+
     size_t numSubjectsNormal = 0;
-    auto numSubjectCounter = makeNumEntitiesCounter(numSubjectsNormal, 0);
-    if (usePatterns_) {
-      PatternCreator patternCreator{onDiskBase_ + ".index.patterns"};
-      auto pushTripleToPatterns = [&patternCreator,
-                                   &isInternalId](const auto& triple) {
-        if (!std::ranges::any_of(triple, isInternalId)) {
-          patternCreator.processTriple(triple);
-        }
-      };
-      createPermutationPair(spoSorter.sortedView(), spo_, sop_,
-                            ospSorter.makePushCallback(), pushTripleToPatterns,
-                            numSubjectCounter);
-      patternCreator.finish();
+    size_t numObjectsNormal = 0;
+    if (createPermutationsInParallel) {
+      // Both sorters already contain all the triples, so the two passes are
+      // independent of each other.
+      auto ospFuture = std::async(std::launch::async, createOspAndOps);
+      numSubjectsNormal = createSpoAndSop();
+      numObjectsNormal = ospFuture.get();
     } else {
-      createPermutationPair(spoSorter.sortedView(), spo_, sop_,
-                            ospSorter.makePushCallback(), numSubjectCounter);
+      ospSorter = makeOspSorter();
+      numSubjectsNormal = createSpoAndSop(ospSorter->makePushCallback());
+      configurationJson_["num-subjects-normal"] = numSubjectsNormal;
+      writeConfiguration();
+      numObjectsNormal = createOspAndOps();
     }
-    spoSorter.clear();
     configurationJson_["num-subjects-normal"] = numSubjectsNormal;
-    writeConfiguration();
-
-    // For the last pair of permutations we don't need a next sorter, so we have
-    // no fourth argument.
-    size_t numObjectsNormal = 0;
-    createPermutationPair(ospSorter.sortedView(), osp_, ops_,
-                          makeNumEntitiesCounter(numObjectsNormal, 2));
     configurationJson_["num-objects-normal"] = numObjectsNormal;
     configurationJson_["has-all-permutations"] = true;
   } else {
@@ -644,26 +729,438 @@ void IndexImpl::createFromOnDiskIndex(const string& onDiskBase) {
   totalVocabularySize_ = vocab_.size() + vocab_.getExternalVocab().size();
   LOG(DEBUG) << "Number of words in internal and external vocabulary: "
              << totalVocabularySize_ << std::endl;
-  pso_.loadFromDisk(onDiskBase_);
-  pos_.loadFromDisk(onDiskBase_);
+
+  // The metadata of the blocks of the permutations and the patterns are read
+  // from the startup snapshot if it exists and was written for the current
+  // index files (see `StartupSnapshot`).
+  const std::string snapshotFilename = onDiskBase_ + STARTUP_SNAPSHOT_SUFFIX;
+  const std::string fingerprint = getFingerprintOfFiles();
+  auto snapshot = StartupSnapshot::open(snapshotFilename, fingerprint);
+  const StartupSnapshot* snapshotPtr =
+      snapshot.has_value() ? &snapshot.value() : nullptr;
+  // Set to true if anything had to be read from the index files, then the
+  // snapshot is written (again).
+  bool snapshotIsIncomplete = !snapshot.has_value();
+
+  auto loadPermutation = [&](Permutation& permutation) {
+    permutation.loadFromDisk(onDiskBase_, memoryMapPermutations_, snapshotPtr);
+    if (snapshotPtr != nullptr) {
+      snapshotIsIncomplete |= !snapshotPtr->containsPermutation(
+          permutation.readableName_);
+    }
+  };
+  loadPermutation(pso_);
+  loadPermutation(pos_);
 
   if (loadAllPermutations_) {
-    ops_.loadFromDisk(onDiskBase_);
-    osp_.loadFromDisk(onDiskBase_);
-    spo_.loadFromDisk(onDiskBase_);
-    sop_.loadFromDisk(onDiskBase_);
+    loadPermutation(ops_);
+    loadPermutation(osp_);
+    loadPermutation(spo_);
+    loadPermutation(sop_);
   } else {
     LOG(INFO) << "Only the PSO and POS permutation were loaded, SPARQL queries "
                  "with predicate variables will therefore not work"
               << std::endl;
   }
+  for (auto permutation : memoryResidentPermutations_) {
+    auto& p = getPermutation(permutation);
+    if (!p.isLoaded_) {
+      LOG(WARN) << "The " << p.readableName_
+                << " permutation was not loaded and can therefore not be kept "
+                   "in memory"
+                << std::endl;
+      continue;
+    }
+    p.loadIntoMemory(useHugePages_, lockInMemory_);
+  }
 
-  if (usePatterns_) {
+  if (usePatterns_ &&
+      (snapshotPtr == nullptr ||
+       !snapshotPtr->readPatterns(avgNumDistinctSubjectsPerPredicate_,
+                                  avgNumDistinctPredicatesPerSubject_,
+                                  numDistinctSubjectPredicatePairs_, patterns_,
+                                  hasPattern_))) {
     PatternCreator::readPatternsFromFile(
         onDiskBase_ + ".index.patterns", avgNumDistinctSubjectsPerPredicate_,
         avgNumDistinctPredicatesPerSubject_, numDistinctSubjectPredicatePairs_,
-        patterns_, hasPattern_);
+        patterns_, hasPatternStorage_);
+    hasPattern_ = hasPatternStorage_;
+    snapshotIsIncomplete = true;
+  }
+  startupSnapshot_ = std::move(snapshot);
+
+  // Writing the snapshot only speeds up later starts, so a failure (e.g.
+  // because the directory of the index is read-only) is not an error.
+  if (snapshotIsIncomplete) {
+    try {
+      std::vector<std::pair<std::string, Permutation::MetaData*>> permutations;
+      for (auto permutation : Permutation::ALL) {
+        auto& p = getPermutation(permutation);
+        if (p.isLoaded_) {
+          permutations.emplace_back(p.readableName_, &p.meta_);
+        }
+      }
+      std::optional<StartupSnapshot::Patterns> patterns;
+      if (usePatterns_) {
+        patterns.emplace(avgNumDistinctSubjectsPerPredicate_,
+                         avgNumDistinctPredicatesPerSubject_,
+                         numDistinctSubjectPredicatePairs_, patterns_,
+                         hasPattern_);
+      }
+      StartupSnapshot::write(snapshotFilename, fingerprint, permutations,
+                             patterns.has_value() ? &patterns.value()
+                                                  : nullptr);
+      LOG(INFO) << "Wrote the startup snapshot " << snapshotFilename
+                << std::endl;
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not write the startup snapshot " << snapshotFilename
+                << ": " << e.what() << std::endl;
+    }
+  }
+
+  if (ad_utility::File::exists(onDiskBase_ + DELTA_TRIPLES_SUFFIX)) {
+    std::lock_guard lock{deltaTriplesMutex_};
+    deltaTriples_.readFromFile(onDiskBase_ + DELTA_TRIPLES_SUFFIX,
+                               getBuildId());
+    LOG(INFO) << "Number of triples that were inserted and deleted after the "
+                 "index was built: "
+              << deltaTriples_.numInserted() << " and "
+              << deltaTriples_.numDeleted() << std::endl;
+    publishDeltaTriples();
+  }
+  hasOutdatedPatterns_ =
+      !deltaTriples_.empty() ||
+      configurationJson_.value("has-outdated-patterns", false);
+  if (ad_utility::File::exists(onDiskBase_ + UPDATE_VOCAB_SUFFIX)) {
+    std::lock_guard lock{deltaTriplesMutex_};
+    // The first record contains the build ID, each of the following ones the
+    // words that were added by one update (see `deleteAndInsertTriples`).
+    auto records = ad_utility::appendOnlyFile::readRecords(
+        onDiskBase_ + UPDATE_VOCAB_SUFFIX);
+    AD_CORRECTNESS_CHECK(!records.empty());
+    using ad_utility::serialization::ByteBufferReadSerializer;
+    string buildId;
+    ByteBufferReadSerializer buildIdSerializer{std::move(records.front())};
+    buildIdSerializer >> buildId;
+    DeltaTriples::checkBuildId(onDiskBase_ + UPDATE_VOCAB_SUFFIX, buildId,
+                               getBuildId());
+    auto updateVocab = updateVocab_.wlock();
+    for (auto& record : records | std::views::drop(1)) {
+      std::vector<string> words;
+      ByteBufferReadSerializer serializer{std::move(record)};
+      serializer >> words;
+      for (auto& word : words) {
+        updateVocab->indices_.emplace(word, updateVocab->words_.size());
+        updateVocab->words_.push_back(std::move(word));
+      }
+    }
+    numPersistedUpdateWords_ = updateVocab->words_.size();
+    LOG(INFO) << "Number of words that were added by updates: "
+              << numPersistedUpdateWords_ << std::endl;
+  }
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::getBuildId() const {
+  return configurationJson_.value("build-id", "");
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::getFingerprintOfFiles() const {
+  ad_utility::StableHash hash;
+  hash.add(configurationJson_.dump());
+
+  // The vocabulary, permutation, and pattern files. Only the files with these
+  // known suffixes are considered (files that don't exist, e.g. of permutations
+  // that were not built, are skipped), other files in the directory of the
+  // index don't affect the fingerprint.
+  namespace fs = std::filesystem;
+  std::vector<std::string> suffixes{INTERNAL_VOCAB_SUFFIX,
+                                    EXTERNAL_VOCAB_SUFFIX, ".index.patterns"};
+  for (auto permutation : Permutation::ALL) {
+    const auto& fileSuffix = getPermutation(permutation).fileSuffix_;
+    suffixes.push_back(".index" + fileSuffix);
+    suffixes.push_back(".index" + fileSuffix + MMAP_FILE_SUFFIX);
+  }
+  for (const auto& suffix : suffixes) {
+    fs::path file{onDiskBase_ + suffix};
+    std::error_code errorCode;
+    auto size = fs::file_size(file, errorCode);
+    if (errorCode) {
+      continue;
+    }
+    hash.add(absl::StrCat(
+        suffix, " ", size, " ",
+        fs::last_write_time(file).time_since_epoch().count(), "\n"));
+  }
+  return absl::StrCat(absl::Hex(hash.value(), absl::kZeroPad16));
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::getFingerprintOfUpdateFiles() const {
+  namespace fs = std::filesystem;
+  std::string result;
+  for (const auto& suffix : {DELTA_TRIPLES_SUFFIX, UPDATE_VOCAB_SUFFIX}) {
+    fs::path file{onDiskBase_ + suffix};
+    std::error_code errorCode;
+    auto size = fs::file_size(file, errorCode);
+    if (errorCode) {
+      absl::StrAppend(&result, suffix, " - ");
+      continue;
+    }
+    absl::StrAppend(&result, suffix, " ", size, " ",
+                    fs::last_write_time(file).time_since_epoch().count(), " ");
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void IndexImpl::insertTriples(const std::vector<std::array<Id, 3>>& triples) {
+  deleteAndInsertTriples({}, triples);
+}
+
+// _____________________________________________________________________________
+void IndexImpl::deleteTriples(const std::vector<std::array<Id, 3>>& triples) {
+  deleteAndInsertTriples(triples, {});
+}
+
+// _____________________________________________________________________________
+void IndexImpl::deleteAndInsertTriples(
+    const std::vector<std::array<Id, 3>>& toDelete,
+    const std::vector<std::array<Id, 3>>& toInsert) {
+  std::lock_guard lock{deltaTriplesMutex_};
+  // The triples are applied to a copy of the `deltaTriples_` (which is cheap,
+  // see `PermutationDeltas`) that only replaces them once it has been written
+  // to disk. If writing fails, the index is therefore unchanged.
+  DeltaTriples deltaTriples = deltaTriples_;
+  for (const auto& triple : toDelete) {
+    deltaTriples.deleteTriple(triple);
+  }
+  for (const auto& triple : toInsert) {
+    deltaTriples.insertTriple(triple);
+  }
+  // The words of the update vocabulary are written first, so that the delta
+  // triples on disk never refer to words that are not persisted. Only the
+  // words that were added since the last update are appended to the file.
+  const string filename = onDiskBase_ + UPDATE_VOCAB_SUFFIX;
+  if (!ad_utility::File::exists(filename)) {
+    numPersistedUpdateWords_ = 0;
+  }
+  std::vector<string> words;
+  {
+    auto updateVocab = updateVocab_.rlock();
+    words.assign(updateVocab->words_.begin() + numPersistedUpdateWords_,
+                 updateVocab->words_.end());
+  }
+  if (!words.empty()) {
+    namespace appendOnlyFile = ad_utility::appendOnlyFile;
+    using ad_utility::serialization::ByteBufferWriteSerializer;
+    auto makeRecord = [](const auto& value) {
+      ByteBufferWriteSerializer serializer;
+      serializer << value;
+      return std::move(serializer).data();
+    };
+    if (numPersistedUpdateWords_ > 0) {
+      appendOnlyFile::appendRecord(filename, makeRecord(words));
+    } else {
+      appendOnlyFile::writeRecords(
+          filename, {makeRecord(getBuildId()), makeRecord(words)});
+    }
+    numPersistedUpdateWords_ += words.size();
+  }
+  deltaTriples.appendToFile(onDiskBase_ + DELTA_TRIPLES_SUFFIX, getBuildId(),
+                            toDelete, toInsert);
+  deltaTriples_ = std::move(deltaTriples);
+  publishDeltaTriples();
+  hasOutdatedPatterns_ = true;
+}
+
+// _____________________________________________________________________________
+Id IndexImpl::getOrAddIdForUpdate(const std::string& word) {
+  VocabIndex index;
+  if (getVocab().getId(word, &index)) {
+    return Id::makeFromVocabIndex(index);
+  }
+  auto updateVocab = updateVocab_.wlock();
+  auto [it, isNew] =
+      updateVocab->indices_.emplace(word, updateVocab->words_.size());
+  if (isNew) {
+    updateVocab->words_.push_back(word);
   }
+  return Id::makeFromVocabIndex(
+      VocabIndex::make(totalVocabularySize_ + it->second));
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const OrderOfUpdateWords> IndexImpl::getOrderOfUpdateWords()
+    const {
+  auto order = orderOfUpdateWords_.wlock();
+  std::vector<std::string> words;
+  {
+    auto updateVocab = updateVocab_.rlock();
+    if (*order != nullptr &&
+        (*order)->numUpdateWords() == updateVocab->words_.size()) {
+      return *order;
+    }
+    words = updateVocab->words_;
+  }
+
+  // Sort the words by the position at which they would be inserted into the
+  // vocabulary, and the words with the same such position by the order of the
+  // vocabulary.
+  std::vector<size_t> lowerBounds;
+  lowerBounds.reserve(words.size());
+  for (const std::string& word : words) {
+    lowerBounds.push_back(vocab_.lower_bound(word).get());
+  }
+  std::vector<size_t> indices(words.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  const auto& comparator = vocab_.getCaseComparator();
+  std::ranges::sort(indices, [&](size_t a, size_t b) {
+    if (lowerBounds[a] != lowerBounds[b]) {
+      return lowerBounds[a] < lowerBounds[b];
+    }
+    if (comparator(words[a], words[b])) {
+      return true;
+    }
+    if (comparator(words[b], words[a])) {
+      return false;
+    }
+    return words[a] < words[b];
+  });
+  std::vector<OrderOfUpdateWords::Position> positions(words.size());
+  for (size_t rank = 0; rank < indices.size(); ++rank) {
+    positions[indices[rank]] = {lowerBounds[indices[rank]], rank};
+  }
+  *order = std::make_shared<const OrderOfUpdateWords>(totalVocabularySize_,
+                                                      std::move(positions));
+  return *order;
+}
+
+// _____________________________________________________________________________
+void IndexImpl::publishDeltaTriples() {
+  // The copies are cheap, because they share most of their triples with the
+  // `deltaTriples_` (see `PermutationDeltas`).
+  for (auto permutation : Permutation::ALL) {
+    const auto& deltas = deltaTriples_.getPermutationDeltas(permutation);
+    getPermutation(permutation)
+        .setDeltas(deltas.empty()
+                       ? nullptr
+                       : std::make_shared<const PermutationDeltas>(deltas));
+  }
+}
+
+namespace {
+// Return true iff the `triple` contains a word that was introduced by an
+// update (see `IndexImpl::getOrAddIdForUpdate`), given the
+// `totalVocabularySize`.
+bool containsUpdateVocabId(const std::array<Id, 3>& triple,
+                           size_t totalVocabularySize) {
+  return std::ranges::any_of(triple, [totalVocabularySize](Id id) {
+    return id.getDatatype() == Datatype::VocabIndex &&
+           id.getVocabIndex().get() >= totalVocabularySize;
+  });
+}
+
+// Yield the triples of the `permutation` (including its delta triples) in the
+// order of the permutation, but with each triple in SPO order, as expected by
+// `IndexImpl::createPermutationPair`. Triples with words from the update
+// vocabulary are skipped, because the compressed permutations only contain
+// words from the vocabulary of the index.
+cppcoro::generator<std::array<Id, 3>> spoTriplesOfPermutation(
+    const Permutation& permutation, size_t totalVocabularySize) {
+  for (const auto& permutedTriple : TriplesView(permutation)) {
+    if (containsUpdateVocabId(permutedTriple, totalVocabularySize)) {
+      continue;
+    }
+    std::array<Id, 3> triple;
+    for (size_t i = 0; i < 3; ++i) {
+      triple[permutation.keyOrder_[i]] = permutedTriple[i];
+    }
+    co_yield triple;
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void IndexImpl::compactDeltaTriples() {
+  std::lock_guard lock{deltaTriplesMutex_};
+  if (deltaTriples_.empty()) {
+    LOG(INFO) << "There are no delta triples to compact" << std::endl;
+    return;
+  }
+  // The delta triples are cleared after the compaction, so a permutation that
+  // exists on disk but is not loaded would silently lose them.
+  for (auto permutation : Permutation::ALL) {
+    const auto& p = getPermutation(permutation);
+    if (!p.isLoaded_ &&
+        ad_utility::File::exists(onDiskBase_ + ".index" + p.fileSuffix_)) {
+      throw std::runtime_error{absl::StrCat(
+          "The ", p.readableName_,
+          " permutation exists on disk but was not loaded, the delta triples "
+          "can only be compacted if all existing permutations are loaded")};
+    }
+  }
+  LOG(INFO) << "Folding " << deltaTriples_.numInserted() << " inserted and "
+            << deltaTriples_.numDeleted()
+            << " deleted triples into the permutations ..." << std::endl;
+  // The new permutations are first written to temporary files, because the
+  // old ones are read while writing.
+  const string onDiskBase = onDiskBase_;
+  const string temporaryBase = onDiskBase_ + ".compaction";
+  std::vector<const Permutation*> compactedPermutations;
+  auto compactPair = [&](const Permutation& p1, const Permutation& p2) {
+    if (!p1.isLoaded_) {
+      return;
+    }
+    onDiskBase_ = temporaryBase;
+    absl::Cleanup restoreOnDiskBase{[&]() { onDiskBase_ = onDiskBase; }};
+    createPermutationPair(spoTriplesOfPermutation(p1, totalVocabularySize_), p1,
+                          p2);
+    compactedPermutations.push_back(&p1);
+    compactedPermutations.push_back(&p2);
+  };
+  compactPair(pso_, pos_);
+  compactPair(spo_, sop_);
+  compactPair(osp_, ops_);
+
+  std::vector<string> suffixes{""};
+  if constexpr (IndexMetaDataMmapDispatcher::WriteType::_isMmapBased) {
+    suffixes.push_back(MMAP_FILE_SUFFIX);
+  }
+  for (const Permutation* permutation : compactedPermutations) {
+    for (const auto& suffix : suffixes) {
+      auto filename = absl::StrCat(".index", permutation->fileSuffix_, suffix);
+      std::filesystem::rename(temporaryBase + filename, onDiskBase_ + filename);
+    }
+  }
+  // The inserted triples with words from the update vocabulary remain delta
+  // triples.
+  std::vector<DeltaTriples::Triple> remainingTriples;
+  std::ranges::copy_if(
+      deltaTriples_.getPermutationDeltas(Permutation::SPO).inserted(),
+      std::back_inserter(remainingTriples), [this](const auto& triple) {
+        return containsUpdateVocabId(triple, totalVocabularySize_);
+      });
+  deltaTriples_.clear();
+  for (const auto& triple : remainingTriples) {
+    deltaTriples_.insertTriple(triple);
+  }
+  if (deltaTriples_.empty()) {
+    ad_utility::deleteFile(onDiskBase_ + DELTA_TRIPLES_SUFFIX);
+  } else {
+    deltaTriples_.writeToFile(onDiskBase_ + DELTA_TRIPLES_SUFFIX,
+                              getBuildId());
+  }
+  publishDeltaTriples();
+  // The patterns are not recomputed, so `ql:has-predicate` must not use them
+  // after a restart either (see `hasOutdatedPatterns_`).
+  configurationJson_["has-outdated-patterns"] = true;
+  writeConfiguration();
+  LOG(WARN) << "The patterns for `ql:has-predicate` and the statistics in the "
+               "configuration file are not updated by the compaction"
+            << std::endl;
+  LOG(INFO) << "Compaction of the delta triples completed" << std::endl;
 }
 
 // _____________________________________________________________________________
@@ -676,7 +1173,7 @@ void IndexImpl::throwExceptionIfNoPatterns() const {
 }
 
 // _____________________________________________________________________________
-const vector<PatternID>& IndexImpl::getHasPattern() const {
+std::span<const PatternID> IndexImpl::getHasPattern() const {
   throwExceptionIfNoPatterns();
   return hasPattern_;
 }
@@ -761,6 +1258,25 @@ void IndexImpl::setLoadAllPermutations(bool loadAllPermutations) {
   loadAllPermutations_ = loadAllPermutations;
 }
 
+// _____________________________________________________________________________
+void IndexImpl::setParallelPermutations(bool parallelPermutations) {
+  parallelPermutations_ = parallelPermutations;
+}
+
+// _____________________________________________________________________________
+void IndexImpl::setMemoryMapPermutations(bool memoryMapPermutations) {
+  memoryMapPermutations_ = memoryMapPermutations;
+}
+
+// _____________________________________________________________________________
+void IndexImpl::setMemoryResidentPermutations(
+    std::vector<Permutation::Enum> permutations, bool useHugePages,
+    bool lockInMemory) {
+  memoryResidentPermutations_ = std::move(permutations);
+  useHugePages_ = useHugePages;
+  lockInMemory_ = lockInMemory;
+}
+
 // ____________________________________________________________________________
 void IndexImpl::setSettingsFile(const std::string& filename) {
   settingsFileName_ = filename;
@@ -771,6 +1287,11 @@ void IndexImpl::setPrefixCompression(bool compressed) {
   vocabPrefixCompressed_ = compressed;
 }
 
+// ____________________________________________________________________________
+void IndexImpl::setFrontCodedExternalVocabulary(bool frontCoded) {
+  frontCodedExternalVocabulary_ = frontCoded;
+}
+
 // ____________________________________________________________________________
 void IndexImpl::writeConfiguration() const {
   // Copy the configuration and add the current commit hash.
@@ -850,6 +1371,14 @@ void IndexImpl::readConfiguration() {
         configurationJson_["prefixes-external"]);
   }
 
+  // Indices that were built before this option existed always have an
+  // external vocabulary of type `VocabularyOnDisk`.
+  frontCodedExternalVocabulary_ =
+      configurationJson_.value("front-coded-external-vocabulary", false);
+  vocab_.setExternalVocabularyType(frontCodedExternalVocabulary_
+                                       ? PolymorphicVocabulary::Type::FrontCoded
+                                       : PolymorphicVocabulary::Type::OnDisk);
+
   if (configurationJson_.count("ignore-case")) {
     LOG(ERROR) << ERROR_IGNORE_CASE_UNSUPPORTED << '\n';
     throw std::runtime_error("Deprecated key \"ignore-case\" in index build");
@@ -1228,11 +1757,17 @@ Index::NumNormalAndInternal IndexImpl::numDistinctCol0(
 
 // ___________________________________________________________________________
 size_t IndexImpl::getCardinality(Id id, Permutation::Enum permutation) const {
-  if (const auto& p = getPermutation(permutation);
-      p.metaData().col0IdExists(id)) {
-    return p.metaData().getMetaData(id).getNofElements();
+  const auto& p = getPermutation(permutation);
+  // The deleted triples are ignored, so this is an upper bound if there are
+  // deltas.
+  size_t numInserted = 0;
+  if (auto deltas = p.getDeltas()) {
+    numInserted = deltas->getNumInsertedTriples(id, std::nullopt);
   }
-  return 0;
+  if (p.metaData().col0IdExists(id)) {
+    return p.metaData().getMetaData(id).getNofElements() + numInserted;
+  }
+  return numInserted;
 }
 
 // ___________________________________________________________________________
@@ -1246,7 +1781,7 @@ size_t IndexImpl::getCardinality(const TripleComponent& comp,
   if (comp == INTERNAL_TEXT_MATCH_PREDICATE) {
     return TEXT_PREDICATE_CARDINALITY_ESTIMATE;
   }
-  if (std::optional<Id> relId = comp.toValueId(getVocab()); relId.has_value()) {
+  if (std::optional<Id> relId = getId(comp); relId.has_value()) {
     return getCardinality(relId.value(), permutation);
   }
   return 0;
@@ -1255,7 +1790,29 @@ size_t IndexImpl::getCardinality(const TripleComponent& comp,
 // TODO<joka921> Once we have an overview over the folding this logic should
 // probably not be in the index class.
 std::optional<string> IndexImpl::idToOptionalString(VocabIndex id) const {
-  return vocab_.indexToOptionalString(id);
+  if (id.get() < totalVocabularySize_) {
+    return vocab_.indexToOptionalString(id);
+  }
+  auto updateVocab = updateVocab_.rlock();
+  size_t index = id.get() - totalVocabularySize_;
+  if (index >= updateVocab->words_.size()) {
+    return std::nullopt;
+  }
+  return updateVocab->words_[index];
+}
+
+// ___________________________________________________________________________
+std::vector<std::optional<string>> IndexImpl::idsToOptionalStrings(
+    std::span<const VocabIndex> sortedIds) const {
+  // The IDs of the words that were introduced by updates come last.
+  auto firstUpdateId = std::ranges::lower_bound(
+      sortedIds, VocabIndex::make(totalVocabularySize_));
+  auto result = vocab_.indicesToOptionalStrings(
+      {sortedIds.begin(), firstUpdateId});
+  for (VocabIndex id : std::ranges::subrange(firstUpdateId, sortedIds.end())) {
+    result.push_back(idToOptionalString(id));
+  }
+  return result;
 }
 
 // ___________________________________________________________________________
@@ -1265,9 +1822,42 @@ bool IndexImpl::getId(const string& element, Id* id) const {
   VocabIndex vocabId;
   auto success = getVocab().getId(element, &vocabId);
   *id = Id::makeFromVocabIndex(vocabId);
+  if (!success) {
+    // Also consider the words that were introduced by updates.
+    if (auto updateId = getIdOfWord(element)) {
+      *id = updateId.value();
+      return true;
+    }
+  }
   return success;
 }
 
+// ___________________________________________________________________________
+std::optional<Id> IndexImpl::getId(
+    const TripleComponent& tripleComponent) const {
+  if (!tripleComponent.isString() && !tripleComponent.isLiteral()) {
+    return tripleComponent.toValueIdIfNotString();
+  }
+  return getIdOfWord(tripleComponent.isString()
+                         ? tripleComponent.getString()
+                         : tripleComponent.getLiteral().rawContent());
+}
+
+// ___________________________________________________________________________
+std::optional<Id> IndexImpl::getIdOfWord(const std::string& word) const {
+  VocabIndex vocabIndex;
+  if (getVocab().getId(word, &vocabIndex)) {
+    return Id::makeFromVocabIndex(vocabIndex);
+  }
+  auto updateVocab = updateVocab_.rlock();
+  auto it = updateVocab->indices_.find(word);
+  if (it == updateVocab->indices_.end()) {
+    return std::nullopt;
+  }
+  return Id::makeFromVocabIndex(
+      VocabIndex::make(totalVocabularySize_ + it->second));
+}
+
 // ___________________________________________________________________________
 std::pair<Id, Id> IndexImpl::prefix_range(const std::string& prefix) const {
   // TODO<joka921> Do we need prefix ranges for numbers?
@@ -1279,7 +1869,7 @@ std::pair<Id, Id> IndexImpl::prefix_range(const std::string& prefix) const {
 vector<float> IndexImpl::getMultiplicities(
     const TripleComponent& key, Permutation::Enum permutation) const {
   const auto& p = getPermutation(permutation);
-  std::optional<Id> keyId = key.toValueId(getVocab());
+  std::optional<Id> keyId = getId(key);
   vector<float> res;
   if (keyId.has_value() && p.meta_.col0IdExists(keyId.value())) {
     auto metaData = p.meta_.getMetaData(keyId.value());
@@ -1310,10 +1900,10 @@ IdTable IndexImpl::scan(
     std::optional<std::reference_wrapper<const TripleComponent>> col1String,
     const Permutation::Enum& permutation,
     ad_utility::SharedConcurrentTimeoutTimer timer) const {
-  std::optional<Id> col0Id = col0String.toValueId(getVocab());
-  std::optional<Id> col1Id =
-      col1String.has_value() ? col1String.value().get().toValueId(getVocab())
-                             : std::nullopt;
+  std::optional<Id> col0Id = getId(col0String);
+  std::optional<Id> col1Id = col1String.has_value()
+                                 ? getId(col1String.value().get())
+                                 : std::nullopt;
   if (!col0Id.has_value() || (col1String.has_value() && !col1Id.has_value())) {
     size_t numColumns = col1String.has_value() ? 1 : 2;
     return IdTable{numColumns, allocator_};
@@ -1331,8 +1921,8 @@ IdTable IndexImpl::scan(Id col0Id, std::optional<Id> col1Id,
 size_t IndexImpl::getResultSizeOfScan(
     const TripleComponent& col0, const TripleComponent& col1,
     const Permutation::Enum& permutation) const {
-  std::optional<Id> col0Id = col0.toValueId(getVocab());
-  std::optional<Id> col1Id = col1.toValueId(getVocab());
+  std::optional<Id> col0Id = getId(col0);
+  std::optional<Id> col1Id = getId(col1);
   if (!col0Id.has_value() || !col1Id.has_value()) {
     return 0;
   }
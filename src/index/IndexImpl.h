@@ -8,13 +8,16 @@
 #include <engine/ResultTable.h>
 #include <global/Pattern.h>
 #include <index/CompressedRelation.h>
+#include <index/DeltaTriples.h>
 #include <index/ConstantsIndexBuilding.h>
 #include <index/DocsDB.h>
 #include <index/Index.h>
 #include <index/IndexBuilderTypes.h>
 #include <index/IndexMetaData.h>
+#include <index/OrderOfUpdateWords.h>
 #include <index/PatternCreator.h>
 #include <index/Permutation.h>
+#include <index/StartupSnapshot.h>
 #include <index/StxxlSortFunctors.h>
 #include <index/TextMetaData.h>
 #include <index/Vocabulary.h>
@@ -29,13 +32,17 @@
 #include <util/Forward.h>
 #include <util/HashMap.h>
 #include <util/MmapVector.h>
+#include <util/Synchronized.h>
 #include <util/Timer.h>
 #include <util/json.h>
 
 #include <array>
+#include <atomic>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <stxxl/sorter>
 #include <stxxl/stream>
@@ -110,6 +117,10 @@ class IndexImpl {
   string settingsFileName_;
   bool onlyAsciiTurtlePrefixes_ = false;
   bool useParallelParser_ = true;
+  // If true, the SPO and OSP orders are sorted concurrently with the creation
+  // of the PSO and POS permutations, and the SPO/SOP and OSP/OPS permutations
+  // are then created in parallel (see `createFromFile`).
+  bool parallelPermutations_ = false;
   TurtleParserIntegerOverflowBehavior turtleParserIntegerOverflowBehavior_ =
       TurtleParserIntegerOverflowBehavior::Error;
   bool turtleParserSkipIllegalLiterals_ = false;
@@ -120,6 +131,9 @@ class IndexImpl {
   Index::Vocab vocab_;
   size_t totalVocabularySize_ = 0;
   bool vocabPrefixCompressed_ = true;
+  // If true, the externalized words are stored in a `FrontCodedVocabulary`,
+  // else in a `VocabularyOnDisk`.
+  bool frontCodedExternalVocabulary_ = false;
   Index::TextVocab textVocab_;
 
   TextMetaData textMeta_;
@@ -131,6 +145,17 @@ class IndexImpl {
   // If false, only PSO and POS permutations are loaded and expected.
   bool loadAllPermutations_ = true;
 
+  // If true, the files of the permutations are mapped into memory when they
+  // are loaded.
+  bool memoryMapPermutations_ = false;
+
+  // The permutations that are completely loaded into memory when the index is
+  // loaded, whether this memory is backed by huge pages, and whether it is
+  // locked in memory.
+  std::vector<Permutation::Enum> memoryResidentPermutations_;
+  bool useHugePages_ = false;
+  bool lockInMemory_ = false;
+
   // Pattern trick data
   bool usePatterns_ = false;
   double avgNumDistinctPredicatesPerSubject_;
@@ -151,9 +176,15 @@ class IndexImpl {
    */
   CompactVectorOfStrings<Id> patterns_;
   /**
-   * @brief Maps entity ids to pattern ids.
+   * @brief Maps entity ids to pattern ids. A view of the `hasPatternStorage_`
+   * or of the memory mapping of the `startupSnapshot_`.
    */
-  std::vector<PatternID> hasPattern_;
+  std::span<const PatternID> hasPattern_;
+  std::vector<PatternID> hasPatternStorage_;
+  // The snapshot from which the metadata of the permutations and the patterns
+  // were read (see `createFromOnDiskIndex`). It is kept because `hasPattern_`
+  // might point into its memory mapping.
+  std::optional<StartupSnapshot> startupSnapshot_;
   /**
    * @brief Maps entity ids to sets of predicate ids
    */
@@ -171,6 +202,35 @@ class IndexImpl {
   Permutation ops_{Permutation::Enum::OPS, allocator_};
   Permutation osp_{Permutation::Enum::OSP, allocator_};
 
+  // The triples that were inserted or deleted after the index was built. The
+  // mutex serializes the updates, the permutations hold immutable copies of
+  // their part of the deltas.
+  DeltaTriples deltaTriples_;
+  std::mutex deltaTriplesMutex_;
+
+  // The IRIs and literals that were introduced by updates and are not part of
+  // the `vocab_`. The i-th word gets the ID `VocabIndex` `totalVocabularySize_
+  // + i`. These IDs are stable because words are never removed, so unlike
+  // words from a `LocalVocab` they can be used like all other vocabulary IDs
+  // (but they are sorted after all the words of the `vocab_`).
+  struct UpdateVocab {
+    std::vector<std::string> words_;
+    ad_utility::HashMap<std::string, size_t> indices_;
+  };
+  ad_utility::Synchronized<UpdateVocab> updateVocab_;
+  // Cache for `getOrderOfUpdateWords`, which is recomputed when new words have
+  // been added to the `updateVocab_`.
+  mutable ad_utility::Synchronized<std::shared_ptr<const OrderOfUpdateWords>>
+      orderOfUpdateWords_;
+  // The number of words of the `updateVocab_` that have been written to disk.
+  // Only accessed under the `deltaTriplesMutex_`.
+  size_t numPersistedUpdateWords_ = 0;
+  // True iff the patterns for `ql:has-predicate` don't reflect all the
+  // triples, because triples were inserted or deleted after the index was
+  // built. This remains true after the compaction of these triples (see
+  // `compactDeltaTriples`), which doesn't recompute the patterns.
+  std::atomic<bool> hasOutdatedPatterns_ = false;
+
  public:
   explicit IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator);
 
@@ -207,12 +267,79 @@ class IndexImpl {
   // by createFromOnDiskIndex after this call.
   void createFromFile(const string& filename);
 
+  // Same as `createFromFile`, but the triples are read from all the given
+  // files. The files are parsed concurrently.
+  void createFromFiles(const std::vector<string>& filenames);
+
   void addPatternsToExistingIndex();
 
   // Creates an index object from an on disk index that has previously been
   // constructed. Read necessary meta data into memory and opens file handles.
+  // Also reads the delta triples if there are any (see `insertTriples`).
   void createFromOnDiskIndex(const string& onDiskBase);
 
+  // Insert or delete triples (given in SPO order) without rebuilding the
+  // index. The triples are stored as `DeltaTriples` that are merged into the
+  // scans of the permutations, and they are persisted next to the index files.
+  // The triples are only applied after they were written to disk, so if
+  // writing throws, the index is unchanged. Note that the query result cache
+  // has to be cleared by the caller.
+  void insertTriples(const std::vector<std::array<Id, 3>>& triples);
+  void deleteTriples(const std::vector<std::array<Id, 3>>& triples);
+
+  // Delete and then insert the given triples as a single operation, which is
+  // persisted as a whole or not at all.
+  void deleteAndInsertTriples(const std::vector<std::array<Id, 3>>& toDelete,
+                              const std::vector<std::array<Id, 3>>& toInsert);
+
+  // The triples that were inserted or deleted since the index was built.
+  const DeltaTriples& deltaTriples() const { return deltaTriples_; }
+
+  // Return true iff the patterns don't reflect all the triples of the index
+  // (see `hasOutdatedPatterns_`).
+  bool hasOutdatedPatterns() const { return hasOutdatedPatterns_; }
+
+  // The random ID that was generated when the index was built (empty for
+  // indices that were built before the ID was introduced). It is stored in the
+  // files with the delta triples and the update vocabulary to detect files
+  // that belong to another build of the index.
+  std::string getBuildId() const;
+
+  // Return a hash of the configuration (see `CONFIGURATION_FILE`) and of the
+  // names, sizes and modification times of the vocabulary, permutation, and
+  // pattern files. It changes whenever the index is rebuilt or compacted (see
+  // `compactDeltaTriples`).
+  std::string getFingerprintOfFiles() const;
+
+  // Return the sizes and modification times of the files with the delta
+  // triples and the update vocabulary (see `deleteAndInsertTriples`). Unlike
+  // `getFingerprintOfFiles`, it changes with every update.
+  std::string getFingerprintOfUpdateFiles() const;
+
+  // Return the ID of the `word` (an IRI or literal as it is stored in the
+  // vocabulary). If the `word` is neither contained in the vocabulary nor in
+  // the words that were introduced by earlier updates, it is added to the
+  // latter (see `updateVocab_`). The new words are persisted with the next
+  // call to `deleteAndInsertTriples`.
+  Id getOrAddIdForUpdate(const std::string& word);
+
+  // The number of words that were introduced by updates.
+  size_t getNumUpdateWords() const {
+    return updateVocab_.rlock()->words_.size();
+  }
+
+  // Return the order of the words that were introduced by updates relative to
+  // the words of the vocabulary (see `OrderOfUpdateWords`).
+  std::shared_ptr<const OrderOfUpdateWords> getOrderOfUpdateWords() const;
+
+  // Fold the delta triples into new compressed blocks by rewriting all the
+  // loaded permutations (this is an offline operation). The patterns and the
+  // statistics in the configuration are not updated. Throws if a permutation
+  // exists on disk, but is not loaded (because its deltas would be lost).
+  // NOTE: The index has to be set up again via `createFromOnDiskIndex` after
+  // this call.
+  void compactDeltaTriples();
+
   // Adds a text index to a complete KB index. First reads the given context
   // file (if file name not empty), then adds words from literals (if true).
   void addTextFromContextFile(const string& contextFile,
@@ -259,15 +386,29 @@ class IndexImpl {
 
   // TODO<joka921> Once we have an overview over the folding this logic should
   // probably not be in the index class.
+  // Also resolves the IDs of the words that were introduced by updates.
   std::optional<string> idToOptionalString(VocabIndex id) const;
 
+  // ___________________________________________________________________________
+  std::vector<std::optional<string>> idsToOptionalStrings(
+      std::span<const VocabIndex> sortedIds) const;
+
   // ___________________________________________________________________________
   bool getId(const string& element, Id* id) const;
 
+  // Convert the `TripleComponent` to an ID. Strings are looked up in the
+  // vocabulary and in the words that were introduced by updates (see
+  // `getOrAddIdForUpdate`). If neither contains the string, return
+  // `std::nullopt`.
+  std::optional<Id> getId(const TripleComponent& tripleComponent) const;
+
+  // Same as above, but for a `word` as it is stored in the vocabulary.
+  std::optional<Id> getIdOfWord(const std::string& word) const;
+
   // ___________________________________________________________________________
   std::pair<Id, Id> prefix_range(const std::string& prefix) const;
 
-  const vector<PatternID>& getHasPattern() const;
+  std::span<const PatternID> getHasPattern() const;
   const CompactVectorOfStrings<Id>& getHasPredicate() const;
   const CompactVectorOfStrings<Id>& getPatterns() const;
   /**
@@ -364,6 +505,14 @@ class IndexImpl {
 
   void setLoadAllPermutations(bool loadAllPermutations);
 
+  void setParallelPermutations(bool parallelPermutations);
+
+  void setMemoryMapPermutations(bool memoryMapPermutations);
+
+  void setMemoryResidentPermutations(
+      std::vector<Permutation::Enum> permutations, bool useHugePages,
+      bool lockInMemory);
+
   void setKeepTempFiles(bool keepTempFiles);
 
   uint64_t& stxxlMemoryInBytes() { return stxxlMemoryInBytes_; }
@@ -379,6 +528,8 @@ class IndexImpl {
 
   void setPrefixCompression(bool compressed);
 
+  void setFrontCodedExternalVocabulary(bool frontCoded);
+
   void setNumTriplesPerBatch(uint64_t numTriplesPerBatch) {
     numTriplesPerBatch_ = numTriplesPerBatch;
   }
@@ -477,6 +628,9 @@ class IndexImpl {
                             auto&& sortedTriples, size_t c0, size_t c1,
                             size_t c2, auto&&... perTripleCallbacks);
 
+  // Pass the current `deltaTriples_` on to the permutations.
+  void publishDeltaTriples();
+
   static CompressedRelationMetadata writeSwitchedRel(
       CompressedRelationWriter* out, Id currentRel, BufferedIdTable* bufPtr);
 
@@ -0,0 +1,73 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "global/Id.h"
+#include "util/Exception.h"
+
+// The words that were introduced by updates get `VocabIndex` IDs that are
+// larger than all the IDs of the vocabulary (see
+// `IndexImpl::getOrAddIdForUpdate`), so unlike for the words of the
+// vocabulary, the order of these IDs is not the order of their words. This
+// class determines the position of each `VocabIndex` ID in the order of all
+// the words, which is used by ORDER BY and by comparisons like `<`.
+class OrderOfUpdateWords {
+ public:
+  // The `i`-th word of the vocabulary has the position `{i, max}`. A word of an
+  // update that is sorted between the words `i - 1` and `i` of the vocabulary
+  // has the position `{i, r}`, where `r` is the rank of the word among all the
+  // words of updates.
+  using Position = std::pair<size_t, size_t>;
+
+ private:
+  size_t numVocabWords_;
+  std::vector<Position> positionsOfUpdateWords_;
+
+ public:
+  // The `positionsOfUpdateWords` are given in the order of the IDs of the
+  // words.
+  OrderOfUpdateWords(size_t numVocabWords,
+                     std::vector<Position> positionsOfUpdateWords)
+      : numVocabWords_{numVocabWords},
+        positionsOfUpdateWords_{std::move(positionsOfUpdateWords)} {}
+
+  // The number of words of updates.
+  size_t numUpdateWords() const { return positionsOfUpdateWords_.size(); }
+
+  // The smallest ID of a word of an update. All the `VocabIndex` IDs of the
+  // words of the vocabulary are smaller.
+  Id getMinIdOfUpdateWords() const {
+    return Id::makeFromVocabIndex(VocabIndex::make(numVocabWords_));
+  }
+
+  // Return true iff the `id` belongs to a word of an update.
+  bool isWordOfUpdate(Id id) const {
+    return id.getDatatype() == Datatype::VocabIndex &&
+           id.getVocabIndex().get() >= numVocabWords_;
+  }
+
+  // Return the position of the word of the `id`, which must be a `VocabIndex`.
+  Position getPosition(Id id) const {
+    AD_CONTRACT_CHECK(id.getDatatype() == Datatype::VocabIndex);
+    size_t index = id.getVocabIndex().get();
+    if (index < numVocabWords_) {
+      return {index, std::numeric_limits<size_t>::max()};
+    }
+    index -= numVocabWords_;
+    if (index >= positionsOfUpdateWords_.size()) {
+      throw std::runtime_error(absl::StrCat(
+          "The word with ID ", id.getVocabIndex().get(),
+          " was introduced by an update that was executed concurrently to the "
+          "query, please repeat the query"));
+    }
+    return positionsOfUpdateWords_[index];
+  }
+};
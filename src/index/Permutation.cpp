@@ -5,6 +5,8 @@
 #include "index/Permutation.h"
 
 #include "absl/strings/str_cat.h"
+#include "index/DeltaTriples.h"
+#include "index/StartupSnapshot.h"
 #include "util/StringUtils.h"
 
 // _____________________________________________________________________
@@ -16,7 +18,9 @@ Permutation::Permutation(Enum permutation, Allocator allocator)
       reader_{std::move(allocator)} {}
 
 // _____________________________________________________________________
-void Permutation::loadFromDisk(const std::string& onDiskBase) {
+void Permutation::loadFromDisk(const std::string& onDiskBase,
+                               bool mapIntoMemory,
+                               const StartupSnapshot* snapshot) {
   if constexpr (MetaData::_isMmapBased) {
     meta_.setup(onDiskBase + ".index" + fileSuffix_ + MMAP_FILE_SUFFIX,
                 ad_utility::ReuseTag(), ad_utility::AccessPattern::Random);
@@ -31,12 +35,29 @@ void Permutation::loadFromDisk(const std::string& onDiskBase) {
              "message was: " +
              e.what());
   }
-  meta_.readFromFile(&file_);
+  if (snapshot == nullptr ||
+      !snapshot->readPermutationMetadata(readableName_, meta_)) {
+    meta_.readFromFile(&file_);
+  }
+  if (mapIntoMemory) {
+    file_.mapIntoMemory();
+  }
   LOG(INFO) << "Registered " << readableName_
             << " permutation: " << meta_.statistics() << std::endl;
   isLoaded_ = true;
 }
 
+// _____________________________________________________________________
+void Permutation::loadIntoMemory(bool useHugePages, bool lockInMemory) {
+  AD_CONTRACT_CHECK(isLoaded_);
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  file_.loadIntoMemory(useHugePages, lockInMemory);
+  LOG(INFO) << "Loaded the " << readableName_ << " permutation into memory ("
+            << file_.sizeOfFile() / (1 << 20) << " MB"
+            << (useHugePages ? ", backed by huge pages" : "") << ") in "
+            << timer.msecs() << " ms" << std::endl;
+}
+
 // _____________________________________________________________________
 IdTable Permutation::scan(Id col0Id, std::optional<Id> col1Id,
                           const TimeoutTimer& timer) const {
@@ -45,22 +66,34 @@ IdTable Permutation::scan(Id col0Id, std::optional<Id> col1Id,
                              readableName_ + ", which was not loaded");
   }
 
-  if (!meta_.col0IdExists(col0Id)) {
-    size_t numColumns = col1Id.has_value() ? 1 : 2;
-    return IdTable{numColumns, reader_.allocator()};
-  }
-  const auto& metaData = meta_.getMetaData(col0Id);
-
-  if (col1Id.has_value()) {
-    return reader_.scan(metaData, col1Id.value(), meta_.blockData(), file_,
-                        timer);
-  } else {
-    return reader_.scan(metaData, meta_.blockData(), file_, timer);
+  auto result = [&]() {
+    if (!meta_.col0IdExists(col0Id)) {
+      size_t numColumns = col1Id.has_value() ? 1 : 2;
+      return IdTable{numColumns, reader_.allocator()};
+    }
+    const auto& metaData = meta_.getMetaData(col0Id);
+
+    if (col1Id.has_value()) {
+      return reader_.scan(metaData, col1Id.value(), meta_.blockData(), file_,
+                          timer);
+    } else {
+      return reader_.scan(metaData, meta_.blockData(), file_, timer);
+    }
+  }();
+  if (auto deltas = getDeltas()) {
+    return deltas->mergeIntoScanResult(std::move(result), col0Id, col1Id);
   }
+  return result;
 }
 
 // _____________________________________________________________________
 size_t Permutation::getResultSizeOfScan(Id col0Id, Id col1Id) const {
+  // With deltas, the exact size can only be obtained by an actual scan.
+  if (auto deltas = getDeltas();
+      deltas && (deltas->hasInsertedTriples(col0Id, col1Id) ||
+                 deltas->hasDeletedTriples(col0Id, col1Id))) {
+    return scan(col0Id, col1Id).size();
+  }
   if (!meta_.col0IdExists(col0Id)) {
     return 0;
   }
@@ -110,11 +143,31 @@ std::string_view Permutation::toString(Permutation::Enum permutation) {
   AD_FAIL();
 }
 
+// _____________________________________________________________________
+Permutation::Enum Permutation::fromString(std::string_view name) {
+  std::string upper = ad_utility::getUppercase(std::string{name});
+  for (auto permutation : ALL) {
+    if (toString(permutation) == upper) {
+      return permutation;
+    }
+  }
+  throw std::runtime_error(
+      absl::StrCat("\"", name,
+                   "\" is not a valid permutation (must be one of PSO, POS, "
+                   "SPO, SOP, OPS, OSP)"));
+}
+
 // _____________________________________________________________________
 std::optional<Permutation::MetadataAndBlocks> Permutation::getMetadataAndBlocks(
     Id col0Id, std::optional<Id> col1Id) const {
   if (!meta_.col0IdExists(col0Id)) {
-    return std::nullopt;
+    if (!hasInsertedTriples(col0Id, col1Id)) {
+      return std::nullopt;
+    }
+    // The relation only consists of inserted triples, so there are no blocks.
+    CompressedRelationMetadata metadata;
+    metadata.col0Id_ = col0Id;
+    return MetadataAndBlocks{metadata, {}, col1Id, std::nullopt};
   }
 
   auto metadata = meta_.getMetaData(col0Id);
@@ -133,20 +186,43 @@ Permutation::IdTableGenerator Permutation::lazyScan(
     Id col0Id, std::optional<Id> col1Id,
     std::optional<std::vector<CompressedBlockMetadata>> blocks,
     const TimeoutTimer& timer) const {
-  if (!meta_.col0IdExists(col0Id)) {
-    return {};
-  }
-  auto relationMetadata = meta_.getMetaData(col0Id);
-  if (!blocks.has_value()) {
-    auto blockSpan = CompressedRelationReader::getBlocksFromMetadata(
-        relationMetadata, col1Id, meta_.blockData());
-    blocks = std::vector(blockSpan.begin(), blockSpan.end());
-  }
-  if (col1Id.has_value()) {
-    return reader_.lazyScan(meta_.getMetaData(col0Id), col1Id.value(),
-                            std::move(blocks.value()), file_, timer);
-  } else {
-    return reader_.lazyScan(meta_.getMetaData(col0Id),
-                            std::move(blocks.value()), file_, timer);
+  auto deltas = getDeltas();
+  auto result = [&]() -> IdTableGenerator {
+    if (!meta_.col0IdExists(col0Id)) {
+      return {};
+    }
+    auto relationMetadata = meta_.getMetaData(col0Id);
+    if (!blocks.has_value()) {
+      auto blockSpan = CompressedRelationReader::getBlocksFromMetadata(
+          relationMetadata, col1Id, meta_.blockData());
+      blocks = std::vector(blockSpan.begin(), blockSpan.end());
+    }
+    if (col1Id.has_value()) {
+      return reader_.lazyScan(meta_.getMetaData(col0Id), col1Id.value(),
+                              std::move(blocks.value()), file_, timer);
+    } else {
+      return reader_.lazyScan(meta_.getMetaData(col0Id),
+                              std::move(blocks.value()), file_, timer);
+    }
+  }();
+  if (deltas && (deltas->hasInsertedTriples(col0Id, col1Id) ||
+                 deltas->hasDeletedTriples(col0Id, col1Id))) {
+    return PermutationDeltas::mergeIntoLazyScan(std::move(deltas),
+                                                std::move(result), col0Id,
+                                                col1Id, reader_.allocator());
   }
+  return result;
+}
+
+// _____________________________________________________________________
+bool Permutation::hasInsertedTriples(Id col0Id,
+                                     std::optional<Id> col1Id) const {
+  auto deltas = getDeltas();
+  return deltas && deltas->hasInsertedTriples(col0Id, col1Id);
+}
+
+// _____________________________________________________________________
+std::vector<Id> Permutation::getCol0IdsOfInsertedTriples() const {
+  auto deltas = getDeltas();
+  return deltas ? deltas->getCol0IdsOfInsertedTriples() : std::vector<Id>{};
 }
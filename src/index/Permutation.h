@@ -4,6 +4,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <memory>
 #include <string>
 
 #include "global/Constants.h"
@@ -13,6 +15,8 @@
 
 // Forward declaration of `IdTable`
 class IdTable;
+class PermutationDeltas;
+class StartupSnapshot;
 
 // Helper class to store static properties of the different permutations to
 // avoid code duplication. The first template parameter is a search functor for
@@ -29,6 +33,7 @@ class Permutation {
   static constexpr auto SOP = Enum::SOP;
   static constexpr auto OPS = Enum::OPS;
   static constexpr auto OSP = Enum::OSP;
+  static constexpr std::array ALL{PSO, POS, SPO, SOP, OPS, OSP};
 
   using MetaData = IndexMetaDataMmapView;
   using Allocator = ad_utility::AllocatorWithLimit<Id>;
@@ -42,15 +47,34 @@ class Permutation {
   // `PSO` is converted to [1, 0, 2].
   static std::array<size_t, 3> toKeyOrder(Enum permutation);
 
+  // The inverse of `toString`, case-insensitive. Throw if the `name` is not the
+  // name of a permutation.
+  static Enum fromString(std::string_view name);
+
   explicit Permutation(Enum permutation, Allocator allocator);
 
-  // everything that has to be done when reading an index from disk
-  void loadFromDisk(const std::string& onDiskBase);
+  // everything that has to be done when reading an index from disk. If
+  // `mapIntoMemory` is true, the file of the permutation is mapped into memory
+  // and the compressed blocks are read directly from this mapping (see
+  // `ad_utility::File::mapIntoMemory`). If a `snapshot` is given and contains
+  // this permutation, its metadata is read from the snapshot instead of being
+  // deserialized from the end of the file of the permutation.
+  void loadFromDisk(const std::string& onDiskBase, bool mapIntoMemory = false,
+                    const StartupSnapshot* snapshot = nullptr);
+
+  // Copy the complete file of the permutation (which must have been loaded
+  // via `loadFromDisk`) into memory that is owned by the permutation, s.t.
+  // scans never have to access the disk or the page cache. See
+  // `ad_utility::File::loadIntoMemory` for `useHugePages` and
+  // `lockInMemory`.
+  void loadIntoMemory(bool useHugePages = false, bool lockInMemory = false);
 
   // For a given ID for the col0, retrieve all IDs of the col1 and col2.
   // If `col1Id` is specified, only the col2 is returned for triples that
   // additionally have the specified col1. .This is just a thin wrapper around
   // `CompressedRelationMetaData::scan`.
+  // The triples that were inserted or deleted after the index was built (see
+  // `setDeltas` below) are merged into the result.
   IdTable scan(Id col0Id, std::optional<Id> col1Id,
                const TimeoutTimer& timer = nullptr) const;
 
@@ -87,6 +111,28 @@ class Permutation {
   /// result
   size_t getResultSizeOfScan(Id col0Id, Id col1Id) const;
 
+  // Set the triples that were inserted into or deleted from this permutation
+  // after the index was built. They are merged into the results of all
+  // subsequent calls to `scan`, `lazyScan` and `getResultSizeOfScan`. Scans
+  // that have already started keep the deltas that were set at their start.
+  void setDeltas(std::shared_ptr<const PermutationDeltas> deltas) {
+    deltas_.store(std::move(deltas));
+  }
+
+  // Return the deltas that are currently set, or `nullptr` if there are none.
+  std::shared_ptr<const PermutationDeltas> getDeltas() const {
+    return deltas_.load();
+  }
+
+  // Return true iff there are triples with the given `col0Id` (and `col1Id`)
+  // that were inserted after the index was built. The block metadata does not
+  // know about these triples, so the blocks can't be prefiltered using the
+  // metadata of another scan in this case.
+  bool hasInsertedTriples(Id col0Id, std::optional<Id> col1Id) const;
+
+  // Return the sorted `col0Id`s of all the inserted triples (see above).
+  std::vector<Id> getCol0IdsOfInsertedTriples() const;
+
   // _______________________________________________________
   void setKbName(const string& name) { meta_.setName(name); }
 
@@ -106,4 +152,7 @@ class Permutation {
   CompressedRelationReader reader_;
 
   bool isLoaded_ = false;
+
+ private:
+  std::atomic<std::shared_ptr<const PermutationDeltas>> deltas_;
 };
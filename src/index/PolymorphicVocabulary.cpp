@@ -0,0 +1,84 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/PolymorphicVocabulary.h"
+
+#include "parser/RdfEscaping.h"
+#include "util/File.h"
+
+// _____________________________________________________________________________
+void PolymorphicVocabulary::resetToType(Type type) {
+  close();
+  if (type == Type::OnDisk) {
+    vocabulary_.emplace<VocabularyOnDisk>();
+  } else {
+    vocabulary_.emplace<FrontCodedVocabulary>();
+  }
+}
+
+// _____________________________________________________________________________
+void PolymorphicVocabulary::buildFromTextFile(const std::string& textFileName,
+                                              const std::string& outFileName) {
+  if (auto* vocabulary = std::get_if<VocabularyOnDisk>(&vocabulary_)) {
+    vocabulary->buildFromTextFile(textFileName, outFileName);
+    return;
+  }
+  auto infile = ad_utility::makeIfstream(textFileName);
+  FrontCodedVocabulary::WordWriter writer{
+      outFileName, FrontCodedVocabulary::defaultNumWordsPerBlock,
+      FrontCodedVocabulary::BlockCompression::Zstd};
+  std::string word;
+  while (std::getline(infile, word)) {
+    // Newlines and backslashes are escaped in the text file (see
+    // `VocabularyOnDisk::buildFromTextFile`).
+    writer.push(RdfEscaping::unescapeNewlinesAndBackslashes(word));
+  }
+}
+
+// _____________________________________________________________________________
+void PolymorphicVocabulary::open(const std::string& filename) {
+  std::visit([&](auto& vocabulary) { vocabulary.open(filename); },
+             vocabulary_);
+}
+
+// _____________________________________________________________________________
+void PolymorphicVocabulary::close() {
+  std::visit([](auto& vocabulary) { vocabulary.close(); }, vocabulary_);
+}
+
+// _____________________________________________________________________________
+size_t PolymorphicVocabulary::size() const {
+  return std::visit([](const auto& vocabulary) { return vocabulary.size(); },
+                    vocabulary_);
+}
+
+// _____________________________________________________________________________
+uint64_t PolymorphicVocabulary::getHighestId() const {
+  return std::visit(
+      [](const auto& vocabulary) { return vocabulary.getHighestId(); },
+      vocabulary_);
+}
+
+// _____________________________________________________________________________
+std::optional<std::string> PolymorphicVocabulary::operator[](
+    uint64_t idx) const {
+  if (const auto* vocabulary = std::get_if<VocabularyOnDisk>(&vocabulary_)) {
+    return (*vocabulary)[idx];
+  }
+  const auto& vocabulary = std::get<FrontCodedVocabulary>(vocabulary_);
+  if (idx >= vocabulary.size()) {
+    return std::nullopt;
+  }
+  return vocabulary[idx];
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<std::string>>
+PolymorphicVocabulary::getWordsForSortedIds(
+    std::span<const uint64_t> sortedIds) const {
+  return std::visit(
+      [&](const auto& vocabulary) {
+        return vocabulary.getWordsForSortedIds(sortedIds);
+      },
+      vocabulary_);
+}
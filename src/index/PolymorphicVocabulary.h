@@ -0,0 +1,96 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "index/VocabularyOnDisk.h"
+#include "index/vocabulary/FrontCodedVocabulary.h"
+#include "index/vocabulary/VocabularyTypes.h"
+
+// An on-disk vocabulary of strings with the contiguous indices [0 .. size()),
+// the on-disk format of which is chosen at runtime. It is either a
+// `VocabularyOnDisk` (every word is stored separately, together with its
+// offset) or a `FrontCodedVocabulary` (blocks of front-coded and compressed
+// words, which requires much less space, but decodes a complete block for each
+// access). This is used for the externalized part of the `Vocabulary`, the
+// type of which is stored in the configuration of the index.
+class PolymorphicVocabulary {
+ public:
+  enum class Type { OnDisk, FrontCoded };
+
+ private:
+  std::variant<VocabularyOnDisk, FrontCodedVocabulary> vocabulary_;
+
+ public:
+  PolymorphicVocabulary() = default;
+  PolymorphicVocabulary(PolymorphicVocabulary&&) noexcept = default;
+  PolymorphicVocabulary& operator=(PolymorphicVocabulary&&) noexcept = default;
+
+  /// Close the current vocabulary and replace it by an empty vocabulary of the
+  /// given `type`.
+  void resetToType(Type type);
+
+  /// Return the type of the current vocabulary.
+  [[nodiscard]] Type getType() const {
+    return std::holds_alternative<VocabularyOnDisk>(vocabulary_)
+               ? Type::OnDisk
+               : Type::FrontCoded;
+  }
+
+  /// Build the vocabulary of the current type from a text file with one word
+  /// per line, in which newlines and backslashes are escaped. The words get the
+  /// contiguous indices [0 .. #numWords).
+  void buildFromTextFile(const std::string& textFileName,
+                         const std::string& outFileName);
+
+  /// Open the vocabulary from a file that was written for the current type.
+  void open(const std::string& filename);
+
+  /// Close the underlying file and clear the vocabulary.
+  void close();
+
+  /// Return the total number of words.
+  [[nodiscard]] size_t size() const;
+
+  /// Return the highest index (see `VocabularyOnDisk::getHighestId`).
+  [[nodiscard]] uint64_t getHighestId() const;
+
+  /// If an entry with this `idx` exists, return the corresponding string, else
+  /// `std::nullopt`.
+  std::optional<std::string> operator[](uint64_t idx) const;
+
+  /// Same as `operator[]` for each of the `sortedIds` (which must be sorted),
+  /// the i-th element of the result is the word for the i-th ID.
+  std::vector<std::optional<std::string>> getWordsForSortedIds(
+      std::span<const uint64_t> sortedIds) const;
+
+  /// Return a `WordAndIndex` that points to the first entry that is equal or
+  /// greater than `word` wrt. the `comparator` (see
+  /// `VocabularyOnDisk::lower_bound`).
+  template <typename Comparator>
+  WordAndIndex lower_bound(const auto& word, Comparator comparator) const {
+    return std::visit(
+        [&](const auto& vocabulary) {
+          return vocabulary.lower_bound(word, comparator);
+        },
+        vocabulary_);
+  }
+
+  /// Return a `WordAndIndex` that points to the first entry that is greater
+  /// than `word` wrt. the `comparator` (see `VocabularyOnDisk::upper_bound`).
+  template <typename Comparator>
+  WordAndIndex upper_bound(const auto& word, Comparator comparator) const {
+    return std::visit(
+        [&](const auto& vocabulary) {
+          return vocabulary.upper_bound(word, comparator);
+        },
+        vocabulary_);
+  }
+};
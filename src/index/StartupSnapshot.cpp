@@ -0,0 +1,288 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/StartupSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <type_traits>
+
+#include "absl/cleanup/cleanup.h"
+#include "util/Log.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+using ad_utility::serialization::ByteBufferReadSerializer;
+using ad_utility::serialization::ByteBufferWriteSerializer;
+
+// Snapshots that were written with a different version of this format are
+// ignored (and overwritten).
+constexpr uint64_t SNAPSHOT_FORMAT_VERSION = 1;
+
+// All the arrays in the file start at a multiple of this alignment, s.t. they
+// can be used directly from the memory mapping.
+constexpr size_t ARRAY_ALIGNMENT = 8;
+
+// A `CompressedBlockMetadata` as a record of a fixed size. Unlike the
+// `CompressedBlockMetadata` (which stores the offsets of its columns in a
+// `std::vector`), it can be stored in an array in the file and read from there
+// without deserialization.
+struct FixedSizeBlockMetadata {
+  std::array<CompressedBlockMetadata::OffsetAndCompressedSize, NumColumns>
+      offsetsAndCompressedSize_;
+  size_t numRows_;
+  CompressedBlockMetadata::PermutedTriple firstTriple_;
+  CompressedBlockMetadata::PermutedTriple lastTriple_;
+  CompressedBlockMetadata::ZoneMap col2ZoneMap_;
+
+  // Conversion from and to a `CompressedBlockMetadata`.
+  static FixedSizeBlockMetadata fromBlock(const CompressedBlockMetadata& block) {
+    AD_CONTRACT_CHECK(block.offsetsAndCompressedSize_.size() == NumColumns);
+    FixedSizeBlockMetadata result;
+    std::ranges::copy(block.offsetsAndCompressedSize_,
+                      result.offsetsAndCompressedSize_.begin());
+    result.numRows_ = block.numRows_;
+    result.firstTriple_ = block.firstTriple_;
+    result.lastTriple_ = block.lastTriple_;
+    result.col2ZoneMap_ = block.col2ZoneMap_;
+    return result;
+  }
+  CompressedBlockMetadata toBlock() const {
+    return {{offsetsAndCompressedSize_.begin(), offsetsAndCompressedSize_.end()},
+            numRows_,
+            firstTriple_,
+            lastTriple_,
+            col2ZoneMap_};
+  }
+};
+static_assert(std::is_trivially_copyable_v<FixedSizeBlockMetadata>);
+static_assert(alignof(FixedSizeBlockMetadata) <= ARRAY_ALIGNMENT);
+static_assert(alignof(PatternID) <= ARRAY_ALIGNMENT);
+
+// Return a view of the `size` elements of type `T` that start at the `offset`
+// in the `file`, which must be mapped into memory. Throw if the range is not
+// contained in the file.
+template <typename T>
+std::span<const T> getArrayFromMapping(const ad_utility::File& file,
+                                       off_t offset, uint64_t size) {
+  if (size == 0) {
+    return {};
+  }
+  AD_CONTRACT_CHECK(offset % ARRAY_ALIGNMENT == 0);
+  AD_CONTRACT_CHECK(size <= std::numeric_limits<size_t>::max() / sizeof(T));
+  auto bytes = file.getMappedRange(size * sizeof(T), offset);
+  return {reinterpret_cast<const T*>(bytes.data()), size};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<StartupSnapshot> StartupSnapshot::open(
+    const std::string& filename, std::string_view fingerprint) {
+  if (!ad_utility::File::exists(filename)) {
+    return std::nullopt;
+  }
+  // A snapshot that can't be read (e.g. because a server was killed while
+  // writing it) must not prevent the start of a server, the state is then
+  // simply read from the index files.
+  try {
+    StartupSnapshot snapshot;
+    auto& file = snapshot.file_;
+    file.open(filename, "r");
+    file.mapIntoMemory();
+    // The file ends with the offset of the header, which is stored behind all
+    // the arrays (see `write`).
+    const auto fileSize = static_cast<size_t>(file.sizeOfFile());
+    AD_CONTRACT_CHECK(fileSize >= sizeof(off_t));
+    const size_t endOfHeader = fileSize - sizeof(off_t);
+    off_t startOfHeader;
+    std::memcpy(&startOfHeader,
+                file.getMappedRange(sizeof(off_t), endOfHeader).data(),
+                sizeof(off_t));
+    AD_CONTRACT_CHECK(startOfHeader >= 0 &&
+                      static_cast<size_t>(startOfHeader) <= endOfHeader);
+    auto headerBytes =
+        file.getMappedRange(endOfHeader - startOfHeader, startOfHeader);
+    ByteBufferReadSerializer header{
+        std::vector<char>(headerBytes.begin(), headerBytes.end())};
+
+    uint64_t version;
+    std::string fingerprintOfFile;
+    header >> version;
+    header >> fingerprintOfFile;
+    if (version != SNAPSHOT_FORMAT_VERSION ||
+        fingerprintOfFile != fingerprint) {
+      LOG(INFO) << "The startup snapshot " << filename
+                << " was written for other index files and is written again"
+                << std::endl;
+      return std::nullopt;
+    }
+
+    uint64_t numPermutations;
+    header >> numPermutations;
+    for (uint64_t i = 0; i < numPermutations; ++i) {
+      PermutationEntry& entry = snapshot.permutations_.emplace_back();
+      header >> entry.name_;
+      header >> entry.metadata_;
+      header >> entry.blocksOffset_;
+      header >> entry.numBlocks_;
+      // Check that the blocks are contained in the file.
+      getArrayFromMapping<FixedSizeBlockMetadata>(file, entry.blocksOffset_,
+                                                  entry.numBlocks_);
+    }
+
+    bool hasPatterns;
+    header >> hasPatterns;
+    if (hasPatterns) {
+      PatternsEntry& patterns = snapshot.patterns_.emplace();
+      header >> patterns.avgNumSubjectsPerPredicate_;
+      header >> patterns.avgNumPredicatesPerSubject_;
+      header >> patterns.numDistinctSubjectPredicatePairs_;
+      header >> patterns.patterns_;
+      header >> patterns.subjectToPatternOffset_;
+      header >> patterns.subjectToPatternSize_;
+      getArrayFromMapping<PatternID>(file, patterns.subjectToPatternOffset_,
+                                     patterns.subjectToPatternSize_);
+    }
+    return snapshot;
+  } catch (const std::exception& e) {
+    LOG(WARN) << "Could not read the startup snapshot " << filename
+              << ", it is written again: " << e.what() << std::endl;
+    return std::nullopt;
+  }
+}
+
+// _____________________________________________________________________________
+bool StartupSnapshot::containsPermutation(std::string_view name) const {
+  return std::ranges::find(permutations_, name, &PermutationEntry::name_) !=
+         permutations_.end();
+}
+
+// _____________________________________________________________________________
+bool StartupSnapshot::readPermutationMetadata(
+    std::string_view name, PermutationMetadata& metadata) const {
+  auto it = std::ranges::find(permutations_, name, &PermutationEntry::name_);
+  if (it == permutations_.end()) {
+    return false;
+  }
+  ByteBufferReadSerializer serializer{it->metadata_};
+  serializer >> metadata;
+  auto records = getArrayFromMapping<FixedSizeBlockMetadata>(
+      file_, it->blocksOffset_, it->numBlocks_);
+  auto& blocks = metadata.blockData();
+  blocks.clear();
+  blocks.reserve(records.size());
+  for (const auto& record : records) {
+    blocks.push_back(record.toBlock());
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+bool StartupSnapshot::readPatterns(
+    double& avgNumSubjectsPerPredicate, double& avgNumPredicatesPerSubject,
+    uint64_t& numDistinctSubjectPredicatePairs,
+    CompactVectorOfStrings<Id>& patterns,
+    std::span<const PatternID>& subjectToPattern) const {
+  if (!patterns_.has_value()) {
+    return false;
+  }
+  avgNumSubjectsPerPredicate = patterns_->avgNumSubjectsPerPredicate_;
+  avgNumPredicatesPerSubject = patterns_->avgNumPredicatesPerSubject_;
+  numDistinctSubjectPredicatePairs =
+      patterns_->numDistinctSubjectPredicatePairs_;
+  ByteBufferReadSerializer serializer{patterns_->patterns_};
+  serializer >> patterns;
+  subjectToPattern = getArrayFromMapping<PatternID>(
+      file_, patterns_->subjectToPatternOffset_,
+      patterns_->subjectToPatternSize_);
+  return true;
+}
+
+// _____________________________________________________________________________
+void StartupSnapshot::write(
+    const std::string& filename, std::string_view fingerprint,
+    const std::vector<std::pair<std::string, PermutationMetadata*>>&
+        permutations,
+    const Patterns* patterns) {
+  const std::string temporaryFilename = filename + ".tmp";
+  absl::Cleanup deleteTemporaryFile{[&temporaryFilename]() {
+    ad_utility::deleteFile(temporaryFilename, false);
+  }};
+  auto out = ad_utility::makeOfstream(temporaryFilename, std::ios::binary);
+  // Write the `bytes` to the file, followed by padding for the alignment of
+  // the next array. Return the offset of the `bytes` in the file.
+  auto writeArray = [&out](std::span<const char> bytes) {
+    auto offset = static_cast<off_t>(out.tellp());
+    AD_CORRECTNESS_CHECK(offset % ARRAY_ALIGNMENT == 0);
+    static constexpr std::array<char, ARRAY_ALIGNMENT> padding{};
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out.write(padding.data(),
+              (ARRAY_ALIGNMENT - bytes.size() % ARRAY_ALIGNMENT) %
+                  ARRAY_ALIGNMENT);
+    return offset;
+  };
+  auto asBytes = []<typename T>(std::span<const T> array) {
+    return std::span<const char>{reinterpret_cast<const char*>(array.data()),
+                                 array.size() * sizeof(T)};
+  };
+
+  ByteBufferWriteSerializer header;
+  header << SNAPSHOT_FORMAT_VERSION;
+  header << std::string{fingerprint};
+  header << static_cast<uint64_t>(permutations.size());
+  for (const auto& [name, metadata] : permutations) {
+    std::vector<FixedSizeBlockMetadata> records;
+    records.reserve(metadata->blockData().size());
+    std::ranges::transform(metadata->blockData(), std::back_inserter(records),
+                           &FixedSizeBlockMetadata::fromBlock);
+    off_t blocksOffset =
+        writeArray(asBytes(std::span<const FixedSizeBlockMetadata>{records}));
+
+    // The blocks are stored separately, so they are temporarily removed from
+    // the `metadata` for its serialization.
+    ByteBufferWriteSerializer metadataSerializer;
+    {
+      auto blocks = std::move(metadata->blockData());
+      metadata->blockData().clear();
+      absl::Cleanup restoreBlocks{[&metadata, &blocks]() {
+        metadata->blockData() = std::move(blocks);
+      }};
+      metadataSerializer << *metadata;
+    }
+    header << name;
+    header << std::move(metadataSerializer).data();
+    header << blocksOffset;
+    header << static_cast<uint64_t>(records.size());
+  }
+
+  header << (patterns != nullptr);
+  if (patterns != nullptr) {
+    off_t subjectToPatternOffset =
+        writeArray(asBytes(patterns->subjectToPattern_));
+    header << patterns->avgNumSubjectsPerPredicate_;
+    header << patterns->avgNumPredicatesPerSubject_;
+    header << patterns->numDistinctSubjectPredicatePairs_;
+    ByteBufferWriteSerializer patternsSerializer;
+    patternsSerializer << patterns->patterns_;
+    header << std::move(patternsSerializer).data();
+    header << subjectToPatternOffset;
+    header << static_cast<uint64_t>(patterns->subjectToPattern_.size());
+  }
+
+  auto startOfHeader = static_cast<off_t>(out.tellp());
+  const auto& headerBytes = header.data();
+  out.write(headerBytes.data(),
+            static_cast<std::streamsize>(headerBytes.size()));
+  out.write(reinterpret_cast<const char*>(&startOfHeader),
+            sizeof(startOfHeader));
+  out.close();
+  if (!out) {
+    throw std::runtime_error{"Writing the file " + temporaryFilename +
+                             " failed"};
+  }
+  std::filesystem::rename(temporaryFilename, filename);
+}
@@ -0,0 +1,121 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "global/Pattern.h"
+#include "index/IndexMetaData.h"
+#include "util/File.h"
+
+// A snapshot of the state of an index that is derived from the index files
+// and would otherwise be deserialized at every start of a server: The metadata
+// of the loaded permutations (including the metadata of all their blocks) and
+// the patterns. The two large arrays, the metadata of the blocks (as records
+// of a fixed size) and the pattern of each subject, are stored s.t. they can
+// be used directly from a memory mapping of the snapshot file.
+//
+// Note: The pattern of each subject is used directly from the mapping, but
+// the metadata of the blocks is converted to the `CompressedBlockMetadata` in
+// the `PermutationMetadata`, which stores the offsets of its columns in a
+// `std::vector` and therefore can't be a view into the mapping. Using the
+// snapshot thus saves the deserialization of the metadata, but not a copy of
+// the metadata of the blocks. The vocabulary is not part of the snapshot: The
+// internal vocabulary is read from its file as before, the offsets of the
+// words of the external vocabulary are already a memory mapped file (see
+// `VocabularyOnDisk`).
+//
+// The snapshot is written at the first start of a server for an index (see
+// `IndexImpl::createFromOnDiskIndex`) and is identified by the fingerprint of
+// the index files (see `IndexImpl::getFingerprintOfFiles`). A snapshot for
+// other index files is ignored and then overwritten.
+class StartupSnapshot {
+ public:
+  using PermutationMetadata = IndexMetaDataMmapView;
+
+  // The patterns of an index that are written to a snapshot (see
+  // `PatternCreator::readPatternsFromFile` for the meaning of the members).
+  struct Patterns {
+    double avgNumSubjectsPerPredicate_;
+    double avgNumPredicatesPerSubject_;
+    uint64_t numDistinctSubjectPredicatePairs_;
+    const CompactVectorOfStrings<Id>& patterns_;
+    std::span<const PatternID> subjectToPattern_;
+  };
+
+ private:
+  // The metadata of a single permutation. The `metadata_` is the serialized
+  // `PermutationMetadata` without the metadata of the blocks, which are stored
+  // at `blocksOffset_` in the file.
+  struct PermutationEntry {
+    std::string name_;
+    std::vector<char> metadata_;
+    off_t blocksOffset_;
+    uint64_t numBlocks_;
+  };
+
+  // The statistics and the serialized patterns (see `Patterns`), and the
+  // position of the array of the pattern of each subject in the file.
+  struct PatternsEntry {
+    double avgNumSubjectsPerPredicate_;
+    double avgNumPredicatesPerSubject_;
+    uint64_t numDistinctSubjectPredicatePairs_;
+    std::vector<char> patterns_;
+    off_t subjectToPatternOffset_;
+    uint64_t subjectToPatternSize_;
+  };
+
+  // The file is mapped into memory and must therefore outlive all the views
+  // that are handed out by this class.
+  ad_utility::File file_;
+  std::vector<PermutationEntry> permutations_;
+  std::optional<PatternsEntry> patterns_;
+
+ public:
+  // Open the snapshot from the given `filename` and map it into memory.
+  // Return `std::nullopt` if the file doesn't exist, can't be read, or was
+  // written for index files with a different `fingerprint`.
+  static std::optional<StartupSnapshot> open(const std::string& filename,
+                                             std::string_view fingerprint);
+
+  // Return true iff the snapshot contains the permutation with the given
+  // `name` (e.g. "PSO").
+  bool containsPermutation(std::string_view name) const;
+
+  // If the snapshot contains the permutation with the given `name` (e.g.
+  // "PSO"), read its metadata into `metadata` and return true. The relation
+  // metadata in the `.meta` file must already be set up (see
+  // `Permutation::loadFromDisk`). The metadata of the blocks is copied from
+  // the mapping into `metadata.blockData()`. Return false if the permutation is
+  // not contained.
+  bool readPermutationMetadata(std::string_view name,
+                               PermutationMetadata& metadata) const;
+
+  // If the snapshot contains the patterns, read them into the arguments (see
+  // `PatternCreator::readPatternsFromFile`) and return true. The
+  // `subjectToPattern` is a view into the memory mapping of this snapshot.
+  // Return false if the patterns are not contained.
+  bool readPatterns(double& avgNumSubjectsPerPredicate,
+                    double& avgNumPredicatesPerSubject,
+                    uint64_t& numDistinctSubjectPredicatePairs,
+                    CompactVectorOfStrings<Id>& patterns,
+                    std::span<const PatternID>& subjectToPattern) const;
+
+  // Write a snapshot with the metadata of the given `permutations` (pairs of
+  // the name and the metadata) and the `patterns` (if not `nullptr`) to the
+  // given `filename`. The metadata of the permutations is only modified
+  // temporarily during the call. The file is first written under a temporary
+  // name and then renamed, so a snapshot that is currently mapped into memory
+  // (e.g. by another server for the same index) remains valid.
+  static void write(
+      const std::string& filename, std::string_view fingerprint,
+      const std::vector<std::pair<std::string, PermutationMetadata*>>&
+          permutations,
+      const Patterns* patterns);
+};
@@ -29,6 +29,9 @@ inline auto alwaysReturnFalse = [](auto&&...) { return false; };
  *        behavior is undefined.
  * @param isTripleIgnored For each triple `isTripleIgnored(triple)` is called.
  *        The triple is only yielded, if the result of this call is `false` ̇.
+ * The triples that were inserted into the permutation after the index was
+ * built (see `DeltaTriples`) are also yielded, even if their `col0Id` is not
+ * contained in the metadata of the permutation.
  */
 template <typename IsTripleIgnored = decltype(detail::alwaysReturnFalse)>
 cppcoro::generator<std::array<Id, 3>> TriplesView(
@@ -42,6 +45,12 @@ cppcoro::generator<std::array<Id, 3>> TriplesView(
   // compute the ranges that are allowed (the inverse).
   using Iterator = std::decay_t<decltype(metaData.ordered_begin())>;
   std::vector<std::pair<Iterator, Iterator>> allowedRanges;
+  // The same for the (sorted) `col0Id`s of the inserted triples.
+  const std::vector<Id> insertedCol0Ids =
+      permutation.getCol0IdsOfInsertedTriples();
+  using InsertedIterator = std::vector<Id>::const_iterator;
+  std::vector<std::pair<InsertedIterator, InsertedIterator>>
+      allowedInsertedRanges;
 
   // Add sentinels.
   // TODO<joka921> implement Index::prefixRange with all the logic.
@@ -64,11 +73,29 @@ cppcoro::generator<std::array<Id, 3>> TriplesView(
           return decltype(orderedBegin)::getIdFromElement(meta) < id;
         });
     allowedRanges.emplace_back(beginOfAllowed, endOfAllowed);
+    allowedInsertedRanges.emplace_back(
+        std::ranges::lower_bound(insertedCol0Ids, it->second),
+        std::ranges::lower_bound(insertedCol0Ids, (it + 1)->first));
   }
 
-  for (auto& [begin, end] : allowedRanges) {
-    for (auto it = begin; it != end; ++it) {
-      Id id = it.getId();
+  for (size_t i = 0; i < allowedRanges.size(); ++i) {
+    auto [it, end] = allowedRanges[i];
+    auto [insertedIt, insertedEnd] = allowedInsertedRanges[i];
+    // Merge the `col0Id`s from the metadata with those of the inserted
+    // triples.
+    while (it != end || insertedIt != insertedEnd) {
+      Id id;
+      if (insertedIt == insertedEnd ||
+          (it != end && it.getId() <= *insertedIt)) {
+        id = it.getId();
+        if (insertedIt != insertedEnd && *insertedIt == id) {
+          ++insertedIt;
+        }
+        ++it;
+      } else {
+        id = *insertedIt;
+        ++insertedIt;
+      }
       auto blockGenerator = permutation.lazyScan(id, std::nullopt, std::nullopt,
                                                  std::move(timer));
       for (const IdTable& col1And2 : blockGenerator) {
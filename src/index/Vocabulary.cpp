@@ -45,6 +45,7 @@ void Vocabulary<S, C, I>::readFromFile(const string& fileName,
     LOG(INFO) << "Number of words in external vocabulary: "
               << _externalVocabulary.size() << std::endl;
   }
+  cacheId_ = VocabularyCache::makeVocabularyId();
 }
 
 // _____________________________________________________________________________
@@ -62,6 +63,7 @@ template <class S, class C, class I>
 void Vocabulary<S, C, I>::createFromSet(
     const ad_utility::HashSet<std::string>& set) {
   LOG(DEBUG) << "BEGIN Vocabulary::createFromSet" << std::endl;
+  cacheId_.reset();
   _internalVocabulary.close();
   std::vector<std::string> words(set.begin(), set.end());
   auto totalComparison = [this](const auto& a, const auto& b) {
@@ -160,6 +162,7 @@ void Vocabulary<S, C, I>::buildCodebookForPrefixCompression(
 template <class S, class C, class I>
 template <class StringRange>
 void Vocabulary<S, C, I>::initializeExternalizePrefixes(const StringRange& s) {
+  cacheId_.reset();
   _externalizedPrefixes.clear();
   for (const auto& el : s) {
     _externalizedPrefixes.emplace_back(el);
@@ -170,6 +173,7 @@ void Vocabulary<S, C, I>::initializeExternalizePrefixes(const StringRange& s) {
 template <class S, class C, class I>
 template <class StringRange>
 void Vocabulary<S, C, I>::initializeInternalizedLangs(const StringRange& s) {
+  cacheId_.reset();
   _internalizedLangs.clear();
   // `StringRange` might be nlohmann::json, for which we have disabled
   // implicit conversions, so `vector::insert` cannot be used.
@@ -216,6 +220,7 @@ template <typename S, typename ComparatorType, typename I>
 void Vocabulary<S, ComparatorType, I>::setLocale(const std::string& language,
                                                  const std::string& country,
                                                  bool ignorePunctuation) {
+  cacheId_.reset();
   _internalVocabulary.getComparator() =
       ComparatorType(language, country, ignorePunctuation);
   _externalVocabulary.getComparator() =
@@ -233,6 +238,25 @@ AccessReturnType_t<StringType> Vocabulary<StringType, C, I>::at(
 // _____________________________________________________________________________
 template <typename S, typename C, typename I>
 bool Vocabulary<S, C, I>::getId(const string& word, IndexType* idx) const {
+  // The binary search in the internal vocabulary only compares words in
+  // memory, so it is not worth the locking of the cache.
+  if (!cacheId_.has_value() || !shouldBeExternalized(word)) {
+    return getIdUncached(word, idx);
+  }
+  auto [index, isContained] = VocabularyCache::shared().getOrComputeIndex(
+      cacheId_.value(), word, [this, &word]() {
+        IndexType result;
+        bool isContained = getIdUncached(word, &result);
+        return VocabularyCache::IndexOfWord{result.get(), isContained};
+      });
+  *idx = IndexType::make(index);
+  return isContained;
+}
+
+// _____________________________________________________________________________
+template <typename S, typename C, typename I>
+bool Vocabulary<S, C, I>::getIdUncached(const string& word,
+                                        IndexType* idx) const {
   if (!shouldBeExternalized(word)) {
     // need the TOTAL level because we want the unique word.
     *idx = lower_bound(word, SortLevel::TOTAL);
@@ -268,6 +292,39 @@ std::optional<std::string_view> Vocabulary<S, C, I>::operator[](
 template std::optional<std::string_view>
 TextVocabulary::operator[]<std::string, void>(IndexType idx) const;
 
+// _____________________________________________________________________________
+template <typename S, typename C, typename I>
+std::vector<std::optional<string>>
+Vocabulary<S, C, I>::indicesToOptionalStrings(
+    std::span<const IndexType> sortedIndices) const {
+  std::vector<std::optional<string>> result;
+  result.reserve(sortedIndices.size());
+  // The internal words come first, because the indices are sorted.
+  std::vector<uint64_t> externalIds;
+  for (IndexType idx : sortedIndices) {
+    if (idx.get() < _internalVocabulary.size()) {
+      result.emplace_back(std::string{_internalVocabulary[idx.get()]});
+    } else {
+      AD_CONTRACT_CHECK(idx.get() - _internalVocabulary.size() <
+                        _externalVocabulary.size());
+      externalIds.push_back(idx.get() - _internalVocabulary.size());
+    }
+  }
+  auto readExternalWords = [this](std::span<const uint64_t> sortedIds) {
+    return _externalVocabulary.getUnderlyingVocabulary().getWordsForSortedIds(
+        sortedIds);
+  };
+  // The words that are not in the `VocabularyCache` are read together and
+  // then added to the cache.
+  auto externalWords =
+      cacheId_.has_value()
+          ? VocabularyCache::shared().getOrComputeWords(
+                cacheId_.value(), externalIds, readExternalWords)
+          : readExternalWords(externalIds);
+  std::ranges::move(externalWords, std::back_inserter(result));
+  return result;
+}
+
 // ___________________________________________________________________________
 template <typename S, typename C, typename I>
 auto Vocabulary<S, C, I>::getRangesForDatatypes() const
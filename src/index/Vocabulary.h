@@ -11,6 +11,7 @@
 #include <fstream>
 #include <functional>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -29,6 +30,8 @@
 #include "./vocabulary/PrefixCompressor.h"
 #include "./vocabulary/UnicodeVocabulary.h"
 #include "./vocabulary/VocabularyInMemory.h"
+#include "PolymorphicVocabulary.h"
+#include "VocabularyCache.h"
 #include "VocabularyOnDisk.h"
 
 using std::string;
@@ -103,6 +106,7 @@ class Vocabulary {
 
   //! clear all the contents, but not the settings for prefixes etc
   void clear() {
+    cacheId_.reset();
     _internalVocabulary.close();
     _externalVocabulary.close();
   }
@@ -128,6 +132,15 @@ class Vocabulary {
   [[nodiscard]] std::optional<string> indexToOptionalString(
       IndexType idx) const;
 
+  // Same as `indexToOptionalString` for each of the `sortedIndices` (which
+  // must be sorted), the i-th element of the result is the word for the i-th
+  // index. The externalized words that are not in the `VocabularyCache` are
+  // read in a single ascending sweep (see
+  // `VocabularyOnDisk::getWordsForSortedIds` and
+  // `FrontCodedVocabulary::getWordsForSortedIds`) and then added to the cache.
+  std::vector<std::optional<string>> indicesToOptionalStrings(
+      std::span<const IndexType> sortedIndices) const;
+
   //! Get the word with the given idx.
   //! lvalue for compressedString and const& for string-based vocabulary
   AccessReturnType_t<StringType> at(IndexType idx) const;
@@ -168,9 +181,18 @@ class Vocabulary {
 
   bool shouldLiteralBeExternalized(const string& word) const;
 
+  // Set the on-disk format of the externalized words. This has to be called
+  // before `externalizeLiteralsFromTextFile` and before `readFromFile` with
+  // the same `type`.
+  void setExternalVocabularyType(PolymorphicVocabulary::Type type) {
+    cacheId_.reset();
+    _externalVocabulary.getUnderlyingVocabulary().resetToType(type);
+  }
+
   // only still needed for text vocabulary
   void externalizeLiteralsFromTextFile(const string& textFileName,
                                        const string& outFileName) {
+    cacheId_.reset();
     _externalVocabulary.getUnderlyingVocabulary().buildFromTextFile(
         textFileName, outFileName);
   }
@@ -251,9 +273,19 @@ class Vocabulary {
   InternalVocabulary _internalVocabulary;
 
   using ExternalVocabulary =
-      UnicodeVocabulary<VocabularyOnDisk, ComparatorType>;
+      UnicodeVocabulary<PolymorphicVocabulary, ComparatorType>;
   ExternalVocabulary _externalVocabulary;
 
+  // The ID of this vocabulary in the `VocabularyCache`, which caches the
+  // externalized words (which have to be read from disk) and the results of
+  // `getId` for them (which performs a binary search on disk). It
+  // is only set by `readFromFile`, when the vocabulary is complete, and reset
+  // by all the functions that change the vocabulary.
+  std::optional<size_t> cacheId_;
+
+  // The implementation of `getId` without the `VocabularyCache`.
+  bool getIdUncached(const string& word, IndexType* idx) const;
+
  public:
   const ExternalVocabulary& getExternalVocab() const {
     return _externalVocabulary;
@@ -289,6 +321,11 @@ std::optional<string> Vocabulary<S, C, I>::indexToOptionalString(
     // this word must be externalized
     idx.get() -= _internalVocabulary.size();
     AD_CONTRACT_CHECK(idx.get() < _externalVocabulary.size());
-    return _externalVocabulary[idx.get()];
+    if (!cacheId_.has_value()) {
+      return _externalVocabulary[idx.get()];
+    }
+    return VocabularyCache::shared().getOrComputeWord(
+        cacheId_.value(), idx.get(),
+        [this, idx]() { return _externalVocabulary[idx.get()]; });
   }
 }
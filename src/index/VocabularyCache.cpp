@@ -0,0 +1,54 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/VocabularyCache.h"
+
+#include "global/Constants.h"
+
+// ____________________________________________________________________________
+void VocabularyCache::setMaxSizeInBytes(size_t maxSizeInBytes) {
+  maxSizeInBytes_ = maxSizeInBytes;
+  if (maxSizeInBytes == 0) {
+    clear();
+  }
+  // Each of the two directions of each shard gets an equal part of the budget.
+  const size_t maxSizePerCache = maxSizeInBytes / (2 * numShards);
+  for (auto& shard : shards_) {
+    shard.words_.setMaxSizeSingleEntry(maxSizePerCache);
+    shard.words_.setMaxSize(maxSizePerCache);
+    shard.indices_.setMaxSizeSingleEntry(maxSizePerCache);
+    shard.indices_.setMaxSize(maxSizePerCache);
+  }
+}
+
+// ____________________________________________________________________________
+size_t VocabularyCache::numEntries() const {
+  size_t result = 0;
+  for (const auto& shard : shards_) {
+    result += shard.words_.numNonPinnedEntries() +
+              shard.indices_.numNonPinnedEntries();
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+size_t VocabularyCache::sizeInBytes() const {
+  size_t result = 0;
+  for (const auto& shard : shards_) {
+    result += shard.words_.nonPinnedSize() + shard.indices_.nonPinnedSize();
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+size_t VocabularyCache::makeVocabularyId() {
+  static std::atomic<size_t> nextVocabularyId = 0;
+  return nextVocabularyId++;
+}
+
+// ____________________________________________________________________________
+VocabularyCache& VocabularyCache::shared() {
+  static VocabularyCache cache{
+      RuntimeParameters().get<"vocabulary-cache-max-size-mb">() * 1'000'000};
+  return cache;
+}
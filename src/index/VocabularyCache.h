@@ -0,0 +1,201 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "util/Cache.h"
+#include "util/ConcurrentCache.h"
+#include "util/Exception.h"
+
+// A cache for the words of a vocabulary that are resolved frequently (e.g. the
+// IRIs of popular classes). It caches both directions: from an index to its
+// word, and from a word to its index. The cache is shared by all the
+// `Vocabulary`s, which are distinguished by an ID (see
+// `Vocabulary::cacheId_`). Each of the two directions may use half of the
+// budget given by the runtime parameter `vocabulary-cache-max-size-mb`. If the
+// budget is zero, the cache is bypassed completely. The numbers of cache hits
+// and misses are counted for the statistics of the server.
+//
+// To reduce the contention between concurrent queries, the entries are
+// distributed to `numShards` independent shards (by the hash of their key),
+// each of which has its own lock and an equal part of the budget.
+class VocabularyCache {
+ public:
+  // The result of `Vocabulary::getId`: the index of the word (or of the
+  // position where it would be inserted) and whether the word is contained.
+  struct IndexOfWord {
+    uint64_t index_;
+    bool isContained_;
+  };
+
+  // The keys consist of the ID of the vocabulary and the index or the word.
+  using IndexKey = std::pair<size_t, uint64_t>;
+  using WordKey = std::pair<size_t, std::string>;
+
+  static constexpr size_t numShards = 16;
+
+ private:
+  // The cached values together with the (approximate) size of their entry in
+  // bytes, which also depends on the size of the key for `WordKey`s.
+  struct CachedIndex {
+    IndexOfWord indexOfWord_;
+    size_t sizeInBytes_;
+  };
+  struct WordSizeGetter {
+    size_t operator()(const std::optional<std::string>& word) const {
+      return sizeof(IndexKey) + sizeof(word) + (word ? word->size() : 0);
+    }
+  };
+  struct IndexSizeGetter {
+    size_t operator()(const CachedIndex& cachedIndex) const {
+      return cachedIndex.sizeInBytes_;
+    }
+  };
+
+  using WordCache = ad_utility::ConcurrentCache<ad_utility::HeapBasedLRUCache<
+      IndexKey, std::optional<std::string>, WordSizeGetter>>;
+  using IndexCache = ad_utility::ConcurrentCache<
+      ad_utility::HeapBasedLRUCache<WordKey, CachedIndex, IndexSizeGetter>>;
+  struct Shard {
+    WordCache words_;
+    IndexCache indices_;
+  };
+  mutable std::array<Shard, numShards> shards_;
+  std::atomic<size_t> maxSizeInBytes_ = 0;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+
+  // Return the shard that is responsible for the `key`.
+  template <typename Key>
+  Shard& getShard(const Key& key) const {
+    return shards_[absl::Hash<Key>{}(key) % numShards];
+  }
+
+  // Count a hit or a miss, depending on the `cacheStatus`.
+  void countHitOrMiss(ad_utility::CacheStatus cacheStatus) {
+    if (cacheStatus == ad_utility::CacheStatus::computed) {
+      ++numMisses_;
+    } else {
+      ++numHits_;
+    }
+  }
+
+ public:
+  explicit VocabularyCache(size_t maxSizeInBytes) {
+    setMaxSizeInBytes(maxSizeInBytes);
+  }
+
+  // Return the word for the `index` of the vocabulary with the `vocabularyId`.
+  // If it is not contained in the cache, it is computed by calling
+  // `computeWord()`.
+  template <std::invocable ComputeWord>
+  std::optional<std::string> getOrComputeWord(size_t vocabularyId,
+                                              uint64_t index,
+                                              ComputeWord computeWord) {
+    if (maxSizeInBytes_ == 0) {
+      return computeWord();
+    }
+    IndexKey key{vocabularyId, index};
+    auto result = getShard(key).words_.computeOnce(key, std::move(computeWord));
+    countHitOrMiss(result._cacheStatus);
+    return *result._resultPointer;
+  }
+
+  // Same as `getOrComputeWord` for each of the `sortedIndices`, the i-th
+  // element of the result is the word for the i-th index. The words that are
+  // not contained in the cache are computed together by a single call to
+  // `computeWords(missingIndices)`, which gets the (still sorted) indices of
+  // these words and has to return their words in the same order.
+  template <typename ComputeWords>
+  std::vector<std::optional<std::string>> getOrComputeWords(
+      size_t vocabularyId, std::span<const uint64_t> sortedIndices,
+      ComputeWords computeWords) {
+    if (maxSizeInBytes_ == 0) {
+      return computeWords(sortedIndices);
+    }
+    std::vector<std::optional<std::string>> result(sortedIndices.size());
+    std::vector<uint64_t> missingIndices;
+    std::vector<size_t> missingPositions;
+    for (size_t i = 0; i < sortedIndices.size(); ++i) {
+      IndexKey key{vocabularyId, sortedIndices[i]};
+      auto cached = getShard(key).words_.getIfContained(key);
+      if (cached.has_value()) {
+        ++numHits_;
+        result[i] = *cached->_resultPointer;
+      } else {
+        ++numMisses_;
+        missingIndices.push_back(sortedIndices[i]);
+        missingPositions.push_back(i);
+      }
+    }
+    if (missingIndices.empty()) {
+      return result;
+    }
+    std::vector<std::optional<std::string>> missingWords =
+        computeWords(std::span<const uint64_t>{missingIndices});
+    AD_CORRECTNESS_CHECK(missingWords.size() == missingIndices.size());
+    for (size_t i = 0; i < missingIndices.size(); ++i) {
+      IndexKey key{vocabularyId, missingIndices[i]};
+      getShard(key).words_.computeOnce(
+          key, [&word = missingWords[i]]() { return word; });
+      result[missingPositions[i]] = std::move(missingWords[i]);
+    }
+    return result;
+  }
+
+  // Return the index of the `word` in the vocabulary with the `vocabularyId`.
+  // If it is not contained in the cache, it is computed by calling
+  // `computeIndex()`, which has to return an `IndexOfWord`.
+  template <std::invocable ComputeIndex>
+  IndexOfWord getOrComputeIndex(size_t vocabularyId, const std::string& word,
+                                ComputeIndex computeIndex) {
+    if (maxSizeInBytes_ == 0) {
+      return computeIndex();
+    }
+    WordKey key{vocabularyId, word};
+    auto result = getShard(key).indices_.computeOnce(
+        key, [&computeIndex, &word]() {
+          size_t sizeInBytes =
+              sizeof(WordKey) + word.size() + sizeof(CachedIndex);
+          return CachedIndex{computeIndex(), sizeInBytes};
+        });
+    countHitOrMiss(result._cacheStatus);
+    return result._resultPointer->indexOfWord_;
+  }
+
+  // Change the maximal total size of the cached entries. Entries are evicted
+  // if necessary. A size of zero disables the cache.
+  void setMaxSizeInBytes(size_t maxSizeInBytes);
+
+  // Remove all the entries from the cache.
+  void clear() {
+    for (auto& shard : shards_) {
+      shard.words_.clearAll();
+      shard.indices_.clearAll();
+    }
+  }
+
+  // Getters for the statistics.
+  size_t numHits() const { return numHits_; }
+  size_t numMisses() const { return numMisses_; }
+  size_t numEntries() const;
+  size_t sizeInBytes() const;
+
+  // The cache that is shared by all the `Vocabulary`s.
+  static VocabularyCache& shared();
+
+  // Return an ID that is different from all the IDs returned before. A
+  // vocabulary gets a new ID whenever its contents change, so that the entries
+  // for the old contents are never found again.
+  static size_t makeVocabularyId();
+};
@@ -48,6 +48,55 @@ std::optional<string> VocabularyOnDisk::operator[](uint64_t idx) const {
   return result;
 }
 
+// _____________________________________________________________________________
+std::vector<std::optional<string>> VocabularyOnDisk::getWordsForSortedIds(
+    std::span<const uint64_t> sortedIds) const {
+  AD_CONTRACT_CHECK(std::ranges::is_sorted(sortedIds));
+  std::vector<std::optional<string>> result(sortedIds.size());
+
+  // The positions in the `result` of the IDs that are contained in the
+  // vocabulary, together with the offsets and sizes of their words. Because the
+  // IDs are sorted, the search for the next ID can start at the previous one.
+  std::vector<std::pair<size_t, OffsetAndSize>> contained;
+  auto it = _idsAndOffsets.begin();
+  for (size_t i = 0; i < sortedIds.size(); ++i) {
+    it = std::lower_bound(it, _idsAndOffsets.end(),
+                          IndexAndOffset{sortedIds[i], 0});
+    if (it >= _idsAndOffsets.end() - 1 || it->_idx != sortedIds[i]) {
+      continue;
+    }
+    contained.emplace_back(
+        i, getOffsetAndSizeForIthElement(it - _idsAndOffsets.begin()));
+  }
+
+  // Read the words in ranges of neighboring words. The offsets are ascending,
+  // because the IDs are.
+  std::string buffer;
+  size_t rangeBegin = 0;
+  while (rangeBegin < contained.size()) {
+    const uint64_t beginOffset = contained[rangeBegin].second._offset;
+    uint64_t endOffset = beginOffset + contained[rangeBegin].second._size;
+    size_t rangeEnd = rangeBegin + 1;
+    for (; rangeEnd < contained.size(); ++rangeEnd) {
+      const auto& [offset, size] = contained[rangeEnd].second;
+      if (offset > endOffset + _maxGapInBatchRead ||
+          offset + size - beginOffset > _maxBatchReadSize) {
+        break;
+      }
+      endOffset = std::max(endOffset, offset + size);
+    }
+    buffer.resize(endOffset - beginOffset);
+    _file.read(buffer.data(), buffer.size(), beginOffset);
+    for (size_t j = rangeBegin; j < rangeEnd; ++j) {
+      const auto& [resultIndex, offsetAndSize] = contained[j];
+      result[resultIndex] = buffer.substr(offsetAndSize._offset - beginOffset,
+                                          offsetAndSize._size);
+    }
+    rangeBegin = rangeEnd;
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 template <typename Iterable>
 void VocabularyOnDisk::buildFromIterable(Iterable&& it,
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -48,6 +49,12 @@ class VocabularyOnDisk {
   // the name for the file in which IDs and offsets are stored.
   static constexpr std::string_view _offsetSuffix = ".idsAndOffsets.mmap";
 
+  // When several words are looked up at once (see `getWordsForSortedIds`),
+  // words that are at most this many bytes apart in the file are read with a
+  // single read, as long as this read is not larger than `_maxBatchReadSize`.
+  static constexpr uint64_t _maxGapInBatchRead = 16 * 1024;
+  static constexpr uint64_t _maxBatchReadSize = 1024 * 1024;
+
  public:
   /// Build from a vector of strings, or from a textFile with one word per line.
   /// These functions will assign the contiguous Ids [0 .. #numWords).
@@ -72,6 +79,14 @@ class VocabularyOnDisk {
   /// `std::nullopt`
   std::optional<string> operator[](uint64_t idx) const;
 
+  /// Same as `operator[]` for each of the `sortedIds` (which must be sorted),
+  /// the i-th element of the result is the word for the i-th ID. The words are
+  /// read from the file in a single ascending sweep, and reads of neighboring
+  /// words are coalesced. This is much faster than many calls to `operator[]`
+  /// when the words are not in the page cache.
+  std::vector<std::optional<string>> getWordsForSortedIds(
+      std::span<const uint64_t> sortedIds) const;
+
   /// Get the number of words in the vocabulary.
   size_t size() const { return _size; }
 
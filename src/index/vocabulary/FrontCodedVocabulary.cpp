@@ -0,0 +1,215 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/vocabulary/FrontCodedVocabulary.h"
+
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/ExceptionHandling.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+// Append the `value` to the `target` as a variable-length integer with 7 bits
+// per byte. The highest bit of each byte indicates whether more bytes follow.
+void appendVarint(std::string& target, uint64_t value) {
+  while (value >= 0x80) {
+    target.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  target.push_back(static_cast<char>(value));
+}
+
+// Read a variable-length integer that was written by `appendVarint` from the
+// `source`, starting at `position`, which is advanced past the integer.
+uint64_t readVarint(std::string_view source, size_t& position) {
+  uint64_t result = 0;
+  for (size_t shift = 0;; shift += 7) {
+    AD_CORRECTNESS_CHECK(position < source.size());
+    auto byte = static_cast<uint8_t>(source[position++]);
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return result;
+    }
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::open(const std::string& filename) {
+  close();
+  file_.open(filename, "r");
+  off_t startOfMetadata;
+  off_t endOfMetadata = file_.getLastOffset(&startOfMetadata);
+  std::vector<char> buffer(endOfMetadata - startOfMetadata);
+  file_.read(buffer.data(), buffer.size(), startOfMetadata);
+  ad_utility::serialization::ByteBufferReadSerializer serializer{
+      std::move(buffer)};
+  uint8_t blockCompression;
+  serializer >> numWords_;
+  serializer >> numWordsPerBlock_;
+  serializer >> blockCompression;
+  serializer >> blockOffsets_;
+  serializer >> firstWordsOfBlocks_;
+  blockCompression_ = static_cast<BlockCompression>(blockCompression);
+  AD_CORRECTNESS_CHECK(blockOffsets_.size() == firstWordsOfBlocks_.size() + 1);
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::close() {
+  file_.close();
+  numWords_ = 0;
+  blockOffsets_.clear();
+  firstWordsOfBlocks_.clear();
+}
+
+// _____________________________________________________________________________
+std::string FrontCodedVocabulary::operator[](uint64_t i) const {
+  AD_CONTRACT_CHECK(i < numWords_);
+  auto words = decodeBlock(i / numWordsPerBlock_, i % numWordsPerBlock_ + 1);
+  return std::move(words.back());
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<std::string>>
+FrontCodedVocabulary::getWordsForSortedIds(
+    std::span<const uint64_t> sortedIds) const {
+  AD_CONTRACT_CHECK(std::ranges::is_sorted(sortedIds));
+  std::vector<std::optional<std::string>> result;
+  result.reserve(sortedIds.size());
+  size_t i = 0;
+  while (i < sortedIds.size() && sortedIds[i] < numWords_) {
+    // Decode the block of the `i`-th ID up to the last ID in this block.
+    uint64_t blockIndex = sortedIds[i] / numWordsPerBlock_;
+    size_t end = i;
+    while (end < sortedIds.size() && sortedIds[end] < numWords_ &&
+           sortedIds[end] / numWordsPerBlock_ == blockIndex) {
+      ++end;
+    }
+    auto words = decodeBlock(blockIndex,
+                             sortedIds[end - 1] % numWordsPerBlock_ + 1);
+    for (; i < end; ++i) {
+      result.emplace_back(words.at(sortedIds[i] % numWordsPerBlock_));
+    }
+  }
+  result.resize(sortedIds.size());
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> FrontCodedVocabulary::decodeBlock(
+    uint64_t blockIndex, uint64_t numWordsToDecode) const {
+  AD_CONTRACT_CHECK(blockIndex + 1 < blockOffsets_.size());
+  uint64_t offset = blockOffsets_[blockIndex];
+  std::string block(blockOffsets_[blockIndex + 1] - offset, '\0');
+  file_.read(block.data(), block.size(), offset);
+  if (blockCompression_ == BlockCompression::Zstd) {
+    size_t position = 0;
+    size_t uncompressedSize = readVarint(block, position);
+    std::string uncompressed(uncompressedSize, '\0');
+    auto numBytes = ZstdWrapper::decompressToBuffer(
+        block.data() + position, block.size() - position, uncompressed.data(),
+        uncompressed.size());
+    AD_CORRECTNESS_CHECK(numBytes == uncompressedSize);
+    block = std::move(uncompressed);
+  }
+
+  // The last block may contain fewer words.
+  numWordsToDecode =
+      std::min(numWordsToDecode, numWords_ - blockIndex * numWordsPerBlock_);
+  std::vector<std::string> words;
+  words.reserve(numWordsToDecode);
+  size_t position = 0;
+  for (uint64_t i = 0; i < numWordsToDecode; ++i) {
+    size_t prefixLength = readVarint(block, position);
+    size_t suffixLength = readVarint(block, position);
+    AD_CORRECTNESS_CHECK(position + suffixLength <= block.size());
+    std::string word;
+    word.reserve(prefixLength + suffixLength);
+    if (prefixLength > 0) {
+      AD_CORRECTNESS_CHECK(!words.empty() &&
+                           prefixLength <= words.back().size());
+      word.append(words.back(), 0, prefixLength);
+    }
+    word.append(block, position, suffixLength);
+    position += suffixLength;
+    words.push_back(std::move(word));
+  }
+  return words;
+}
+
+// _____________________________________________________________________________
+FrontCodedVocabulary::WordWriter::WordWriter(const std::string& filename,
+                                             uint64_t numWordsPerBlock,
+                                             BlockCompression blockCompression)
+    : file_{filename, "w"},
+      numWordsPerBlock_{numWordsPerBlock},
+      blockCompression_{blockCompression} {
+  AD_CONTRACT_CHECK(numWordsPerBlock_ > 0);
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::WordWriter::push(const char* data, size_t size) {
+  AD_CONTRACT_CHECK(!finished_);
+  std::string_view word{data, size};
+  if (numWords_ % numWordsPerBlock_ == 0) {
+    if (numWords_ > 0) {
+      writeCurrentBlock();
+    }
+    firstWordsOfBlocks_.emplace_back(word);
+    previousWord_.clear();
+  }
+  auto mismatch = std::ranges::mismatch(word, previousWord_);
+  size_t prefixLength = mismatch.in1 - word.begin();
+  appendVarint(currentBlock_, prefixLength);
+  appendVarint(currentBlock_, size - prefixLength);
+  currentBlock_.append(word.substr(prefixLength));
+  previousWord_.assign(word);
+  ++numWords_;
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::WordWriter::writeCurrentBlock() {
+  if (blockCompression_ == BlockCompression::Zstd) {
+    std::vector<char> compressed =
+        ZstdWrapper::compress(currentBlock_.data(), currentBlock_.size());
+    std::string block;
+    appendVarint(block, currentBlock_.size());
+    block.append(compressed.begin(), compressed.end());
+    currentBlock_ = std::move(block);
+  }
+  file_.write(currentBlock_.data(), currentBlock_.size());
+  blockOffsets_.push_back(blockOffsets_.back() + currentBlock_.size());
+  currentBlock_.clear();
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::WordWriter::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  if (numWords_ > 0) {
+    writeCurrentBlock();
+  }
+  CompactVectorOfStrings<char> firstWordsOfBlocks;
+  firstWordsOfBlocks.build(firstWordsOfBlocks_);
+  off_t startOfMetadata = static_cast<off_t>(blockOffsets_.back());
+  ad_utility::serialization::FileWriteSerializer serializer{std::move(file_)};
+  serializer << numWords_;
+  serializer << numWordsPerBlock_;
+  serializer << static_cast<uint8_t>(blockCompression_);
+  serializer << blockOffsets_;
+  serializer << firstWordsOfBlocks;
+  file_ = std::move(serializer).file();
+  file_.write(&startOfMetadata, sizeof(startOfMetadata));
+  file_.close();
+}
+
+// _____________________________________________________________________________
+FrontCodedVocabulary::WordWriter::~WordWriter() {
+  ad_utility::terminateIfThrows(
+      [this]() { finish(); },
+      "Finishing the underlying File of a `FrontCodedVocabulary::WordWriter` "
+      "during destruction failed");
+}
@@ -0,0 +1,181 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "global/Pattern.h"
+#include "index/vocabulary/VocabularyTypes.h"
+#include "util/File.h"
+
+// An on-disk vocabulary of strings with the contiguous indices [0 .. size()).
+// The words are stored in blocks of a fixed number of words. Within a block,
+// the words are front-coded: each word is stored as the length of the prefix
+// that it shares with the previous word, followed by the remaining suffix.
+// Optionally, each block is additionally compressed with Zstd. Only the first
+// word and the offset of each block are kept in RAM, so `operator[]`,
+// `lower_bound` and `upper_bound` each read and decode a single block.
+//
+// The words can be arbitrary byte strings, in particular they can be the
+// output of a `Compressor` when this class is used as the underlying
+// vocabulary of a `CompressedVocabulary`. The front coding is most effective if
+// the words are sorted, and `lower_bound` and `upper_bound` only work correctly
+// for sorted words.
+class FrontCodedVocabulary {
+ public:
+  // The compression that is applied to each block after the front coding.
+  enum class BlockCompression : uint8_t { None, Zstd };
+
+  static constexpr size_t defaultNumWordsPerBlock = 64;
+
+ private:
+  // The file that contains the blocks, followed by the metadata (the members
+  // below).
+  mutable ad_utility::File file_;
+  uint64_t numWords_ = 0;
+  uint64_t numWordsPerBlock_ = defaultNumWordsPerBlock;
+  BlockCompression blockCompression_ = BlockCompression::None;
+  // The offsets of the blocks in the `file_`, followed by the end of the last
+  // block.
+  std::vector<uint64_t> blockOffsets_;
+  // The first word of each block.
+  CompactVectorOfStrings<char> firstWordsOfBlocks_;
+
+ public:
+  FrontCodedVocabulary() = default;
+  FrontCodedVocabulary(FrontCodedVocabulary&&) noexcept = default;
+  FrontCodedVocabulary& operator=(FrontCodedVocabulary&&) noexcept = default;
+
+  /// Read the vocabulary from a file. The file must have been created using a
+  /// `WordWriter`.
+  void open(const std::string& filename);
+
+  /// Close the underlying file and clear the vocabulary.
+  void close();
+
+  /// Return the total number of words.
+  [[nodiscard]] size_t size() const { return numWords_; }
+
+  /// Return the highest index. For an empty vocabulary this is the highest
+  /// possible index (s.t. `getHighestId() + 1` overflows to 0), which is
+  /// consistent with `VocabularyOnDisk`.
+  [[nodiscard]] uint64_t getHighestId() const { return numWords_ - 1; }
+
+  /// Return the `i`-th word. Requires that `i < size()`.
+  std::string operator[](uint64_t i) const;
+
+  /// Same as `operator[]` for each of the `sortedIds` (which must be sorted),
+  /// the i-th element of the result is the word for the i-th ID, or
+  /// `std::nullopt` if the ID is not smaller than `size()`. Each block is read
+  /// and decoded only once.
+  std::vector<std::optional<std::string>> getWordsForSortedIds(
+      std::span<const uint64_t> sortedIds) const;
+
+  /// Return a `WordAndIndex` that points to the first entry that is equal or
+  /// greater than `word` wrt. the `comparator`. Only works correctly if the
+  /// words are sorted according to the comparator (exactly like in
+  /// `std::lower_bound`, which is used internally).
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex lower_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    auto blockIt = std::lower_bound(firstWordsOfBlocks_.begin(),
+                                    firstWordsOfBlocks_.end(), word,
+                                    comparator);
+    return findInBlockOrFirstOfNextBlock(
+        blockIt - firstWordsOfBlocks_.begin(), [&](const auto& words) {
+          return std::lower_bound(words.begin(), words.end(), word,
+                                  comparator);
+        });
+  }
+
+  /// Return a `WordAndIndex` that points to the first entry that is greater
+  /// than `word` wrt. the `comparator`. Only works correctly if the words are
+  /// sorted according to the comparator (exactly like in `std::upper_bound`,
+  /// which is used internally).
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex upper_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    auto blockIt = std::upper_bound(firstWordsOfBlocks_.begin(),
+                                    firstWordsOfBlocks_.end(), word,
+                                    comparator);
+    return findInBlockOrFirstOfNextBlock(
+        blockIt - firstWordsOfBlocks_.begin(), [&](const auto& words) {
+          return std::upper_bound(words.begin(), words.end(), word,
+                                  comparator);
+        });
+  }
+
+  /// Allows the incremental writing of the words to disk. Only one block and
+  /// the first word of each block are kept in RAM.
+  class WordWriter {
+   private:
+    ad_utility::File file_;
+    uint64_t numWordsPerBlock_;
+    BlockCompression blockCompression_;
+    uint64_t numWords_ = 0;
+    std::vector<uint64_t> blockOffsets_{0};
+    std::vector<std::string> firstWordsOfBlocks_;
+    // The front-coded words of the current block and the previous word.
+    std::string currentBlock_;
+    std::string previousWord_;
+    bool finished_ = false;
+
+   public:
+    explicit WordWriter(const std::string& filename,
+                        uint64_t numWordsPerBlock = defaultNumWordsPerBlock,
+                        BlockCompression blockCompression =
+                            BlockCompression::None);
+
+    /// Append the word that is given by `data` and `size`.
+    void push(const char* data, size_t size);
+    void push(std::string_view word) { push(word.data(), word.size()); }
+
+    /// Write the last block and the metadata. After calls to `finish()` no
+    /// more words can be pushed. `finish()` is implicitly also called by the
+    /// destructor.
+    void finish();
+
+    ~WordWriter();
+
+   private:
+    // Write the `currentBlock_` to the file and start a new one.
+    void writeCurrentBlock();
+  };
+
+ private:
+  // Read the block with the `blockIndex` from the file and decode its first
+  // `numWordsToDecode` words.
+  std::vector<std::string> decodeBlock(uint64_t blockIndex,
+                                       uint64_t numWordsToDecode) const;
+
+  // Common implementation of `lower_bound` and `upper_bound`. The word that is
+  // searched is before the first word of the block with the
+  // `indexOfNextBlock`, so it is either found in the block before it (by
+  // calling `findInBlock`, which returns an iterator into the decoded words of
+  // that block), or it is the first word of the block with the
+  // `indexOfNextBlock`.
+  WordAndIndex findInBlockOrFirstOfNextBlock(uint64_t indexOfNextBlock,
+                                             const auto& findInBlock) const {
+    if (indexOfNextBlock > 0) {
+      uint64_t blockIndex = indexOfNextBlock - 1;
+      auto words = decodeBlock(blockIndex, numWordsPerBlock_);
+      auto it = findInBlock(words);
+      if (it != words.end()) {
+        return {std::move(*it), blockIndex * numWordsPerBlock_ +
+                                    static_cast<uint64_t>(it - words.begin())};
+      }
+    }
+    if (indexOfNextBlock < firstWordsOfBlocks_.size()) {
+      return {std::string{firstWordsOfBlocks_[indexOfNextBlock]},
+              indexOfNextBlock * numWordsPerBlock_};
+    }
+    return {std::nullopt, getHighestId() + 1};
+  }
+};
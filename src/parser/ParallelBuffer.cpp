@@ -3,13 +3,57 @@
 
 #include "./ParallelBuffer.h"
 
+// For some include orders the EOF constant is not defined although `<cstdio>`
+// was included, so we define it manually (see `util/CompressorStream.h`).
+#ifndef EOF
+#define EOF std::char_traits<char>::eof()
+#endif
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
 // _________________________________________________________________________
 void ParallelFileBuffer::open(const string& filename) {
+  namespace io = boost::iostreams;
   file_.open(filename, "r");
+  decompressingStream_.reset();
+  if (filename.ends_with(".gz") || filename.ends_with(".zst")) {
+    // The `ad_utility::File` is only used to check that the file can be
+    // opened, the actual reading is done by the decompressing stream.
+    auto stream = std::make_unique<io::filtering_istream>();
+    if (filename.ends_with(".gz")) {
+      stream->push(io::gzip_decompressor());
+    } else {
+      stream->push(io::zstd_decompressor());
+    }
+    stream->push(io::file_source(filename, std::ios::in | std::ios::binary));
+    // Corrupt input has to lead to an error instead of silently truncating it.
+    stream->exceptions(std::ios::badbit);
+    decompressingStream_ = std::move(stream);
+  }
   eof_ = false;
+  readNextBlockAsync();
+}
+
+// _________________________________________________________________________
+void ParallelFileBuffer::readNextBlockAsync() {
   buf_.resize(blocksize_);
-  auto task = [&file = this->file_, bs = this->blocksize_,
-               &buf = this->buf_]() { return file.read(buf.data(), bs); };
+  auto task = [&file = this->file_, &stream = this->decompressingStream_,
+               bs = this->blocksize_, &buf = this->buf_]() -> size_t {
+    if (!stream) {
+      return file.read(buf.data(), bs);
+    }
+    // A single `read` on the decompressing stream might return fewer bytes than
+    // requested although the end of the input was not yet reached.
+    size_t numBytesRead = 0;
+    while (numBytesRead < bs && stream->good()) {
+      stream->read(buf.data() + numBytesRead,
+                   static_cast<std::streamsize>(bs - numBytesRead));
+      numBytesRead += static_cast<size_t>(stream->gcount());
+    }
+    return numBytesRead;
+  };
   fut_ = std::async(task);
 }
 
@@ -27,14 +71,7 @@ std::optional<ParallelBuffer::BufferType> ParallelFileBuffer::getNextBlock() {
   }
   buf_.resize(numBytesRead);
   std::optional<BufferType> ret = std::move(buf_);
-
-  buf_.resize(blocksize_);
-  auto getNextBlock = [&file = this->file_, bs = this->blocksize_,
-                       &buf = this->buf_]() {
-    return file.read(buf.data(), bs);
-  };
-  fut_ = std::async(getNextBlock);
-
+  readNextBlockAsync();
   return ret;
 }
 
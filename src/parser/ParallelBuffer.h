@@ -7,6 +7,8 @@
 #include <re2/re2.h>
 
 #include <future>
+#include <istream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -56,7 +58,9 @@ class ParallelBuffer {
  * any modification.
  *
  * The next block is also read in parallel in case we have a
- * really slow filesystem etc.
+ * really slow filesystem etc. If the filename ends with `.gz` or `.zst`, the
+ * file is decompressed on the fly (gzip or Zstandard) and the blocks contain
+ * the decompressed bytes.
  */
 class ParallelFileBuffer : public ParallelBuffer {
  public:
@@ -70,7 +74,13 @@ class ParallelFileBuffer : public ParallelBuffer {
   std::optional<BufferType> getNextBlock() override;
 
  private:
+  // Asynchronously read the next block into `buf_`.
+  void readNextBlockAsync();
+
   ad_utility::File file_;
+  // Only set if the input is compressed, then we read from this stream instead
+  // of from `file_`.
+  std::unique_ptr<std::istream> decompressingStream_;
   bool eof_ = true;
   BufferType buf_;
   std::future<size_t> fut_;
@@ -0,0 +1,24 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/TripleComponent.h"
+
+// A single operation of a SPARQL 1.1 Update request, see
+// `SparqlParser::parseUpdate`. The triples of `INSERT DATA` and `DELETE DATA`
+// only consist of IRIs and literals and there is no `whereClause_`. For
+// `DELETE WHERE` and `DELETE ... INSERT ... WHERE`, the triples are templates
+// that are instantiated with each row of the result of the `whereClause_`,
+// which is a `SELECT *` query.
+struct ParsedUpdate {
+  using Triple = std::array<TripleComponent, 3>;
+  std::vector<Triple> toDelete_;
+  std::vector<Triple> toInsert_;
+  std::optional<ParsedQuery> whereClause_;
+};
@@ -4,7 +4,12 @@
 
 #include "./SparqlParser.h"
 
+#include "absl/strings/str_cat.h"
 #include "parser/SparqlParserHelpers.h"
+#include "parser/TokenizerCtre.h"
+#include "parser/TurtleParser.h"
+#include "util/OverloadCallOperator.h"
+#include "util/StringUtils.h"
 
 using AntlrParser = SparqlAutomaticParser;
 
@@ -24,3 +29,158 @@ ParsedQuery SparqlParser::parseQuery(std::string query) {
   AD_CONTRACT_CHECK(resultOfParseAndRemainingText.remainingText_.empty());
   return std::move(resultOfParseAndRemainingText.resultOfParse_);
 }
+
+namespace {
+// Convert an element of a triple template of an update to a
+// `TripleComponent`. Blank nodes are not supported, because they would have to
+// be replaced by new blank nodes that are not contained in the index.
+TripleComponent toTripleComponent(const VarOrTerm& varOrTerm) {
+  auto visitIri = [](const Iri& iri) -> TripleComponent {
+    return iri.toSparql();
+  };
+  auto visitBlankNode = [](const BlankNode&) -> TripleComponent {
+    throw ParseException{
+        "Blank nodes in the triples of a SPARQL update are not supported by "
+        "QLever"};
+  };
+  auto visitLiteral = [](const Literal& literal) {
+    return TurtleStringParser<TokenizerCtre>::parseTripleObject(
+        literal.toSparql());
+  };
+  auto visitGraphTerm = [&](const GraphTerm& graphTerm) {
+    return graphTerm.visit(ad_utility::OverloadCallOperator{
+        visitIri, visitBlankNode, visitLiteral});
+  };
+  auto visitVariable = [](const Variable& var) { return TripleComponent{var}; };
+  return varOrTerm.visit(
+      ad_utility::OverloadCallOperator{visitVariable, visitGraphTerm});
+}
+
+// Convert the triples of a `CONSTRUCT`-like template to `TripleComponent`s.
+std::vector<ParsedUpdate::Triple> toTriples(
+    const std::optional<parsedQuery::ConstructClause>& clause) {
+  std::vector<ParsedUpdate::Triple> triples;
+  if (!clause.has_value()) {
+    return triples;
+  }
+  for (const auto& [subject, predicate, object] : clause.value().triples_) {
+    triples.push_back({toTripleComponent(subject), toTripleComponent(predicate),
+                       toTripleComponent(object)});
+  }
+  return triples;
+}
+
+// Make a `SELECT *` query from the result of visiting a WHERE clause.
+ParsedQuery makeSelectAllQuery(
+    SparqlQleverVisitor::PatternAndVisibleVariables whereClause,
+    std::string originalString) {
+  ParsedQuery query;
+  ParsedQuery::SelectClause selectClause;
+  selectClause.setAsterisk();
+  query._clause = std::move(selectClause);
+  auto& [pattern, visibleVariables] = whereClause;
+  query._rootGraphPattern = std::move(pattern);
+  query.registerVariablesVisibleInQueryBody(visibleVariables);
+  query.addSolutionModifiers({});
+  query._originalString = std::move(originalString);
+  return query;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<ParsedUpdate> SparqlParser::parseUpdate(std::string update) {
+  std::string originalString = update;
+  sparqlParserHelpers::ParserAndVisitor p{
+      std::move(update),
+      {{INTERNAL_PREDICATE_PREFIX_NAME, INTERNAL_PREDICATE_PREFIX_IRI}}};
+  auto& parser = p.parser_;
+  auto& visitor = p.visitor_;
+  // The grammar has no rules for updates (yet), so we dispatch on the keywords
+  // manually and only use the rules for the prologue, the triple templates,
+  // and the WHERE clause.
+  auto currentText = [&parser]() {
+    return ad_utility::getUppercase(parser.getCurrentToken()->getText());
+  };
+  auto consumeIf = [&parser, &currentText](std::string_view keyword) {
+    if (currentText() != keyword) {
+      return false;
+    }
+    parser.consume();
+    return true;
+  };
+  auto parseTemplate = [&parser, &visitor]() {
+    return toTriples(visitor.visit(parser.constructTemplate()));
+  };
+  auto parseData = [&parseTemplate]() {
+    auto triples = parseTemplate();
+    for (const auto& triple : triples) {
+      if (std::ranges::any_of(triple, &TripleComponent::isVariable)) {
+        throw ParseException{
+            "Variables are not allowed in INSERT DATA and DELETE DATA"};
+      }
+    }
+    return triples;
+  };
+  auto parseWhereClause = [&]() {
+    if (currentText() != "WHERE") {
+      throw ParseException{absl::StrCat("Expected WHERE, but found \"",
+                                        parser.getCurrentToken()->getText(),
+                                        "\"")};
+    }
+    return makeSelectAllQuery(visitor.visit(parser.whereClause()),
+                              originalString);
+  };
+
+  std::vector<ParsedUpdate> result;
+  do {
+    visitor.visit(parser.prologue());
+    // An update request may be empty and may end with a `;`.
+    if (parser.getCurrentToken()->getType() == antlr4::Token::EOF) {
+      break;
+    }
+    ParsedUpdate operation;
+    if (consumeIf("INSERT")) {
+      if (consumeIf("DATA")) {
+        operation.toInsert_ = parseData();
+      } else {
+        operation.toInsert_ = parseTemplate();
+        operation.whereClause_ = parseWhereClause();
+      }
+    } else if (consumeIf("DELETE")) {
+      if (consumeIf("DATA")) {
+        operation.toDelete_ = parseData();
+      } else if (consumeIf("WHERE")) {
+        // `DELETE WHERE { template }` is a shorthand for
+        // `DELETE { template } WHERE { template }`.
+        auto* templateContext = parser.constructTemplate();
+        std::string templateString =
+            SparqlQleverVisitor::getOriginalInputForContext(templateContext);
+        operation.toDelete_ = toTriples(visitor.visit(templateContext));
+        sparqlParserHelpers::ParserAndVisitor whereParser{
+            absl::StrCat("WHERE ", templateString), visitor.prefixMap()};
+        operation.whereClause_ = makeSelectAllQuery(
+            whereParser.visitor_.visit(whereParser.parser_.whereClause()),
+            originalString);
+      } else {
+        operation.toDelete_ = parseTemplate();
+        if (consumeIf("INSERT")) {
+          operation.toInsert_ = parseTemplate();
+        }
+        operation.whereClause_ = parseWhereClause();
+      }
+    } else {
+      throw ParseException{absl::StrCat(
+          "Unsupported or invalid SPARQL update operation starting with \"",
+          parser.getCurrentToken()->getText(),
+          "\". Supported are INSERT DATA, DELETE DATA, DELETE WHERE, and "
+          "DELETE/INSERT ... WHERE (without WITH and USING)")};
+    }
+    result.push_back(std::move(operation));
+  } while (consumeIf(";"));
+  if (parser.getCurrentToken()->getType() != antlr4::Token::EOF) {
+    throw ParseException{
+        absl::StrCat("Unexpected input \"", parser.getCurrentToken()->getText(),
+                     "\" after a SPARQL update operation")};
+  }
+  return result;
+}
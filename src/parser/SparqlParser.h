@@ -4,8 +4,10 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "parser/ParsedQuery.h"
+#include "parser/ParsedUpdate.h"
 
 // The SPARQL parser used by QLever. The actual parsing is delegated to a parser
 // that is based on ANTLR4, which recognises the complete SPARQL 1.1 QL grammar.
@@ -14,4 +16,10 @@
 class SparqlParser {
  public:
   static ParsedQuery parseQuery(std::string query);
+
+  // Parse a SPARQL 1.1 Update request, which consists of one or more
+  // operations separated by `;`. Supported are `INSERT DATA`, `DELETE DATA`,
+  // `DELETE WHERE` and `DELETE/INSERT ... WHERE` without `WITH`, `USING`, and
+  // blank nodes.
+  static std::vector<ParsedUpdate> parseUpdate(std::string update);
 };
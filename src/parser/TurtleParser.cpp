@@ -848,7 +848,8 @@ void TurtleParallelParser<Tokenizer_T>::initialize(const string& filename) {
         inputBatch = std::move(remainingBatchFromInitialization_);
         first = false;
       } else {
-        auto nextOptional = fileBuffer_.getNextBlock();
+        auto nextOptional =
+            isCancelled_ ? std::nullopt : fileBuffer_.getNextBlock();
         if (!nextOptional) {
           // Wait until everything has been parsed.
           parallelParser_.finish();
@@ -881,6 +882,19 @@ void TurtleParallelParser<Tokenizer_T>::initialize(const string& filename) {
   parseFuture_ = std::async(std::launch::async, feedBatches);
 }
 
+template <class T>
+TurtleParallelParser<T>::~TurtleParallelParser() {
+  if (!parseFuture_.valid()) {
+    return;
+  }
+  isCancelled_ = true;
+  // Discard the remaining parsed batches, otherwise the parsing threads might
+  // block forever because nobody picks up their results.
+  while (tripleCollector_.popManually()) {
+  }
+  parseFuture_.wait();
+}
+
 template <class T>
 bool TurtleParallelParser<T>::getLine(TurtleTriple* triple) {
   // If the current batch is out of triples_ get the next batch of triples.
@@ -919,6 +933,80 @@ std::optional<std::vector<TurtleTriple>> TurtleParallelParser<T>::getBatch() {
   return std::move(triples_);
 }
 
+// _____________________________________________________________________________
+TurtleMultiFileParser::TurtleMultiFileParser(std::vector<string> filenames,
+                                             ParserFactory makeParser,
+                                             size_t numConcurrentFiles)
+    : filenames_{std::move(filenames)},
+      makeParser_{std::move(makeParser)},
+      numConcurrentFiles_{std::max(
+          size_t{1}, std::min(numConcurrentFiles, filenames_.size()))} {
+  AD_CONTRACT_CHECK(!filenames_.empty());
+}
+
+// _____________________________________________________________________________
+TurtleMultiFileParser::~TurtleMultiFileParser() {
+  // Unblock the threads that wait for space in the queue, the destructors of
+  // the `JThread`s then join them.
+  batches_.finish();
+}
+
+// _____________________________________________________________________________
+void TurtleMultiFileParser::startParsing() {
+  numActiveThreads_ = numConcurrentFiles_;
+  auto parseFiles = [this]() {
+    try {
+      for (size_t i = nextFile_++; i < filenames_.size(); i = nextFile_++) {
+        LOG(INFO) << "Parsing input file " << filenames_[i] << " ..."
+                  << std::endl;
+        auto parser = makeParser_(filenames_[i]);
+        parser->integerOverflowBehavior() = integerOverflowBehavior();
+        parser->invalidLiteralsAreSkipped() = invalidLiteralsAreSkipped();
+        while (auto batch = parser->getBatch()) {
+          if (!batches_.push(std::move(batch.value()))) {
+            return;
+          }
+        }
+      }
+    } catch (...) {
+      batches_.pushException(std::current_exception());
+      return;
+    }
+    // The last thread that is done signals the end of the input.
+    if (--numActiveThreads_ == 0) {
+      batches_.finish();
+    }
+  };
+  for (size_t i = 0; i < numConcurrentFiles_; ++i) {
+    threads_.emplace_back(parseFiles);
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<TurtleTriple>> TurtleMultiFileParser::getBatch() {
+  if (threads_.empty()) {
+    startParsing();
+  }
+  if (!triples_.empty()) {
+    return std::exchange(triples_, {});
+  }
+  return batches_.pop();
+}
+
+// _____________________________________________________________________________
+bool TurtleMultiFileParser::getLine(TurtleTriple* triple) {
+  while (triples_.empty()) {
+    auto batch = getBatch();
+    if (!batch) {
+      return false;
+    }
+    triples_ = std::move(batch.value());
+  }
+  *triple = std::move(triples_.back());
+  triples_.pop_back();
+  return true;
+}
+
 // Explicit instantiations
 template class TurtleParser<Tokenizer>;
 template class TurtleParser<TokenizerCtre>;
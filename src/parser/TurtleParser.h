@@ -20,13 +20,17 @@
 #include <util/Log.h>
 #include <util/TaskQueue.h>
 
+#include <atomic>
 #include <codecvt>
 #include <exception>
+#include <functional>
 #include <future>
 #include <locale>
 #include <string_view>
 
 #include "util/ParseException.h"
+#include "util/ThreadSafeQueue.h"
+#include "util/jthread.h"
 
 using std::string;
 
@@ -572,6 +576,9 @@ class TurtleParallelParser : public TurtleParser<Tokenizer_T> {
     initialize(filename);
   }
 
+  // Stop the parsing if the input has not been completely consumed.
+  ~TurtleParallelParser() override;
+
   // inherit the wrapper overload
   using TurtleParser<Tokenizer_T>::getLine;
 
@@ -610,6 +617,60 @@ class TurtleParallelParser : public TurtleParser<Tokenizer_T> {
       QUEUE_SIZE_BEFORE_PARALLEL_PARSING, NUM_PARALLEL_PARSER_THREADS,
       "parallel parser"};
   std::future<void> parseFuture_;
+  // Set by the destructor to stop reading further blocks from the input.
+  std::atomic<bool> isCancelled_ = false;
 
   ParallelBuffer::BufferType remainingBatchFromInitialization_;
 };
+
+/**
+ * A parser that reads the triples from several input files. Up to
+ * `numConcurrentFiles` of the files are parsed concurrently, each by its own
+ * parser that is created via `makeParser`, and the batches of triples of all
+ * the files are returned in an unspecified order. Note that blank node labels
+ * like `_:b` are shared between all the files.
+ */
+class TurtleMultiFileParser : public TurtleParserBase {
+ public:
+  using ParserFactory =
+      std::function<std::unique_ptr<TurtleParserBase>(const string& filename)>;
+
+  TurtleMultiFileParser(
+      std::vector<string> filenames, ParserFactory makeParser,
+      size_t numConcurrentFiles = NUM_CONCURRENTLY_PARSED_INPUT_FILES);
+
+  // Stop and join all the parsing threads.
+  ~TurtleMultiFileParser() override;
+
+  // inherit the wrapper overload
+  using TurtleParserBase::getLine;
+
+  bool getLine(TurtleTriple* triple) override;
+
+  std::optional<std::vector<TurtleTriple>> getBatch() override;
+
+  size_t getParsePosition() const override {
+    // There is no meaningful position when reading from several files.
+    return 0;
+  }
+
+ private:
+  // Start the threads that parse the files. This is done lazily on the first
+  // call to `getBatch`, s.t. the settings of this parser (e.g.
+  // `invalidLiteralsAreSkipped()`) can be passed on to the parsers of the
+  // individual files.
+  void startParsing();
+
+  std::vector<string> filenames_;
+  ParserFactory makeParser_;
+  size_t numConcurrentFiles_;
+  // The index of the next file that has not yet been started.
+  std::atomic<size_t> nextFile_ = 0;
+  // The number of threads that are still parsing.
+  std::atomic<size_t> numActiveThreads_ = 0;
+  ad_utility::data_structures::ThreadSafeQueue<std::vector<TurtleTriple>>
+      batches_{QUEUE_SIZE_AFTER_PARALLEL_PARSING};
+  std::vector<ad_utility::JThread> threads_;
+  // The remainder of the current batch (only used by `getLine`).
+  std::vector<TurtleTriple> triples_;
+};
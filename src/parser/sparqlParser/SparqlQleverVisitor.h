@@ -103,6 +103,15 @@ class SparqlQleverVisitor {
   const PrefixMap& prefixMap() const { return prefixMap_; }
   void setPrefixMapManually(PrefixMap map) { prefixMap_ = std::move(map); }
 
+  // Get the part of the original input string that pertains to the given
+  // context. This is necessary because ANTLR's `getText()` only provides that
+  // part with *all* whitespace removed. Preserving the whitespace is important
+  // for readability (for example, in an error message), and even more so when
+  // using such parts for further processing (like the body of a SERVICE query,
+  // which is not valid SPARQL anymore when you remove all whitespace).
+  static std::string getOriginalInputForContext(
+      const antlr4::ParserRuleContext* context);
+
   // ___________________________________________________________________________
   [[nodiscard]] ParsedQuery visit(Parser::QueryContext* ctx);
 
@@ -441,15 +450,6 @@ class SparqlQleverVisitor {
     return {true, std::move(label)};
   }
 
-  // Get the part of the original input string that pertains to the given
-  // context. This is necessary because ANTLR's `getText()` only provides that
-  // part with *all* whitespace removed. Preserving the whitespace is important
-  // for readability (for example, in an error message), and even more so when
-  // using such parts for further processing (like the body of a SERVICE query,
-  // which is not valid SPARQL anymore when you remove all whitespace).
-  static std::string getOriginalInputForContext(
-      const antlr4::ParserRuleContext* context);
-
   // Process an IRI function call. This is used in both `visitFunctionCall` and
   // `visitIriOrFunction`.
   [[nodiscard]] static ExpressionPtr processIriFunctionCall(
@@ -0,0 +1,146 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "util/File.h"
+#include "util/Log.h"
+#include "util/StableHash.h"
+
+// Helpers for files that consist of a sequence of records, to which new
+// records are only ever appended. Each record is an arbitrary byte buffer that
+// is prefixed with its size and a checksum of its contents. A record that was
+// not completely written (e.g. because the process was killed while appending
+// it) is detected when the file is read and ignored. The files are synced to
+// the disk before the functions that write them return.
+namespace ad_utility::appendOnlyFile {
+
+using Record = std::vector<char>;
+
+namespace detail {
+inline uint64_t checksum(const Record& record) {
+  return stableHash({record.data(), record.size()});
+}
+
+inline void writeRecord(File& file, const Record& record) {
+  uint64_t size = record.size();
+  uint64_t hash = checksum(record);
+  if (file.write(&size, sizeof(size)) != sizeof(size) ||
+      file.write(&hash, sizeof(hash)) != sizeof(hash) ||
+      file.write(record.data(), record.size()) != record.size()) {
+    throw std::runtime_error("Could not write a record of an append-only file");
+  }
+}
+
+// Make sure that the entry of the `filename` in its directory (e.g. after a
+// rename) has been written to the disk.
+inline void syncDirectory(const std::string& filename) {
+  std::filesystem::path directory =
+      std::filesystem::absolute(filename).parent_path();
+  int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd < 0 || ::fsync(fd) != 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    throw std::runtime_error(absl::StrCat("Could not write the directory \"",
+                                          directory.string(), "\" to disk (",
+                                          strerror(errno), ")"));
+  }
+  ::close(fd);
+}
+}  // namespace detail
+
+// Write the `records` to a temporary file and then rename it to `filename`.
+// This atomically replaces an existing file, so the file is never observed in
+// a partially written state.
+inline void writeRecords(const std::string& filename,
+                         const std::vector<Record>& records) {
+  const std::string temporaryFilename = filename + ".tmp";
+  {
+    File file{temporaryFilename, "w"};
+    for (const auto& record : records) {
+      detail::writeRecord(file, record);
+    }
+    file.sync();
+  }
+  std::filesystem::rename(temporaryFilename, filename);
+  detail::syncDirectory(filename);
+}
+
+// Append a single `record` to the file, which must have been written by
+// `writeRecords`. If the record can't be written completely (e.g. because the
+// disk is full), the file is truncated to its previous size before the
+// exception is rethrown. Otherwise, the next record would be appended after
+// the incomplete one, and `readRecords` would consider the file corrupted.
+inline void appendRecord(const std::string& filename, const Record& record) {
+  const auto previousSize = std::filesystem::file_size(filename);
+  try {
+    File file{filename, "a"};
+    detail::writeRecord(file, record);
+    file.sync();
+  } catch (...) {
+    // The `file` has already been closed, so no buffered bytes can be written
+    // after the truncation.
+    std::error_code errorCode;
+    std::filesystem::resize_file(filename, previousSize, errorCode);
+    if (errorCode) {
+      LOG(ERROR) << "Could not remove the incomplete record from the file \""
+                 << filename << "\" (" << errorCode.message() << ")"
+                 << std::endl;
+    }
+    throw;
+  }
+}
+
+// Read all the complete records from the file. An incompletely written last
+// record is removed from the file, s.t. new records can be appended again.
+// Throws if a record in the middle of the file has a wrong checksum.
+inline std::vector<Record> readRecords(const std::string& filename) {
+  File file{filename, "r"};
+  const auto fileSize = static_cast<uint64_t>(file.sizeOfFile());
+  std::vector<Record> records;
+  uint64_t offset = 0;
+  while (offset < fileSize) {
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    constexpr uint64_t headerSize = sizeof(size) + sizeof(hash);
+    if (fileSize - offset < headerSize) {
+      break;
+    }
+    file.read(&size, sizeof(size), static_cast<off_t>(offset));
+    file.read(&hash, sizeof(hash), static_cast<off_t>(offset + sizeof(size)));
+    if (fileSize - offset - headerSize < size) {
+      break;
+    }
+    Record record(size);
+    file.read(record.data(), size, static_cast<off_t>(offset + headerSize));
+    if (detail::checksum(record) != hash) {
+      // Only the last record can be incomplete (e.g. if the size, but not all
+      // of the contents were written to the disk).
+      if (offset + headerSize + size == fileSize) {
+        break;
+      }
+      throw std::runtime_error(absl::StrCat(
+          "The record at offset ", offset, " of the file \"", filename,
+          "\" has a wrong checksum, the file is corrupted"));
+    }
+    records.push_back(std::move(record));
+    offset += headerSize + size;
+  }
+  if (offset < fileSize) {
+    LOG(WARN) << "The last record of the file \"" << filename
+              << "\" was not completely written and is removed" << std::endl;
+    file.close();
+    std::filesystem::resize_file(filename, offset);
+  }
+  return records;
+}
+}  // namespace ad_utility::appendOnlyFile
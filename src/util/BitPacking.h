@@ -0,0 +1,159 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "util/ConstexprUtils.h"
+#include "util/Exception.h"
+
+// Lightweight encodings of sequences of 64-bit integers by bit-packing. The
+// values are stored relative to a common reference value ("frame of
+// reference"), or, for sorted sequences, as the differences of consecutive
+// values ("delta"). The remaining values are all stored with the number of bits
+// that is needed for the largest of them. Decoding is much cheaper than for
+// general-purpose compression like Zstd.
+//
+// The encoded format is a header (the reference value as 8 bytes, followed by
+// the number of bits per value as 1 byte, padded to `HEADER_SIZE` bytes),
+// followed by the bit-packed values as 64-bit words. The values are packed
+// starting from the least significant bits of the words, and a value can span
+// two adjacent words. The number of values is not stored, it has to be passed
+// to the decoding functions.
+namespace ad_utility::bitPacking {
+
+constexpr inline size_t HEADER_SIZE = 16;
+
+namespace detail {
+// Load the `i`-th 64-bit word from `data`, which is not necessarily aligned.
+inline uint64_t loadWord(const char* data, size_t i) {
+  uint64_t word;
+  std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+  return word;
+}
+
+// Pack the `values`, each of which must fit into `numBits` bits, and return
+// them together with the header that stores the `reference` value.
+inline std::vector<char> pack(const std::vector<uint64_t>& values,
+                              uint64_t reference, size_t numBits) {
+  const size_t numWords = (values.size() * numBits + 63) / 64;
+  std::vector<uint64_t> words(numWords, 0);
+  for (size_t i = 0; numBits > 0 && i < values.size(); ++i) {
+    size_t bitPos = i * numBits;
+    size_t wordIndex = bitPos / 64;
+    size_t shift = bitPos % 64;
+    words[wordIndex] |= values[i] << shift;
+    if (shift + numBits > 64) {
+      words[wordIndex + 1] |= values[i] >> (64 - shift);
+    }
+  }
+  std::vector<char> result(HEADER_SIZE + numWords * sizeof(uint64_t), 0);
+  std::memcpy(result.data(), &reference, sizeof(reference));
+  result[sizeof(reference)] = static_cast<char>(numBits);
+  std::memcpy(result.data() + HEADER_SIZE, words.data(),
+              numWords * sizeof(uint64_t));
+  return result;
+}
+
+// Unpack `numValues` values with `NumBits` bits each from `data` and call
+// `store(i, value)` for each of them in order. `NumBits` is a template
+// parameter s.t. the shifts and masks are compile-time constants, which allows
+// the compiler to unroll and vectorize the loop.
+template <size_t NumBits>
+void unpack(const char* data, size_t numValues, auto store) {
+  if constexpr (NumBits == 0) {
+    for (size_t i = 0; i < numValues; ++i) {
+      store(i, uint64_t{0});
+    }
+  } else {
+    constexpr uint64_t mask =
+        NumBits == 64 ? ~uint64_t{0} : (uint64_t{1} << NumBits) - 1;
+    for (size_t i = 0; i < numValues; ++i) {
+      size_t bitPos = i * NumBits;
+      size_t wordIndex = bitPos / 64;
+      size_t shift = bitPos % 64;
+      uint64_t value = loadWord(data, wordIndex) >> shift;
+      if (shift + NumBits > 64) {
+        value |= loadWord(data, wordIndex + 1) << (64 - shift);
+      }
+      store(i, value & mask);
+    }
+  }
+}
+
+// Read the header of the `encoded` data and call `unpack` with the stored
+// number of bits.
+inline void unpackEncoded(std::span<const char> encoded, size_t numValues,
+                          uint64_t* reference, auto store) {
+  AD_CORRECTNESS_CHECK(encoded.size() >= HEADER_SIZE);
+  std::memcpy(reference, encoded.data(), sizeof(*reference));
+  const auto numBits =
+      static_cast<size_t>(static_cast<uint8_t>(encoded[sizeof(*reference)]));
+  AD_CORRECTNESS_CHECK(numBits <= 64);
+  AD_CORRECTNESS_CHECK(encoded.size() - HEADER_SIZE >=
+                       (numValues * numBits + 63) / 64 * sizeof(uint64_t));
+  ad_utility::RuntimeValueToCompileTimeValue<64>(
+      numBits, [&]<size_t NumBits>() {
+        unpack<NumBits>(encoded.data() + HEADER_SIZE, numValues, store);
+      });
+}
+}  // namespace detail
+
+// Encode the `values` relative to their minimum.
+inline std::vector<char> encodeFrameOfReference(
+    std::span<const uint64_t> values) {
+  uint64_t min = values.empty() ? 0 : std::ranges::min(values);
+  uint64_t max = values.empty() ? 0 : std::ranges::max(values);
+  std::vector<uint64_t> offsets;
+  offsets.reserve(values.size());
+  for (uint64_t value : values) {
+    offsets.push_back(value - min);
+  }
+  return detail::pack(offsets, min, std::bit_width(max - min));
+}
+
+// Decode `numValues` values that were encoded by `encodeFrameOfReference` and
+// write them to `result`.
+inline void decodeFrameOfReference(std::span<const char> encoded,
+                                   size_t numValues, uint64_t* result) {
+  uint64_t min;
+  detail::unpackEncoded(encoded, numValues, &min,
+                        [result, &min](size_t i, uint64_t offset) {
+                          result[i] = min + offset;
+                        });
+}
+
+// Encode the `values`, which must be sorted, as the differences between
+// consecutive values. The first value is the reference value.
+inline std::vector<char> encodeDelta(std::span<const uint64_t> values) {
+  AD_CONTRACT_CHECK(std::ranges::is_sorted(values));
+  std::vector<uint64_t> deltas;
+  deltas.reserve(values.size());
+  uint64_t maxDelta = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    deltas.push_back(i == 0 ? 0 : values[i] - values[i - 1]);
+    maxDelta = std::max(maxDelta, deltas.back());
+  }
+  return detail::pack(deltas, values.empty() ? 0 : values[0],
+                      std::bit_width(maxDelta));
+}
+
+// Decode `numValues` values that were encoded by `encodeDelta` and write them
+// to `result`.
+inline void decodeDelta(std::span<const char> encoded, size_t numValues,
+                        uint64_t* result) {
+  uint64_t current;
+  detail::unpackEncoded(encoded, numValues, &current,
+                        [result, &current](size_t i, uint64_t delta) {
+                          current += delta;
+                          result[i] = current;
+                        });
+}
+
+}  // namespace ad_utility::bitPacking
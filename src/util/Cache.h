@@ -353,6 +353,11 @@ class FlexibleCache {
   /// Return the number of pinned entries
   [[nodiscard]] size_t numPinnedEntries() const { return _pinnedMap.size(); }
 
+  /// Return the keys and values of all pinned entries (in no particular order)
+  [[nodiscard]] std::vector<std::pair<Key, ValuePtr>> getPinnedEntries() const {
+    return {_pinnedMap.begin(), _pinnedMap.end()};
+  }
+
   // Delete cache entries from the non-pinned area, until an element of size
   // `sizeToMakeRoomFor` can be inserted into the cache.
   // The special case `sizeToMakeRoomFor == 0`  means, that we do not need to
@@ -8,6 +8,7 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <utility>
 
 #include "util/Forward.h"
@@ -178,25 +179,32 @@ class ConcurrentCache {
    * @param onlyReadFromCache If true, then the result will only be returned if
    * it is contained in the cache. Otherwise `nullptr` with a cache status of
    * `notInCacheNotComputed` will be returned.
+   * @param generation The `generation()` of the cache at the time the
+   * computation (e.g. the query it belongs to) was started. If the cache has
+   * a newer generation by now, a result that is not in the cache is computed
+   * without being added to the cache, and other threads do not wait for it.
+   * If not specified, the current generation is used.
    * @return A shared_ptr to the computation result.
    *
    */
   template <class ComputeFunction>
-  ResultAndCacheStatus computeOnce(const Key& key,
-                                   ComputeFunction computeFunction,
-                                   bool onlyReadFromCache = false) {
+  ResultAndCacheStatus computeOnce(
+      const Key& key, ComputeFunction computeFunction,
+      bool onlyReadFromCache = false,
+      std::optional<size_t> generation = std::nullopt) {
     return computeOnceImpl(false, key, std::move(computeFunction),
-                           onlyReadFromCache);
+                           onlyReadFromCache, generation);
   }
 
   /// Similar to computeOnce, with the following addition: After the call
   /// completes, the result will be pinned in the underlying cache.
   template <class ComputeFunction>
-  ResultAndCacheStatus computeOncePinned(const Key& key,
-                                         ComputeFunction computeFunction,
-                                         bool onlyReadFromCache = false) {
+  ResultAndCacheStatus computeOncePinned(
+      const Key& key, ComputeFunction computeFunction,
+      bool onlyReadFromCache = false,
+      std::optional<size_t> generation = std::nullopt) {
     return computeOnceImpl(true, key, std::move(computeFunction),
-                           onlyReadFromCache);
+                           onlyReadFromCache, generation);
   }
 
   /// Clear the cache (but not the pinned entries)
@@ -204,8 +212,32 @@ class ConcurrentCache {
     _cacheAndInProgressMap.wlock()->_cache.clearUnpinnedOnly();
   }
 
-  /// Clear the cache, including the pinned entries.
-  virtual void clearAll() { _cacheAndInProgressMap.wlock()->_cache.clearAll(); }
+  /// Clear the cache, including the pinned entries. The results that are
+  /// currently being computed will not be added to the cache when they are
+  /// finished (they might have been computed from an outdated state, e.g. of
+  /// an index that is being updated), but are still passed to all threads
+  /// that are already waiting for them.
+  virtual void clearAll() {
+    auto lockPtr = _cacheAndInProgressMap.wlock();
+    lockPtr->_cache.clearAll();
+    lockPtr->_inProgress.clear();
+  }
+
+  /// The generation of the cache, which is incremented by
+  /// `clearAllAndStartNewGeneration`.
+  size_t generation() const {
+    return _cacheAndInProgressMap.wlock()->_generation;
+  }
+
+  /// Increment the `generation()` and then clear the cache (see `clearAll`).
+  /// Computations that were started for an older generation (see
+  /// `computeOnce`) will not add their results to the cache anymore. This is
+  /// used when the cached results become outdated, e.g. after an update of
+  /// the index.
+  void clearAllAndStartNewGeneration() {
+    ++_cacheAndInProgressMap.wlock()->_generation;
+    clearAll();
+  }
 
   /// Delete elements from the unpinned part of the cache of total size
   /// at least `size`;
@@ -236,6 +268,23 @@ class ConcurrentCache {
     return _cacheAndInProgressMap.wlock()->_cache.pinnedSize();
   }
 
+  /// The keys and values of all pinned entries in the cache.
+  auto getPinnedEntries() const {
+    return _cacheAndInProgressMap.wlock()->_cache.getPinnedEntries();
+  }
+
+  /// Insert the `value` as a pinned entry, unless the `key` is already
+  /// contained in the cache or its value is currently being computed. Return
+  /// true iff the `value` was inserted.
+  bool insertPinnedIfNotContained(const Key& key, shared_ptr<Value> value) {
+    auto lockPtr = _cacheAndInProgressMap.wlock();
+    if (lockPtr->_cache.contains(key) || lockPtr->_inProgress.contains(key)) {
+      return false;
+    }
+    lockPtr->_cache.insertPinned(key, std::move(value));
+    return true;
+  }
+
   /// only for testing: get access to the implementation
   auto& getStorage() { return _cacheAndInProgressMap; }
 
@@ -280,6 +329,8 @@ class ConcurrentCache {
     // Values that are currently being computed. The bool tells us whether this
     // result will be pinned in the cache.
     HashMap<Key, std::pair<bool, shared_ptr<ResultInProgress>>> _inProgress;
+    // See `generation()`.
+    size_t _generation = 0;
 
     CacheAndInProgressMap() = default;
     template <typename Arg, typename... Args>
@@ -291,13 +342,30 @@ class ConcurrentCache {
   // make the whole class thread-safe by making all the data members thread-safe
   using SyncCache = ad_utility::Synchronized<CacheAndInProgressMap, std::mutex>;
 
+  // Return true iff the `resultInProgress` is (still) the computation for the
+  // `key` in the hash map of the operations that are in progress. This is not
+  // the case if the `_inProgress` map was cleared by `clearAll` in the
+  // meantime.
+  static bool isInProgress(
+      const CacheAndInProgressMap& storage, const Key& key,
+      const shared_ptr<ResultInProgress>& resultInProgress) {
+    auto it = storage._inProgress.find(key);
+    return it != storage._inProgress.end() &&
+           it->second.second == resultInProgress;
+  }
+
   // delete the operation with the key from the hash map of the operations that
-  // are in progress, and add it to the cache using the computationResult
-  // Will crash if the key cannot be found in the hash map
-  void moveFromInProgressToCache(Key key, shared_ptr<Value> computationResult) {
+  // are in progress, and add it to the cache using the computationResult. If
+  // the computation is no longer in progress (see `isInProgress`), the result
+  // is not added to the cache.
+  void moveFromInProgressToCache(
+      Key key, shared_ptr<Value> computationResult,
+      const shared_ptr<ResultInProgress>& resultInProgress) {
     // Obtain a lock for the whole operation, making it atomic.
     auto lockPtr = _cacheAndInProgressMap.wlock();
-    AD_CONTRACT_CHECK(lockPtr->_inProgress.contains(key));
+    if (!isInProgress(*lockPtr, key, resultInProgress)) {
+      return;
+    }
     bool pinned = lockPtr->_inProgress[key].first;
     if (pinned) {
       lockPtr->_cache.insertPinned(std::move(key),
@@ -313,8 +381,10 @@ class ConcurrentCache {
   template <class ComputeFunction>
   ResultAndCacheStatus computeOnceImpl(bool pinned, const Key& key,
                                        ComputeFunction computeFunction,
-                                       bool onlyReadFromCache) {
+                                       bool onlyReadFromCache,
+                                       std::optional<size_t> generation) {
     bool mustCompute;
+    bool isOutdated = false;
     shared_ptr<ResultInProgress> resultInProgress;
     // first determine whether we have to compute the result,
     // this is done atomically by locking the storage for the whole time
@@ -331,6 +401,11 @@ class ConcurrentCache {
         return {cache[key], cacheStatus};
       } else if (onlyReadFromCache) {
         return {nullptr, CacheStatus::notInCacheAndNotComputed};
+      } else if (generation.has_value() &&
+                 generation.value() != lockPtr->_generation) {
+        // The computation belongs to an older generation, its result must
+        // neither be added to the cache nor be used by other threads.
+        isOutdated = true;
       } else if (lockPtr->_inProgress.contains(key)) {
         // the result is not cached, but someone else is computing it.
         // it is important, that we do not immediately call getResult() since
@@ -350,19 +425,26 @@ class ConcurrentCache {
         lockPtr->_inProgress[key] = std::pair(pinned, resultInProgress);
       }
     }  // release the lock, it is not required while we are computing
-    if (mustCompute) {
+    if (isOutdated) {
+      return {make_shared<Value>(computeFunction()), CacheStatus::computed};
+    } else if (mustCompute) {
       LOG(TRACE) << "Not in the cache, need to compute result" << std::endl;
       try {
         // The actual computation
         shared_ptr<Value> result = make_shared<Value>(computeFunction());
-        moveFromInProgressToCache(key, result);
+        moveFromInProgressToCache(key, result, resultInProgress);
         // Signal other threads who are waiting for the results.
         resultInProgress->finish(result);
         // result was not cached
         return {std::move(result), CacheStatus::computed};
       } catch (...) {
         // Other threads may try this computation again in the future
-        _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
+        {
+          auto lockPtr = _cacheAndInProgressMap.wlock();
+          if (isInProgress(*lockPtr, key, resultInProgress)) {
+            lockPtr->_inProgress.erase(key);
+          }
+        }
         // Result computation has failed, signal the other threads,
         resultInProgress->abort();
         throw;
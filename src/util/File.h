@@ -9,13 +9,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "./Exception.h"
@@ -40,6 +43,12 @@ class File {
  private:
   string _name;
   FILE* _file;
+  // The read-only memory mapping of the complete file, if it has been created
+  // by `mapIntoMemory()`.
+  const char* _mappedData = nullptr;
+  size_t _mappedSize = 0;
+  // True iff the mapping was created by `loadIntoMemory()`.
+  bool _isResident = false;
 
  public:
   //! Default constructor
@@ -65,11 +74,19 @@ class File {
 
     _file = rhs._file;
     rhs._file = nullptr;
+    _mappedData = std::exchange(rhs._mappedData, nullptr);
+    _mappedSize = std::exchange(rhs._mappedSize, 0);
+    _isResident = std::exchange(rhs._isResident, false);
     _name = std::move(rhs._name);
     return *this;
   }
 
-  File(File&& rhs) : _name{std::move(rhs._name)}, _file{rhs._file} {
+  File(File&& rhs)
+      : _name{std::move(rhs._name)},
+        _file{rhs._file},
+        _mappedData{std::exchange(rhs._mappedData, nullptr)},
+        _mappedSize{std::exchange(rhs._mappedSize, 0)},
+        _isResident{std::exchange(rhs._isResident, false)} {
     rhs._file = nullptr;
   }
 
@@ -105,6 +122,7 @@ class File {
     if (not isOpen()) {
       return true;
     }
+    unmap();
     if (fclose(_file) != 0) {
       cout << "! ERROR closing file \"" << _name << "\" (" << strerror(errno)
            << ")" << endl
@@ -171,6 +189,17 @@ class File {
 
   void flush() { fflush(_file); }
 
+  // Flush the buffer and make sure that the contents of the file have been
+  // written to the disk (via `fsync`). Throws if this fails.
+  void sync() {
+    assert(_file);
+    if (fflush(_file) != 0 || fsync(fileno(_file)) != 0) {
+      throw std::runtime_error(absl::StrCat("Could not write file \"", _name,
+                                            "\" to disk (", strerror(errno),
+                                            ")"));
+    }
+  }
+
   bool isAtEof() {
     assert(_file);
     return feof(_file) != 0;
@@ -224,6 +253,118 @@ class File {
     return bytesRead;
   }
 
+  // Map the complete file, which must be open for reading, read-only into
+  // memory. Afterwards, `getMappedRange` hands out views of the file's contents
+  // without copying them, and the caching of the contents is left to the page
+  // cache of the operating system.
+  void mapIntoMemory() {
+    AD_CONTRACT_CHECK(isOpen());
+    unmap();
+    const auto size = static_cast<size_t>(sizeOfFile());
+    if (size == 0) {
+      // `mmap` doesn't support empty mappings, but an empty file has no
+      // contents to hand out anyway.
+      return;
+    }
+    void* ptr =
+        mmap(nullptr, size, PROT_READ, MAP_SHARED, getFileDescriptor(), 0);
+    if (ptr == MAP_FAILED) {
+      throw std::runtime_error(absl::StrCat("Could not map the file \"", _name,
+                                            "\" into memory (",
+                                            strerror(errno), ")"));
+    }
+    _mappedData = static_cast<const char*>(ptr);
+    _mappedSize = size;
+  }
+
+  // Like `mapIntoMemory()`, but copy the complete file into anonymous memory
+  // that is owned by this `File`. The contents are then independent of the
+  // page cache and are never evicted from memory (unless the memory is swapped
+  // out). If `useHugePages` is true, the memory is backed by transparent huge
+  // pages (if the kernel supports them), which reduces the number of TLB
+  // misses for random accesses to a large file. If `lockInMemory` is true, the
+  // memory is additionally locked via `mlock`, s.t. it is never swapped out.
+  // If the memory can't be locked (e.g. because the process lacks the
+  // capability `CAP_IPC_LOCK` and `RLIMIT_MEMLOCK` is too low), only a warning
+  // is logged.
+  void loadIntoMemory(bool useHugePages = false, bool lockInMemory = false) {
+    AD_CONTRACT_CHECK(isOpen());
+    unmap();
+    const auto size = static_cast<size_t>(sizeOfFile());
+    if (size == 0) {
+      return;
+    }
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+      throw std::runtime_error(absl::StrCat(
+          "Could not allocate ", size, " bytes for loading the file \"", _name,
+          "\" into memory (", strerror(errno), ")"));
+    }
+    if (useHugePages) {
+      // This is only a hint, so errors are deliberately ignored.
+      madvise(ptr, size, MADV_HUGEPAGE);
+    }
+    _mappedData = static_cast<const char*>(ptr);
+    _mappedSize = size;
+    _isResident = true;
+    if (read(ptr, size, 0) != static_cast<ssize_t>(size)) {
+      unmap();
+      throw std::runtime_error(absl::StrCat(
+          "Could not read the file \"", _name, "\" into memory"));
+    }
+    mprotect(ptr, size, PROT_READ);
+    if (lockInMemory && mlock(ptr, size) != 0) {
+      const int error = errno;
+      const bool isPermissionError = error == EPERM || error == ENOMEM;
+      LOG(WARN) << "Could not lock the memory of the file \"" << _name
+                << "\" (" << strerror(error) << ")"
+                << (isPermissionError
+                        ? ", the limit for locked memory (see `ulimit -l`) is "
+                          "too low or the capability CAP_IPC_LOCK is missing"
+                        : "")
+                << std::endl;
+    }
+  }
+
+  // Return true iff `mapIntoMemory()` or `loadIntoMemory()` has been called
+  // for a non-empty file.
+  [[nodiscard]] bool isMappedIntoMemory() const {
+    return _mappedData != nullptr;
+  }
+
+  // Return true iff `loadIntoMemory()` has been called for a non-empty file.
+  [[nodiscard]] bool isLoadedIntoMemory() const { return _isResident; }
+
+  // Return a view of the `nofBytes` bytes of the file starting at the given
+  // `offset`. The file must be mapped into memory, and the view is valid until
+  // the file is closed.
+  [[nodiscard]] std::span<const char> getMappedRange(size_t nofBytes,
+                                                     off_t offset) const {
+    AD_CONTRACT_CHECK(isMappedIntoMemory());
+    AD_CONTRACT_CHECK(offset >= 0 &&
+                      static_cast<size_t>(offset) + nofBytes <= _mappedSize);
+    return {_mappedData + offset, nofBytes};
+  }
+
+  // Advise the operating system that the `nofBytes` bytes starting at the
+  // given `offset` will be read soon, s.t. they can already be read ahead
+  // asynchronously. This has no effect if the file is not mapped into memory
+  // or if it has been loaded into memory completely.
+  void adviseWillNeed(size_t nofBytes, off_t offset) const {
+    if (!isMappedIntoMemory() || _isResident || offset < 0 ||
+        static_cast<size_t>(offset) >= _mappedSize) {
+      return;
+    }
+    // `madvise` requires an address that is aligned to the page size.
+    static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = static_cast<size_t>(offset) / pageSize * pageSize;
+    size_t end = std::min(static_cast<size_t>(offset) + nofBytes, _mappedSize);
+    // This is only a hint, so errors are deliberately ignored.
+    madvise(const_cast<char*>(_mappedData) + begin, end - begin,
+            MADV_WILLNEED);
+  }
+
   //! get the underlying file descriptor
   [[nodiscard]] int getFileDescriptor() const { return fileno(_file); }
 
@@ -262,6 +403,17 @@ class File {
   static bool exists(const std::filesystem::path& path) {
     return std::filesystem::exists(path);
   }
+
+ private:
+  // Remove the memory mapping of the file if there is one.
+  void unmap() {
+    if (isMappedIntoMemory()) {
+      munmap(const_cast<char*>(_mappedData), _mappedSize);
+      _mappedData = nullptr;
+      _mappedSize = 0;
+      _isResident = false;
+    }
+  }
 };
 
 /**
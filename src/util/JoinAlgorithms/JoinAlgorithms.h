@@ -406,6 +406,160 @@ void gallopingJoin(
   }
 }
 
+// A pair of subranges `[beginLeft, endLeft)` and `[beginRight, endRight)` of
+// the two inputs of a join, see `partitionSortedInputsForJoin` below.
+struct JoinPartition {
+  size_t beginLeft_;
+  size_t endLeft_;
+  size_t beginRight_;
+  size_t endRight_;
+  bool operator==(const JoinPartition&) const = default;
+};
+
+/**
+ * @brief Split the two sorted inputs `left` and `right` of a join into at most
+ * `numPartitions` consecutive pairs of subranges, s.t. the join of `left` and
+ * `right` is the concatenation of the joins of the pairs. The splits are only
+ * performed between different elements (wrt `lessThan`), so all the elements
+ * that are equal to each other end up in the same partition. The partitions
+ * can therefore be joined independently (e.g. in parallel) and concatenating
+ * their results in order preserves the sorting. The split points are chosen
+ * evenly spaced in the larger of the two inputs and are then looked up in the
+ * other input via binary search. The inputs must not contain UNDEF values.
+ * Empty partitions are omitted, so the result is empty iff both inputs are
+ * empty.
+ */
+template <std::ranges::random_access_range Range1,
+          std::ranges::random_access_range Range2>
+std::vector<JoinPartition> partitionSortedInputsForJoin(
+    const Range1& left, const Range2& right, size_t numPartitions,
+    const auto& lessThan) {
+  AD_CONTRACT_CHECK(numPartitions > 0);
+  const size_t sizeLeft = std::ranges::size(left);
+  const size_t sizeRight = std::ranges::size(right);
+  const bool leftIsLarger = sizeLeft >= sizeRight;
+  const size_t sizeLarger = leftIsLarger ? sizeLeft : sizeRight;
+
+  // Return the index of the first element in `range` that is not less than
+  // `pivot`.
+  auto lowerBound = [&lessThan](const auto& range, const auto& pivot) {
+    return static_cast<size_t>(
+        std::lower_bound(std::ranges::begin(range), std::ranges::end(range),
+                         pivot, lessThan) -
+        std::ranges::begin(range));
+  };
+
+  std::vector<JoinPartition> result;
+  size_t beginLeft = 0;
+  size_t beginRight = 0;
+  for (size_t i = 1; i < numPartitions; ++i) {
+    size_t splitIndex = i * sizeLarger / numPartitions;
+    if (splitIndex == 0) {
+      continue;
+    }
+    const auto& pivot = leftIsLarger ? *(std::ranges::begin(left) + splitIndex)
+                                     : *(std::ranges::begin(right) + splitIndex);
+    size_t endLeft = lowerBound(left, pivot);
+    size_t endRight = lowerBound(right, pivot);
+    // Multiple split points might fall into the same range of equal elements.
+    if (endLeft == beginLeft && endRight == beginRight) {
+      continue;
+    }
+    result.push_back({beginLeft, endLeft, beginRight, endRight});
+    beginLeft = endLeft;
+    beginRight = endRight;
+  }
+  if (beginLeft < sizeLeft || beginRight < sizeRight) {
+    result.push_back({beginLeft, sizeLeft, beginRight, sizeRight});
+  }
+  return result;
+}
+
+namespace detail {
+// The number of `Id`s that are compared at once by `skipSmallerIds` below.
+// Eight 64-bit values fill two AVX2 registers or a single AVX-512 register.
+static constexpr size_t ID_BLOCK_SIZE = 8;
+
+// Return the first iterator in `[it, end)` that points to an `Id` that is not
+// smaller than `bound`. The range must be sorted. The range is processed in
+// blocks of `ID_BLOCK_SIZE` elements: A block the last element of which is
+// smaller than the `bound` is skipped completely, and inside the block that
+// contains the result, the position is computed by counting the smaller
+// elements. The counting loop has a fixed trip count and no branches, s.t. it
+// is compiled to SIMD comparisons for the target architecture.
+template <std::random_access_iterator It>
+It skipSmallerIds(It it, It end, Id bound) {
+  const uint64_t boundBits = bound.getBits();
+  while (static_cast<size_t>(end - it) >= ID_BLOCK_SIZE) {
+    if (it[ID_BLOCK_SIZE - 1].getBits() < boundBits) {
+      it += ID_BLOCK_SIZE;
+      continue;
+    }
+    size_t numSmaller = 0;
+    for (size_t i = 0; i < ID_BLOCK_SIZE; ++i) {
+      numSmaller += static_cast<size_t>(it[i].getBits() < boundBits);
+    }
+    return it + numSmaller;
+  }
+  while (it != end && it->getBits() < boundBits) {
+    ++it;
+  }
+  return it;
+}
+}  // namespace detail
+
+/**
+ * @brief Perform a zipper/merge join on two sorted ranges of `Id`s that both
+ * contain no UNDEF values. This is the very common special case of a join on a
+ * single column (e.g. of two index scans), for which the general
+ * `zipperJoinWithUndef` is unnecessarily expensive. The comparisons are
+ * performed directly on the bit representation of the `Id`s, and the
+ * non-matching entries are skipped in blocks (see `detail::skipSmallerIds`).
+ * @param left The left input. Must be sorted and must not contain UNDEF.
+ * @param right The right input. Must be sorted and must not contain UNDEF.
+ * @param compatibleRowAction Is called with the iterators `(itLeft, itRight)`
+ * for each pair of matching entries. The calls are sorted by the `Id`s.
+ */
+template <std::ranges::random_access_range Range1,
+          std::ranges::random_access_range Range2>
+requires std::same_as<std::ranges::range_value_t<Range1>, Id> &&
+         std::same_as<std::ranges::range_value_t<Range2>, Id>
+void zipperJoinForSingleColumnWithoutUndef(const Range1& left,
+                                           const Range2& right,
+                                           const auto& compatibleRowAction) {
+  auto itLeft = std::ranges::begin(left);
+  auto endLeft = std::ranges::end(left);
+  auto itRight = std::ranges::begin(right);
+  auto endRight = std::ranges::end(right);
+
+  while (itLeft != endLeft && itRight != endRight) {
+    itLeft = detail::skipSmallerIds(itLeft, endLeft, *itRight);
+    if (itLeft == endLeft) {
+      return;
+    }
+    itRight = detail::skipSmallerIds(itRight, endRight, *itLeft);
+    if (itRight == endRight) {
+      return;
+    }
+    if (*itLeft != *itRight) {
+      continue;
+    }
+    // Both inputs now point to the same `Id`. Find the ranges of equal `Id`s
+    // and add the cross product of these ranges to the result.
+    const Id id = *itLeft;
+    auto notEqual = [id](Id other) { return other != id; };
+    auto endSameLeft = std::find_if(itLeft, endLeft, notEqual);
+    auto endSameRight = std::find_if(itRight, endRight, notEqual);
+    for (; itLeft != endSameLeft; ++itLeft) {
+      for (auto innerItRight = itRight; innerItRight != endSameRight;
+           ++innerItRight) {
+        compatibleRowAction(itLeft, innerItRight);
+      }
+    }
+    itRight = endSameRight;
+  }
+}
+
 /**
  * @brief Perform an OPTIONAL join for the following special case: The `right`
  * input contains no UNDEF values in any of its join columns, the `left`
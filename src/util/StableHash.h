@@ -0,0 +1,35 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ad_utility {
+// The 64-bit FNV-1a hash. Unlike `std::hash` or `absl::Hash`, it is guaranteed
+// to be the same for every run and build of QLever, so it can be used for
+// checksums and fingerprints that are written to disk.
+class StableHash {
+ private:
+  uint64_t hash_ = 14695981039346656037ull;
+
+ public:
+  // Add the `bytes` to the hash.
+  void add(std::string_view bytes) {
+    for (char c : bytes) {
+      hash_ ^= static_cast<uint8_t>(c);
+      hash_ *= 1099511628211ull;
+    }
+  }
+
+  uint64_t value() const { return hash_; }
+};
+
+// Return the `StableHash` of the `bytes`.
+inline uint64_t stableHash(std::string_view bytes) {
+  StableHash hash;
+  hash.add(bytes);
+  return hash.value();
+}
+}  // namespace ad_utility
@@ -0,0 +1,60 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace ad_utility {
+
+// A reservation of additional worker threads from a budget that is shared by
+// all the operations of all the concurrently running queries (for example the
+// parallel `Join`, `GROUP BY`, and `TransitivePath`). The budget is the number
+// of hardware threads, so that many concurrent queries with large inputs don't
+// start an unbounded number of threads. Reserving never blocks: if the budget
+// is exhausted, fewer (possibly zero) threads are reserved, and the operation
+// has to do the remaining work in its own thread. The reserved threads are
+// returned to the budget on destruction.
+class ReservedThreads {
+ private:
+  size_t numThreads_ = 0;
+
+  // The number of threads that are currently reserved by all the
+  // `ReservedThreads` objects.
+  static std::atomic<size_t>& numReservedTotal() {
+    static std::atomic<size_t> numReserved = 0;
+    return numReserved;
+  }
+
+ public:
+  // The total number of threads that can be reserved at the same time.
+  static size_t maxNumThreads() {
+    static const size_t maxNumThreads =
+        std::max(std::thread::hardware_concurrency(), 1U);
+    return maxNumThreads;
+  }
+
+  // Reserve as many of the `numWanted` threads as are currently available.
+  explicit ReservedThreads(size_t numWanted) {
+    auto& total = numReservedTotal();
+    size_t numReserved = total.load();
+    do {
+      numThreads_ = std::min(
+          numWanted, maxNumThreads() - std::min(numReserved, maxNumThreads()));
+    } while (!total.compare_exchange_weak(numReserved,
+                                          numReserved + numThreads_));
+  }
+
+  ~ReservedThreads() { numReservedTotal() -= numThreads_; }
+
+  ReservedThreads(const ReservedThreads&) = delete;
+  ReservedThreads& operator=(const ReservedThreads&) = delete;
+
+  // The number of threads that were actually reserved.
+  size_t numThreads() const { return numThreads_; }
+};
+
+}  // namespace ad_utility
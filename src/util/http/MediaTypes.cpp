@@ -51,6 +51,7 @@ const ad_utility::HashMap<MediaType, MediaTypeImpl>& getAllMediaTypes() {
     add(qleverJson, "application", "qlever-results+json", {});
     add(turtle, "text", "turtle", {".ttl"});
     add(octetStream, "application", "octet-stream", {});
+    add(qleverColumnar, "application", "qlever-columnar", {});
     return t;
   }();
   return types;
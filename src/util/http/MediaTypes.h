@@ -42,7 +42,8 @@ enum class MediaType {
   csv,
   textApplication,
   turtle,
-  octetStream
+  octetStream,
+  qleverColumnar
 };
 
 struct MediaTypeWithQuality {
@@ -0,0 +1,58 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+
+#include <csignal>
+
+#include "absl/cleanup/cleanup.h"
+#include "util/AppendOnlyFile.h"
+
+using namespace ad_utility::appendOnlyFile;
+
+namespace {
+Record makeRecord(std::string_view contents) {
+  return Record(contents.begin(), contents.end());
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(AppendOnlyFile, writeAppendAndRead) {
+  const std::string filename = "appendOnlyFileTest.dat";
+  writeRecords(filename, {makeRecord("first"), makeRecord("")});
+  appendRecord(filename, makeRecord("second"));
+  EXPECT_EQ(readRecords(filename),
+            (std::vector{makeRecord("first"), makeRecord(""),
+                         makeRecord("second")}));
+  ad_utility::deleteFile(filename);
+}
+
+// A record that could not be written completely is removed again, s.t. the
+// following records can be appended and the file can still be read.
+TEST(AppendOnlyFile, failedAppendIsRemoved) {
+  const std::string filename = "appendOnlyFileTestFailedAppend.dat";
+  writeRecords(filename, {makeRecord("first")});
+  const auto sizeBefore = std::filesystem::file_size(filename);
+  {
+    // Simulate a full disk by limiting the size of the files that this
+    // process can write. Exceeding the limit raises `SIGXFSZ`, which is
+    // ignored s.t. the write fails with `EFBIG` instead.
+    rlimit oldLimit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+    auto oldHandler = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit limit = oldLimit;
+    limit.rlim_cur = sizeBefore + 20;
+    absl::Cleanup restoreLimit{[&oldLimit, oldHandler] {
+      setrlimit(RLIMIT_FSIZE, &oldLimit);
+      std::signal(SIGXFSZ, oldHandler);
+    }};
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+    EXPECT_ANY_THROW(appendRecord(filename, Record(1000, 'x')));
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), sizeBefore);
+  appendRecord(filename, makeRecord("second"));
+  EXPECT_EQ(readRecords(filename),
+            (std::vector{makeRecord("first"), makeRecord("second")}));
+  ad_utility::deleteFile(filename);
+}
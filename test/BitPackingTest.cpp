@@ -0,0 +1,101 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+#include "util/BitPacking.h"
+
+using namespace ad_utility::bitPacking;
+
+namespace {
+// Encode the `values` with the `encode` function, check that the encoded size
+// matches the `expectedNumBits` per value, and that `decode` yields the
+// original `values`.
+void testRoundTrip(const std::vector<uint64_t>& values, auto encode,
+                   auto decode, size_t expectedNumBits) {
+  std::vector<char> encoded = encode(values);
+  EXPECT_EQ(encoded.size(),
+            HEADER_SIZE + (values.size() * expectedNumBits + 63) / 64 * 8);
+  std::vector<uint64_t> decoded(values.size());
+  decode(encoded, values.size(), decoded.data());
+  EXPECT_EQ(decoded, values);
+}
+
+auto testFrameOfReference = [](const std::vector<uint64_t>& values,
+                               size_t expectedNumBits) {
+  testRoundTrip(values, &encodeFrameOfReference, &decodeFrameOfReference,
+                expectedNumBits);
+};
+
+auto testDelta = [](const std::vector<uint64_t>& values,
+                    size_t expectedNumBits) {
+  testRoundTrip(values, &encodeDelta, &decodeDelta, expectedNumBits);
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BitPacking, FrameOfReference) {
+  testFrameOfReference({}, 0);
+  testFrameOfReference({42}, 0);
+  testFrameOfReference({42, 42, 42}, 0);
+  testFrameOfReference({1000, 1001, 1003, 1000}, 2);
+  testFrameOfReference({7, 3, 10, 4}, 3);
+  constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+  testFrameOfReference({0, max, 17, max - 1}, 64);
+  testFrameOfReference({max, max - 5}, 3);
+
+  // Many random values with every possible number of bits, s.t. the values
+  // span word boundaries at all possible positions.
+  std::mt19937_64 randomEngine{42};
+  for (size_t numBits = 1; numBits <= 64; ++numBits) {
+    uint64_t mask = numBits == 64 ? max : (uint64_t{1} << numBits) - 1;
+    std::vector<uint64_t> values;
+    for (size_t i = 0; i < 200; ++i) {
+      values.push_back((randomEngine() & mask) + 12345);
+    }
+    values[17] = 12345;
+    values[23] = mask + 12345;
+    testFrameOfReference(values, numBits);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(BitPacking, Delta) {
+  testDelta({}, 0);
+  testDelta({42}, 0);
+  testDelta({42, 42, 42}, 0);
+  testDelta({1000, 1001, 1003, 1003, 1010}, 3);
+  constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+  testDelta({0, max}, 64);
+  testDelta({max - 2, max - 1, max}, 1);
+
+  std::mt19937_64 randomEngine{42};
+  for (size_t numBits = 1; numBits <= 20; ++numBits) {
+    uint64_t mask = (uint64_t{1} << numBits) - 1;
+    std::vector<uint64_t> values{uint64_t{1} << 40};
+    for (size_t i = 0; i < 200; ++i) {
+      values.push_back(values.back() + (randomEngine() & mask));
+    }
+    values.push_back(values.back() + mask);
+    testDelta(values, numBits);
+  }
+
+  // Unsorted values can't be delta-encoded.
+  std::vector<uint64_t> unsorted{3, 2};
+  EXPECT_ANY_THROW(encodeDelta(unsorted));
+}
+
+// _____________________________________________________________________________
+TEST(BitPacking, CorruptedInput) {
+  std::vector<uint64_t> values{1, 2, 3, 4};
+  std::vector<char> encoded = encodeFrameOfReference(values);
+  std::vector<uint64_t> decoded(values.size() + 100);
+  // Too few bytes for the requested number of values.
+  EXPECT_ANY_THROW(decodeFrameOfReference(encoded, 100, decoded.data()));
+  // Too few bytes for the header.
+  encoded.resize(HEADER_SIZE - 1);
+  EXPECT_ANY_THROW(decodeDelta(encoded, 1, decoded.data()));
+}
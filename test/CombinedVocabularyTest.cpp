@@ -5,7 +5,9 @@
 #include <gtest/gtest.h>
 
 #include "../src/index/vocabulary/CombinedVocabulary.h"
+#include "../src/index/vocabulary/FrontCodedVocabulary.h"
 #include "../src/index/vocabulary/VocabularyInMemory.h"
+#include "../src/util/File.h"
 #include "./VocabularyTestHelpers.h"
 
 using namespace vocabulary_test;
@@ -68,6 +70,24 @@ auto createVocabularyInMemory(const std::vector<std::string>& words) {
   return VocabularyInMemory(std::move(w));
 }
 
+// Create a `FrontCodedVocabulary` with a small block size, s.t. the words are
+// spread over several blocks. The `filename` has to be unique among the
+// vocabularies that are used at the same time.
+auto createFrontCodedVocabulary(const std::vector<std::string>& words,
+                                const std::string& filename) {
+  {
+    FrontCodedVocabulary::WordWriter writer{
+        filename, 2, FrontCodedVocabulary::BlockCompression::Zstd};
+    for (const auto& word : words) {
+      writer.push(word);
+    }
+  }
+  FrontCodedVocabulary vocab;
+  vocab.open(filename);
+  ad_utility::deleteFile(filename);
+  return vocab;
+}
+
 /// The first half of the words go to the first vocabulary, the second
 /// half of the words go to the second vocabulary.
 auto createLeftAndRightVocabulary(const std::vector<std::string>& words) {
@@ -118,3 +138,37 @@ TEST(CombinedVocabulary, EmptyVocabulary) {
   testEmptyVocabulary(createLeftAndRightVocabulary);
   testEmptyVocabulary(createEvenOddVocabulary);
 }
+
+/// Same as `createLeftAndRightVocabulary` and `createEvenOddVocabulary`, but
+/// both underlying vocabularies are `FrontCodedVocabulary`s.
+auto createFrontCodedLeftAndRightVocabulary(
+    const std::vector<std::string>& words) {
+  auto middle = words.begin() + static_cast<ptrdiff_t>(words.size() / 2);
+  return CombinedVocabulary{
+      createFrontCodedVocabulary({words.begin(), middle}, "combinedLeft.dat"),
+      createFrontCodedVocabulary({middle, words.end()}, "combinedRight.dat"),
+      LeftAndRight{}};
+}
+
+auto createFrontCodedEvenOddVocabulary(const std::vector<std::string>& words) {
+  std::vector<std::string> even, odd;
+  for (size_t i = 0; i < words.size(); ++i) {
+    (i % 2 == 0 ? even : odd).push_back(words[i]);
+  }
+  return CombinedVocabulary{
+      createFrontCodedVocabulary(even, "combinedEven.dat"),
+      createFrontCodedVocabulary(odd, "combinedOdd.dat"), EvenAndOdd{}};
+}
+
+TEST(CombinedVocabulary, FrontCodedUnderlyingVocabularies) {
+  testUpperAndLowerBoundWithStdLess(createFrontCodedLeftAndRightVocabulary);
+  testUpperAndLowerBoundWithStdLess(createFrontCodedEvenOddVocabulary);
+  testUpperAndLowerBoundWithNumericComparator(
+      createFrontCodedLeftAndRightVocabulary);
+  testUpperAndLowerBoundWithNumericComparator(
+      createFrontCodedEvenOddVocabulary);
+  testAccessOperatorForUnorderedVocabulary(
+      createFrontCodedLeftAndRightVocabulary);
+  testEmptyVocabulary(createFrontCodedLeftAndRightVocabulary);
+  testEmptyVocabulary(createFrontCodedEvenOddVocabulary);
+}
@@ -54,9 +54,12 @@ void checkThatTablesAreEqual(
 // `inputs` must be ordered wrt the `col0_`. `testCaseName` is used to create
 // a unique name for the required temporary files and for the implicit cache
 // of the `CompressedRelationMetaData`. `blocksize` is the size of the blocks
-// in which the permutation will be compressed and stored on disk.
+// in which the permutation will be compressed and stored on disk. If
+// `mapIntoMemory` is true, the blocks are read from a memory mapping of the
+// file.
 void testCompressedRelations(const std::vector<RelationInput>& inputs,
-                             std::string testCaseName, size_t blocksize) {
+                             std::string testCaseName, size_t blocksize,
+                             bool mapIntoMemory = false) {
   // First check the invariants of the `inputs`. They must be sorted by the
   // `col0_` and for each of the `inputs` the `col1And2_` must also be sorted.
   AD_CONTRACT_CHECK(std::ranges::is_sorted(
@@ -109,8 +112,21 @@ void testCompressedRelations(const std::vector<RelationInput>& inputs,
   r >> blocks;
 
   ASSERT_EQ(metaData.size(), inputs.size());
+  // All the `Id`s in the inputs are `VocabIndex`es.
+  for (const auto& block : blocks) {
+    const auto& zoneMap = block.col2ZoneMap_;
+    EXPECT_EQ(zoneMap.datatypes_,
+              1u << static_cast<size_t>(Datatype::VocabIndex));
+    EXPECT_LE(zoneMap.min_, zoneMap.max_);
+    EXPECT_LE(zoneMap.min_, block.firstTriple_.col2Id_);
+    EXPECT_GE(zoneMap.max_, block.lastTriple_.col2Id_);
+  }
 
   ad_utility::File file{filename, "r"};
+  if (mapIntoMemory) {
+    file.mapIntoMemory();
+    ASSERT_TRUE(file.isMappedIntoMemory());
+  }
   auto timer = std::make_shared<ad_utility::ConcurrentTimeoutTimer>(
       ad_utility::TimeoutTimer::unlimited());
   // Check the contents of the metadata.
@@ -136,6 +152,13 @@ void testCompressedRelations(const std::vector<RelationInput>& inputs,
     }
     checkThatTablesAreEqual(col1And2, table);
 
+    // The blocks that were read twice are now in the `DecompressedBlockCache`
+    // (see `DecompressedBlockCache::registerMiss`).
+    checkThatTablesAreEqual(col1And2,
+                            reader.scan(metaData[i], blocks, file, timer));
+    checkThatTablesAreEqual(col1And2,
+                            reader.scan(metaData[i], blocks, file, timer));
+
     // Check for all distinct combinations of `(col0, col1)` and check that
     // we get the expected result.
     // TODO<joka921>, C++23 use views::chunk_by
@@ -177,12 +200,15 @@ void testCompressedRelations(const std::vector<RelationInput>& inputs,
 // Run `testCompressedRelations` (see above) for the given `inputs` and
 // `testCaseName`, but with a set of different `blocksizes` (small and medium
 // size, powers of two and odd), to find subtle rounding bugs when creating the
-// blocks.
+// blocks. The permutation is read both via explicit reads and via a memory
+// mapping.
 void testWithDifferentBlockSizes(const std::vector<RelationInput>& inputs,
                                  std::string testCaseName) {
-  testCompressedRelations(inputs, testCaseName, 37);
-  testCompressedRelations(inputs, testCaseName, 237);
-  testCompressedRelations(inputs, testCaseName, 4096);
+  for (bool mapIntoMemory : {false, true}) {
+    testCompressedRelations(inputs, testCaseName, 37, mapIntoMemory);
+    testCompressedRelations(inputs, testCaseName, 237, mapIntoMemory);
+    testCompressedRelations(inputs, testCaseName, 4096, mapIntoMemory);
+  }
 }
 }  // namespace
 
@@ -411,3 +437,232 @@ TEST(CompressedRelationReader, getBlocksForJoin) {
   metadataAndBlocksB.col1Id_ = V(7);
   test({std::vector{block4, block5}, std::vector{blockB3}});
 }
+
+// _____________________________________________________________________________
+TEST(CompressedBlockMetadata, ZoneMap) {
+  using enum valueIdComparators::Comparison;
+  using ZoneMap = CompressedBlockMetadata::ZoneMap;
+  auto I = &Id::makeFromInt;
+  auto D = &Id::makeFromDouble;
+  auto fromColumn = [](std::vector<Id> column) {
+    return ZoneMap::fromColumn(column);
+  };
+
+  // A zone map about which nothing is known never excludes anything.
+  ZoneMap unknown;
+  for (auto comparison : {LT, LE, EQ, NE, GE, GT}) {
+    EXPECT_TRUE(unknown.mayContainMatch(comparison, I(3)));
+    EXPECT_TRUE(unknown.mayContainMatch(comparison, V(3)));
+  }
+
+  // Positive integers in [10, 20].
+  auto ints = fromColumn({I(17), I(10), I(20), I(12)});
+  EXPECT_EQ(ints.min_, I(10));
+  EXPECT_EQ(ints.max_, I(20));
+  EXPECT_EQ(ints.datatypes_, 1u << static_cast<size_t>(Datatype::Int));
+  EXPECT_FALSE(ints.mayContainMatch(LT, I(10)));
+  EXPECT_TRUE(ints.mayContainMatch(LE, I(10)));
+  EXPECT_FALSE(ints.mayContainMatch(GT, I(20)));
+  EXPECT_TRUE(ints.mayContainMatch(GE, D(19.5)));
+  EXPECT_FALSE(ints.mayContainMatch(GE, D(20.5)));
+  EXPECT_TRUE(ints.mayContainMatch(EQ, I(15)));
+  EXPECT_FALSE(ints.mayContainMatch(EQ, I(21)));
+  EXPECT_FALSE(ints.mayContainMatch(EQ, D(9.0)));
+  EXPECT_TRUE(ints.mayContainMatch(NE, I(10)));
+  // Values of incompatible datatypes never match.
+  EXPECT_FALSE(ints.mayContainMatch(NE, V(15)));
+  EXPECT_FALSE(ints.mayContainMatch(LT, Id::makeUndefined()));
+
+  auto constant = fromColumn({I(5), I(5)});
+  EXPECT_FALSE(constant.mayContainMatch(NE, I(5)));
+  EXPECT_TRUE(constant.mayContainMatch(NE, I(6)));
+
+  // Negative integers are stored after the positive ones (wrt the bits), so
+  // a zone map that contains both can't exclude any numeric values.
+  auto mixedSign = fromColumn({I(-3), I(4)});
+  EXPECT_TRUE(mixedSign.mayContainMatch(LT, I(-100)));
+  EXPECT_TRUE(mixedSign.mayContainMatch(GT, I(100)));
+  auto negative = fromColumn({I(-3), I(-20)});
+  EXPECT_FALSE(negative.mayContainMatch(LT, I(-20)));
+  EXPECT_TRUE(negative.mayContainMatch(LE, I(-20)));
+  EXPECT_FALSE(negative.mayContainMatch(GT, I(-3)));
+
+  // Negative doubles are stored in reverse order.
+  auto negativeDoubles = fromColumn({D(-1.5), D(-8.0), D(-2.0)});
+  EXPECT_FALSE(negativeDoubles.mayContainMatch(GT, D(-1.5)));
+  EXPECT_TRUE(negativeDoubles.mayContainMatch(GT, D(-1.6)));
+  EXPECT_FALSE(negativeDoubles.mayContainMatch(LT, I(-8)));
+  EXPECT_TRUE(negativeDoubles.mayContainMatch(LT, I(-7)));
+  auto mixedSignDoubles = fromColumn({D(-1.5), D(2.0)});
+  EXPECT_TRUE(mixedSignDoubles.mayContainMatch(GT, D(100.0)));
+
+  // Ints and doubles together can't be excluded by their range, but numeric
+  // zone maps can be excluded by the datatype.
+  auto intsAndDoubles = fromColumn({I(3), D(4.0)});
+  EXPECT_TRUE(intsAndDoubles.mayContainMatch(GT, I(100)));
+  EXPECT_FALSE(intsAndDoubles.mayContainMatch(EQ, V(3)));
+  auto vocabAndDates =
+      fromColumn({V(3), Id::makeFromDate(DateOrLargeYear{Date{2000, 1, 1}})});
+  EXPECT_FALSE(vocabAndDates.mayContainMatch(GT, I(3)));
+  EXPECT_TRUE(vocabAndDates.mayContainMatch(
+      GT, Id::makeFromDate(DateOrLargeYear{Date{1990, 1, 1}})));
+
+  // Dates are ordered by their bits.
+  auto date = [](int year) {
+    return Id::makeFromDate(DateOrLargeYear{Date{year, 1, 1}});
+  };
+  auto dates = fromColumn({date(1990), date(2010), date(2000)});
+  EXPECT_FALSE(dates.mayContainMatch(LT, date(1990)));
+  EXPECT_TRUE(dates.mayContainMatch(LT, date(1991)));
+  EXPECT_FALSE(dates.mayContainMatch(GE, date(2011)));
+}
+
+TEST(CompressedRelationReader, getBlocksForFilter) {
+  auto I = &Id::makeFromInt;
+  using ZoneMap = CompressedBlockMetadata::ZoneMap;
+  auto makeBlock = [](Id col0Id, std::vector<Id> col2) {
+    return CompressedBlockMetadata{{},
+                                   0,
+                                   {col0Id, V(0), col2.front()},
+                                   {col0Id, V(1), col2.back()},
+                                   ZoneMap::fromColumn(col2)};
+  };
+  CompressedBlockMetadata block1 = makeBlock(V(16), {I(0), I(200)});
+  CompressedBlockMetadata block2 = makeBlock(V(42), {I(3), I(5)});
+  CompressedBlockMetadata block3 = makeBlock(V(42), {I(12), I(14)});
+  CompressedBlockMetadata block4 = makeBlock(V(42), {I(7), I(1)});
+  // A block that was written without a zone map.
+  CompressedBlockMetadata block5{
+      {}, 0, {V(42), V(2), V(0)}, {V(42), V(3), V(12)}};
+
+  CompressedRelationMetadata relation;
+  relation.col0Id_ = V(42);
+  std::vector blocks{block1, block2, block3, block4, block5};
+  CompressedRelationReader::MetadataAndBlocks metadataAndBlocks{
+      relation, blocks, std::nullopt, std::nullopt};
+
+  auto test = [&metadataAndBlocks](
+                  valueIdComparators::Comparison comparison, Id value,
+                  const std::vector<CompressedBlockMetadata>& expectedBlocks,
+                  source_location l = source_location::current()) {
+    auto t = generateLocationTrace(l);
+    auto result = CompressedRelationReader::getBlocksForFilter(
+        metadataAndBlocks, comparison, value);
+    EXPECT_THAT(result, ::testing::ElementsAreArray(expectedBlocks));
+  };
+  using enum valueIdComparators::Comparison;
+  // `block1` is never returned because it belongs to a different relation.
+  test(GT, I(100), {block5});
+  test(GT, I(6), {block3, block4, block5});
+  test(LE, I(3), {block2, block4, block5});
+  test(EQ, I(13), {block3, block5});
+  test(EQ, V(13), {block5});
+}
+
+TEST(DecompressedBlockCache, HitsMissesAndAdmission) {
+  // Each block has 2 columns and 4 rows of 8 bytes, so 64 bytes in total.
+  auto makeBlock = [](int value) {
+    IdTable block{2, ad_utility::testing::makeAllocator()};
+    for (int i = 0; i < 4; ++i) {
+      block.push_back({V(value), V(i)});
+    }
+    return block;
+  };
+  DecompressedBlockCache cache{128};
+  size_t numComputations = 0;
+  auto get = [&](off_t offset, bool admit) {
+    return cache.getOrCompute(
+        {0, offset},
+        [&]() {
+          ++numComputations;
+          return makeBlock(static_cast<int>(offset));
+        },
+        admit);
+  };
+
+  // A block that is not admitted is computed every time.
+  EXPECT_EQ(get(1, false), makeBlock(1));
+  EXPECT_EQ(get(1, false), makeBlock(1));
+  EXPECT_EQ(numComputations, 2u);
+  EXPECT_EQ(cache.numEntries(), 0u);
+  EXPECT_EQ(cache.numMisses(), 2u);
+
+  // An admitted block is only computed once, and can then also be read by the
+  // calls that don't admit blocks.
+  EXPECT_EQ(get(1, true), makeBlock(1));
+  EXPECT_EQ(get(1, true), makeBlock(1));
+  EXPECT_EQ(get(1, false), makeBlock(1));
+  EXPECT_EQ(numComputations, 3u);
+  EXPECT_EQ(cache.numEntries(), 1u);
+  EXPECT_EQ(cache.sizeInBytes(), 64u);
+  EXPECT_EQ(cache.numHits(), 2u);
+  EXPECT_EQ(cache.numMisses(), 3u);
+
+  // Blocks with the same offset, but from a different reader are different.
+  cache.getOrCompute({1, 1}, [&]() { return makeBlock(42); }, true);
+  EXPECT_EQ(get(1, true), makeBlock(1));
+  EXPECT_EQ(cache.numEntries(), 2u);
+
+  // The least recently used block is evicted if the size limit is exceeded.
+  EXPECT_EQ(get(2, true), makeBlock(2));
+  EXPECT_EQ(cache.numEntries(), 2u);
+  EXPECT_EQ(cache.sizeInBytes(), 128u);
+  numComputations = 0;
+  get(1, true);
+  get(2, true);
+  EXPECT_EQ(numComputations, 0u);
+
+  // Shrinking the cache evicts blocks, and a size of zero disables it.
+  cache.setMaxSizeInBytes(64);
+  EXPECT_EQ(cache.numEntries(), 1u);
+  cache.setMaxSizeInBytes(0);
+  EXPECT_EQ(cache.numEntries(), 0u);
+  get(3, true);
+  EXPECT_EQ(cache.numEntries(), 0u);
+
+  cache.setMaxSizeInBytes(1000);
+  get(3, true);
+  EXPECT_EQ(cache.numEntries(), 1u);
+  cache.clear();
+  EXPECT_EQ(cache.numEntries(), 0u);
+}
+
+TEST(DecompressedBlockCache, GetIfContainedAndInsert) {
+  auto makeBlock = [](int value) {
+    IdTable block{2, ad_utility::testing::makeAllocator()};
+    block.push_back({V(value), V(value + 1)});
+    return block;
+  };
+  DecompressedBlockCache cache{1000};
+  // Only the blocks that are read from disk are counted as misses.
+  EXPECT_EQ(cache.getIfContained({0, 3}), nullptr);
+  EXPECT_EQ(cache.numMisses(), 0u);
+  // A block of a large scan is only inserted when it is read for the second
+  // time, a block of a small scan is always inserted.
+  EXPECT_FALSE(cache.registerMiss({0, 3}, false));
+  EXPECT_TRUE(cache.registerMiss({0, 4}, true));
+  EXPECT_TRUE(cache.registerMiss({0, 3}, false));
+  EXPECT_FALSE(cache.registerMiss({0, 3}, false));
+  EXPECT_EQ(cache.numMisses(), 4u);
+  cache.clear();
+  EXPECT_FALSE(cache.registerMiss({0, 3}, false));
+  EXPECT_EQ(cache.numMisses(), 5u);
+
+  // An inserted block is not counted again.
+  cache.insert({0, 3}, makeBlock(3));
+  EXPECT_EQ(cache.numMisses(), 5u);
+  EXPECT_EQ(cache.numEntries(), 1u);
+  auto block = cache.getIfContained({0, 3});
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(*block, makeBlock(3));
+  EXPECT_EQ(cache.numHits(), 1u);
+
+  // A block that is already contained is not replaced.
+  cache.insert({0, 3}, makeBlock(4));
+  EXPECT_EQ(*cache.getIfContained({0, 3}), makeBlock(3));
+  EXPECT_EQ(cache.getOrCompute(
+                {0, 3}, [&]() { return makeBlock(5); }, true),
+            makeBlock(3));
+  EXPECT_EQ(cache.numHits(), 3u);
+  EXPECT_EQ(cache.numMisses(), 5u);
+}
@@ -314,3 +314,113 @@ TEST(ConcurrentCache, cacheStatusToString) {
       static_cast<int>(notInCacheAndNotComputed) + 1);
   EXPECT_ANY_THROW(toString(outOfBounds));
 }
+
+TEST(ConcurrentCache, insertPinnedIfNotContained) {
+  SimpleConcurrentLruCache a{3ul};
+  a.computeOnce(1, waiting_function("1"s, 0));
+  EXPECT_FALSE(a.insertPinnedIfNotContained(1, std::make_shared<std::string>(
+                                                   "other")));
+  EXPECT_TRUE(a.insertPinnedIfNotContained(2, std::make_shared<std::string>(
+                                                  "2")));
+  EXPECT_EQ(1ul, a.numPinnedEntries());
+  EXPECT_EQ(1ul, a.numNonPinnedEntries());
+  auto pinned = a.getPinnedEntries();
+  ASSERT_EQ(pinned.size(), 1ul);
+  EXPECT_EQ(pinned[0].first, 2);
+  EXPECT_EQ(*pinned[0].second, "2");
+
+  // A result that is currently being computed is not replaced.
+  StartStopSignal signal;
+  auto fut = std::async(std::launch::async, [&]() {
+    return a.computeOnce(3, waiting_function("3"s, 0, &signal));
+  });
+  signal._hasStartedSignal.wait();
+  EXPECT_FALSE(
+      a.insertPinnedIfNotContained(3, std::make_shared<std::string>("other")));
+  signal._mayFinishSignal.notify();
+  EXPECT_EQ(*fut.get()._resultPointer, "3");
+}
+
+TEST(ConcurrentCache, clearAllDuringComputation) {
+  SimpleConcurrentLruCache a{3ul};
+  StartStopSignal signal;
+  auto fut = std::async(std::launch::async, [&]() {
+    return a.computeOnce(3, waiting_function("old"s, 0, &signal));
+  });
+  signal._hasStartedSignal.wait();
+  a.clearAll();
+  ASSERT_TRUE(a.getStorage().wlock()->_inProgress.empty());
+
+  // After `clearAll`, the result is computed again instead of waiting for the
+  // computation that was started before.
+  auto result = a.computeOnce(3, waiting_function("new"s, 0));
+  EXPECT_EQ(*result._resultPointer, "new");
+  EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::computed);
+
+  // The old computation still returns its result, but doesn't replace the
+  // new result in the cache.
+  signal._mayFinishSignal.notify();
+  EXPECT_EQ(*fut.get()._resultPointer, "old");
+  EXPECT_EQ(1ul, a.numNonPinnedEntries());
+  EXPECT_EQ(*a.computeOnce(3, waiting_function("other"s, 0))._resultPointer,
+            "new");
+
+  // The same holds if the old computation finishes first.
+  a.clearAll();
+  StartStopSignal signal2;
+  auto fut2 = std::async(std::launch::async, [&]() {
+    return a.computeOnce(4, waiting_function("old"s, 0, &signal2));
+  });
+  signal2._hasStartedSignal.wait();
+  a.clearAll();
+  signal2._mayFinishSignal.notify();
+  EXPECT_EQ(*fut2.get()._resultPointer, "old");
+  EXPECT_EQ(0ul, a.numNonPinnedEntries());
+  EXPECT_TRUE(a.getStorage().wlock()->_inProgress.empty());
+}
+
+TEST(ConcurrentCache, outdatedGeneration) {
+  SimpleConcurrentLruCache a{3ul};
+  size_t generation = a.generation();
+  auto result =
+      a.computeOnce(3, waiting_function("first"s, 0), false, generation);
+  EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::computed);
+  EXPECT_TRUE(a.cacheContains(3));
+
+  // `clearAll` doesn't change the generation.
+  a.clearAll();
+  EXPECT_EQ(a.generation(), generation);
+  a.clearAllAndStartNewGeneration();
+  EXPECT_EQ(a.generation(), generation + 1);
+
+  // A computation of the old generation is not added to the cache, even if it
+  // is started after the cache was cleared, and a computation of the new
+  // generation doesn't wait for it.
+  StartStopSignal signal;
+  auto fut = std::async(std::launch::async, [&]() {
+    return a.computeOnce(3, waiting_function("old"s, 0, &signal), false,
+                         generation);
+  });
+  signal._hasStartedSignal.wait();
+  EXPECT_TRUE(a.getStorage().wlock()->_inProgress.empty());
+  result = a.computeOnce(3, waiting_function("new"s, 0), false,
+                         generation + 1);
+  EXPECT_EQ(*result._resultPointer, "new");
+  signal._mayFinishSignal.notify();
+  EXPECT_EQ(*fut.get()._resultPointer, "old");
+  EXPECT_EQ(1ul, a.numNonPinnedEntries());
+
+  // Results that are already in the cache can still be read by computations
+  // of the old generation.
+  result = a.computeOncePinned(3, waiting_function("other"s, 0), false,
+                               generation);
+  EXPECT_EQ(*result._resultPointer, "new");
+  EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::cachedNotPinned);
+  result = a.computeOnce(4, waiting_function("other"s, 0), false, generation);
+  EXPECT_EQ(*result._resultPointer, "other");
+  EXPECT_FALSE(a.cacheContains(4));
+
+  // Without a generation, the current generation is used.
+  a.computeOnce(4, waiting_function("current"s, 0));
+  EXPECT_TRUE(a.cacheContains(4));
+}
@@ -0,0 +1,289 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "./util/AllocatorTestHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "index/DeltaTriples.h"
+#include "util/File.h"
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+using Triple = DeltaTriples::Triple;
+
+// Create an `IdTable` from the given `rows`, the ints are converted via `V`.
+IdTable makeTable(size_t numColumns,
+                  const std::vector<std::vector<int>>& rows) {
+  IdTable result{numColumns, ad_utility::testing::makeAllocator()};
+  for (const auto& row : rows) {
+    AD_CONTRACT_CHECK(row.size() == numColumns);
+    result.emplace_back();
+    for (size_t i = 0; i < numColumns; ++i) {
+      result(result.size() - 1, i) = V(row[i]);
+    }
+  }
+  return result;
+}
+
+// Yield each of the `blocks` as an `IdTable` with two columns.
+PermutationDeltas::IdTableGenerator makeLazyScan(
+    std::vector<std::vector<std::vector<int>>> blocks) {
+  for (const auto& block : blocks) {
+    co_yield makeTable(2, block);
+  }
+}
+
+Triple T(int a, int b, int c) { return {V(a), V(b), V(c)}; }
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(PermutationDeltas, insertAndErase) {
+  PermutationDeltas deltas;
+  EXPECT_TRUE(deltas.empty());
+  deltas.insert(T(1, 2, 3));
+  deltas.insert(T(1, 4, 5));
+  deltas.insert(T(3, 2, 3));
+  deltas.erase(T(4, 2, 3));
+  EXPECT_EQ(deltas.inserted().size(), 3u);
+  EXPECT_EQ(deltas.deleted().size(), 1u);
+
+  // The last call for a triple wins.
+  deltas.erase(T(1, 4, 5));
+  deltas.insert(T(4, 2, 3));
+  EXPECT_EQ(deltas.inserted(), (std::set{T(1, 2, 3), T(3, 2, 3), T(4, 2, 3)}));
+  EXPECT_EQ(deltas.deleted(), (std::set{T(1, 4, 5)}));
+
+  EXPECT_TRUE(deltas.hasInsertedTriples(V(1), std::nullopt));
+  EXPECT_TRUE(deltas.hasInsertedTriples(V(1), V(2)));
+  EXPECT_FALSE(deltas.hasInsertedTriples(V(1), V(4)));
+  EXPECT_FALSE(deltas.hasInsertedTriples(V(2), std::nullopt));
+  EXPECT_TRUE(deltas.hasDeletedTriples(V(1), V(4)));
+  EXPECT_FALSE(deltas.hasDeletedTriples(V(3), std::nullopt));
+  EXPECT_EQ(deltas.getNumInsertedTriples(V(4), std::nullopt), 1u);
+  EXPECT_EQ(deltas.getNumInsertedTriples(V(4), V(3)), 0u);
+  EXPECT_EQ(deltas.getCol0IdsOfInsertedTriples(),
+            (std::vector{V(1), V(3), V(4)}));
+}
+
+// _____________________________________________________________________________
+TEST(PermutationDeltas, levelsAndCopies) {
+  // The `recent_` level is merged into the `base_` level as soon as it
+  // contains more than two triples.
+  PermutationDeltas deltas{2};
+  deltas.insert(T(1, 2, 3));
+  deltas.insert(T(1, 4, 5));
+  deltas.erase(T(2, 2, 2));
+  EXPECT_EQ(deltas.getSizesOfLevels(), (std::pair<size_t, size_t>{3, 0}));
+
+  // The `recent_` level overrides the `base_` level, also for copies that
+  // share the levels.
+  deltas.erase(T(1, 2, 3));
+  deltas.insert(T(2, 2, 2));
+  EXPECT_EQ(deltas.getSizesOfLevels(), (std::pair<size_t, size_t>{3, 2}));
+  PermutationDeltas copy = deltas;
+  deltas.insert(T(1, 2, 3));
+  deltas.insert(T(3, 3, 3));
+  EXPECT_EQ(copy.inserted(), (std::set{T(1, 4, 5), T(2, 2, 2)}));
+  EXPECT_EQ(copy.deleted(), (std::set{T(1, 2, 3)}));
+  EXPECT_EQ(copy.numInserted(), 2u);
+  EXPECT_EQ(copy.numDeleted(), 1u);
+  EXPECT_FALSE(copy.hasInsertedTriples(V(1), V(2)));
+  EXPECT_TRUE(copy.hasDeletedTriples(V(1), V(2)));
+  EXPECT_EQ(copy.getNumInsertedTriples(V(1), std::nullopt), 1u);
+  EXPECT_EQ(copy.mergeIntoScanResult(makeTable(1, {{3}, {4}}), V(1), V(2)),
+            makeTable(1, {{4}}));
+
+  // The insertions into `deltas` caused a merge, which doesn't affect the
+  // copy.
+  EXPECT_EQ(deltas.getSizesOfLevels(), (std::pair<size_t, size_t>{4, 0}));
+  EXPECT_EQ(deltas.inserted(),
+            (std::set{T(1, 2, 3), T(1, 4, 5), T(2, 2, 2), T(3, 3, 3)}));
+  EXPECT_TRUE(deltas.deleted().empty());
+  EXPECT_EQ(copy.getSizesOfLevels(), (std::pair<size_t, size_t>{3, 2}));
+}
+
+// _____________________________________________________________________________
+TEST(PermutationDeltas, mergeIntoScanResult) {
+  PermutationDeltas deltas;
+  deltas.insert(T(1, 2, 3));
+  deltas.insert(T(1, 4, 5));
+  deltas.insert(T(1, 7, 1));
+  deltas.insert(T(2, 0, 0));
+  deltas.erase(T(1, 3, 3));
+  deltas.erase(T(1, 8, 8));
+
+  auto scanResult = makeTable(2, {{2, 3}, {3, 3}, {5, 0}, {8, 8}});
+  auto merged = deltas.mergeIntoScanResult(std::move(scanResult), V(1),
+                                           std::nullopt);
+  EXPECT_EQ(merged, makeTable(2, {{2, 3}, {4, 5}, {5, 0}, {7, 1}}));
+
+  // Scan with a fixed `col1Id`.
+  merged = deltas.mergeIntoScanResult(makeTable(1, {{1}, {3}}), V(1), V(3));
+  EXPECT_EQ(merged, makeTable(1, {{1}}));
+  merged = deltas.mergeIntoScanResult(makeTable(1, {}), V(1), V(4));
+  EXPECT_EQ(merged, makeTable(1, {{5}}));
+
+  // Without deltas for the `col0Id` the scan result is unchanged.
+  merged = deltas.mergeIntoScanResult(makeTable(2, {{1, 1}}), V(3),
+                                      std::nullopt);
+  EXPECT_EQ(merged, makeTable(2, {{1, 1}}));
+}
+
+// _____________________________________________________________________________
+TEST(PermutationDeltas, mergeIntoLazyScan) {
+  auto deltas = std::make_shared<PermutationDeltas>();
+  deltas->insert(T(1, 0, 1));
+  deltas->insert(T(1, 4, 5));
+  deltas->insert(T(1, 9, 9));
+  deltas->insert(T(1, 10, 0));
+  deltas->erase(T(1, 3, 3));
+  deltas->erase(T(1, 7, 7));
+
+  auto allocator = ad_utility::testing::makeAllocator();
+  auto blocks = makeLazyScan({{{2, 3}, {3, 3}}, {{7, 7}}, {{8, 8}}});
+  std::vector<IdTable> result;
+  for (auto& block : PermutationDeltas::mergeIntoLazyScan(
+           deltas, std::move(blocks), V(1), std::nullopt, allocator)) {
+    result.push_back(std::move(block));
+  }
+  // The only row of the second block is deleted, but the block still contains
+  // an inserted triple. The inserted triples that are larger than the last
+  // block are yielded at the end.
+  ASSERT_EQ(result.size(), 4u);
+  EXPECT_EQ(result[0], makeTable(2, {{0, 1}, {2, 3}}));
+  EXPECT_EQ(result[1], makeTable(2, {{4, 5}}));
+  EXPECT_EQ(result[2], makeTable(2, {{8, 8}}));
+  EXPECT_EQ(result[3], makeTable(2, {{9, 9}, {10, 0}}));
+
+  // A block that becomes empty is skipped.
+  result.clear();
+  blocks = makeLazyScan({{{2, 3}}, {{3, 3}}, {{8, 8}}});
+  for (auto& block : PermutationDeltas::mergeIntoLazyScan(
+           deltas, std::move(blocks), V(1), std::nullopt, allocator)) {
+    result.push_back(std::move(block));
+  }
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(result[1], makeTable(2, {{4, 5}, {8, 8}}));
+
+  // Inserted triples for a `col0Id` without any blocks.
+  result.clear();
+  for (auto& block : PermutationDeltas::mergeIntoLazyScan(
+           deltas, makeLazyScan({}), V(1), V(4), allocator)) {
+    result.push_back(std::move(block));
+  }
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0], makeTable(1, {{5}}));
+}
+
+// _____________________________________________________________________________
+TEST(DeltaTriples, permutationsAndSerialization) {
+  DeltaTriples deltaTriples;
+  deltaTriples.insertTriple(T(1, 2, 3));
+  deltaTriples.insertTriple(T(4, 5, 6));
+  deltaTriples.deleteTriple(T(7, 8, 9));
+  EXPECT_EQ(deltaTriples.numInserted(), 2u);
+  EXPECT_EQ(deltaTriples.numDeleted(), 1u);
+  EXPECT_EQ(deltaTriples.getPermutationDeltas(Permutation::PSO).inserted(),
+            (std::set{T(2, 1, 3), T(5, 4, 6)}));
+  EXPECT_EQ(deltaTriples.getPermutationDeltas(Permutation::OPS).deleted(),
+            (std::set{T(9, 8, 7)}));
+
+  std::string filename = "deltaTriplesTest.delta-triples";
+  deltaTriples.writeToFile(filename, "buildId");
+  DeltaTriples readTriples;
+  readTriples.insertTriple(T(10, 11, 12));
+  // The file belongs to another build of the index.
+  EXPECT_ANY_THROW(readTriples.readFromFile(filename, "otherBuildId"));
+  readTriples.readFromFile(filename, "buildId");
+  ad_utility::deleteFile(filename);
+  for (auto permutation : Permutation::ALL) {
+    EXPECT_EQ(readTriples.getPermutationDeltas(permutation).inserted(),
+              deltaTriples.getPermutationDeltas(permutation).inserted());
+    EXPECT_EQ(readTriples.getPermutationDeltas(permutation).deleted(),
+              deltaTriples.getPermutationDeltas(permutation).deleted());
+  }
+
+  deltaTriples.clear();
+  EXPECT_TRUE(deltaTriples.empty());
+}
+
+// _____________________________________________________________________________
+TEST(DeltaTriples, appendToFile) {
+  std::string filename = "deltaTriplesTest.append.delta-triples";
+  ad_utility::deleteFile(filename, false);
+  DeltaTriples deltaTriples;
+  auto insert = [&](std::vector<Triple> triples) {
+    for (const auto& triple : triples) {
+      deltaTriples.insertTriple(triple);
+    }
+    deltaTriples.appendToFile(filename, "buildId", {}, triples);
+  };
+  auto erase = [&](std::vector<Triple> triples) {
+    for (const auto& triple : triples) {
+      deltaTriples.deleteTriple(triple);
+    }
+    deltaTriples.appendToFile(filename, "buildId", triples, {});
+  };
+  auto expectFileContents = [&](const DeltaTriples& expected) {
+    DeltaTriples readTriples;
+    readTriples.readFromFile(filename, "buildId");
+    for (auto permutation : Permutation::ALL) {
+      EXPECT_EQ(readTriples.getPermutationDeltas(permutation).inserted(),
+                expected.getPermutationDeltas(permutation).inserted());
+      EXPECT_EQ(readTriples.getPermutationDeltas(permutation).deleted(),
+                expected.getPermutationDeltas(permutation).deleted());
+    }
+  };
+
+  // The first call creates the file, the following ones append to it.
+  insert({T(1, 2, 3), T(4, 5, 6)});
+  erase({T(1, 2, 3)});
+  auto sizeBeforeLastUpdate = std::filesystem::file_size(filename);
+  insert({T(7, 8, 9)});
+  EXPECT_GT(std::filesystem::file_size(filename), sizeBeforeLastUpdate);
+  expectFileContents(deltaTriples);
+
+  // An incompletely written last update is ignored and removed from the file,
+  // s.t. further updates can be appended.
+  std::filesystem::resize_file(filename,
+                               std::filesystem::file_size(filename) - 1);
+  DeltaTriples withoutLastUpdate;
+  withoutLastUpdate.insertTriple(T(4, 5, 6));
+  withoutLastUpdate.deleteTriple(T(1, 2, 3));
+  expectFileContents(withoutLastUpdate);
+  EXPECT_EQ(std::filesystem::file_size(filename), sizeBeforeLastUpdate);
+  withoutLastUpdate.appendToFile(filename, "buildId", {}, {T(1, 1, 1)});
+  withoutLastUpdate.insertTriple(T(1, 1, 1));
+  expectFileContents(withoutLastUpdate);
+
+  // The deleted and inserted triples of a single operation are stored in a
+  // single record, the deleted ones are applied first.
+  auto sizeBeforeOperation = std::filesystem::file_size(filename);
+  withoutLastUpdate.deleteTriple(T(1, 1, 1));
+  withoutLastUpdate.insertTriple(T(1, 2, 3));
+  withoutLastUpdate.appendToFile(filename, "buildId", {T(1, 1, 1)},
+                                 {T(1, 2, 3)});
+  expectFileContents(withoutLastUpdate);
+
+  // The same holds for the last record if it has a wrong checksum, e.g.
+  // because its size was written, but not all of its contents.
+  auto flipLastByteBefore = [&filename](uintmax_t offset) {
+    std::fstream file{filename,
+                      std::ios::in | std::ios::out | std::ios::binary};
+    file.seekg(static_cast<std::streamoff>(offset) - 1);
+    char c = static_cast<char>(file.get());
+    file.seekp(static_cast<std::streamoff>(offset) - 1);
+    file.put(static_cast<char>(c ^ 1));
+  };
+  flipLastByteBefore(std::filesystem::file_size(filename));
+  withoutLastUpdate.deleteTriple(T(1, 2, 3));
+  withoutLastUpdate.insertTriple(T(1, 1, 1));
+  expectFileContents(withoutLastUpdate);
+  EXPECT_EQ(std::filesystem::file_size(filename), sizeBeforeOperation);
+
+  // A wrong checksum of any other record means that the file is corrupted.
+  flipLastByteBefore(sizeBeforeLastUpdate);
+  EXPECT_ANY_THROW(DeltaTriples{}.readFromFile(filename, "buildId"));
+  ad_utility::deleteFile(filename);
+}
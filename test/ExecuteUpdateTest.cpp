@@ -0,0 +1,353 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "./IndexTestHelpers.h"
+#include "absl/cleanup/cleanup.h"
+#include "absl/strings/str_cat.h"
+#include "engine/ExecuteUpdate.h"
+#include "engine/QueryPlanner.h"
+#include "global/Constants.h"
+#include "parser/SparqlParser.h"
+#include "util/Conversions.h"
+
+namespace {
+using namespace ad_utility::testing;
+
+// A test index for the given `turtle` together with everything that is needed
+// to execute updates and queries on it. The files of the index are deleted on
+// destruction.
+class UpdateTestContext {
+ private:
+  std::string basename_;
+  Index index_;
+  QueryResultCache cache_;
+  QueryExecutionContext qec_;
+  std::shared_ptr<ad_utility::ConcurrentTimeoutTimer> timer_ =
+      std::make_shared<ad_utility::ConcurrentTimeoutTimer>(
+          ad_utility::TimeoutTimer::unlimited());
+
+ public:
+  UpdateTestContext(std::string basename, const std::string& turtle)
+      : basename_{std::move(basename)},
+        index_{makeTestIndex(basename_, turtle)},
+        qec_{index_, &cache_, makeAllocator(), SortPerformanceEstimator{}} {}
+
+  ~UpdateTestContext() {
+    for (const std::string& filename : getAllIndexFilenames(basename_)) {
+      ad_utility::deleteFile(filename, false);
+    }
+  }
+
+  // Execute the `update` (which consists of a single operation) and return
+  // the number of deleted and inserted triples.
+  std::pair<size_t, size_t> execute(std::string update) {
+    auto operations = SparqlParser::parseUpdate(std::move(update));
+    AD_CONTRACT_CHECK(operations.size() == 1);
+    auto [numDeleted, numInserted] =
+        ExecuteUpdate::execute(index_, operations[0], qec_, timer_);
+    cache_.clearAll();
+    return std::pair{numDeleted, numInserted};
+  }
+
+  // Return the number of rows of the result of the `query`.
+  size_t numRows(std::string query) {
+    ParsedQuery pq = SparqlParser::parseQuery(std::move(query));
+    QueryPlanner queryPlanner{&qec_};
+    return queryPlanner.createExecutionTree(pq).getResult()->size();
+  }
+
+  // Return the words to which the `variable` is bound in the rows of the
+  // result of the `query`.
+  std::vector<std::string> words(std::string query, const Variable& variable) {
+    ParsedQuery pq = SparqlParser::parseQuery(std::move(query));
+    QueryPlanner queryPlanner{&qec_};
+    auto qet = queryPlanner.createExecutionTree(pq);
+    auto result = qet.getResult();
+    std::vector<std::string> words;
+    for (Id id : result->idTable().getColumn(qet.getVariableColumn(variable))) {
+      words.push_back(
+          index_.getImpl().idToOptionalString(id.getVocabIndex()).value());
+    }
+    return words;
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ExecuteUpdate, insertAndDelete) {
+  UpdateTestContext context{"executeUpdateTest",
+                            "<a> <b> <c> . <a> <b> <d> ."};
+  auto execute = [&](std::string update) {
+    return context.execute(std::move(update));
+  };
+  auto numRows = [&](std::string query) {
+    return context.numRows(std::move(query));
+  };
+  using P = std::pair<size_t, size_t>;
+
+  // Deleted triples with words that are not contained in the index are
+  // dropped.
+  EXPECT_EQ(execute("DELETE DATA { <a> <b> <c> . <a> <b> <unknown> }"),
+            (P{1, 0}));
+  EXPECT_EQ(numRows("SELECT * WHERE { <a> <b> ?o }"), 1u);
+
+  // Inserted triples may contain new words.
+  EXPECT_EQ(execute("INSERT DATA { <a> <b> <new> . <new> <b> \"lit\" }"),
+            (P{0, 2}));
+  EXPECT_EQ(numRows("SELECT * WHERE { <a> <b> ?o }"), 2u);
+  EXPECT_EQ(numRows("SELECT * WHERE { <new> <b> \"lit\" }"), 1u);
+
+  // Move all triples from `<b>` to the new predicate `<e>`.
+  EXPECT_EQ(execute("DELETE { ?s <b> ?o } INSERT { ?s <e> ?o } "
+                    "WHERE { ?s <b> ?o }"),
+            (P{3, 3}));
+  EXPECT_EQ(numRows("SELECT * WHERE { ?s <b> ?o }"), 0u);
+  EXPECT_EQ(numRows("SELECT * WHERE { ?s <e> ?o }"), 3u);
+
+  EXPECT_EQ(execute("DELETE WHERE { <new> ?p ?o }"), (P{1, 0}));
+  EXPECT_EQ(numRows("SELECT * WHERE { ?s <e> ?o }"), 2u);
+
+  // Unbound variables in a template don't produce triples.
+  EXPECT_EQ(execute("INSERT { ?s <f> ?x } WHERE { ?s <e> ?o }"), (P{0, 0}));
+}
+
+// The words that were introduced by an update have regular IDs, so results
+// that contain them can be combined with results that have a local vocabulary
+// (here the `VALUES` clause with the word `<other>`, which is neither
+// contained in the index nor in an update).
+TEST(ExecuteUpdate, newWordsCanBeCombinedWithLocalVocab) {
+  UpdateTestContext context{"executeUpdateTestNewWords", "<a> <b> <c> ."};
+  EXPECT_EQ(context.execute("INSERT DATA { <new> <b> <c> . <a> <b> <new> }"),
+            (std::pair<size_t, size_t>{0, 2}));
+
+  EXPECT_EQ(context.numRows("SELECT * WHERE { VALUES ?s { <new> <other> } "
+                            "?s <b> ?o }"),
+            1u);
+  EXPECT_EQ(context.numRows("SELECT * WHERE { VALUES ?o { <new> <other> } "
+                            "?s <b> ?o }"),
+            1u);
+  EXPECT_EQ(context.numRows("SELECT * WHERE { VALUES ?s { <new> <other> } "
+                            "OPTIONAL { ?s <b> ?o } }"),
+            2u);
+  EXPECT_EQ(context.numRows("SELECT * WHERE { VALUES ?s { <new> <other> } "
+                            "MINUS { ?s <b> ?o } }"),
+            1u);
+  EXPECT_EQ(context.numRows("SELECT * WHERE { { VALUES ?s { <other> } } "
+                            "UNION { ?s <b> <new> } }"),
+            2u);
+  EXPECT_EQ(context.numRows("SELECT * WHERE { VALUES (?s ?o) "
+                            "{ (<new> <c>) (<other> <c>) } ?s <b> ?o }"),
+            1u);
+  // Filters with the new words work as well.
+  EXPECT_EQ(context.numRows("SELECT * WHERE { ?s <b> ?o FILTER(?o = <new>) }"),
+            1u);
+  EXPECT_EQ(
+      context.numRows("SELECT * WHERE { ?s <b> ?o FILTER(?o != <new>) }"), 2u);
+  // Range comparisons with the new words compare the words (`<c> < <new>`).
+  EXPECT_EQ(context.numRows("SELECT * WHERE { ?s <b> ?o FILTER(?o < <new>) }"),
+            2u);
+  EXPECT_EQ(
+      context.numRows("SELECT * WHERE { ?s <b> ?o FILTER(<new> >= ?o) }"), 3u);
+  EXPECT_EQ(context.numRows("SELECT * WHERE { ?s <b> ?o FILTER(?o <= <c>) }"),
+            2u);
+}
+
+// The IDs of the new words are larger than the IDs of all the words of the
+// index, but ORDER BY and comparisons like `<` use the order of the words.
+TEST(ExecuteUpdate, orderOfNewWords) {
+  UpdateTestContext context{"executeUpdateTestOrderOfNewWords",
+                            "<s> <p> <o2> . <s> <p> <o4> . <s> <p> <o6> ."};
+  EXPECT_EQ(context.execute("INSERT DATA { <s> <p> <o5> . <s> <p> <o1> . "
+                            "<s> <p> <o7> . <s> <p> <o3> }"),
+            (std::pair<size_t, size_t>{0, 4}));
+  using V = std::vector<std::string>;
+  Variable o{"?o"};
+  EXPECT_EQ(context.words("SELECT ?o WHERE { ?s <p> ?o } ORDER BY ?o", o),
+            (V{"<o1>", "<o2>", "<o3>", "<o4>", "<o5>", "<o6>", "<o7>"}));
+  EXPECT_EQ(context.words("SELECT ?o WHERE { ?s <p> ?o } ORDER BY DESC(?o)", o),
+            (V{"<o7>", "<o6>", "<o5>", "<o4>", "<o3>", "<o2>", "<o1>"}));
+
+  // Comparisons of two variables.
+  EXPECT_EQ(context.numRows("SELECT * WHERE { ?s <p> ?x . ?s <p> ?y "
+                            "FILTER(?x < ?y) }"),
+            21u);
+  EXPECT_EQ(context.words("SELECT ?x WHERE { ?s <p> ?x . ?s <p> ?y "
+                          "FILTER(?y = <o3> && ?x < ?y) } ORDER BY ?x",
+                          Variable{"?x"}),
+            (V{"<o1>", "<o2>"}));
+
+  // Comparisons with constants, the column of `?o` is sorted, so these use
+  // the binary search for the words of the index.
+  EXPECT_EQ(context.words("SELECT ?o WHERE { <s> <p> ?o FILTER(?o < <o4>) } "
+                          "ORDER BY ?o",
+                          o),
+            (V{"<o1>", "<o2>", "<o3>"}));
+  EXPECT_EQ(context.words("SELECT ?o WHERE { <s> <p> ?o FILTER(?o >= <o3>) } "
+                          "ORDER BY ?o",
+                          o),
+            (V{"<o3>", "<o4>", "<o5>", "<o6>", "<o7>"}));
+
+  // `<o35>` is neither contained in the index nor in an update, and the order
+  // of `<o3>` and `<o35>` can't be determined via the IDs.
+  EXPECT_ANY_THROW(
+      context.numRows("SELECT * WHERE { <s> <p> ?o FILTER(?o < <o35>) }"));
+}
+
+// Triples with a language-tagged literal as their object are inserted and
+// deleted together with the additional triples that are used by the `LANG()`
+// filters.
+TEST(ExecuteUpdate, languageFilters) {
+  UpdateTestContext context{"executeUpdateTestLanguageFilters",
+                            "<a> <label> \"A\"@en . <a> <label> \"A\"@de ."};
+  auto numRows = [&](std::string query) {
+    return context.numRows(std::move(query));
+  };
+  // With a fixed predicate, the `LANG()` filter uses the language-tagged
+  // predicate `@en@<label>`, otherwise the `ql:langtag` triples.
+  auto numLabels = [&](std::string_view language) {
+    return numRows(absl::StrCat(
+        "SELECT * WHERE { ?s <label> ?o FILTER(LANG(?o) = \"", language,
+        "\") }"));
+  };
+  auto numLiterals = [&](std::string_view language) {
+    return numRows(absl::StrCat(
+        "SELECT DISTINCT ?o WHERE { ?s ?p ?o FILTER(LANG(?o) = \"", language,
+        "\") }"));
+  };
+  auto numTaggedLiterals = [&](std::string_view language) {
+    return numRows(absl::StrCat("SELECT * WHERE { ?o ", LANGUAGE_PREDICATE, " ",
+                                ad_utility::convertLangtagToEntityUri(language),
+                                " }"));
+  };
+  EXPECT_EQ(numLabels("en"), 1u);
+  EXPECT_EQ(numLabels("fr"), 0u);
+
+  using P = std::pair<size_t, size_t>;
+  EXPECT_EQ(context.execute("INSERT DATA { <b> <label> \"B\"@en . "
+                            "<b> <label> \"B\"@fr . <c> <other> \"B\"@en }"),
+            (P{0, 3}));
+  EXPECT_EQ(numLabels("en"), 2u);
+  EXPECT_EQ(numLabels("fr"), 1u);
+  EXPECT_EQ(numLiterals("en"), 2u);
+  EXPECT_EQ(numLiterals("fr"), 1u);
+  EXPECT_EQ(numTaggedLiterals("en"), 2u);
+
+  // `"B"@en` is still the object of another triple, so its `ql:langtag`
+  // triple remains.
+  EXPECT_EQ(context.execute("DELETE DATA { <a> <label> \"A\"@en . "
+                            "<b> <label> \"B\"@en . <b> <label> \"B\"@fr }"),
+            (P{3, 0}));
+  EXPECT_EQ(numLabels("en"), 0u);
+  EXPECT_EQ(numLabels("fr"), 0u);
+  EXPECT_EQ(numLabels("de"), 1u);
+  EXPECT_EQ(numLiterals("en"), 1u);
+  EXPECT_EQ(numLiterals("fr"), 0u);
+  EXPECT_EQ(numTaggedLiterals("en"), 1u);
+  EXPECT_EQ(numTaggedLiterals("fr"), 0u);
+}
+
+// The patterns of `ql:has-predicate` don't reflect updates, so scans are used
+// instead once an index has been updated.
+TEST(ExecuteUpdate, hasPredicate) {
+  UpdateTestContext context{"executeUpdateTestHasPredicate",
+                            "<a> <b> <c> . <a> <b> <d> . <a> <l> \"x\"@en ."};
+  auto numRows = [&](std::string query) {
+    return context.numRows(std::move(query));
+  };
+  auto check = [&](size_t numPredicatesOfA, size_t numSubjectsWithB,
+                   size_t numPairs, size_t numPredicates) {
+    EXPECT_EQ(numRows("SELECT ?p WHERE { <a> ql:has-predicate ?p }"),
+              numPredicatesOfA);
+    EXPECT_EQ(numRows("SELECT ?s WHERE { ?s ql:has-predicate <b> }"),
+              numSubjectsWithB);
+    EXPECT_EQ(numRows("SELECT * WHERE { ?s ql:has-predicate ?p }"), numPairs);
+    // The pattern trick.
+    EXPECT_EQ(numRows("SELECT ?p (COUNT(?s) AS ?count) WHERE "
+                      "{ ?s ql:has-predicate ?p } GROUP BY ?p"),
+              numPredicates);
+  };
+  check(2, 1, 2, 2);
+  context.execute("INSERT DATA { <a> <e> <c> . <new> <b> \"y\"@en }");
+  check(3, 2, 4, 3);
+  context.execute("DELETE DATA { <a> <b> <c> . <a> <b> <d> }");
+  check(2, 1, 3, 3);
+}
+
+// The compaction folds the delta triples into the permutations on disk. Only
+// inserted triples with words that were introduced by updates remain delta
+// triples.
+TEST(ExecuteUpdate, compactDeltaTriples) {
+  const std::string basename = "executeUpdateTestCompaction";
+  absl::Cleanup deleteIndexFiles{[&basename] {
+    for (const std::string& filename : getAllIndexFilenames(basename)) {
+      ad_utility::deleteFile(filename, false);
+    }
+  }};
+  auto loadIndex = [&basename] {
+    Index index{ad_utility::makeUnlimitedAllocator<Id>()};
+    index.setUsePatterns(true);
+    index.createFromOnDiskIndex(basename);
+    return index;
+  };
+  using Triple = std::array<Id, 3>;
+  // The IDs of the words don't change with the compaction.
+  Id a, b, c, d, e;
+  std::vector<Id> expectedObjectsOfA, expectedObjectsOfE;
+  auto expectScanResults = [&](const Index& index) {
+    const auto& impl = index.getImpl();
+    auto objects = [&impl, &b](Id subject) {
+      IdTable result = impl.PSO().scan(b, subject);
+      return std::vector<Id>(result.getColumn(0).begin(),
+                             result.getColumn(0).end());
+    };
+    EXPECT_EQ(objects(a), expectedObjectsOfA);
+    EXPECT_EQ(objects(e), expectedObjectsOfE);
+    EXPECT_EQ(impl.SPO().scan(a, std::nullopt).size(),
+              expectedObjectsOfA.size());
+    auto numTriplesWithObject = [&](Id object) {
+      return static_cast<size_t>(
+          std::ranges::count(expectedObjectsOfA, object) +
+          std::ranges::count(expectedObjectsOfE, object));
+    };
+    EXPECT_EQ(impl.OPS().scan(c, std::nullopt).size(), numTriplesWithObject(c));
+    EXPECT_EQ(impl.OSP().scan(d, std::nullopt).size(), numTriplesWithObject(d));
+  };
+
+  {
+    Index index =
+        makeTestIndex(basename, "<a> <b> <c> . <a> <b> <d> . <e> <b> <c> .");
+    for (auto [word, id] : std::vector<std::pair<std::string, Id*>>{
+             {"<a>", &a}, {"<b>", &b}, {"<c>", &c}, {"<d>", &d}, {"<e>", &e}}) {
+      ASSERT_TRUE(index.getId(word, id));
+    }
+    index.deleteAndInsertTriples({Triple{a, b, c}}, {Triple{e, b, d}});
+    expectedObjectsOfA = {d};
+    expectedObjectsOfE = {c, d};
+    expectScanResults(index);
+    index.compactDeltaTriples();
+  }
+  Id newWord;
+  {
+    Index index = loadIndex();
+    EXPECT_TRUE(index.getImpl().deltaTriples().empty());
+    EXPECT_FALSE(ad_utility::File::exists(basename + DELTA_TRIPLES_SUFFIX));
+    EXPECT_TRUE(index.getImpl().hasOutdatedPatterns());
+    expectScanResults(index);
+
+    newWord = index.getImpl().getOrAddIdForUpdate("<new>");
+    index.deleteAndInsertTriples({Triple{e, b, c}}, {Triple{a, b, newWord}});
+    expectedObjectsOfA = {d, newWord};
+    expectedObjectsOfE = {d};
+    expectScanResults(index);
+    index.compactDeltaTriples();
+  }
+  Index index = loadIndex();
+  expectScanResults(index);
+  EXPECT_EQ(index.getImpl().getIdOfWord("<new>"), newWord);
+  const auto& deltaTriples = index.getImpl().deltaTriples();
+  EXPECT_EQ(deltaTriples.numInserted(), 1u);
+  EXPECT_EQ(deltaTriples.numDeleted(), 0u);
+  EXPECT_TRUE(ad_utility::File::exists(basename + DELTA_TRIPLES_SUFFIX));
+}
@@ -7,6 +7,7 @@
 #include "./IndexTestHelpers.h"
 #include "./util/GTestHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "absl/strings/str_cat.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/IndexScan.h"
 #include "engine/QueryPlanner.h"
@@ -47,8 +48,12 @@ nlohmann::json runJSONQuery(const std::string& kg, const std::string& query,
   auto pq = SparqlParser::parseQuery(query);
   auto qet = qp.createExecutionTree(pq);
   ad_utility::Timer timer{ad_utility::Timer::Started};
-  return ExportQueryExecutionTrees::computeResultAsJSON(pq, qet, timer, 200,
-                                                        mediaType);
+  std::string result;
+  for (const auto& block : ExportQueryExecutionTrees::computeResultAsJSONStream(
+           pq, qet, timer, 200, mediaType)) {
+    result += block;
+  }
+  return nlohmann::json::parse(result);
 }
 
 // A test case that tests the correct execution and exporting of a SELECT query
@@ -655,6 +660,117 @@ TEST(ExportQueryExecutionTree, BinaryExport) {
   ASSERT_EQ(ad_utility::testing::IntId(31), id3);
 }
 
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTree, ColumnarExport) {
+  // Append the bytes of the `value` to the `target`.
+  auto append = [](std::string& target, const auto& value) {
+    target.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  // Append zero bytes to the `target` until its size is a multiple of 8.
+  auto pad = [](std::string& target) {
+    while (target.size() % 8 != 0) {
+      target.push_back('\0');
+    }
+  };
+  // Append the `value` (of a field that is padded) and the padding.
+  auto appendPadded = [&](std::string& target, const auto& value) {
+    append(target, value);
+    pad(target);
+  };
+  auto appendHeader = [&](std::string& target,
+                          const std::vector<std::string>& variables) {
+    target = "QLVRCOL1";
+    append(target, uint64_t{variables.size()});
+    for (const auto& variable : variables) {
+      append(target, uint64_t{variable.size()});
+      target.append(variable);
+      pad(target);
+    }
+  };
+  // A string column (type 3) with the given `validity`, `words` in the
+  // dictionary, and `indices` into the dictionary.
+  auto appendStringColumn = [&](std::string& target, uint8_t validity,
+                                const std::vector<std::string>& words,
+                                const std::vector<uint32_t>& indices) {
+    appendPadded(target, uint8_t{3});
+    appendPadded(target, validity);
+    appendPadded(target, static_cast<uint32_t>(words.size()));
+    uint64_t offset = 0;
+    append(target, offset);
+    for (const auto& word : words) {
+      offset += word.size();
+      append(target, offset);
+    }
+    for (const auto& word : words) {
+      target.append(word);
+    }
+    pad(target);
+    for (uint32_t index : indices) {
+      append(target, index);
+    }
+    pad(target);
+  };
+  auto exportColumnar = [](const std::string& kg, const std::string& query) {
+    std::string result = runQueryStreamableResult(
+        kg, query, ad_utility::MediaType::qleverColumnar);
+    // All the buffers are padded to a multiple of 8 bytes.
+    EXPECT_EQ(result.size() % 8, 0u);
+    return result;
+  };
+
+  // A column with only integers is exported natively.
+  {
+    std::string kg = "<s> <p> 31 . <s> <o> 42";
+    std::string query = "SELECT ?p ?o WHERE {<s> ?p ?o } ORDER BY ?p ?o";
+    std::string expected;
+    appendHeader(expected, {"?p", "?o"});
+    append(expected, uint64_t{2});
+    appendStringColumn(expected, 0b11, {"<o>", "<p>"}, {0, 1});
+    appendPadded(expected, uint8_t{0});
+    appendPadded(expected, uint8_t{0b11});
+    append(expected, int64_t{42});
+    append(expected, int64_t{31});
+    append(expected, uint64_t{0});
+    EXPECT_EQ(exportColumnar(kg, query), expected);
+  }
+
+  // Booleans are bit-packed like the validity bitmap.
+  {
+    std::string kg = "<s> <p> true . <s> <q> false . <s> <r> true";
+    std::string query = "SELECT ?o WHERE {<s> ?p ?o } ORDER BY ?p";
+    std::string expected;
+    appendHeader(expected, {"?o"});
+    append(expected, uint64_t{3});
+    appendPadded(expected, uint8_t{2});
+    appendPadded(expected, uint8_t{0b111});
+    appendPadded(expected, uint8_t{0b101});
+    append(expected, uint64_t{0});
+    EXPECT_EQ(exportColumnar(kg, query), expected);
+  }
+
+  // A column with values of different types is exported as strings, and a
+  // variable that is not bound by the query yields a column where no row is
+  // bound. Equal values share an entry in the dictionary.
+  {
+    std::string kg = "<s> <p> 31 . <s> <q> \"abc\" . <s> <r> 31";
+    std::string query = "SELECT ?o ?x WHERE {<s> ?p ?o } ORDER BY ?p";
+    std::string expected;
+    appendHeader(expected, {"?o", "?x"});
+    append(expected, uint64_t{3});
+    appendStringColumn(expected, 0b111, {"31", "\"abc\""}, {0, 1, 0});
+    appendStringColumn(expected, 0b000, {}, {0, 0, 0});
+    append(expected, uint64_t{0});
+    EXPECT_EQ(exportColumnar(kg, query), expected);
+  }
+
+  // The columnar export is not supported for CONSTRUCT queries.
+  std::string constructQuery =
+      "CONSTRUCT {?s ?p ?o} WHERE {?s ?p ?o } ORDER BY ?p ?o";
+  ASSERT_THROW(runQueryStreamableResult("<s> <p> <o>", constructQuery,
+                                        ad_utility::MediaType::qleverColumnar),
+               ad_utility::Exception);
+}
+
 // ____________________________________________________________________________
 TEST(ExportQueryExecutionTree, CornerCases) {
   std::string kg = "<s> <p> <o>";
@@ -662,7 +778,7 @@ TEST(ExportQueryExecutionTree, CornerCases) {
   std::string constructQuery =
       "CONSTRUCT {?s ?p ?o} WHERE {?s ?p ?o } ORDER BY ?p ?o";
 
-  // JSON is not streamable.
+  // JSON is streamed via `computeResultAsJSONStream`.
   ASSERT_THROW(
       runQueryStreamableResult(kg, query, ad_utility::MediaType::qleverJson),
       ad_utility::Exception);
@@ -701,6 +817,81 @@ TEST(ExportQueryExecutionTree, CornerCases) {
       ::testing::ContainsRegex("should be unreachable"));
 }
 
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTree, LimitOffsetOfLazyResult) {
+  std::string kg;
+  for (int i = 0; i < 20; ++i) {
+    absl::StrAppend(&kg, "<s> <p> ", i, " . ");
+  }
+  // The test index uses very small blocks, so the results of the following
+  // queries are computed lazily in many blocks. The roots (FILTER and BIND) do
+  // not support a LIMIT, so the LIMIT and OFFSET are applied by the export
+  // across the boundaries of the blocks.
+  auto qec = ad_utility::testing::getQec(kg);
+  auto runLazyQuery = [qec](const std::string& query,
+                            ad_utility::MediaType mediaType) {
+    qec->clearCacheUnpinnedOnly();
+    QueryPlanner qp{qec};
+    auto pq = SparqlParser::parseQuery(query);
+    auto qet = qp.createExecutionTree(pq);
+    std::string result;
+    for (const auto& block :
+         ExportQueryExecutionTrees::computeResultAsStream(pq, qet, mediaType)) {
+      result += block;
+    }
+    EXPECT_EQ(qet.getRootOperation()->getRuntimeInfo().status_,
+              RuntimeInformation::Status::lazilyMaterialized);
+    return result;
+  };
+  using enum ad_utility::MediaType;
+
+  std::string filterQuery = "SELECT ?o WHERE { <s> <p> ?o FILTER(?o >= 0) }";
+  EXPECT_EQ(runLazyQuery(filterQuery + " LIMIT 5 OFFSET 3", tsv),
+            "?o\n3\n4\n5\n6\n7\n");
+  EXPECT_EQ(runLazyQuery(filterQuery + " OFFSET 17", csv), "o\n17\n18\n19\n");
+  EXPECT_EQ(runLazyQuery(filterQuery + " LIMIT 1 OFFSET 5", tsv), "?o\n5\n");
+  EXPECT_EQ(runLazyQuery(filterQuery + " OFFSET 20", tsv), "?o\n");
+
+  std::string bindQuery =
+      "SELECT ?o ?b WHERE { <s> <p> ?o BIND(?o + 1 AS ?b) } LIMIT 3 OFFSET 9";
+  EXPECT_EQ(runLazyQuery(bindQuery, tsv), "?o\t?b\n9\t10\n10\t11\n11\t12\n");
+}
+
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTree, JSONStreamWithMaxSend) {
+  std::string kg = "<s> <p> 1 . <s> <p> 2 . <s> <p> 3";
+  std::string query = "SELECT ?o WHERE {<s> <p> ?o} ORDER BY ?o";
+  auto qec = ad_utility::testing::getQec(kg);
+  qec->clearCacheUnpinnedOnly();
+  QueryPlanner qp{qec};
+  auto pq = SparqlParser::parseQuery(query);
+  auto qet = qp.createExecutionTree(pq);
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  auto getJSON = [&](ad_utility::MediaType mediaType) {
+    std::string result;
+    auto generator = ExportQueryExecutionTrees::computeResultAsJSONStream(
+        pq, qet, timer, 2, mediaType);
+    for (const auto& block : generator) {
+      result += block;
+    }
+    return nlohmann::json::parse(result);
+  };
+
+  // Only the first two rows are sent, but the full result size is reported.
+  auto qleverJSON = getJSON(ad_utility::MediaType::qleverJson);
+  EXPECT_EQ(qleverJSON["resultsize"], 3);
+  EXPECT_EQ(qleverJSON["selected"], std::vector{"?o"s});
+  EXPECT_EQ(qleverJSON["res"],
+            makeExpectedQLeverJSON(
+                {"\"1\"^^<http://www.w3.org/2001/XMLSchema#int>"s,
+                 "\"2\"^^<http://www.w3.org/2001/XMLSchema#int>"s}));
+  EXPECT_TRUE(qleverJSON["time"].contains("total"));
+  EXPECT_TRUE(qleverJSON["time"].contains("computeResult"));
+
+  auto sparqlJSON = getJSON(ad_utility::MediaType::sparqlJson);
+  EXPECT_EQ(sparqlJSON["results"]["bindings"].size(), 2u);
+}
+
 // TODO<joka921> Unit tests for the more complex CONSTRUCT export (combination
 // between constants and stuff from the knowledge graph).
 
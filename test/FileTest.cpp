@@ -210,3 +210,76 @@ TEST(File, makeFilestream) {
   ASSERT_THROW(ad_utility::makeIfstream("nonExisting1620349.datxyz"),
                std::runtime_error);
 }
+
+TEST(File, mapIntoMemory) {
+  std::string filename = "mapIntoMemoryTest.dat";
+  {
+    ad_utility::File file{filename, "w"};
+    std::string content = "abcdefgh";
+    file.write(content.data(), content.size());
+  }
+  ad_utility::File file{filename, "r"};
+  ASSERT_FALSE(file.isMappedIntoMemory());
+  // Advising is a no-op for files that are not mapped.
+  file.adviseWillNeed(3, 2);
+  file.mapIntoMemory();
+  ASSERT_TRUE(file.isMappedIntoMemory());
+  file.adviseWillNeed(100, 2);
+  auto range = file.getMappedRange(3, 2);
+  ASSERT_EQ(std::string_view(range.data(), range.size()), "cde");
+  range = file.getMappedRange(0, 8);
+  ASSERT_EQ(std::string_view(range.data(), range.size()), "");
+  range = file.getMappedRange(8, 0);
+  ASSERT_EQ(std::string_view(range.data(), range.size()), "abcdefgh");
+  ASSERT_ANY_THROW(file.getMappedRange(2, 7));
+
+  // The mapping is moved together with the file.
+  ad_utility::File movedFile{std::move(file)};
+  ASSERT_FALSE(file.isMappedIntoMemory());
+  ASSERT_TRUE(movedFile.isMappedIntoMemory());
+  range = movedFile.getMappedRange(2, 6);
+  ASSERT_EQ(std::string_view(range.data(), range.size()), "gh");
+  movedFile.close();
+  ASSERT_FALSE(movedFile.isMappedIntoMemory());
+
+  // An empty file is not mapped.
+  { ad_utility::File emptyFile{filename, "w"}; }
+  ad_utility::File emptyFile{filename, "r"};
+  emptyFile.mapIntoMemory();
+  ASSERT_FALSE(emptyFile.isMappedIntoMemory());
+  ad_utility::deleteFile(filename);
+}
+
+TEST(File, loadIntoMemory) {
+  std::string filename = "loadIntoMemoryTest.dat";
+  {
+    ad_utility::File file{filename, "w"};
+    std::string content = "abcdefgh";
+    file.write(content.data(), content.size());
+  }
+  // Locking the memory might fail (e.g. because of a low limit for locked
+  // memory), which only logs a warning.
+  for (auto [useHugePages, lockInMemory] :
+       {std::pair{false, false}, std::pair{true, false}, std::pair{false, true},
+        std::pair{true, true}}) {
+    ad_utility::File file{filename, "r"};
+    file.mapIntoMemory();
+    ASSERT_FALSE(file.isLoadedIntoMemory());
+    file.loadIntoMemory(useHugePages, lockInMemory);
+    ASSERT_TRUE(file.isMappedIntoMemory());
+    ASSERT_TRUE(file.isLoadedIntoMemory());
+    file.adviseWillNeed(3, 2);
+    auto range = file.getMappedRange(3, 2);
+    ASSERT_EQ(std::string_view(range.data(), range.size()), "cde");
+    ASSERT_ANY_THROW(file.getMappedRange(2, 7));
+
+    ad_utility::File movedFile{std::move(file)};
+    ASSERT_FALSE(file.isLoadedIntoMemory());
+    ASSERT_TRUE(movedFile.isLoadedIntoMemory());
+    range = movedFile.getMappedRange(8, 0);
+    ASSERT_EQ(std::string_view(range.data(), range.size()), "abcdefgh");
+    movedFile.close();
+    ASSERT_FALSE(movedFile.isLoadedIntoMemory());
+  }
+  ad_utility::deleteFile(filename);
+}
@@ -0,0 +1,67 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./IndexTestHelpers.h"
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "absl/strings/str_cat.h"
+#include "engine/Filter.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+using ad_utility::testing::IntId;
+
+namespace {
+// Plan the given SPARQL `query` on the `qec`. The cache is cleared before, so
+// the query is computed from scratch.
+QueryExecutionTree makeTree(QueryExecutionContext* qec,
+                            const std::string& query) {
+  qec->clearCacheUnpinnedOnly();
+  QueryPlanner qp{qec};
+  auto pq = SparqlParser::parseQuery(query);
+  return qp.createExecutionTree(pq);
+}
+}  // namespace
+
+// A FILTER that compares the variable of the last column of an index scan with
+// a constant only reads the blocks of the scan whose zone map can contain a
+// match (see `Filter::getPrefilteredIndexScan`). The result is the same as
+// without skipping blocks, also if the constant is the left operand.
+TEST(Filter, prefilteredIndexScan) {
+  std::string kg;
+  for (int i = 0; i < 100; ++i) {
+    absl::StrAppend(&kg, "<s> <p> ", i, " . ");
+  }
+  // The test index uses very small blocks, so the objects of `<p>` are
+  // distributed over many blocks.
+  auto* qec = ad_utility::testing::getQec(kg);
+
+  for (std::string filter : {"?o > 95", "95 < ?o"}) {
+    auto query =
+        absl::StrCat("SELECT ?o WHERE { <s> <p> ?o FILTER(", filter, ") }");
+    auto tree = makeTree(qec, query);
+    auto filterOperation =
+        std::dynamic_pointer_cast<Filter>(tree.getRootOperation());
+    ASSERT_NE(filterOperation, nullptr);
+    auto result = tree.getResult();
+    EXPECT_EQ(result->idTable(),
+              makeIdTableFromVector(
+                  {{IntId(96)}, {IntId(97)}, {IntId(98)}, {IntId(99)}}));
+
+    auto scan = filterOperation->getChildren().at(0)->getRootOperation();
+    const auto& scanInfo = scan->getRuntimeInfo();
+    auto numBlocksRead =
+        scanInfo.details_.at("num-blocks-read").get<size_t>();
+    auto numBlocksAll = scanInfo.details_.at("num-blocks-all").get<size_t>();
+    EXPECT_GT(numBlocksRead, 0u);
+    EXPECT_LT(numBlocksRead, numBlocksAll / 2);
+  }
+
+  // A FILTER that can't be used to skip blocks gives the same result.
+  auto tree =
+      makeTree(qec, "SELECT ?o WHERE { <s> <p> ?o FILTER(?o + 1 > 96) }");
+  EXPECT_EQ(tree.getResult()->idTable().numRows(), 4u);
+}
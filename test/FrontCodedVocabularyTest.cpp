@@ -0,0 +1,149 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "../src/index/vocabulary/CompressedVocabulary.h"
+#include "../src/index/vocabulary/FrontCodedVocabulary.h"
+#include "../src/index/vocabulary/PrefixCompressor.h"
+#include "../src/util/File.h"
+#include "./VocabularyTestHelpers.h"
+
+namespace {
+
+using namespace vocabulary_test;
+using Vocab = FrontCodedVocabulary;
+using BlockCompression = FrontCodedVocabulary::BlockCompression;
+
+// Return a function that creates a `FrontCodedVocabulary` from a vector of
+// words, with the given number of words per block and block compression.
+auto makeCreateVocabulary(size_t numWordsPerBlock,
+                          BlockCompression blockCompression) {
+  return [=](const std::vector<std::string>& words) {
+    std::string filename = "frontCodedVocabulary.test.dat";
+    {
+      Vocab::WordWriter writer{filename, numWordsPerBlock, blockCompression};
+      for (const auto& word : words) {
+        writer.push(word);
+      }
+    }
+    Vocab vocab;
+    vocab.open(filename);
+    ad_utility::deleteFile(filename);
+    return vocab;
+  };
+}
+
+// Run the `test` for vocabularies with different block sizes, s.t. the words
+// are in a single block, in several full blocks, or the last block is not
+// full, with and without compression.
+void testWithDifferentBlockSizes(auto test) {
+  for (size_t numWordsPerBlock : {1, 2, 3, 64}) {
+    for (auto blockCompression :
+         {BlockCompression::None, BlockCompression::Zstd}) {
+      test(makeCreateVocabulary(numWordsPerBlock, blockCompression));
+    }
+  }
+}
+
+TEST(FrontCodedVocabulary, UpperLowerBound) {
+  testWithDifferentBlockSizes([](auto createVocabulary) {
+    testUpperAndLowerBoundWithStdLess(createVocabulary);
+  });
+}
+
+TEST(FrontCodedVocabulary, UpperLowerBoundAlternativeComparator) {
+  testWithDifferentBlockSizes([](auto createVocabulary) {
+    testUpperAndLowerBoundWithNumericComparator(createVocabulary);
+  });
+}
+
+TEST(FrontCodedVocabulary, AccessOperator) {
+  testWithDifferentBlockSizes([](auto createVocabulary) {
+    testAccessOperatorForUnorderedVocabulary(createVocabulary);
+  });
+}
+
+TEST(FrontCodedVocabulary, EmptyVocabulary) {
+  testWithDifferentBlockSizes(
+      [](auto createVocabulary) { testEmptyVocabulary(createVocabulary); });
+}
+
+TEST(FrontCodedVocabulary, GetWordsForSortedIds) {
+  testWithDifferentBlockSizes([](auto createVocabulary) {
+    std::vector<std::string> words{"alpha", "beta", "delta", "epsilon",
+                                   "gamma", "kappa", "zeta"};
+    auto vocab = createVocabulary(words);
+    // Duplicates, IDs in the same block, and IDs that are not contained.
+    std::vector<uint64_t> sortedIds{0, 0, 1, 3, 4, 6, 7, 100};
+    auto result = vocab.getWordsForSortedIds(sortedIds);
+    ASSERT_EQ(result.size(), sortedIds.size());
+    for (size_t i = 0; i < sortedIds.size(); ++i) {
+      if (sortedIds[i] < words.size()) {
+        EXPECT_EQ(result[i], words[sortedIds[i]]);
+      } else {
+        EXPECT_EQ(result[i], std::nullopt);
+      }
+    }
+    EXPECT_TRUE(vocab.getWordsForSortedIds({}).empty());
+  });
+}
+
+// Words with long common prefixes (like IRIs with the same namespace) are
+// stored in much less space than their total size.
+TEST(FrontCodedVocabulary, FrontCodingIsActuallyApplied) {
+  std::vector<std::string> words;
+  size_t totalSize = 0;
+  for (size_t i = 0; i < 1000; ++i) {
+    words.push_back("<http://www.wikidata.org/entity/Q" +
+                    std::to_string(100'000 + i) + ">");
+    totalSize += words.back().size();
+  }
+  for (auto blockCompression :
+       {BlockCompression::None, BlockCompression::Zstd}) {
+    std::string filename = "frontCodedVocabulary.size.test.dat";
+    {
+      Vocab::WordWriter writer{filename, 64, blockCompression};
+      for (const auto& word : words) {
+        writer.push(word);
+      }
+    }
+    ad_utility::File file{filename, "r"};
+    EXPECT_LT(static_cast<size_t>(file.sizeOfFile()), totalSize / 3);
+    file.close();
+
+    Vocab vocab;
+    vocab.open(filename);
+    ASSERT_EQ(vocab.size(), words.size());
+    for (size_t i = 0; i < words.size(); ++i) {
+      ASSERT_EQ(vocab[i], words[i]);
+    }
+    vocab.close();
+    ad_utility::deleteFile(filename);
+  }
+}
+
+// The `FrontCodedVocabulary` can be used as the underlying vocabulary of a
+// `CompressedVocabulary`.
+TEST(FrontCodedVocabulary, AsUnderlyingVocabularyOfCompressedVocabulary) {
+  using Compressed = CompressedVocabulary<Vocab, PrefixCompressor>;
+  auto createVocabulary = [](const std::vector<std::string>& words) {
+    PrefixCompressor compressor;
+    compressor.buildCodebook(std::vector<std::string>{"al", "be", "de"});
+    Compressed vocab{std::move(compressor)};
+    std::string filename = "frontCodedVocabulary.compressed.test.dat";
+    {
+      auto writer = vocab.makeDiskWriter(filename);
+      for (const auto& word : words) {
+        writer.push(word);
+      }
+    }
+    vocab.open(filename);
+    ad_utility::deleteFile(filename);
+    return vocab;
+  };
+  testUpperAndLowerBoundWithStdLess(createVocabulary);
+  testAccessOperatorForUnorderedVocabulary(createVocabulary);
+  testEmptyVocabulary(createVocabulary);
+}
+}  // namespace
@@ -16,6 +16,7 @@
 #include "engine/sparqlExpressions/AggregateExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
+#include "engine/sparqlExpressions/SampleExpression.h"
 #include "gtest/gtest.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "parser/SparqlParser.h"
@@ -805,8 +806,106 @@ TEST(GroupBy, AliasResultReused) {
   EXPECT_EQ(table, expected);
 }
 
+// Test that the hash-based GROUP BY yields the same result as the sort-based
+// GROUP BY, both for a sequential and for a parallel computation.
+TEST(GroupBy, HashBasedAlgorithm) {
+  parsedQuery::SparqlValues input;
+  using TC = TripleComponent;
+  // Test the following SPARQL query:
+  //
+  // SELECT (COUNT(?b) AS ?count) (SUM(?b) AS ?sum) (AVG(?b) AS ?avg)
+  //        (MIN(?b) AS ?min) (MAX(?b) AS ?max) (SAMPLE(?a) AS ?sample) WHERE {
+  //   VALUES (?a ?b) { (5.0 4.0) (1.0 3.0) (5.0 2.0) (1.0 7.0) (3.0 UNDEF)}
+  // } GROUP BY ?a
+  Variable varA = Variable{"?a"};
+  Variable varB = Variable{"?b"};
+
+  input._variables = std::vector{varA, varB};
+  input._values.push_back(std::vector{TC(5.0), TC(4.0)});
+  input._values.push_back(std::vector{TC(1.0), TC(3.0)});
+  input._values.push_back(std::vector{TC(5.0), TC(2.0)});
+  input._values.push_back(std::vector{TC(1.0), TC(7.0)});
+  input._values.push_back(std::vector{TC(3.0), TC(TC::UNDEF{})});
+
+  using namespace sparqlExpression;
+  auto makeAliases = [&varA, &varB]() {
+    std::vector<Alias> aliases;
+    auto add = [&]<typename Expression>(std::string name,
+                                        const Variable& var) {
+      aliases.push_back(Alias{
+          SparqlExpressionPimpl{
+              make<Expression>(false, make<VariableExpression>(var)), name},
+          Variable{"?" + name}});
+    };
+    add.operator()<CountExpression>("count", varB);
+    add.operator()<SumExpression>("sum", varB);
+    add.operator()<AvgExpression>("avg", varB);
+    add.operator()<MinExpression>("min", varB);
+    add.operator()<MaxExpression>("max", varB);
+    // Note: The SAMPLE of `?b` is not deterministic for the sort-based
+    // algorithm, because the sorting is not stable.
+    add.operator()<SampleExpression>("sample", varA);
+    return aliases;
+  };
+  auto* qec = ad_utility::testing::getQec();
+  auto subtree = ad_utility::makeExecutionTree<Values>(qec, input);
+  EXPECT_TRUE(
+      GroupBy::supportsHashBasedAlgorithm({varA}, makeAliases(), *subtree));
+  EXPECT_FALSE(
+      GroupBy::supportsHashBasedAlgorithm({}, makeAliases(), *subtree));
+  // Grouped and aggregated variables must be bound by the subtree.
+  Variable unbound{"?unbound"};
+  EXPECT_FALSE(GroupBy::supportsHashBasedAlgorithm({unbound}, makeAliases(),
+                                                   *subtree));
+  std::vector<Alias> sumOfUnbound{Alias{
+      SparqlExpressionPimpl{
+          make<SumExpression>(false, make<VariableExpression>(unbound)),
+          "SUM(?unbound)"},
+      Variable{"?sum"}}};
+  EXPECT_FALSE(
+      GroupBy::supportsHashBasedAlgorithm({varA}, sumOfUnbound, *subtree));
+
+  auto computeGroupBy = [&](GroupBy::Algorithm algorithm) {
+    qec->getQueryTreeCache().clearAll();
+    GroupBy groupBy{qec, {varA}, makeAliases(),
+                    ad_utility::makeExecutionTree<Values>(qec, input),
+                    algorithm};
+    return groupBy.getResult()->idTable().clone();
+  };
+
+  auto d = DoubleId;
+  auto U = Id::makeUndefined();
+  auto expected = makeIdTableFromVector(
+      {{d(1), I(2), d(10), d(5), d(3), d(7), d(1)},
+       {d(3), I(0), U, U, U, U, d(3)},
+       {d(5), I(2), d(6), d(3), d(2), d(4), d(5)}});
+  EXPECT_EQ(computeGroupBy(GroupBy::Algorithm::SortBased), expected);
+  EXPECT_EQ(computeGroupBy(GroupBy::Algorithm::HashBased), expected);
+
+  // Force the hash-based GROUP BY to use several threads.
+  auto minRowsPerThread =
+      RuntimeParameters().get<"group-by-min-num-rows-per-thread">();
+  RuntimeParameters().set<"group-by-min-num-rows-per-thread">(1);
+  EXPECT_EQ(computeGroupBy(GroupBy::Algorithm::HashBased), expected);
+  RuntimeParameters().set<"group-by-min-num-rows-per-thread">(
+      minRowsPerThread);
+}
+
 }  // namespace
 
+// An aggregate of a variable that is not bound by the subtree can't be computed
+// by the hash-based GROUP BY, so the query planner must use the sort-based one.
+TEST(GroupBy, AggregateOfUnboundVariable) {
+  auto query =
+      "SELECT ?x (SUM(?unbound) AS ?sum) WHERE {"
+      " VALUES (?x ?y) {(0 1) (0 3) (1 4)} } GROUP BY ?x";
+  auto pq = SparqlParser::parseQuery(query);
+  QueryPlanner qp{ad_utility::testing::getQec()};
+  auto tree = qp.createExecutionTree(pq);
+  auto res = tree.getResult();
+  EXPECT_EQ(res->idTable().numRows(), 2u);
+}
+
 // Expressions in HAVING clauses are converted to special internal aliases. Test
 // the combination of parsing and evaluating such queries.
 TEST(GroupBy, AddedHavingRows) {
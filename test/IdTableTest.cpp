@@ -347,8 +347,14 @@ TEST(IdTable, insertAtEnd) {
     for (size_t i = 0; i < t1.size(); i++) {
       ASSERT_EQ(t1[i], t2[i + init.size()]);
     }
+
+    // Test inserting a complete table at the end.
+    Table t3 = clone(init, std::move(additionalArgs.at(3))...);
+    t3.insertAtEnd(t1);
+    ASSERT_EQ(t3.numRows(), init.size() + t1.size());
+    ASSERT_TRUE(t3 == t2);
   };
-  runTestForDifferentTypes<3>(runTestForIdTable, "idTableTest.insertAtEnd");
+  runTestForDifferentTypes<4>(runTestForIdTable, "idTableTest.insertAtEnd");
 }
 
 TEST(IdTable, reserve_and_resize) {
@@ -546,3 +546,238 @@ TEST(IndexTest, getPermutation) {
   EXPECT_EQ(&index.OPS(), &index.getPermutation(OPS));
   EXPECT_EQ(&index.OSP(), &index.getPermutation(OSP));
 }
+
+// Building the permutations in parallel must yield exactly the same files as
+// building them one after the other.
+TEST(IndexTest, parallelPermutations) {
+  std::string turtleInput =
+      "<x> <label> \"alpha\" . <x> <label> \"älpha\" . <x> <label> \"A\" . "
+      "<x> <label> \"Beta\". <x> <is-a> <y>. <y> <is-a> <x>. <z> <label> "
+      "\"zz\"@en . <y> <label> \"A\" . <z> <is-a> <y> . <a> <b> <c> .";
+  auto buildIndex = [&turtleInput](const std::string& basename,
+                                   bool parallelPermutations) {
+    std::ofstream{basename + ".ttl"} << turtleInput;
+    Index index = makeIndexWithTestSettings();
+    index.blocksizePermutationsInBytes() = 32;
+    index.setOnDiskBase(basename);
+    index.setUsePatterns(true);
+    index.setParallelPermutations(parallelPermutations);
+    index.createFromFile(basename + ".ttl");
+  };
+  std::string sequentialBasename = "parallelPermutationsTestSequential";
+  std::string parallelBasename = "parallelPermutationsTestParallel";
+  buildIndex(sequentialBasename, false);
+  buildIndex(parallelBasename, true);
+
+  auto readFile = [](const std::string& filename) {
+    std::ifstream file{filename, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, {}};
+  };
+  for (std::string suffix : {".index.pso", ".index.pos", ".index.spo",
+                             ".index.sop", ".index.osp", ".index.ops",
+                             ".index.patterns"}) {
+    auto sequential = readFile(sequentialBasename + suffix);
+    EXPECT_FALSE(sequential.empty()) << suffix;
+    EXPECT_EQ(sequential, readFile(parallelBasename + suffix)) << suffix;
+  }
+
+  Index index{ad_utility::makeUnlimitedAllocator<Id>()};
+  index.createFromOnDiskIndex(parallelBasename);
+  const IndexImpl& impl = index.getImpl();
+  EXPECT_EQ(impl.numDistinctSubjects().normal_, 4);
+  EXPECT_EQ(impl.numDistinctObjects().normal_, 8);
+  EXPECT_EQ(impl.numTriples().normal_, 10);
+
+  for (const auto& basename : {sequentialBasename, parallelBasename}) {
+    for (const std::string& filename : getAllIndexFilenames(basename)) {
+      ad_utility::deleteFile(filename, false);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, getFingerprintOfFiles) {
+  std::string basename = "indexTestFingerprint";
+  std::string turtle = "<a> <b> <c> .";
+  auto fingerprint =
+      makeTestIndex(basename, turtle).getImpl().getFingerprintOfFiles();
+  // Loading the same index again gives the same fingerprint.
+  {
+    Index index{ad_utility::makeUnlimitedAllocator<Id>()};
+    index.createFromOnDiskIndex(basename);
+    EXPECT_EQ(index.getImpl().getFingerprintOfFiles(), fingerprint);
+    // Other files in the directory of the index don't change the fingerprint.
+    std::string otherFilename = basename + ".index.other";
+    ad_utility::makeOfstream(otherFilename) << "other";
+    EXPECT_EQ(index.getImpl().getFingerprintOfFiles(), fingerprint);
+    ad_utility::deleteFile(otherFilename);
+  }
+  // Rebuilding the index from the same input changes the fingerprint.
+  EXPECT_NE(makeTestIndex(basename, turtle).getImpl().getFingerprintOfFiles(),
+            fingerprint);
+  for (const std::string& filename : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(filename, false);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, insertTriplesOnlyAppliesPersistedTriples) {
+  std::string basename = "indexTestInsertTriplesFailure";
+  Index index = makeTestIndex(basename, "<a> <b> <c> .");
+  std::array<Id, 3> triple{Id::makeFromInt(1), Id::makeFromInt(2),
+                           Id::makeFromInt(3)};
+  auto numScannedTriples = [&index, &triple]() {
+    return index.getImpl()
+        .getPermutation(Permutation::PSO)
+        .scan(triple[1], std::nullopt)
+        .size();
+  };
+
+  // A directory in place of the file with the delta triples makes writing it
+  // fail. The triples are then neither contained in the delta triples nor in
+  // the scans.
+  std::string deltaTriplesFilename = basename + DELTA_TRIPLES_SUFFIX;
+  std::filesystem::create_directory(deltaTriplesFilename);
+  EXPECT_ANY_THROW(index.insertTriples({triple}));
+  EXPECT_TRUE(index.getImpl().deltaTriples().empty());
+  EXPECT_EQ(numScannedTriples(), 0u);
+
+  std::filesystem::remove(deltaTriplesFilename);
+  index.insertTriples({triple});
+  EXPECT_EQ(index.getImpl().deltaTriples().numInserted(), 1u);
+  EXPECT_EQ(numScannedTriples(), 1u);
+
+  // The same holds for deleted triples.
+  std::filesystem::remove(deltaTriplesFilename);
+  std::filesystem::create_directory(deltaTriplesFilename);
+  EXPECT_ANY_THROW(index.deleteTriples({triple}));
+  EXPECT_EQ(index.getImpl().deltaTriples().numInserted(), 1u);
+  EXPECT_EQ(numScannedTriples(), 1u);
+
+  std::filesystem::remove(deltaTriplesFilename);
+  for (const std::string& filename : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(filename, false);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, getFingerprintOfUpdateFiles) {
+  std::string basename = "indexTestFingerprintOfUpdateFiles";
+  Index index = makeTestIndex(basename, "<a> <b> <c> .");
+  const auto& impl = index.getImpl();
+  auto fingerprintOfFiles = impl.getFingerprintOfFiles();
+  std::array<Id, 3> triple{Id::makeFromInt(1), Id::makeFromInt(2),
+                           Id::makeFromInt(3)};
+  // Every update changes the fingerprint, even if the numbers of inserted and
+  // deleted triples are the same as before. The fingerprint of the other index
+  // files is not affected.
+  auto fingerprint0 = impl.getFingerprintOfUpdateFiles();
+  index.insertTriples({triple});
+  auto fingerprint1 = impl.getFingerprintOfUpdateFiles();
+  EXPECT_NE(fingerprint1, fingerprint0);
+  index.deleteTriples({triple});
+  index.insertTriples({triple});
+  EXPECT_EQ(impl.deltaTriples().numInserted(), 1u);
+  EXPECT_NE(impl.getFingerprintOfUpdateFiles(), fingerprint1);
+  EXPECT_EQ(impl.getFingerprintOfFiles(), fingerprintOfFiles);
+
+  for (const std::string& filename : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(filename, false);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, startupSnapshot) {
+  std::string basename = "indexTestStartupSnapshot";
+  std::string snapshotFilename = basename + STARTUP_SNAPSHOT_SUFFIX;
+  std::string turtle =
+      "<a> <b> <c> . <a> <b> <c2> . <a> <b2> <c> . <a2> <b2> <c2> . "
+      "<a2> <d> <c2> . <a3> <b> <c> .";
+  // The first start writes the snapshot.
+  Index index = makeTestIndex(basename, turtle);
+  ASSERT_TRUE(ad_utility::File::exists(snapshotFilename));
+  auto snapshotSize = std::filesystem::file_size(snapshotFilename);
+
+  // The metadata of the permutations and the patterns that are read from the
+  // snapshot are the same as the ones that were read from the index files.
+  auto expectSameAsFirstStart = [&index](const Index& other) {
+    for (auto permutation : Permutation::ALL) {
+      const auto& expected = index.getImpl().getPermutation(permutation).meta_;
+      const auto& actual = other.getImpl().getPermutation(permutation).meta_;
+      EXPECT_EQ(actual.blockData(), expected.blockData());
+      EXPECT_EQ(actual.getNofTriples(), expected.getNofTriples());
+      EXPECT_EQ(actual.getNofDistinctC1(), expected.getNofDistinctC1());
+    }
+    EXPECT_TRUE(
+        std::ranges::equal(other.getHasPattern(), index.getHasPattern()));
+    const auto& expectedPatterns = index.getPatterns();
+    const auto& actualPatterns = other.getPatterns();
+    ASSERT_EQ(actualPatterns.size(), expectedPatterns.size());
+    for (size_t i = 0; i < expectedPatterns.size(); ++i) {
+      EXPECT_TRUE(std::ranges::equal(actualPatterns[i], expectedPatterns[i]));
+    }
+    EXPECT_EQ(other.getAvgNumDistinctSubjectsPerPredicate(),
+              index.getAvgNumDistinctSubjectsPerPredicate());
+  };
+  auto loadIndex = [&basename]() {
+    Index result{ad_utility::makeUnlimitedAllocator<Id>()};
+    result.setUsePatterns(true);
+    result.createFromOnDiskIndex(basename);
+    return result;
+  };
+
+  // The second start reads the snapshot and doesn't write it again.
+  auto lastWriteTime = std::filesystem::last_write_time(snapshotFilename);
+  expectSameAsFirstStart(loadIndex());
+  EXPECT_EQ(std::filesystem::last_write_time(snapshotFilename), lastWriteTime);
+
+  // A corrupt snapshot is ignored and written again.
+  std::filesystem::resize_file(snapshotFilename, snapshotSize / 2);
+  expectSameAsFirstStart(loadIndex());
+  EXPECT_EQ(std::filesystem::file_size(snapshotFilename), snapshotSize);
+  expectSameAsFirstStart(loadIndex());
+
+  for (const std::string& filename : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(filename, false);
+  }
+}
+
+// The externalized words (by default all literals with a language tag other
+// than English) can be stored in a `FrontCodedVocabulary`. The type is stored
+// in the configuration and used when the index is loaded.
+TEST(IndexTest, frontCodedExternalVocabulary) {
+  std::string turtle =
+      "<x> <label> \"alpha\"@fr . <x> <label> \"beta\"@de . "
+      "<y> <label> \"gamma\"@fr . <y> <label> \"delta\"@en .";
+  for (bool frontCoded : {false, true}) {
+    std::string basename = "indexTestFrontCodedExternalVocabulary";
+    const Index index =
+        makeTestIndex(basename, turtle, true, true, true, 32, frontCoded);
+    const auto& impl = index.getImpl();
+    const auto& externalVocab =
+        impl.getVocab().getExternalVocab().getUnderlyingVocabulary();
+    EXPECT_EQ(externalVocab.getType(),
+              frontCoded ? PolymorphicVocabulary::Type::FrontCoded
+                         : PolymorphicVocabulary::Type::OnDisk);
+    EXPECT_EQ(externalVocab.size(), 3u);
+    std::vector<VocabIndex> ids;
+    for (std::string word :
+         {"\"alpha\"@fr", "\"beta\"@de", "\"delta\"@en", "\"gamma\"@fr"}) {
+      Id id;
+      ASSERT_TRUE(impl.getId(word, &id)) << word;
+      EXPECT_EQ(impl.idToOptionalString(id.getVocabIndex()), word);
+      ids.push_back(id.getVocabIndex());
+    }
+    std::ranges::sort(ids);
+    auto words = impl.idsToOptionalStrings(ids);
+    ASSERT_EQ(words.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      EXPECT_EQ(words[i], impl.idToOptionalString(ids[i]));
+    }
+    Id id;
+    EXPECT_FALSE(impl.getId("\"epsilon\"@fr", &id));
+    for (const std::string& filename : getAllIndexFilenames(basename)) {
+      ad_utility::deleteFile(filename, false);
+    }
+  }
+}
@@ -50,7 +50,10 @@ inline std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".prefixes",
           indexBasename + ".vocabulary.internal",
           indexBasename + ".vocabulary.external",
-          indexBasename + ".vocabulary.external.idsAndOffsets.mmap"};
+          indexBasename + ".vocabulary.external.idsAndOffsets.mmap",
+          indexBasename + DELTA_TRIPLES_SUFFIX,
+          indexBasename + UPDATE_VOCAB_SUFFIX,
+          indexBasename + STARTUP_SNAPSHOT_SUFFIX};
 }
 
 // Create an `Index` from the given `turtleInput`. If the `turtleInput` is not
@@ -64,7 +67,8 @@ inline Index makeTestIndex(const std::string& indexBasename,
                            bool loadAllPermutations = true,
                            bool usePatterns = true,
                            bool usePrefixCompression = true,
-                           size_t blocksizePermutationsInBytes = 32) {
+                           size_t blocksizePermutationsInBytes = 32,
+                           bool frontCodedExternalVocabulary = false) {
   // Ignore the (irrelevant) log output of the index building and loading during
   // these tests.
   static std::ostringstream ignoreLogStream;
@@ -93,6 +97,7 @@ inline Index makeTestIndex(const std::string& indexBasename,
     index.setOnDiskBase(indexBasename);
     index.setUsePatterns(usePatterns);
     index.setPrefixCompression(usePrefixCompression);
+    index.setFrontCodedExternalVocabulary(frontCodedExternalVocabulary);
     index.createFromFile(inputFilename);
   }
   Index index{ad_utility::makeUnlimitedAllocator<Id>()};
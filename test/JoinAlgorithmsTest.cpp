@@ -6,10 +6,12 @@
 #include <gtest/gtest.h>
 
 #include "./util/GTestHelpers.h"
+#include "./util/IdTestHelpers.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
 #include "util/TransparentFunctors.h"
 
 using namespace ad_utility;
+using ad_utility::testing::IntId;
 namespace {
 
 // Some helpers for testing the joining of blocks of Integers.
@@ -118,3 +120,119 @@ TEST(JoinAlgorithms, JoinWithBlocksMultipleBlocksPerElementBothSides) {
       {42, 2, 13}, {42, 3, 12}, {42, 3, 13}, {67, 0, 14}};
   testJoin(a, b, expectedResult);
 }
+
+// ________________________________________________________________________________________
+TEST(JoinAlgorithms, ZipperJoinForSingleColumnWithoutUndef) {
+  using ::testing::ElementsAreArray;
+  auto toIds = [](const std::vector<int64_t>& ints) {
+    std::vector<Id> result;
+    std::ranges::transform(ints, std::back_inserter(result), IntId);
+    return result;
+  };
+  // Compute the join result (as pairs of indices) via the specialized kernel
+  // and via the general `zipperJoinWithUndef` and check that they are equal.
+  auto testJoin = [&toIds](const std::vector<int64_t>& leftInts,
+                           const std::vector<int64_t>& rightInts,
+                           source_location l = source_location::current()) {
+    auto trace = generateLocationTrace(l);
+    auto left = toIds(leftInts);
+    auto right = toIds(rightInts);
+    using Result = std::vector<std::array<size_t, 2>>;
+    auto makeAdder = [&left, &right](Result& result) {
+      return [&result, &left, &right](auto itLeft, auto itRight) {
+        size_t leftIndex = itLeft - left.begin();
+        size_t rightIndex = itRight - right.begin();
+        result.push_back(std::array{leftIndex, rightIndex});
+      };
+    };
+    Result result;
+    zipperJoinForSingleColumnWithoutUndef(left, right, makeAdder(result));
+    Result expected;
+    auto numOutOfOrder = zipperJoinWithUndef(
+        left, right, std::ranges::less{}, makeAdder(expected), noop, noop);
+    EXPECT_EQ(numOutOfOrder, 0u);
+    EXPECT_THAT(result, ElementsAreArray(expected));
+  };
+
+  testJoin({}, {});
+  testJoin({1, 2, 3}, {});
+  testJoin({}, {1, 2, 3});
+  testJoin({1, 3, 5, 7}, {2, 3, 4, 7, 8});
+  testJoin({1, 1, 1, 4}, {1, 1, 4, 4, 4});
+
+  // Larger inputs with duplicates and gaps, s.t. the block-wise skipping is
+  // exercised, also across block boundaries and at the end of the inputs.
+  std::vector<int64_t> multiplesOf3;
+  std::vector<int64_t> multiplesOf7;
+  for (int64_t i = 0; i < 500; ++i) {
+    multiplesOf3.push_back(3 * (i / 2));
+    multiplesOf7.push_back(7 * i);
+    if (i % 5 == 0) {
+      multiplesOf7.push_back(7 * i);
+    }
+  }
+  testJoin(multiplesOf3, multiplesOf7);
+  testJoin(multiplesOf7, multiplesOf3);
+  testJoin({0, 1000, 3493}, multiplesOf7);
+  testJoin(multiplesOf3, {0, 27, 748, 1000});
+}
+
+// ________________________________________________________________________________________
+TEST(JoinAlgorithms, PartitionSortedInputsForJoin) {
+  using P = JoinPartition;
+  using ::testing::ElementsAre;
+  auto partition = [](const std::vector<int>& left,
+                      const std::vector<int>& right, size_t numPartitions) {
+    return partitionSortedInputsForJoin(left, right, numPartitions,
+                                        std::ranges::less{});
+  };
+  EXPECT_TRUE(partition({}, {}, 4).empty());
+  EXPECT_THAT(partition({1, 2, 3}, {}, 1), ElementsAre(P{0, 3, 0, 0}));
+  EXPECT_THAT(partition({1, 2, 3, 4}, {2, 4}, 2),
+              ElementsAre(P{0, 2, 0, 1}, P{2, 4, 1, 2}));
+  // The split points are taken from the larger input.
+  EXPECT_THAT(partition({2, 4}, {1, 2, 3, 4}, 2),
+              ElementsAre(P{0, 1, 0, 2}, P{1, 2, 2, 4}));
+  // Equal elements are never split, so there might be fewer partitions than
+  // requested.
+  EXPECT_THAT(partition({1, 3, 3, 3, 3, 3, 3, 5}, {3, 5}, 4),
+              ElementsAre(P{0, 1, 0, 0}, P{1, 8, 0, 2}));
+  EXPECT_THAT(partition({3, 3, 3, 3}, {3}, 3), ElementsAre(P{0, 4, 0, 1}));
+  EXPECT_ANY_THROW(partition({1}, {1}, 0));
+
+  // The concatenation of the joins of all the partitions is the join of the
+  // complete inputs.
+  std::vector<int> left;
+  std::vector<int> right;
+  for (int i = 0; i < 1000; ++i) {
+    left.push_back(i / 3);
+    right.push_back(i / 7);
+  }
+  for (size_t numPartitions : {1, 2, 5, 17, 2000}) {
+    auto partitions = partition(left, right, numPartitions);
+    EXPECT_LE(partitions.size(), numPartitions);
+    EXPECT_EQ(partitions.front().beginLeft_, 0u);
+    EXPECT_EQ(partitions.front().beginRight_, 0u);
+    EXPECT_EQ(partitions.back().endLeft_, left.size());
+    EXPECT_EQ(partitions.back().endRight_, right.size());
+    for (size_t i = 1; i < partitions.size(); ++i) {
+      const auto& previous = partitions[i - 1];
+      const auto& current = partitions[i];
+      EXPECT_EQ(previous.endLeft_, current.beginLeft_);
+      EXPECT_EQ(previous.endRight_, current.beginRight_);
+      // All the elements of a partition are smaller than all the elements of
+      // the next partition.
+      auto lastElement = [&](const P& p) {
+        return std::max(p.endLeft_ > p.beginLeft_ ? left[p.endLeft_ - 1] : -1,
+                        p.endRight_ > p.beginRight_ ? right[p.endRight_ - 1]
+                                                    : -1);
+      };
+      auto firstElement = [&](const P& p) {
+        return std::min(
+            p.endLeft_ > p.beginLeft_ ? left[p.beginLeft_] : 1'000'000,
+            p.endRight_ > p.beginRight_ ? right[p.beginRight_] : 1'000'000);
+      };
+      EXPECT_LT(lastElement(previous), firstElement(current));
+    }
+  }
+}
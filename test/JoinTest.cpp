@@ -17,6 +17,7 @@
 #include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
 #include "./util/JoinHelpers.h"
+#include "absl/cleanup/cleanup.h"
 #include "engine/CallFixedSize.h"
 #include "engine/Engine.h"
 #include "engine/IndexScan.h"
@@ -208,6 +209,22 @@ TEST(JoinTest, joinTest) {
   runTestCasesForAllJoinAlgorithms(createJoinTestSet());
 };
 
+// Run the same tests with a setting that makes even the small inputs from the
+// test set be split into several partitions that are joined in parallel.
+TEST(JoinTest, joinTestParallel) {
+  auto maxNumThreads = RuntimeParameters().get<"join-max-num-threads">();
+  auto minNumRowsPerThread =
+      RuntimeParameters().get<"join-min-num-rows-per-thread">();
+  absl::Cleanup restoreParameters{[maxNumThreads, minNumRowsPerThread] {
+    RuntimeParameters().set<"join-max-num-threads">(maxNumThreads);
+    RuntimeParameters().set<"join-min-num-rows-per-thread">(
+        minNumRowsPerThread);
+  }};
+  RuntimeParameters().set<"join-max-num-threads">(4);
+  RuntimeParameters().set<"join-min-num-rows-per-thread">(1);
+  runTestCasesForAllJoinAlgorithms(createJoinTestSet());
+};
+
 // Several helpers for the test cases below.
 namespace {
 
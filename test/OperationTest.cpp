@@ -3,7 +3,19 @@
 // Author: Johannes Kalmbach (joka921) <kalmbach@cs.uni-freiburg.de>
 
 #include "./IndexTestHelpers.h"
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "absl/strings/str_cat.h"
+#include "engine/Bind.h"
+#include "engine/Distinct.h"
+#include "engine/Filter.h"
+#include "engine/IndexScan.h"
 #include "engine/NeutralElementOperation.h"
+#include "engine/Union.h"
+#include "engine/ValuesForTesting.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/NaryExpression.h"
+#include "engine/sparqlExpressions/RelationalExpressions.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -80,3 +92,198 @@ TEST(OperationTest, getResultOnlyCached) {
   // tests.
   qec->getQueryTreeCache().clearAll();
 }
+
+// _____________________________________________________________________________
+TEST(OperationTest, getLazyResultOfMaterializedOperation) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  NeutralElementOperation n{qec};
+  EXPECT_FALSE(n.supportsLazyEvaluation());
+  // An operation without support for lazy evaluation yields its complete
+  // result as a single block, which is also stored in the cache.
+  auto lazyResult = n.getLazyResult();
+  size_t numBlocks = 0;
+  for (const IdTable& block : lazyResult.blocks_) {
+    EXPECT_EQ(block.numRows(), 1u);
+    ++numBlocks;
+  }
+  EXPECT_EQ(numBlocks, 1u);
+  EXPECT_EQ(qec->getQueryTreeCache().numNonPinnedEntries(), 1);
+  qec->getQueryTreeCache().clearAll();
+}
+
+// _____________________________________________________________________________
+TEST(OperationTest, getLazyResultUnionAndDistinct) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto makeValues = [qec](IdTable table, size_t blockSize) {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(table), std::vector{Variable{"?x"}}, blockSize);
+  };
+  auto left = makeValues(makeIdTableFromVector({{1}, {2}, {2}, {3}, {3}}), 2);
+  auto right = makeValues(makeIdTableFromVector({{3}, {4}, {4}}), 1);
+
+  Union u{qec, left, right};
+  EXPECT_TRUE(u.supportsLazyEvaluation());
+  auto unionResult = u.getLazyResult();
+  std::vector<size_t> blockSizes;
+  IdTable materialized{1, makeAllocator()};
+  for (const IdTable& block : unionResult.blocks_) {
+    blockSizes.push_back(block.numRows());
+    materialized.insertAtEnd(block.begin(), block.end());
+  }
+  EXPECT_THAT(blockSizes, ::testing::ElementsAre(2, 2, 1, 1, 1, 1));
+  EXPECT_EQ(materialized,
+            makeIdTableFromVector({{1}, {2}, {2}, {3}, {3}, {3}, {4}, {4}}));
+  EXPECT_EQ(u.getRuntimeInfo().status_,
+            RuntimeInformation::Status::lazilyMaterialized);
+  EXPECT_EQ(u.getRuntimeInfo().numRows_, 8u);
+  // Lazily computed results are not cached.
+  EXPECT_EQ(qec->getQueryTreeCache().numNonPinnedEntries(), 0);
+
+  // The duplicates at the block boundaries are also removed by a lazy
+  // DISTINCT.
+  Distinct d{qec, std::make_shared<QueryExecutionTree>(
+                      qec, std::make_shared<Union>(qec, left, right)),
+             {ColumnIndex{0}}};
+  EXPECT_TRUE(d.supportsLazyEvaluation());
+  EXPECT_EQ(d.getLazyResult().materialize(makeAllocator()),
+            makeIdTableFromVector({{1}, {2}, {3}, {4}}));
+  qec->getQueryTreeCache().clearAll();
+}
+
+namespace {
+// Consume the lazy result of the `operation` and return the sizes of its blocks
+// and the complete result.
+std::pair<std::vector<size_t>, IdTable> consumeLazyResult(
+    Operation& operation) {
+  auto lazyResult = operation.getLazyResult();
+  std::vector<size_t> blockSizes;
+  IdTable result{operation.getResultWidth(), makeAllocator()};
+  for (const IdTable& block : lazyResult.blocks_) {
+    blockSizes.push_back(block.numRows());
+    result.insertAtEnd(block.begin(), block.end());
+  }
+  return {std::move(blockSizes), std::move(result)};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(OperationTest, getLazyResultFilterAndBind) {
+  using namespace sparqlExpression;
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  Variable x{"?x"};
+  auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{1}, {2}, {3}, {4}, {5}}, IntId),
+      std::vector{x}, 2);
+
+  // `FILTER(?x != 3)` is applied to each block separately.
+  Filter filter{
+      qec, values,
+      SparqlExpressionPimpl{
+          std::make_unique<NotEqualExpression>(std::array<SparqlExpression::Ptr,
+                                                          2>{
+              std::make_unique<VariableExpression>(x),
+              std::make_unique<IdExpression>(IntId(3))}),
+          "?x != 3"}};
+  EXPECT_TRUE(filter.supportsLazyEvaluation());
+  auto [filterBlockSizes, filterResult] = consumeLazyResult(filter);
+  EXPECT_THAT(filterBlockSizes, ::testing::ElementsAre(2, 1, 1));
+  EXPECT_EQ(filterResult,
+            makeIdTableFromVector({{1}, {2}, {4}, {5}}, IntId));
+  EXPECT_EQ(filter.getRuntimeInfo().status_,
+            RuntimeInformation::Status::lazilyMaterialized);
+  EXPECT_EQ(filter.getRuntimeInfo().numRows_, 4u);
+
+  // `BIND(?x + 10 AS ?y)` adds a column to each block.
+  auto addExpression =
+      makeAddExpression(std::make_unique<VariableExpression>(x),
+                        std::make_unique<IdExpression>(IntId(10)));
+  Bind bind{qec, values,
+            parsedQuery::Bind{
+                SparqlExpressionPimpl{std::move(addExpression), "?x + 10"},
+                Variable{"?y"}}};
+  EXPECT_TRUE(bind.supportsLazyEvaluation());
+  auto [bindBlockSizes, bindResult] = consumeLazyResult(bind);
+  EXPECT_THAT(bindBlockSizes, ::testing::ElementsAre(2, 2, 1));
+  EXPECT_EQ(bindResult,
+            makeIdTableFromVector(
+                {{1, 11}, {2, 12}, {3, 13}, {4, 14}, {5, 15}}, IntId));
+  EXPECT_EQ(bind.getRuntimeInfo().numRows_, 5u);
+
+  // Lazily computed results are not cached.
+  EXPECT_EQ(qec->getQueryTreeCache().numNonPinnedEntries(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(OperationTest, getLazyResultIndexScan) {
+  std::string kg;
+  for (int i = 0; i < 10; ++i) {
+    absl::StrAppend(&kg, "<s> <p> ", i, " . ");
+  }
+  // The test index uses very small blocks, so the scan yields several blocks.
+  auto qec = getQec(kg);
+  qec->getQueryTreeCache().clearAll();
+  IndexScan scan{qec, Permutation::PSO,
+                 SparqlTriple{{"<s>"}, {"<p>"}, Variable{"?o"}}};
+  EXPECT_TRUE(scan.supportsLazyEvaluation());
+  auto [blockSizes, result] = consumeLazyResult(scan);
+  EXPECT_GT(blockSizes.size(), 1u);
+  EXPECT_EQ(result, makeIdTableFromVector(
+                        {{0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}},
+                        IntId));
+  EXPECT_EQ(scan.getRuntimeInfo().status_,
+            RuntimeInformation::Status::lazilyMaterialized);
+  EXPECT_EQ(qec->getQueryTreeCache().numNonPinnedEntries(), 0);
+
+  // A scan with three variables can't be computed lazily, its result is
+  // materialized and yielded as a single block.
+  IndexScan fullScan{
+      qec, Permutation::PSO,
+      SparqlTriple{Variable{"?s"}, "?p", Variable{"?o"}}};
+  EXPECT_FALSE(fullScan.supportsLazyEvaluation());
+  auto [fullScanBlockSizes, fullScanResult] = consumeLazyResult(fullScan);
+  EXPECT_EQ(fullScanBlockSizes.size(), 1u);
+  qec->getQueryTreeCache().clearAll();
+}
+
+// _____________________________________________________________________________
+TEST(OperationTest, getOwnedResult) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto table = makeIdTableFromVector({{1}, {2}, {3}});
+  auto hasClonedResult = [](Operation& operation) {
+    return operation.getRuntimeInfo().details_.contains("time-cloning");
+  };
+
+  // A freshly computed result is written to the cache, so the caller gets a
+  // copy.
+  ValuesForTesting v{qec, table.clone(), {Variable{"?x"}}};
+  ResultTable result = v.getOwnedResult();
+  EXPECT_EQ(result.idTable(), table);
+  EXPECT_EQ(v.getRuntimeInfo().cacheStatus_, ad_utility::CacheStatus::computed);
+  EXPECT_TRUE(hasClonedResult(v));
+  EXPECT_EQ(qec->getQueryTreeCache().numNonPinnedEntries(), 1);
+
+  // The same holds for a result that is already contained in the cache.
+  ValuesForTesting v2{qec, table.clone(), {Variable{"?x"}}};
+  ResultTable copiedResult = v2.getOwnedResult();
+  EXPECT_EQ(copiedResult.idTable(), table);
+  EXPECT_EQ(v2.getRuntimeInfo().cacheStatus_,
+            ad_utility::CacheStatus::cachedNotPinned);
+  EXPECT_TRUE(hasClonedResult(v2));
+  qec->getQueryTreeCache().clearAll();
+
+  // A result that is too large for the cache is only owned by the caller and
+  // therefore not copied.
+  QueryResultCache cache;
+  cache.setMaxSizeSingleEntry(0);
+  QueryExecutionContext smallCacheQec{qec->getIndex(), &cache, makeAllocator(),
+                                      SortPerformanceEstimator{}};
+  ValuesForTesting v3{&smallCacheQec, table.clone(), {Variable{"?x"}}};
+  ResultTable ownedResult = v3.getOwnedResult();
+  EXPECT_EQ(ownedResult.idTable(), table);
+  EXPECT_FALSE(hasClonedResult(v3));
+  EXPECT_EQ(cache.numNonPinnedEntries(), 0);
+}
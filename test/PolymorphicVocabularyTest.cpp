@@ -0,0 +1,125 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "../src/index/PolymorphicVocabulary.h"
+#include "../src/parser/RdfEscaping.h"
+#include "../src/util/File.h"
+#include "./VocabularyTestHelpers.h"
+
+namespace {
+
+using namespace vocabulary_test;
+using Type = PolymorphicVocabulary::Type;
+
+// Return a function that creates a `PolymorphicVocabulary` of the given `type`
+// from a vector of words via `buildFromTextFile`.
+auto makeCreateVocabulary(Type type) {
+  return [type](const std::vector<std::string>& words) {
+    std::string textFilename = "polymorphicVocabulary.test.txt";
+    std::string filename = "polymorphicVocabulary.test.dat";
+    {
+      auto textFile = ad_utility::makeOfstream(textFilename);
+      for (const auto& word : words) {
+        textFile << RdfEscaping::escapeNewlinesAndBackslashes(word) << '\n';
+      }
+    }
+    PolymorphicVocabulary vocab;
+    vocab.resetToType(type);
+    vocab.buildFromTextFile(textFilename, filename);
+    vocab.open(filename);
+    EXPECT_EQ(vocab.getType(), type);
+    ad_utility::deleteFile(textFilename);
+    ad_utility::deleteFile(filename);
+    if (type == Type::OnDisk) {
+      ad_utility::deleteFile(filename + ".idsAndOffsets.mmap");
+    }
+    return vocab;
+  };
+}
+
+// Run the `test` for both types of the `PolymorphicVocabulary`.
+void testWithBothTypes(auto test) {
+  for (auto type : {Type::OnDisk, Type::FrontCoded}) {
+    test(makeCreateVocabulary(type));
+  }
+}
+
+TEST(PolymorphicVocabulary, UpperLowerBound) {
+  testWithBothTypes([](auto createVocabulary) {
+    testUpperAndLowerBoundWithStdLess(createVocabulary);
+    testUpperAndLowerBoundWithNumericComparator(createVocabulary);
+  });
+}
+
+TEST(PolymorphicVocabulary, AccessOperator) {
+  testWithBothTypes([](auto createVocabulary) {
+    testAccessOperatorForUnorderedVocabulary(createVocabulary);
+  });
+}
+
+// Newlines and backslashes are escaped in the text file and unescaped when
+// building the vocabulary.
+TEST(PolymorphicVocabulary, EscapedWords) {
+  std::string textFilename = "polymorphicVocabulary.escaped.test.txt";
+  std::string filename = "polymorphicVocabulary.escaped.test.dat";
+  {
+    auto textFile = ad_utility::makeOfstream(textFilename);
+    textFile << "a\\nb\nc\\\\d\ne\n";
+  }
+  for (auto type : {Type::OnDisk, Type::FrontCoded}) {
+    PolymorphicVocabulary vocab;
+    vocab.resetToType(type);
+    vocab.buildFromTextFile(textFilename, filename);
+    vocab.open(filename);
+    ASSERT_EQ(vocab.size(), 3u);
+    EXPECT_EQ(vocab[0], "a\nb");
+    EXPECT_EQ(vocab[1], "c\\d");
+    EXPECT_EQ(vocab[2], "e");
+    EXPECT_EQ(vocab[3], std::nullopt);
+    vocab.close();
+    ad_utility::deleteFile(filename);
+    if (type == Type::OnDisk) {
+      ad_utility::deleteFile(filename + ".idsAndOffsets.mmap");
+    }
+  }
+  ad_utility::deleteFile(textFilename);
+}
+
+TEST(PolymorphicVocabulary, EmptyVocabulary) {
+  testWithBothTypes(
+      [](auto createVocabulary) { testEmptyVocabulary(createVocabulary); });
+}
+
+TEST(PolymorphicVocabulary, GetWordsForSortedIds) {
+  testWithBothTypes([](auto createVocabulary) {
+    std::vector<std::string> words;
+    for (size_t i = 0; i < 200; ++i) {
+      words.push_back("<word" + std::to_string(1000 + i) + ">");
+    }
+    auto vocab = createVocabulary(words);
+    // Several IDs in the same block, duplicates, and IDs that are not
+    // contained.
+    std::vector<uint64_t> sortedIds{0, 1, 1, 63, 64, 130, 199, 200, 1000};
+    auto result = vocab.getWordsForSortedIds(sortedIds);
+    ASSERT_EQ(result.size(), sortedIds.size());
+    for (size_t i = 0; i < sortedIds.size(); ++i) {
+      EXPECT_EQ(result[i], vocab[sortedIds[i]]);
+    }
+    EXPECT_EQ(result[2], "<word1001>");
+    EXPECT_EQ(result[7], std::nullopt);
+    EXPECT_TRUE(vocab.getWordsForSortedIds({}).empty());
+  });
+}
+
+TEST(PolymorphicVocabulary, ResetToType) {
+  PolymorphicVocabulary vocab;
+  EXPECT_EQ(vocab.getType(), Type::OnDisk);
+  vocab.resetToType(Type::FrontCoded);
+  EXPECT_EQ(vocab.getType(), Type::FrontCoded);
+  EXPECT_EQ(vocab.size(), 0u);
+  vocab.resetToType(Type::OnDisk);
+  EXPECT_EQ(vocab.getType(), Type::OnDisk);
+}
+}  // namespace
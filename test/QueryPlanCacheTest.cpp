@@ -0,0 +1,125 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./IndexTestHelpers.h"
+#include "engine/QueryPlanCache.h"
+
+namespace {
+using TC = TripleComponent;
+using SparqlValues = QueryPlanCache::SparqlValues;
+
+// Return a plan that only consists of a `VALUES` clause for the variable `?x`
+// with the given `value`.
+PlannedQuery makePlan(int value) {
+  auto qec = ad_utility::testing::getQec();
+  PlannedQuery plan;
+  plan.tree_ = *ad_utility::makeExecutionTree<Values>(
+      qec, SparqlValues{{Variable{"?x"}}, {{TC{value}}}});
+  return plan;
+}
+
+// Return the `VALUES` of the root operation of the given `plan`.
+const SparqlValues& getValues(const PlannedQuery& plan) {
+  auto values =
+      std::dynamic_pointer_cast<Values>(plan.tree_->getRootOperation());
+  AD_CONTRACT_CHECK(values != nullptr);
+  return values->getValues();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, normalizeQuery) {
+  auto normalize = &QueryPlanCache::normalizeQuery;
+  EXPECT_EQ(normalize("  SELECT *\n\tWHERE {  ?x <p>   ?y }  "),
+            "SELECT * WHERE { ?x <p> ?y }");
+  // Whitespace inside of literals is kept.
+  EXPECT_EQ(normalize("SELECT * {?x <p>  \"a  b\" . ?x <q> 'c  d'}"),
+            "SELECT * {?x <p> \"a  b\" . ?x <q> 'c  d'}");
+  EXPECT_EQ(normalize("{?x <p> \"\"\"a \" \n b\"\"\"  }"),
+            "{?x <p> \"\"\"a \" \n b\"\"\" }");
+  EXPECT_EQ(normalize("{?x <p> \"a\\\"  b\"  }"), "{?x <p> \"a\\\"  b\" }");
+  // A comment ends at the end of the line.
+  EXPECT_EQ(normalize("SELECT * # a  comment\n  WHERE {}"),
+            "SELECT * # a  comment\nWHERE {}");
+  EXPECT_NE(normalize("SELECT * # a\n{}"), normalize("SELECT * # a {}"));
+  // A `<` that doesn't start an IRI is the less-than operator.
+  EXPECT_EQ(normalize("FILTER(?x <  3 && ?y >  4)"),
+            "FILTER(?x < 3 && ?y > 4)");
+  EXPECT_EQ(normalize("{ <http://a#b>  ?p  ?o }"), "{ <http://a#b> ?p ?o }");
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, takeAndPut) {
+  QueryPlanCache cache{2};
+  EXPECT_FALSE(cache.take("a").has_value());
+  cache.put("a", makePlan(1));
+  cache.put("a", makePlan(2));
+  EXPECT_EQ(cache.numPlans(), 2u);
+
+  // The least recently used plan is dropped.
+  cache.put("b", makePlan(3));
+  EXPECT_EQ(cache.numPlans(), 2u);
+  auto plan = cache.take("a");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_EQ(getValues(plan.value())._values[0][0], TC{2});
+  EXPECT_FALSE(cache.take("a").has_value());
+  EXPECT_EQ(cache.numPlans(), 1u);
+
+  cache.setMaxNumPlans(0);
+  EXPECT_EQ(cache.numPlans(), 0u);
+  cache.put("a", std::move(plan.value()));
+  EXPECT_FALSE(cache.take("a").has_value());
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, outdatedPlansAreDropped) {
+  QueryPlanCache cache;
+  EXPECT_EQ(cache.version(), 0u);
+  cache.put("a", makePlan(1));
+  auto plan = cache.take("a");
+  ASSERT_TRUE(plan.has_value());
+
+  // The cache is cleared while the plan is executed, so it is not put back.
+  cache.clear();
+  EXPECT_EQ(cache.version(), 1u);
+  cache.put("a", std::move(plan.value()));
+  EXPECT_EQ(cache.numPlans(), 0u);
+  EXPECT_FALSE(cache.take("a").has_value());
+
+  // A plan that is created for the new version can be reused.
+  PlannedQuery newPlan = makePlan(2);
+  newPlan.version_ = cache.version();
+  cache.put("a", std::move(newPlan));
+  plan = cache.take("a");
+  ASSERT_TRUE(plan.has_value());
+  EXPECT_EQ(getValues(plan.value())._values[0][0], TC{2});
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, parameters) {
+  ParsedQuery parsedQuery;
+  SparqlValues parameters{{Variable{"?x"}}, {{TC{1}}}};
+  QueryPlanCache::addParameters(parsedQuery, parameters);
+  ASSERT_EQ(parsedQuery.children().size(), 1u);
+  EXPECT_TRUE(
+      std::holds_alternative<parsedQuery::Values>(parsedQuery.children()[0]));
+
+  auto plan = makePlan(1);
+  EXPECT_EQ(QueryPlanCache::findParameters(plan.tree_.value(),
+                                           {{Variable{"?x"}}, {{TC{2}}}}),
+            nullptr);
+  plan.parameters_ =
+      QueryPlanCache::findParameters(plan.tree_.value(), parameters);
+  ASSERT_NE(plan.parameters_, nullptr);
+
+  // The string representation (which is the key in the query result cache)
+  // reflects the new values.
+  using ::testing::HasSubstr;
+  EXPECT_THAT(plan.tree_->asString(), ::testing::Not(HasSubstr("42")));
+  QueryPlanCache::bindParameters(plan, {{Variable{"?x"}}, {{TC{42}}}});
+  EXPECT_EQ(getValues(plan)._values[0][0], TC{42});
+  EXPECT_THAT(plan.tree_->asString(), HasSubstr("42"));
+}
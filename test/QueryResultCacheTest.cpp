@@ -0,0 +1,104 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "./util/AllocatorTestHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "engine/LocalVocab.h"
+#include "engine/QueryExecutionContext.h"
+#include "util/File.h"
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+
+// Return a result with the given `rows` (the ints are converted via `V`) and
+// an additional column that refers to the first word of the `localVocab`.
+ResultTable makeResult(const std::vector<std::array<int, 2>>& rows,
+                       LocalVocab localVocab) {
+  IdTable table{3, ad_utility::testing::makeAllocator()};
+  for (const auto& [a, b] : rows) {
+    table.emplace_back();
+    table(table.size() - 1, 0) = V(a);
+    table(table.size() - 1, 1) = V(b);
+    table(table.size() - 1, 2) =
+        Id::makeFromLocalVocabIndex(LocalVocabIndex::make(0));
+  }
+  return {std::move(table), {0, 1}, std::move(localVocab)};
+}
+
+LocalVocab makeLocalVocab(const std::vector<std::string>& words) {
+  LocalVocab localVocab;
+  for (const auto& word : words) {
+    localVocab.getIndexAndAddIfNotContained(word);
+  }
+  return localVocab;
+}
+
+RuntimeInformation makeRuntimeInfo(std::string descriptor) {
+  RuntimeInformation runtimeInfo;
+  runtimeInfo.descriptor_ = std::move(descriptor);
+  runtimeInfo.columnNames_ = {"?a", "?b", "?c"};
+  runtimeInfo.totalTime_ = 42.0;
+  runtimeInfo.numRows_ = 2;
+  runtimeInfo.numCols_ = 3;
+  return runtimeInfo;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryResultCache, writeAndReadPinnedResults) {
+  QueryResultCache cache;
+  cache.computeOncePinned("pinned", [] {
+    return CacheValue{makeResult({{1, 2}, {3, 4}}, makeLocalVocab({"<a>"})),
+                      makeRuntimeInfo("first")};
+  });
+  cache.computeOncePinned("pinnedWithLocalVocab", [] {
+    return CacheValue{makeResult({{5, 6}}, makeLocalVocab({"<x>", "\"y\""})),
+                      makeRuntimeInfo("second")};
+  });
+  cache.computeOnce("notPinned", [] {
+    return CacheValue{makeResult({{7, 8}}, LocalVocab{}),
+                      makeRuntimeInfo("third")};
+  });
+  (*cache.pinnedSizes().wlock())["scan"] = 17;
+
+  const std::string filename = "queryResultCacheTest.pinned-results";
+  EXPECT_EQ(cache.writePinnedResultsToFile(filename, "fingerprint"), 2u);
+
+  QueryResultCache restored;
+  auto allocator = ad_utility::testing::makeAllocator();
+  // Nothing is read for a different state of the index.
+  EXPECT_EQ(restored.readPinnedResultsFromFile(filename, "other", allocator),
+            0u);
+  EXPECT_EQ(restored.numPinnedEntries(), 0u);
+
+  // A result that is already contained is not replaced.
+  restored.computeOnce("pinned", [] {
+    return CacheValue{makeResult({}, LocalVocab{}), makeRuntimeInfo("other")};
+  });
+  EXPECT_EQ(
+      restored.readPinnedResultsFromFile(filename, "fingerprint", allocator),
+      1u);
+  ad_utility::deleteFile(filename);
+  EXPECT_EQ(restored.numPinnedEntries(), 1u);
+  EXPECT_EQ(restored.getPinnedSize("scan"), 17u);
+
+  auto original = cache.getIfContained("pinnedWithLocalVocab");
+  auto copy = restored.getIfContained("pinnedWithLocalVocab");
+  ASSERT_TRUE(original.has_value());
+  ASSERT_TRUE(copy.has_value());
+  const auto& originalResult = *original.value()._resultPointer->resultTable();
+  const auto& copyResult = *copy.value()._resultPointer->resultTable();
+  EXPECT_EQ(copyResult.idTable(), originalResult.idTable());
+  EXPECT_EQ(copyResult.sortedBy(), originalResult.sortedBy());
+  const auto& localVocab = copyResult.localVocab();
+  ASSERT_EQ(localVocab.size(), 2u);
+  EXPECT_EQ(localVocab.getWord(LocalVocabIndex::make(0)), "<x>");
+  EXPECT_EQ(localVocab.getWord(LocalVocabIndex::make(1)), "\"y\"");
+  const auto& runtimeInfo = copy.value()._resultPointer->runtimeInfo();
+  EXPECT_EQ(runtimeInfo.descriptor_, "second");
+  EXPECT_EQ(runtimeInfo.columnNames_, makeRuntimeInfo("").columnNames_);
+  EXPECT_EQ(runtimeInfo.totalTime_, 42.0);
+  EXPECT_EQ(runtimeInfo.numRows_, 2u);
+}
@@ -8,6 +8,7 @@
 #include "./SparqlExpressionTestHelpers.h"
 #include "./util/AllocatorTestHelpers.h"
 #include "./util/GTestHelpers.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressions.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -775,6 +776,64 @@ TEST(RelationalExpression, VariableAndConstantBinarySearch) {
   testSortedVariableAndConstant<LE>(mixed, "<z>"s, {{{2, 3}}});
 }
 
+// _____________________________________________________________________________
+TEST(RelationalExpression, getRangeFilterExpression) {
+  Variable x{"?x"};
+  auto var = [](const Variable& v) -> SparqlExpression::Ptr {
+    return std::make_unique<VariableExpression>(v);
+  };
+  auto id = [](Id value) -> SparqlExpression::Ptr {
+    return std::make_unique<IdExpression>(value);
+  };
+  auto getRangeFilter = []<Comparison comp>(SparqlExpression::Ptr left,
+                                            SparqlExpression::Ptr right) {
+    return relational::RelationalExpression<comp>{
+        {std::move(left), std::move(right)}}
+        .getRangeFilterExpression();
+  };
+  auto expectRangeFilter =
+      [&x](const std::optional<SparqlExpression::RangeFilterData>& rangeFilter,
+           Comparison comparison, Id value,
+           source_location l = source_location::current()) {
+        auto trace = generateLocationTrace(l);
+        ASSERT_TRUE(rangeFilter.has_value());
+        EXPECT_EQ(rangeFilter->variable_, x);
+        EXPECT_EQ(rangeFilter->comparison_, comparison);
+        EXPECT_EQ(rangeFilter->value_, value);
+      };
+
+  // The variable is the left operand.
+  expectRangeFilter(getRangeFilter.operator()<LT>(var(x), id(IntId(42))), LT,
+                    IntId(42));
+  expectRangeFilter(getRangeFilter.operator()<NE>(var(x), id(DoubleId(1.5))),
+                    NE, DoubleId(1.5));
+
+  // The constant is the left operand, the comparison is mirrored s.t. the
+  // variable becomes the left operand.
+  expectRangeFilter(getRangeFilter.operator()<LT>(id(IntId(42)), var(x)), GT,
+                    IntId(42));
+  expectRangeFilter(getRangeFilter.operator()<LE>(id(IntId(42)), var(x)), GE,
+                    IntId(42));
+  expectRangeFilter(getRangeFilter.operator()<GT>(id(IntId(42)), var(x)), LT,
+                    IntId(42));
+  expectRangeFilter(getRangeFilter.operator()<GE>(id(IntId(42)), var(x)), LE,
+                    IntId(42));
+  expectRangeFilter(getRangeFilter.operator()<EQ>(id(IntId(42)), var(x)), EQ,
+                    IntId(42));
+
+  // Two variables, two constants, or a constant that is not stored in an `Id`
+  // (e.g. an IRI, which has to be looked up in the vocabulary) are not
+  // supported.
+  EXPECT_FALSE(getRangeFilter.operator()<LT>(var(x), var(Variable{"?y"}))
+                   .has_value());
+  EXPECT_FALSE(
+      getRangeFilter.operator()<LT>(id(IntId(1)), id(IntId(2))).has_value());
+  EXPECT_FALSE(getRangeFilter
+                   .operator()<LT>(var(x),
+                                   std::make_unique<IriExpression>("<x>"))
+                   .has_value());
+}
+
 // TODO<joka921> We currently do not have tests for the `LocalVocab` case,
 // because the relational expressions do not work properly with the current
 // limited implementation of the local vocabularies. Add those tests, as soon as
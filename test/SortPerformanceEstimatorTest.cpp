@@ -8,6 +8,7 @@
 #include <thread>
 
 #include "engine/SortPerformanceEstimator.h"
+#include "util/File.h"
 #include "util/Log.h"
 #include "util/Random.h"
 
@@ -55,3 +56,30 @@ TEST(SortPerformanceEstimator, TestManyEstimates) {
     }
   }
 }
+
+// _____________________________________________________________________________
+TEST(SortPerformanceEstimator, writeAndReadEstimates) {
+  auto allocator = ad_utility::AllocatorWithLimit<Id>{
+      ad_utility::makeAllocationMemoryLeftThreadsafeObject(1ull << 30ul)};
+  SortPerformanceEstimator estimator{allocator, 100'000};
+  std::string filename = "sortPerformanceEstimatorTest.sort-estimates";
+  estimator.writeToFile(filename, 100'000);
+
+  SortPerformanceEstimator readEstimator;
+  // Estimates that were computed for a different number of elements are not
+  // used.
+  ASSERT_FALSE(readEstimator.readFromFile(filename, 200'000));
+  ASSERT_FALSE(readEstimator.readFromFile("nonExisting.sort-estimates", 0));
+  ASSERT_TRUE(readEstimator.readFromFile(filename, 100'000));
+  // A truncated file leads to an exception (which the server handles by
+  // measuring the estimates again) and leaves the estimates unchanged.
+  std::filesystem::resize_file(filename, 20);
+  ASSERT_ANY_THROW(readEstimator.readFromFile(filename, 100'000));
+  ad_utility::deleteFile(filename);
+  for (size_t numRows : {1'000, 50'000, 3'000'000}) {
+    for (size_t numColumns : {1, 4, 7}) {
+      ASSERT_EQ(readEstimator.estimatedSortTime(numRows, numColumns),
+                estimator.estimatedSortTime(numRows, numColumns));
+    }
+  }
+}
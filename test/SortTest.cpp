@@ -7,6 +7,7 @@
 
 #include "./IndexTestHelpers.h"
 #include "./util/IdTableHelpers.h"
+#include "absl/cleanup/cleanup.h"
 #include "engine/Sort.h"
 #include "engine/ValuesForTesting.h"
 #include "global/ValueIdComparators.h"
@@ -16,15 +17,17 @@ using ad_utility::source_location;
 
 namespace {
 
-// Create a `Sort` operation that sorts the `input` by the `sortColumns`.
-Sort makeSort(IdTable input, const std::vector<ColumnIndex>& sortColumns) {
+// Create a `Sort` operation that sorts the `input` by the `sortColumns`. If
+// `lazyBlockSize` is specified, the input can be computed lazily.
+Sort makeSort(IdTable input, const std::vector<ColumnIndex>& sortColumns,
+              std::optional<size_t> lazyBlockSize = std::nullopt) {
   std::vector<Variable> vars;
   auto qec = ad_utility::testing::getQec();
   for (ColumnIndex i = 0; i < input.numColumns(); ++i) {
     vars.emplace_back("?"s + std::to_string(i));
   }
   auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
-      ad_utility::testing::getQec(), std::move(input), vars);
+      ad_utility::testing::getQec(), std::move(input), vars, lazyBlockSize);
   return Sort{qec, subtree, sortColumns};
 }
 
@@ -65,6 +68,29 @@ void testSort(IdTable input, const IdTable& expected,
       auto result = s.getResult();
       const auto& resultTable = result->idTable();
       ASSERT_EQ(resultTable, permutedExpected);
+
+      // Also test the external sort, which is used if the input is too large
+      // to be sorted in RAM.
+      qec->getQueryTreeCache().clearAll();
+      auto maxSize = RuntimeParameters().get<"sort-in-memory-max-size-mb">();
+      auto externalMemory =
+          RuntimeParameters().get<"sort-external-memory-mb">();
+      absl::Cleanup restoreParameters{[maxSize, externalMemory] {
+        RuntimeParameters().set<"sort-in-memory-max-size-mb">(maxSize);
+        RuntimeParameters().set<"sort-external-memory-mb">(externalMemory);
+      }};
+      RuntimeParameters().set<"sort-in-memory-max-size-mb">(0);
+      RuntimeParameters().set<"sort-external-memory-mb">(1);
+      Sort externalSort = makeSort(permutedInput.clone(), sortColumns, 2);
+      ASSERT_TRUE(externalSort.supportsLazyEvaluation());
+      auto externalResult =
+          externalSort.getLazyResult().materialize(qec->getAllocator());
+      ASSERT_EQ(externalResult, permutedExpected);
+
+      // The external sort is also used if the result is materialized.
+      qec->getQueryTreeCache().clearAll();
+      auto materializedResult = externalSort.getResult();
+      ASSERT_EQ(materializedResult->idTable(), permutedExpected);
     }
   } while (std::next_permutation(sortColumns.begin(), sortColumns.end()));
 }
@@ -1210,3 +1210,61 @@ TEST(ParserTest, LanguageFilterPostProcessing) {
               triples[2]);
   }
 }
+
+// _____________________________________________________________________________
+TEST(ParserTest, parseUpdate) {
+  using Triple = ParsedUpdate::Triple;
+  {
+    auto updates = SparqlParser::parseUpdate(
+        "PREFIX x: <http://x.org/> INSERT DATA { x:a x:b \"c\" . x:a x:b 42 }");
+    ASSERT_EQ(updates.size(), 1u);
+    const auto& update = updates[0];
+    EXPECT_TRUE(update.toDelete_.empty());
+    EXPECT_FALSE(update.whereClause_.has_value());
+    ASSERT_EQ(update.toInsert_.size(), 2u);
+    EXPECT_EQ(update.toInsert_[0],
+              (Triple{"<http://x.org/a>", "<http://x.org/b>", lit("\"c\"")}));
+    EXPECT_EQ(update.toInsert_[1],
+              (Triple{"<http://x.org/a>", "<http://x.org/b>", 42}));
+  }
+  {
+    // Several operations, separated by `;`, and the keywords are not case
+    // sensitive.
+    auto updates = SparqlParser::parseUpdate(
+        "delete data { <a> <b> <c> } ; DELETE WHERE { ?s <b> ?o } ;"
+        "DELETE { ?s <b> ?o } INSERT { ?s <d> ?o } WHERE { ?s <b> ?o }");
+    ASSERT_EQ(updates.size(), 3u);
+    EXPECT_EQ(updates[0].toDelete_,
+              (std::vector<Triple>{{"<a>", "<b>", "<c>"}}));
+    EXPECT_FALSE(updates[0].whereClause_.has_value());
+
+    Triple sbo{Var{"?s"}, "<b>", Var{"?o"}};
+    EXPECT_EQ(updates[1].toDelete_, (std::vector<Triple>{sbo}));
+    EXPECT_TRUE(updates[1].toInsert_.empty());
+    ASSERT_TRUE(updates[1].whereClause_.has_value());
+    EXPECT_TRUE(updates[1].whereClause_.value().selectClause().isAsterisk());
+
+    EXPECT_EQ(updates[2].toDelete_, (std::vector<Triple>{sbo}));
+    EXPECT_EQ(updates[2].toInsert_,
+              (std::vector<Triple>{{Var{"?s"}, "<d>", Var{"?o"}}}));
+    ASSERT_TRUE(updates[2].whereClause_.has_value());
+  }
+  {
+    auto updates =
+        SparqlParser::parseUpdate("INSERT { ?s <b> ?o } WHERE { ?s <a> ?o }");
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_TRUE(updates[0].toDelete_.empty());
+    EXPECT_EQ(updates[0].toInsert_.size(), 1u);
+    EXPECT_TRUE(updates[0].whereClause_.has_value());
+  }
+  // Variables are not allowed in `INSERT DATA`, blank nodes are not supported,
+  // and a `WHERE` clause is required for templates with variables.
+  EXPECT_THROW(SparqlParser::parseUpdate("INSERT DATA { ?s <b> <c> }"),
+               ParseException);
+  EXPECT_THROW(SparqlParser::parseUpdate("INSERT DATA { _:x <b> <c> }"),
+               ParseException);
+  EXPECT_THROW(SparqlParser::parseUpdate("DELETE { ?s <b> <c> }"),
+               ParseException);
+  EXPECT_THROW(SparqlParser::parseUpdate("SELECT * WHERE { ?s ?p ?o }"),
+               ParseException);
+}
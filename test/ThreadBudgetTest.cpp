@@ -0,0 +1,37 @@
+//  Copyright 2023, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "util/ThreadBudget.h"
+
+using ad_utility::ReservedThreads;
+
+// _____________________________________________________________________________
+TEST(ThreadBudget, reserveAndRelease) {
+  const size_t maxNumThreads = ReservedThreads::maxNumThreads();
+  ASSERT_GE(maxNumThreads, 1U);
+  {
+    ReservedThreads none{0};
+    EXPECT_EQ(none.numThreads(), 0U);
+    ReservedThreads one{1};
+    EXPECT_EQ(one.numThreads(), 1U);
+
+    // Only the remaining threads of the budget can be reserved, further
+    // reservations get no threads at all.
+    std::optional<ReservedThreads> rest{std::in_place, maxNumThreads + 5};
+    EXPECT_EQ(rest->numThreads(), maxNumThreads - 1);
+    ReservedThreads exhausted{3};
+    EXPECT_EQ(exhausted.numThreads(), 0U);
+
+    // Released threads can be reserved again.
+    rest.reset();
+    ReservedThreads again{maxNumThreads};
+    EXPECT_EQ(again.numThreads(), maxNumThreads - 1);
+  }
+  // All threads have been returned to the budget.
+  ReservedThreads all{maxNumThreads};
+  EXPECT_EQ(all.numThreads(), maxNumThreads);
+}
@@ -8,10 +8,15 @@
 #include <string>
 #include <vector>
 
+#include "./IndexTestHelpers.h"
 #include "./util/AllocatorTestHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "absl/cleanup/cleanup.h"
+#include "engine/IndexScan.h"
+#include "engine/QueryExecutionTree.h"
 #include "engine/TransitivePath.h"
 #include "global/Id.h"
+#include "util/ThreadBudget.h"
 
 using ad_utility::testing::makeAllocator;
 namespace {
@@ -115,3 +120,126 @@ TEST(TransitivePathTest, computeTransitivePath) {
   T.computeTransitivePath<2>(&result, sub, true, false, 0, 1, V(0), V(2), 1, 2);
   assertSameUnorderedContent(expected, result);
 }
+
+// Test that the parallel search from many start nodes yields the same result
+// as the sequential search, and that the order of the start nodes (and thus
+// the sorting of the left column) is preserved.
+TEST(TransitivePathTest, computeTransitivePathParallel) {
+  // A chain `0 -> 1 -> ... -> 99` with an additional edge `99 -> 0`.
+  IdTable sub(2, makeAllocator());
+  const size_t numNodes = 100;
+  for (size_t i = 0; i < numNodes; ++i) {
+    sub.push_back({V(i), V((i + 1) % numNodes)});
+  }
+
+  IdTable expected(2, makeAllocator());
+  for (size_t i = 0; i < numNodes; ++i) {
+    for (size_t j = 0; j < numNodes; ++j) {
+      expected.push_back({V(i), V(j)});
+    }
+  }
+
+  TransitivePath T(nullptr, nullptr, false, false, 0, 0, V(0), V(0),
+                   Variable{"?bim"}, Variable{"?bam"}, 0, 0);
+  auto chunkSize = RuntimeParameters().get<"transitive-path-chunk-size">();
+  absl::Cleanup restoreChunkSize{[chunkSize] {
+    RuntimeParameters().set<"transitive-path-chunk-size">(chunkSize);
+  }};
+  RuntimeParameters().set<"transitive-path-chunk-size">(3);
+  IdTable result(2, makeAllocator());
+  T.computeTransitivePath<2>(&result, sub, true, true, 0, 1, V(0), V(0), 1,
+                             std::numeric_limits<size_t>::max());
+  ASSERT_TRUE(std::ranges::is_sorted(result.getColumn(0)));
+  assertSameUnorderedContent(expected, result);
+
+  // If the threads of the shared budget are all used (e.g. by concurrent
+  // queries), the calling thread searches from all the start nodes alone.
+  ad_utility::ReservedThreads allThreads{
+      ad_utility::ReservedThreads::maxNumThreads()};
+  ASSERT_EQ(ad_utility::ReservedThreads{1}.numThreads(), 0U);
+  result.clear();
+  T.computeTransitivePath<2>(&result, sub, true, true, 0, 1, V(0), V(0), 1,
+                             std::numeric_limits<size_t>::max());
+  ASSERT_TRUE(std::ranges::is_sorted(result.getColumn(0)));
+  assertSameUnorderedContent(expected, result);
+}
+
+// Test the bidirectional search that is used if both sides are fixed.
+TEST(TransitivePathTest, computeTransitivePathBothSidesFixed) {
+  // A chain `0 -> 1 -> ... -> 9` with an additional edge `9 -> 0` and a
+  // disconnected component `20 -> 21`.
+  IdTable sub(2, makeAllocator());
+  for (size_t i = 0; i < 10; ++i) {
+    sub.push_back({V(i), V((i + 1) % 10)});
+  }
+  sub.push_back({V(20), V(21)});
+
+  TransitivePath T(nullptr, nullptr, false, false, 0, 0, V(0), V(0),
+                   Variable{"?bim"}, Variable{"?bam"}, 0, 0);
+  auto isReachable = [&](size_t from, size_t to, size_t minDist,
+                         size_t maxDist) {
+    IdTable result(2, makeAllocator());
+    T.computeTransitivePath<2>(&result, sub, false, false, 0, 1, V(from),
+                               V(to), minDist, maxDist);
+    if (result.empty()) {
+      return false;
+    }
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result(0, 0), V(from));
+    EXPECT_EQ(result(0, 1), V(to));
+    return true;
+  };
+  constexpr size_t inf = std::numeric_limits<size_t>::max();
+
+  EXPECT_TRUE(isReachable(0, 1, 1, inf));
+  EXPECT_TRUE(isReachable(2, 7, 1, inf));
+  EXPECT_TRUE(isReachable(7, 2, 1, inf));
+  EXPECT_TRUE(isReachable(20, 21, 1, inf));
+  EXPECT_FALSE(isReachable(21, 20, 1, inf));
+  EXPECT_FALSE(isReachable(0, 21, 1, inf));
+  EXPECT_FALSE(isReachable(0, 42, 1, inf));
+  EXPECT_FALSE(isReachable(42, 0, 1, inf));
+
+  // A node is only reachable from itself via the cycle.
+  EXPECT_TRUE(isReachable(3, 3, 1, inf));
+  EXPECT_TRUE(isReachable(3, 3, 10, 10));
+  EXPECT_FALSE(isReachable(3, 3, 1, 9));
+  EXPECT_FALSE(isReachable(20, 20, 1, inf));
+
+  // The distance from 2 to 7 is 5, or 15, 25, ... via the cycle.
+  EXPECT_TRUE(isReachable(2, 7, 5, 5));
+  EXPECT_TRUE(isReachable(2, 7, 1, 5));
+  EXPECT_FALSE(isReachable(2, 7, 1, 4));
+  EXPECT_FALSE(isReachable(2, 7, 6, 14));
+  EXPECT_TRUE(isReachable(2, 7, 6, 15));
+  EXPECT_TRUE(isReachable(2, 7, 15, inf));
+  EXPECT_FALSE(isReachable(2, 7, 3, 2));
+}
+
+// If both sides are fixed and the subtree is a scan with a fixed predicate,
+// the reachability is computed by index scans and the subtree is not
+// evaluated, which is reported in the runtime information.
+TEST(TransitivePathTest, bothSidesFixedWithIndexScans) {
+  auto qec = ad_utility::testing::getQec(
+      "<a> <p> <b> . <b> <p> <c> . <c> <q> <d> .");
+  auto id = ad_utility::testing::makeGetId(qec->getIndex());
+  auto scan = ad_utility::makeExecutionTree<IndexScan>(
+      qec, Permutation::Enum::PSO,
+      SparqlTriple{Variable{"?x"}, "<p>", Variable{"?y"}});
+  auto reachability = [&](const std::string& from, const std::string& to) {
+    TransitivePath T(qec, scan, false, false, 0, 1, id(from), id(to),
+                     Variable{"?start"}, Variable{"?end"}, 1,
+                     std::numeric_limits<size_t>::max());
+    auto result = T.getResult();
+    const auto& children = T.getRuntimeInfo().children_;
+    EXPECT_EQ(children.size(), 1u);
+    if (!children.empty()) {
+      EXPECT_EQ(children.at(0).status_,
+                RuntimeInformation::Status::optimizedOut);
+    }
+    return result->size();
+  };
+  EXPECT_EQ(reachability("<a>", "<c>"), 1u);
+  EXPECT_EQ(reachability("<c>", "<a>"), 0u);
+  EXPECT_EQ(reachability("<a>", "<d>"), 0u);
+}
@@ -49,7 +49,12 @@ struct DummyPermutation {
     Data data() const { return {}; }
   };
 
+  std::vector<Id> getCol0IdsOfInsertedTriples() const {
+    return insertedCol0Ids_;
+  }
+
   Metadata meta_;
+  std::vector<Id> insertedCol0Ids_;
 };
 
 std::vector<std::array<Id, 3>> expectedResult() {
@@ -88,6 +93,26 @@ TEST(TriplesView, IgnoreRanges) {
   ASSERT_EQ(result, expected);
 }
 
+TEST(TriplesView, InsertedCol0Ids) {
+  // `V(2)` and `V(14)` only occur in inserted triples, `V(3)` also in the
+  // metadata, and `V(4)` is in an ignored range.
+  DummyPermutation permutation;
+  permutation.insertedCol0Ids_ = {V(2), V(3), V(4), V(14)};
+  auto expected = expectedResult();
+  std::vector<std::array<Id, 3>> expected2{{V(2), V(2), V(4)},
+                                           {V(2), V(4), V(6)}};
+  expected.insert(expected.begin() + 1, expected2.begin(), expected2.end());
+  for (size_t i = 0; i < 14; ++i) {
+    expected.push_back({V(14), V(14 * (i + 1)), V(14 * (i + 2))});
+  }
+  std::vector<std::pair<Id, Id>> ignoredRanges{{V(4), V(5)}};
+  std::vector<std::array<Id, 3>> result;
+  for (auto triple : TriplesView(permutation, ignoredRanges)) {
+    result.push_back(triple);
+  }
+  ASSERT_EQ(result, expected);
+}
+
 TEST(TriplesView, IgnoreTriples) {
   std::vector<std::array<Id, 3>> result;
   auto expected = expectedResult();
@@ -2,6 +2,13 @@
 // Chair of Algorithms and Data Structures.
 // Author: Johannes Kalmbach(joka921) <johannes.kalmbach@gmail.com>
 //
+#ifndef EOF
+#define EOF std::char_traits<char>::eof()
+#endif
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <iostream>
 #include <string>
 
@@ -635,3 +642,91 @@ TEST(TurtleParserTest, TurtleStreamAndParallelParser) {
   testWithParser.template operator()<TurtleParallelParser<Tokenizer>>(false);
   ad_utility::deleteFile(filename);
 }
+
+// _____________________________________________________________________________
+TEST(TurtleParserTest, CompressedAndMultipleInputFiles) {
+  namespace io = boost::iostreams;
+  std::vector<TurtleTriple> expectedTriples;
+  // Write the triples `[begin, end)` to `filename`, compressed with the
+  // `compressor` (if any).
+  auto writeTriples = [&expectedTriples](const std::string& filename,
+                                         size_t begin, size_t end,
+                                         auto... compressor) {
+    io::filtering_ostream of;
+    (..., of.push(compressor));
+    of.push(io::file_sink(filename, std::ios::out | std::ios::binary));
+    for (size_t i = begin; i < end; ++i) {
+      auto subject = absl::StrCat("<", i / 1000, ">");
+      auto predicate = absl::StrCat("<", i / 100, ">");
+      auto object = absl::StrCat("<", i / 10, ">");
+      of << subject << ' ' << predicate << ' ' << object << ".\n";
+      expectedTriples.emplace_back(subject, predicate, object);
+    }
+  };
+  writeTriples("turtleCompressedInput.ttl", 0, 1'000);
+  writeTriples("turtleCompressedInput.ttl.gz", 1'000, 2'500,
+               io::gzip_compressor());
+  writeTriples("turtleCompressedInput.ttl.zst", 2'500, 3'000,
+               io::zstd_compressor());
+  std::vector<std::string> filenames{"turtleCompressedInput.ttl",
+                                     "turtleCompressedInput.ttl.gz",
+                                     "turtleCompressedInput.ttl.zst"};
+
+  auto toRef = [](const TurtleTriple& t) {
+    return std::tie(t.subject_, t.predicate_, t.object_.getString());
+  };
+  auto parseAll = [&toRef](TurtleParserBase& parser) {
+    std::vector<TurtleTriple> result;
+    while (auto batch = parser.getBatch()) {
+      result.insert(result.end(), batch.value().begin(), batch.value().end());
+    }
+    std::ranges::sort(result, std::less{}, toRef);
+    return result;
+  };
+
+  FILE_BUFFER_SIZE() = 1000;
+  // Each of the compressed files can be read on its own.
+  auto expectedGz = std::vector<TurtleTriple>(expectedTriples.begin() + 1'000,
+                                              expectedTriples.begin() + 2'500);
+  std::ranges::sort(expectedGz, std::less{}, toRef);
+  TurtleParallelParser<Tokenizer> gzParser{filenames[1]};
+  EXPECT_THAT(parseAll(gzParser), ::testing::ElementsAreArray(expectedGz));
+  auto expectedZst = std::vector<TurtleTriple>(expectedTriples.begin() + 2'500,
+                                               expectedTriples.end());
+  std::ranges::sort(expectedZst, std::less{}, toRef);
+  TurtleStreamParser<Tokenizer> zstParser{filenames[2]};
+  EXPECT_THAT(parseAll(zstParser), ::testing::ElementsAreArray(expectedZst));
+
+  // All the files together, with different numbers of concurrently parsed
+  // files.
+  std::ranges::sort(expectedTriples, std::less{}, toRef);
+  auto makeParser = [](const std::string& filename) {
+    return std::make_unique<TurtleParallelParser<Tokenizer>>(filename);
+  };
+  for (size_t numConcurrentFiles : {1, 2, 3, 5}) {
+    TurtleMultiFileParser parser{filenames, makeParser, numConcurrentFiles};
+    EXPECT_THAT(parseAll(parser), ::testing::ElementsAreArray(expectedTriples));
+  }
+
+  // The `getLine` interface also works.
+  TurtleMultiFileParser parser{filenames, makeParser};
+  std::vector<TurtleTriple> result;
+  TurtleTriple next;
+  while (parser.getLine(next)) {
+    result.push_back(next);
+  }
+  std::ranges::sort(result, std::less{}, toRef);
+  EXPECT_THAT(result, ::testing::ElementsAreArray(expectedTriples));
+
+  // Destroying the parser before all the triples were read must not block.
+  { TurtleMultiFileParser{filenames, makeParser}.getBatch(); }
+
+  // Errors in one of the files are propagated.
+  TurtleMultiFileParser failingParser{{filenames[0], "doesNotExist.ttl"},
+                                      makeParser};
+  EXPECT_ANY_THROW(parseAll(failingParser));
+
+  for (const auto& filename : filenames) {
+    ad_utility::deleteFile(filename);
+  }
+}
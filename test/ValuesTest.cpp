@@ -82,3 +82,32 @@ TEST(Values, illegalInput) {
   ValuesComponents values{{TC{12}, TC{"<x>"}}, {TC::UNDEF{}}};
   ASSERT_ANY_THROW(Values(qec, {{Variable{"?x"}, Variable{"?y"}}, values}));
 }
+
+// Check that the values can be replaced and that the result can be computed
+// repeatedly, which is needed for cached query plans.
+TEST(Values, replaceValuesAndComputeAgain) {
+  auto testQec = ad_utility::testing::getQec("<x> <x> <x> .");
+  std::vector<Variable> variables{Variable{"?x"}, Variable{"?y"}};
+  Values valuesOperation(testQec, {variables, {{TC{12}, TC{"<y>"}}}});
+  auto I = ad_utility::testing::IntId;
+  auto L = ad_utility::testing::LocalVocabId;
+  for (size_t i = 0; i < 2; ++i) {
+    auto result = valuesOperation.computeResultOnlyForTesting();
+    EXPECT_EQ(result.idTable(), makeIdTableFromVector({{I(12), L(0)}}));
+    EXPECT_EQ(result.localVocab().getWord(LocalVocabIndex::make(0)), "<y>");
+  }
+
+  valuesOperation.replaceValues({variables, {{TC{13}, TC{"<z>"}}}});
+  EXPECT_THAT(valuesOperation.asString(), ::testing::HasSubstr("<z>"));
+  auto result = valuesOperation.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{I(13), L(0)}}));
+  EXPECT_EQ(result.localVocab().getWord(LocalVocabIndex::make(0)), "<z>");
+
+  // Other variables, another number of rows, and undefined values are not
+  // allowed.
+  ASSERT_ANY_THROW(valuesOperation.replaceValues(
+      {{Variable{"?x"}, Variable{"?z"}}, {{TC{13}, TC{"<z>"}}}}));
+  ASSERT_ANY_THROW(valuesOperation.replaceValues({variables, {}}));
+  ASSERT_ANY_THROW(
+      valuesOperation.replaceValues({variables, {{TC{13}, TC::UNDEF{}}}}));
+}
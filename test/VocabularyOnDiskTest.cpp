@@ -159,3 +159,39 @@ TEST(VocabularyOnDisk, ErrorOnNonAscendingIds) {
 TEST(VocabularyOnDisk, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
+
+TEST(VocabularyOnDisk, GetWordsForSortedIds) {
+  std::vector<std::string> words{"game",  "4",      "nobody", "33",
+                                 "alpha", "\n\1\t", "222",    "1111"};
+  std::vector<uint64_t> ids{2, 4, 8, 16, 17, 19, 42, 42 * 42 + 7};
+  VocabularyCreator creator{"GetWordsForSortedIds"};
+  auto vocabulary = creator.createVocabularyFromDiskImpl(words, ids);
+
+  // IDs that are not contained, duplicates, and all the contained IDs.
+  std::vector<uint64_t> sortedIds{0, 2, 2, 3, 8, 16, 17, 19, 42, 43, 1771};
+  auto result = vocabulary.getWordsForSortedIds(sortedIds);
+  ASSERT_EQ(result.size(), sortedIds.size());
+  for (size_t i = 0; i < sortedIds.size(); ++i) {
+    EXPECT_EQ(result[i], vocabulary[sortedIds[i]]);
+  }
+  EXPECT_EQ(result[1], "game");
+  EXPECT_EQ(result[3], std::nullopt);
+  EXPECT_EQ(result[10], "1111");
+
+  EXPECT_TRUE(vocabulary.getWordsForSortedIds({}).empty());
+
+  // Words that are far apart in the file are read separately.
+  std::vector<std::string> longWords{"a", std::string(100'000, 'b'), "c",
+                                     std::string(2'000'000, 'd'), "e"};
+  VocabularyCreator creator2{"GetWordsForSortedIds2"};
+  auto vocabulary2 = creator2.createVocabularyFromDisk(longWords);
+  std::vector<uint64_t> allIds{0, 1, 2, 3, 4};
+  EXPECT_EQ(vocabulary2.getWordsForSortedIds(allIds),
+            std::vector<std::optional<std::string>>(longWords.begin(),
+                                                    longWords.end()));
+  std::vector<uint64_t> someIds{0, 2, 4};
+  EXPECT_EQ(vocabulary2.getWordsForSortedIds(someIds),
+            (std::vector<std::optional<std::string>>{"a", "c", "e"}));
+  ASSERT_THROW(vocabulary.getWordsForSortedIds(std::vector<uint64_t>{4, 2}),
+               ad_utility::Exception);
+}
@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures.
 // Author: Björn Buchhold <buchholb>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <cstdio>
@@ -126,3 +127,113 @@ TEST(Vocabulary, PrefixFilter) {
   ASSERT_EQ(x.first.get(), 1u);
   ASSERT_EQ(x.second.get(), 2u);
 }
+
+TEST(VocabularyCache, HitsMissesAndClear) {
+  VocabularyCache cache{1'000'000};
+  size_t numComputations = 0;
+  auto getWord = [&](size_t vocabularyId, uint64_t index) {
+    return cache.getOrComputeWord(vocabularyId, index, [&]() {
+      ++numComputations;
+      return std::optional<std::string>{std::to_string(index)};
+    });
+  };
+  auto getIndex = [&](size_t vocabularyId, const std::string& word) {
+    return cache.getOrComputeIndex(vocabularyId, word, [&]() {
+      ++numComputations;
+      return VocabularyCache::IndexOfWord{word.size(), true};
+    });
+  };
+
+  EXPECT_EQ(getWord(0, 42), "42");
+  EXPECT_EQ(getWord(0, 42), "42");
+  EXPECT_EQ(numComputations, 1u);
+  // The entries of different vocabularies are distinct.
+  EXPECT_EQ(getWord(1, 42), "42");
+  EXPECT_EQ(numComputations, 2u);
+  EXPECT_EQ(getIndex(0, "abc").index_, 3u);
+  EXPECT_EQ(getIndex(0, "abc").index_, 3u);
+  EXPECT_EQ(numComputations, 3u);
+  EXPECT_EQ(cache.numEntries(), 3u);
+  EXPECT_GT(cache.sizeInBytes(), 0u);
+  EXPECT_EQ(cache.numHits(), 2u);
+  EXPECT_EQ(cache.numMisses(), 3u);
+
+  cache.clear();
+  EXPECT_EQ(cache.numEntries(), 0u);
+  EXPECT_EQ(getWord(0, 42), "42");
+  EXPECT_EQ(numComputations, 4u);
+
+  // Words that are resolved together only compute the missing ones.
+  size_t numBatches = 0;
+  std::vector<uint64_t> computedIndices;
+  auto getWords = [&](std::vector<uint64_t> indices) {
+    return cache.getOrComputeWords(
+        0, indices, [&](std::span<const uint64_t> missingIndices) {
+          ++numBatches;
+          std::vector<std::optional<std::string>> words;
+          for (uint64_t index : missingIndices) {
+            computedIndices.push_back(index);
+            words.emplace_back(std::to_string(index));
+          }
+          return words;
+        });
+  };
+  using ::testing::ElementsAre;
+  EXPECT_THAT(getWords({3, 42, 50}), ElementsAre("3", "42", "50"));
+  EXPECT_THAT(computedIndices, ElementsAre(3, 50));
+  EXPECT_THAT(getWords({3, 42, 50}), ElementsAre("3", "42", "50"));
+  EXPECT_EQ(numBatches, 1u);
+  EXPECT_EQ(getWord(0, 50), "50");
+  EXPECT_EQ(numComputations, 4u);
+
+  // With a budget of zero, the cache is bypassed.
+  cache.setMaxSizeInBytes(0);
+  EXPECT_EQ(cache.numEntries(), 0u);
+  auto numHitsAndMisses = cache.numHits() + cache.numMisses();
+  EXPECT_EQ(getWord(0, 42), "42");
+  EXPECT_EQ(getWord(0, 42), "42");
+  EXPECT_EQ(numComputations, 6u);
+  EXPECT_THAT(getWords({3, 42}), ElementsAre("3", "42"));
+  EXPECT_EQ(numBatches, 2u);
+  EXPECT_EQ(cache.numEntries(), 0u);
+  EXPECT_EQ(cache.numHits() + cache.numMisses(), numHitsAndMisses);
+}
+
+// The entries are distributed to the shards of the cache, the statistics
+// count the entries of all shards.
+TEST(VocabularyCache, Shards) {
+  VocabularyCache cache{1'000'000};
+  for (uint64_t i = 0; i < 10 * VocabularyCache::numShards; ++i) {
+    cache.getOrComputeWord(0, i, [i]() {
+      return std::optional<std::string>{std::to_string(i)};
+    });
+  }
+  EXPECT_EQ(cache.numEntries(), 10 * VocabularyCache::numShards);
+  EXPECT_EQ(cache.numMisses(), 10 * VocabularyCache::numShards);
+  cache.clear();
+  EXPECT_EQ(cache.numEntries(), 0u);
+  EXPECT_EQ(cache.sizeInBytes(), 0u);
+}
+
+TEST(VocabularyCache, VocabularyReadFromFile) {
+  {
+    TextVocabulary v;
+    ad_utility::HashSet<string> s{"a", "ab", "ba", "car"};
+    v.createFromSet(s);
+    v.writeToFile("_testtmp_vocfile_cache");
+  }
+  TextVocabulary v;
+  v.readFromFile("_testtmp_vocfile_cache");
+  // The words are not externalized, so their lookup bypasses the cache.
+  const auto& cache = VocabularyCache::shared();
+  auto numHitsAndMisses = cache.numHits() + cache.numMisses();
+  for (size_t i = 0; i < 2; ++i) {
+    WordVocabIndex idx;
+    ASSERT_TRUE(v.getId("ba", &idx));
+    ASSERT_EQ(2u, idx.get());
+    ASSERT_FALSE(v.getId("b", &idx));
+    ASSERT_EQ(2u, idx.get());
+  }
+  EXPECT_EQ(cache.numHits() + cache.numMisses(), numHitsAndMisses);
+  remove("_testtmp_vocfile_cache");
+}